@@ -0,0 +1,168 @@
+/**
+ * @file ax25.h
+ * @brief Streaming AX.25 UI frame encoder
+ *
+ * Emits opening flag, address, control, PID, information field, FCS and
+ * closing flag straight into a caller-owned output buffer in one pass,
+ * updating the CRC-16/X.25 frame check sequence as bytes are written.
+ *
+ * Two output forms are supported:
+ * - Octets (default): the frame as bytes, as handed to a KISS TNC.
+ * - HDLC bit stream (AX25_OPT_BIT_STUFF): each octet sent LSB first with a
+ *   zero inserted after five consecutive ones, flags left unstuffed, and
+ *   optionally NRZI-encoded (AX25_OPT_NRZI). Bits are packed LSB first
+ *   into output bytes, so the modem shifts each byte out starting at bit 0.
+ *
+ * @requirement SRS-F020 Generate beacon at configurable intervals
+ */
+
+#ifndef SMART_QSO_AX25_H
+#define SMART_QSO_AX25_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "smart_qso.h"
+#include "crc16.h"
+
+/*===========================================================================*/
+/* AX.25 Constants                                                            */
+/*===========================================================================*/
+
+/** AX.25 frame constants */
+#define AX25_FLAG               0x7E
+#define AX25_CTRL_UI            0x03
+#define AX25_PID_NO_L3          0xF0
+#define AX25_ADDR_LEN           7
+#define AX25_MAX_FRAME_LEN      330
+
+/** FCS plus closing flag, appended by ax25_encoder_finish() */
+#define AX25_TRAILER_LEN        3U
+
+/** Encoder option: emit a bit-stuffed HDLC bit stream instead of octets */
+#define AX25_OPT_BIT_STUFF      0x01U
+
+/** Encoder option: NRZI-encode the bit stream (implies AX25_OPT_BIT_STUFF) */
+#define AX25_OPT_NRZI           0x02U
+
+/**
+ * @brief Worst-case bit-stream buffer size for a frame of n octets
+ *
+ * Stuffing adds at most one bit per five, plus one byte of padding.
+ */
+#define AX25_BITSTREAM_MAX_LEN(n)   ((n) + ((n) + 4U) / 5U + 1U)
+
+/*===========================================================================*/
+/* AX.25 Types                                                                */
+/*===========================================================================*/
+
+/**
+ * @brief Streaming AX.25 encoder state
+ */
+typedef struct {
+    uint8_t   *buffer;        /**< Destination buffer */
+    size_t     capacity;      /**< Destination buffer size */
+    size_t     pos;           /**< Completed output bytes */
+    size_t     bit_count;     /**< Bits emitted (bit-stream mode) */
+    size_t     frame_bits;    /**< Bits up to closing flag, set by finish */
+    Crc16Ctx_t fcs;           /**< Running FCS */
+    uint32_t   options;       /**< AX25_OPT_* flags */
+    uint8_t    bit_acc;       /**< Partially filled output byte */
+    uint8_t    ones;          /**< Consecutive one bits (for stuffing) */
+    uint8_t    level;         /**< NRZI line level */
+    bool       overflow;      /**< A write exceeded the buffer */
+} Ax25Encoder_t;
+
+/*===========================================================================*/
+/* AX.25 Functions                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief Encode a callsign and SSID into a 7-byte address field
+ *
+ * @param callsign Callsign (up to 6 characters, upper-cased)
+ * @param ssid     Secondary station ID (0-15)
+ * @param output   Output buffer of AX25_ADDR_LEN bytes
+ * @param is_last  true for the last address (sets the extension bit)
+ */
+void ax25_encode_address(const char *callsign, uint8_t ssid,
+                         uint8_t *output, bool is_last);
+
+/**
+ * @brief Start a frame and emit the opening flag
+ *
+ * @param enc      Encoder state
+ * @param buffer   Output buffer
+ * @param capacity Output buffer size
+ * @param options  AX25_OPT_* flags (0 for octet output)
+ * @return SMART_QSO_OK on success, SMART_QSO_ERROR_NULL_PTR on NULL args
+ */
+SmartQsoResult_t ax25_encoder_begin(Ax25Encoder_t *enc, uint8_t *buffer,
+                                    size_t capacity, uint32_t options);
+
+/**
+ * @brief Append an address field
+ *
+ * @param enc      Encoder state
+ * @param callsign Callsign
+ * @param ssid     SSID
+ * @param is_last  true for the last address
+ */
+void ax25_encoder_put_address(Ax25Encoder_t *enc, const char *callsign,
+                              uint8_t ssid, bool is_last);
+
+/**
+ * @brief Append one byte
+ *
+ * @param enc   Encoder state
+ * @param value Byte value
+ */
+void ax25_encoder_put_u8(Ax25Encoder_t *enc, uint8_t value);
+
+/**
+ * @brief Append a byte sequence
+ *
+ * @param enc  Encoder state
+ * @param data Bytes to append
+ * @param len  Number of bytes
+ */
+void ax25_encoder_put_bytes(Ax25Encoder_t *enc, const uint8_t *data, size_t len);
+
+/**
+ * @brief Reserve space to write a field in place (octet mode only)
+ *
+ * Lets a formatter write the information field directly into the output
+ * buffer. Space for the FCS and closing flag is held back.
+ *
+ * @param enc       Encoder state
+ * @param available Receives the number of bytes that may be written
+ * @return Write pointer, or NULL in bit-stream mode or if full
+ */
+uint8_t *ax25_encoder_reserve(Ax25Encoder_t *enc, size_t *available);
+
+/**
+ * @brief Commit bytes written after ax25_encoder_reserve()
+ *
+ * @param enc Encoder state
+ * @param len Number of bytes written
+ */
+void ax25_encoder_commit(Ax25Encoder_t *enc, size_t len);
+
+/**
+ * @brief Emit FCS and closing flag, and flush any partial byte
+ *
+ * In bit-stream mode the last byte is padded with idle flag bits;
+ * enc->frame_bits holds the exact length up to the closing flag.
+ *
+ * @param enc           Encoder state
+ * @param bytes_written Receives the number of output bytes
+ * @return SMART_QSO_OK, or SMART_QSO_ERROR_NO_MEM if the buffer overflowed
+ */
+SmartQsoResult_t ax25_encoder_finish(Ax25Encoder_t *enc, size_t *bytes_written);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SMART_QSO_AX25_H */
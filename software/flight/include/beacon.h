@@ -21,6 +21,8 @@ extern "C" {
 #endif
 
 #include "smart_qso.h"
+#include "ax25.h"
+#include "fec.h"
 
 /*===========================================================================*/
 /* Beacon Configuration Constants                                             */
@@ -32,6 +34,45 @@ extern "C" {
 /** Maximum total beacon payload length */
 #define BEACON_MAX_PAYLOAD_LEN   256
 
+/** Info field type byte identifying a binary beacon (never printable ASCII) */
+#define BEACON_BIN_TYPE          0xB1U
+
+/** Binary beacon info field length (including type byte and CRC) */
+#define BEACON_BIN_LEN           25U
+
+/** Info field type byte identifying a log-digest beacon */
+#define BEACON_DIGEST_TYPE       0xB2U
+
+/** Fault log entries carried in a log-digest beacon */
+#define BEACON_DIGEST_ENTRIES    4U
+
+/** Log-digest beacon info field length (including type byte and CRC) */
+#define BEACON_DIGEST_LEN        42U
+
+/** Default interleave: text beacons per cycle */
+#define BEACON_DEFAULT_TEXT_RATIO    2U
+
+/** Default interleave: binary beacons per cycle */
+#define BEACON_DEFAULT_BINARY_RATIO  1U
+
+/** Default interleave: log-digest beacons per cycle */
+#define BEACON_DEFAULT_DIGEST_RATIO  1U
+
+/** Downlink data rate used for airtime accounting (AFSK 1200 bd) */
+#define BEACON_BAUD_RATE         1200U
+
+/** Transmitter key-up time before each frame (ms) */
+#define BEACON_TX_PREAMBLE_MS    500U
+
+/** Transmitter tail after each frame (ms) */
+#define BEACON_TX_TAIL_MS        100U
+
+/** Nominal orbit period for airtime budgeting (ms) */
+#define BEACON_ORBIT_PERIOD_MS   5400000U
+
+/** Default beacon airtime budget per orbit (ms, 5% duty cycle) */
+#define BEACON_DEFAULT_AIRTIME_BUDGET_MS  270000U
+
 /** Callsign for beacon identification */
 #define BEACON_CALLSIGN          "SQSO-1"
 
@@ -44,14 +85,7 @@ extern "C" {
 /** Default beacon interval in SAFE mode (ms) */
 #define BEACON_INTERVAL_SAFE_MS     180000
 
-/** AX.25 frame constants */
-#define AX25_FLAG               0x7E
-#define AX25_CTRL_UI            0x03
-#define AX25_PID_NO_L3          0xF0
-#define AX25_ADDR_LEN           7
-#define AX25_MAX_FRAME_LEN      330
-
-/** CRC-16 CCITT constants */
+/** CRC-16/X.25 (AX.25 FCS) constants; see crc16.h */
 #define CRC16_INIT              0xFFFF
 #define CRC16_POLY              0x8408
 
@@ -68,6 +102,16 @@ typedef enum {
     BEACON_SOURCE_CUSTOM   = 2   /**< Custom text (for testing) */
 } BeaconSource_t;
 
+/**
+ * @brief Beacon info field format
+ */
+typedef enum {
+    BEACON_FORMAT_TEXT   = 0,    /**< Human-readable ASCII payload */
+    BEACON_FORMAT_BINARY = 1,    /**< Packed, CRC-protected telemetry */
+    BEACON_FORMAT_DIGEST = 2,    /**< Packed summary of recent faults */
+    BEACON_FORMAT_COUNT  = 3     /**< Number of formats */
+} BeaconFormat_t;
+
 /**
  * @brief Beacon telemetry structure
  */
@@ -94,6 +138,7 @@ typedef struct {
     BeaconSource_t source;                        /**< Text source */
     BeaconTelemetry_t telemetry;                 /**< Telemetry data */
     uint32_t      sequence;                       /**< Beacon sequence number */
+    BeaconFormat_t format;                        /**< Info field format */
 } BeaconContent_t;
 
 /**
@@ -114,11 +159,29 @@ typedef struct {
  */
 typedef struct {
     uint32_t last_beacon_ms;      /**< Last beacon transmission time */
-    uint32_t interval_ms;         /**< Current beacon interval */
+    uint32_t interval_ms;         /**< Planned interval to next beacon */
+    uint32_t base_interval_ms;    /**< Power-mode interval before planning */
     uint32_t sequence;            /**< Beacon sequence counter */
     uint32_t ai_beacon_count;     /**< Count of AI-generated beacons */
     uint32_t template_count;      /**< Count of template beacons */
     uint32_t total_bytes_tx;      /**< Total bytes transmitted */
+    uint32_t binary_beacon_count; /**< Count of binary beacons */
+    uint32_t digest_beacon_count; /**< Count of log-digest beacons */
+    uint32_t useful_bytes_tx;     /**< Info field bytes transmitted */
+    uint32_t orbit_period_ms;     /**< Budget window length */
+    uint32_t orbit_budget_ms;     /**< Airtime budget per window */
+    uint32_t orbit_start_ms;      /**< Start of current budget window */
+    uint32_t orbit_airtime_ms;    /**< Airtime used in current window */
+    uint32_t total_airtime_ms;    /**< Airtime used since reset */
+    uint32_t last_airtime_ms;     /**< Airtime of the last beacon */
+    uint32_t format_airtime_ms[BEACON_FORMAT_COUNT]; /**< Last airtime per format */
+    uint32_t budget_deferrals;    /**< Beacons delayed or downgraded by budget */
+    uint32_t fec_beacon_count;    /**< Beacons sent as FX.25 */
+    bool     fec_enabled;         /**< Wrap beacons in FX.25 when they fit */
+    uint8_t  text_ratio;          /**< Text beacons per interleave cycle */
+    uint8_t  binary_ratio;        /**< Binary beacons per interleave cycle */
+    uint8_t  digest_ratio;        /**< Log-digest beacons per interleave cycle */
+    uint16_t interleave_pos;      /**< Position in interleave cycle (up to the ratio sum) */
     bool     ai_available;        /**< AI text generation available */
     char     last_ai_text[BEACON_MAX_TEXT_LEN]; /**< Last AI text */
 } BeaconState_t;
@@ -183,6 +246,100 @@ size_t beacon_format_payload(const BeaconContent_t *content,
                              char *buffer,
                              size_t buffer_len);
 
+/**
+ * @brief Format binary beacon info field
+ *
+ * Layout (multi-byte fields big-endian):
+ *   0 type (BEACON_BIN_TYPE)  1 sequence u32  5 timestamp u32
+ *   9 power_mode u8  10 soc u8  11 battery_mv u16  13 temp_obc s8
+ *  14 temp_payload s8  15 sunlit u8  16 rf_power u8  17 qso_count u16
+ *  19 orbit_number u16  21 fault_flags u8  22 source u8
+ *  23 CRC-16/X.25 of bytes 0..22, u16
+ *
+ * @param content Beacon content
+ * @param buffer Output buffer
+ * @param buffer_len Buffer length
+ * @return BEACON_BIN_LEN on success, 0 if the buffer is too small
+ */
+size_t beacon_format_binary(const BeaconContent_t *content,
+                            uint8_t *buffer,
+                            size_t buffer_len);
+
+/**
+ * @brief Format log-digest beacon info field
+ *
+ * Summarizes the fault log (most recent entries first). Layout
+ * (multi-byte fields big-endian):
+ *   0 type (BEACON_DIGEST_TYPE)  1 sequence u32  5 timestamp u32
+ *   9 total faults u16 (saturating)  11 entry count u8
+ *  12 BEACON_DIGEST_ENTRIES x { type u8, severity u8, recovered u8,
+ *                               time_s u32 } (unused entries zero)
+ *  40 CRC-16/X.25 of bytes 0..39, u16
+ *
+ * @param content Beacon content (sequence and timestamp)
+ * @param buffer Output buffer
+ * @param buffer_len Buffer length
+ * @return BEACON_DIGEST_LEN on success, 0 if the buffer is too small
+ */
+size_t beacon_format_digest(const BeaconContent_t *content,
+                            uint8_t *buffer,
+                            size_t buffer_len);
+
+/**
+ * @brief Format the info field in the content's format
+ *
+ * @param content Beacon content
+ * @param buffer Output buffer
+ * @param buffer_len Buffer length
+ * @return Number of bytes written, 0 on error
+ */
+size_t beacon_format_info(const BeaconContent_t *content,
+                          uint8_t *buffer,
+                          size_t buffer_len);
+
+/**
+ * @brief Set the text:binary:digest beacon interleave ratio
+ *
+ * beacon_generate_content() emits text_count text beacons, then
+ * binary_count binary beacons, then digest_count log-digest beacons, and
+ * repeats. (1, 0, 0) sends text only. Any ratios are honoured exactly; a
+ * cycle is at most 765 beacons.
+ *
+ * @param text_count Text beacons per cycle
+ * @param binary_count Binary beacons per cycle
+ * @param digest_count Log-digest beacons per cycle
+ * @return SMART_QSO_OK, or SMART_QSO_ERROR_INVALID if all are zero
+ */
+SmartQsoResult_t beacon_set_interleave(uint8_t text_count, uint8_t binary_count,
+                                       uint8_t digest_count);
+
+/**
+ * @brief Estimate on-air time of a frame
+ *
+ * Preamble + frame bits at BEACON_BAUD_RATE + tail.
+ *
+ * @param frame_len Frame length in bytes
+ * @return Airtime in milliseconds (rounded up)
+ */
+uint32_t beacon_airtime_ms(size_t frame_len);
+
+/**
+ * @brief Configure the per-orbit airtime budget
+ *
+ * The planner spreads the remaining budget over the remaining window:
+ * it stretches the interval beyond the power-mode interval when the
+ * budget is tight, and compresses it (down to half the power-mode
+ * interval, never in SAFE mode) when there is budget to spare. Text
+ * beacons are downgraded to binary when only a short frame still fits.
+ *
+ * @param orbit_period_ms Budget window (typically one orbit)
+ * @param budget_ms Airtime allowed per window
+ * @return SMART_QSO_OK, or SMART_QSO_ERROR_INVALID if the window is zero
+ *         or the budget exceeds it
+ */
+SmartQsoResult_t beacon_set_airtime_budget(uint32_t orbit_period_ms,
+                                           uint32_t budget_ms);
+
 /**
  * @brief Build AX.25 frame from beacon content
  *
@@ -205,6 +362,57 @@ size_t beacon_serialize_ax25(const Ax25Frame_t *frame,
                              uint8_t *buffer,
                              size_t buffer_len);
 
+/**
+ * @brief Encode a beacon directly into a transmit buffer in one pass
+ *
+ * Equivalent to beacon_build_ax25_frame() followed by
+ * beacon_serialize_ax25(), without the intermediate Ax25Frame_t. With
+ * AX25_OPT_BIT_STUFF / AX25_OPT_NRZI the output is a ready-to-send HDLC
+ * bit stream; size the buffer with AX25_BITSTREAM_MAX_LEN().
+ *
+ * @param content Beacon content
+ * @param buffer Output buffer
+ * @param buffer_len Buffer length
+ * @param options AX25_OPT_* flags (0 for octets)
+ * @param bytes_written Receives the number of bytes written
+ * @return SMART_QSO_OK on success, SMART_QSO_ERROR_NO_MEM if too small
+ */
+SmartQsoResult_t beacon_encode_ax25(const BeaconContent_t *content,
+                                    uint8_t *buffer,
+                                    size_t buffer_len,
+                                    uint32_t options,
+                                    size_t *bytes_written);
+
+/**
+ * @brief Encode a beacon as an FX.25 transmission
+ *
+ * Bit-stuffs the AX.25 frame and wraps it with fx25_encode(), so the
+ * result is a ready-to-send bit stream (NRZI is left to the modem).
+ * Receivers without FX.25 still decode the embedded AX.25 frame.
+ *
+ * @param content Beacon content
+ * @param buffer Output buffer (FX25_MAX_LEN bytes always suffices)
+ * @param buffer_len Buffer length
+ * @param bytes_written Receives the number of bytes written
+ * @return SMART_QSO_OK on success, SMART_QSO_ERROR_INVALID if the frame
+ *         is too long for an FX.25 codeword, SMART_QSO_ERROR_NO_MEM if the
+ *         buffer is too small
+ */
+SmartQsoResult_t beacon_encode_fx25(const BeaconContent_t *content,
+                                    uint8_t *buffer,
+                                    size_t buffer_len,
+                                    size_t *bytes_written);
+
+/**
+ * @brief Enable or disable FX.25 forward error correction on beacons
+ *
+ * When enabled, beacon_transmit() sends FX.25 and falls back to a plain
+ * AX.25 frame for beacons too long for one codeword.
+ *
+ * @param enable true to wrap beacons in FX.25
+ */
+void beacon_set_fec(bool enable);
+
 /**
  * @brief Transmit beacon
  *
@@ -252,7 +460,9 @@ SmartQsoResult_t beacon_store_ai_text(const char *text, size_t len);
 const char *beacon_get_template(void);
 
 /**
- * @brief Calculate CRC-16 CCITT
+ * @brief Calculate CRC-16/X.25 (AX.25 FCS)
+ *
+ * Equivalent to crc16_x25(); kept for existing callers.
  *
  * @param data Data buffer
  * @param len Data length
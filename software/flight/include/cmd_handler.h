@@ -51,7 +51,8 @@ typedef enum {
     CMD_SYS_SET_MODE    = 0x02,  /**< Set operational mode */
     CMD_SYS_GET_STATUS  = 0x03,  /**< Get system status */
     CMD_SYS_SET_TIME    = 0x04,  /**< Set mission time */
-    CMD_SYS_CLEAR_FAULTS = 0x05  /**< Clear fault log */
+    CMD_SYS_CLEAR_FAULTS = 0x05, /**< Clear fault log */
+    CMD_SYS_FLUSH_NVM   = 0x06   /**< Save pending persistent data now */
 } CmdSystem_t;
 
 /**
@@ -0,0 +1,111 @@
+/**
+ * @file crc16.h
+ * @brief CRC-16/X.25 (AX.25 FCS) for SMART-QSO flight software
+ *
+ * Table-driven CRC-16/X.25: reflected polynomial 0x8408 (0x1021 normal),
+ * initial value 0xFFFF, final XOR 0xFFFF. This is the HDLC/AX.25 frame
+ * check sequence, transmitted least significant byte first.
+ *
+ * The incremental context lets callers fold bytes into the FCS as they
+ * are written into a frame instead of re-reading the frame afterwards.
+ *
+ * @requirement SRS-DATA-002 System shall protect data integrity with CRC
+ */
+
+#ifndef SMART_QSO_CRC16_H
+#define SMART_QSO_CRC16_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*===========================================================================*/
+/* CRC-16/X.25 Constants                                                      */
+/*===========================================================================*/
+
+/** Initial register value */
+#define CRC16_X25_INIT      0xFFFFU
+
+/** Final XOR value */
+#define CRC16_X25_XOROUT    0xFFFFU
+
+/** CRC of "123456789" (catalogue check value) */
+#define CRC16_X25_CHECK     0x906EU
+
+/** Register value after running a frame including its own FCS */
+#define CRC16_X25_RESIDUE   0xF0B8U
+
+/*===========================================================================*/
+/* CRC-16/X.25 Types                                                          */
+/*===========================================================================*/
+
+/**
+ * @brief Incremental CRC-16/X.25 context
+ */
+typedef struct {
+    uint16_t reg;             /**< Running CRC register (not finalized) */
+} Crc16Ctx_t;
+
+/*===========================================================================*/
+/* CRC-16/X.25 API                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief Calculate CRC-16/X.25 over a buffer
+ *
+ * @param data Data buffer
+ * @param len  Length in bytes
+ * @return Finalized CRC (FCS value)
+ */
+uint16_t crc16_x25(const void *data, size_t len);
+
+/**
+ * @brief Advance a raw CRC-16/X.25 register
+ *
+ * @param crc  Register value (CRC16_X25_INIT to start)
+ * @param data Data buffer (NULL leaves the register unchanged)
+ * @param len  Length in bytes
+ * @return Updated register; XOR with CRC16_X25_XOROUT to finalize
+ */
+uint16_t crc16_x25_update(uint16_t crc, const void *data, size_t len);
+
+/**
+ * @brief Start an incremental CRC-16/X.25 calculation
+ *
+ * @param ctx Context to initialize
+ */
+void crc16_ctx_init(Crc16Ctx_t *ctx);
+
+/**
+ * @brief Feed data into an incremental CRC-16/X.25 calculation
+ *
+ * @param ctx  Context
+ * @param data Data buffer
+ * @param len  Length in bytes
+ */
+void crc16_update(Crc16Ctx_t *ctx, const void *data, size_t len);
+
+/**
+ * @brief Feed a single byte into an incremental CRC-16/X.25 calculation
+ *
+ * @param ctx  Context
+ * @param byte Byte value
+ */
+void crc16_update_byte(Crc16Ctx_t *ctx, uint8_t byte);
+
+/**
+ * @brief Finish an incremental CRC-16/X.25 calculation
+ *
+ * @param ctx Context
+ * @return FCS of all data fed since crc16_ctx_init()
+ */
+uint16_t crc16_final(const Crc16Ctx_t *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SMART_QSO_CRC16_H */
@@ -0,0 +1,121 @@
+/**
+ * @file crc32.h
+ * @brief CRC32 engine interface for SMART-QSO flight software
+ *
+ * Extends the basic smart_qso_crc32() API with an incremental context and
+ * selectable implementations. All implementations compute the same IEEE
+ * 802.3 CRC32 (reflected polynomial 0xEDB88320); they differ only in speed.
+ *
+ * crc32_init() selects the fastest implementation supported by the running
+ * processor. Until it is called the portable slicing-by-8 engine is used,
+ * so CRC users never depend on initialization order.
+ *
+ * @requirement SRS-DATA-002 System shall protect data integrity with CRC
+ */
+
+#ifndef SMART_QSO_CRC32_H
+#define SMART_QSO_CRC32_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "smart_qso.h"
+
+/*===========================================================================*/
+/* CRC32 Types                                                                */
+/*===========================================================================*/
+
+/**
+ * @brief CRC32 implementation identifiers
+ */
+typedef enum {
+    CRC32_IMPL_BYTEWISE = 0,  /**< Byte-at-a-time table (reference) */
+    CRC32_IMPL_SLICE8   = 1,  /**< Portable slicing-by-8 tables */
+    CRC32_IMPL_PCLMUL   = 2,  /**< x86 PCLMULQDQ carry-less folding */
+    CRC32_IMPL_ARMV8    = 3,  /**< ARMv8 CRC32 instructions */
+    CRC32_IMPL_COUNT    = 4   /**< Number of implementations */
+} Crc32Impl_t;
+
+/**
+ * @brief Incremental CRC32 context
+ */
+typedef struct {
+    uint32_t reg;             /**< Running CRC register (not finalized) */
+} Crc32Ctx_t;
+
+/*===========================================================================*/
+/* Implementation Selection                                                   */
+/*===========================================================================*/
+
+/**
+ * @brief Select the fastest CRC32 implementation for this processor
+ *
+ * @return Selected implementation
+ */
+Crc32Impl_t crc32_init(void);
+
+/**
+ * @brief Check whether an implementation is available
+ *
+ * @param impl Implementation identifier
+ * @return true if compiled in and supported by the running processor
+ */
+bool crc32_impl_supported(Crc32Impl_t impl);
+
+/**
+ * @brief Force a specific implementation (tests and benchmarks)
+ *
+ * @param impl Implementation identifier
+ * @return SMART_QSO_OK on success, SMART_QSO_ERROR_INVALID if unsupported
+ */
+SmartQsoResult_t crc32_select(Crc32Impl_t impl);
+
+/**
+ * @brief Get the active implementation
+ *
+ * @return Active implementation
+ */
+Crc32Impl_t crc32_get_impl(void);
+
+/**
+ * @brief Get a printable implementation name
+ *
+ * @param impl Implementation identifier
+ * @return Static name string
+ */
+const char *crc32_impl_name(Crc32Impl_t impl);
+
+/*===========================================================================*/
+/* Incremental API                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief Start an incremental CRC32 calculation
+ *
+ * @param ctx Context to initialize
+ */
+void crc32_ctx_init(Crc32Ctx_t *ctx);
+
+/**
+ * @brief Feed data into an incremental CRC32 calculation
+ *
+ * @param ctx  Context
+ * @param data Data buffer
+ * @param len  Length in bytes
+ */
+void crc32_update(Crc32Ctx_t *ctx, const void *data, size_t len);
+
+/**
+ * @brief Finish an incremental CRC32 calculation
+ *
+ * @param ctx Context
+ * @return CRC32 of all data fed since crc32_ctx_init()
+ */
+uint32_t crc32_final(const Crc32Ctx_t *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SMART_QSO_CRC32_H */
@@ -47,6 +47,9 @@ extern "C" {
 /** Deployment verification timeout (ms) */
 #define DEPLOYMENT_VERIFY_TIMEOUT_MS    10000U
 
+/** Schema version of the persisted DeploymentStatus_t (kv_store) */
+#define DEPLOY_STATUS_SCHEMA_VERSION    1U
+
 /*===========================================================================*/
 /* Types                                                                      */
 /*===========================================================================*/
@@ -25,8 +25,8 @@ extern "C" {
 /* EPS Configuration Constants                                                */
 /*===========================================================================*/
 
-/** EPS configuration file path */
-#define EPS_CONFIG_FILE "/tmp/eps_config.dat"
+/** Schema version of the persisted EpsControlState_t (kv_store) */
+#define EPS_CONFIG_SCHEMA_VERSION 1U
 
 /** Power limit for SAFE mode (Watts) */
 #define EPS_POWER_LIMIT_SAFE_W   0.5
@@ -25,8 +25,8 @@ extern "C" {
 /* Fault Management Constants                                                 */
 /*===========================================================================*/
 
-/** Fault log file path */
-#define FAULT_LOG_FILE "/tmp/fault_log.dat"
+/** Schema version of the persisted fault log (kv_store) */
+#define FAULT_LOG_SCHEMA_VERSION 1U
 
 /*===========================================================================*/
 /* Fault Log Entry Structure                                                  */
@@ -118,10 +118,22 @@ SmartQsoResult_t fault_log_mark_recovered(size_t index);
 /**
  * @brief Save fault log to persistent storage
  *
+ * Rewrites every entry. fault_log_add() and fault_log_mark_recovered()
+ * only queue their entry for fault_log_flush().
+ *
  * @return SMART_QSO_OK on success, error code otherwise
  */
 SmartQsoResult_t fault_log_save(void);
 
+/**
+ * @brief Write the entries queued since the last flush
+ *
+ * Registered with the persistence service (PERSIST_MODULE_FAULT_LOG).
+ *
+ * @return SMART_QSO_OK on success, error code otherwise
+ */
+SmartQsoResult_t fault_log_flush(void);
+
 /**
  * @brief Load fault log from persistent storage
  *
@@ -0,0 +1,182 @@
+/**
+ * @file fec.h
+ * @brief Reed-Solomon forward error correction for downlink frames
+ *
+ * RS(255,223) over GF(2^8) (field polynomial 0x11D, first consecutive
+ * root alpha^1), correcting up to 16 byte errors per codeword. Shorter
+ * blocks use the same code shortened (virtual leading zeros), so any
+ * 1..223 data bytes gain 32 check bytes.
+ *
+ * Two framings are built on it:
+ * - FX.25: a 64-bit correlation tag followed by an RS codeword holding
+ *   the bit-stuffed AX.25 frame padded with flags. Receivers that do not
+ *   know FX.25 still see an ordinary AX.25 frame inside the codeword.
+ * - Telemetry: the frame sync word sent uncoded, then the rest of the
+ *   frame split evenly into shortened RS(255,223) codewords.
+ *
+ * Decoding is Berlekamp-Massey, Chien search and Forney.
+ *
+ * @requirement SRS-DATA-002 System shall protect data integrity with CRC
+ */
+
+#ifndef SMART_QSO_FEC_H
+#define SMART_QSO_FEC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "smart_qso.h"
+
+/*===========================================================================*/
+/* Reed-Solomon Constants                                                     */
+/*===========================================================================*/
+
+/** Codeword length */
+#define FEC_RS_N            255U
+
+/** Maximum data bytes per codeword */
+#define FEC_RS_K            223U
+
+/** Check bytes per codeword */
+#define FEC_RS_PARITY       (FEC_RS_N - FEC_RS_K)
+
+/** Correctable byte errors per codeword */
+#define FEC_RS_MAX_CORRECT  (FEC_RS_PARITY / 2U)
+
+/*===========================================================================*/
+/* FX.25 Constants                                                            */
+/*===========================================================================*/
+
+/** Correlation tag length (sent least significant byte first) */
+#define FX25_TAG_LEN        8U
+
+/** Tag bit errors tolerated when matching a received tag */
+#define FX25_TAG_MAX_ERRORS 8U
+
+/** Largest FX.25 transmission: tag plus a full codeword */
+#define FX25_MAX_LEN        (FX25_TAG_LEN + FEC_RS_N)
+
+/** Largest AX.25 bit stream that fits in one FX.25 codeword (bytes) */
+#define FX25_MAX_DATA_LEN   FEC_RS_K
+
+/*===========================================================================*/
+/* Telemetry Framing Constants                                                */
+/*===========================================================================*/
+
+/** Uncoded sync word ahead of the codewords */
+#define FEC_TLM_SYNC_LEN    4U
+
+/** Codewords needed for a frame of n bytes (including the sync word) */
+#define FEC_TLM_BLOCKS(n) \
+    ((((n) - FEC_TLM_SYNC_LEN) + FEC_RS_K - 1U) / FEC_RS_K)
+
+/** Coded length of a frame of n bytes (including the sync word) */
+#define FEC_TLM_CODED_LEN(n)  ((n) + (FEC_TLM_BLOCKS(n) * FEC_RS_PARITY))
+
+/*===========================================================================*/
+/* Reed-Solomon Functions                                                     */
+/*===========================================================================*/
+
+/**
+ * @brief Compute check bytes for a (possibly shortened) codeword
+ *
+ * @param data     Data bytes
+ * @param data_len Number of data bytes (1..FEC_RS_K)
+ * @param parity   Receives FEC_RS_PARITY check bytes, sent after the data
+ * @return SMART_QSO_OK, SMART_QSO_ERROR_NULL_PTR or SMART_QSO_ERROR_INVALID
+ */
+SmartQsoResult_t fec_rs_encode(const uint8_t *data, size_t data_len,
+                               uint8_t *parity);
+
+/**
+ * @brief Correct a received codeword in place
+ *
+ * @param block     Data bytes followed by FEC_RS_PARITY check bytes
+ * @param block_len Total length (FEC_RS_PARITY + 1 .. FEC_RS_N)
+ * @param corrected Receives the number of bytes corrected (may be NULL)
+ * @return SMART_QSO_OK if the block is (now) a valid codeword,
+ *         SMART_QSO_ERROR if the errors exceed the code's capability,
+ *         SMART_QSO_ERROR_NULL_PTR or SMART_QSO_ERROR_INVALID
+ */
+SmartQsoResult_t fec_rs_decode(uint8_t *block, size_t block_len,
+                               size_t *corrected);
+
+/*===========================================================================*/
+/* FX.25 Functions                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief Wrap an AX.25 bit stream in an FX.25 transmission
+ *
+ * Picks the shortest RS(255,223)-family codeword that holds the stream,
+ * pads it with idle flags continuing the stream's flag phase, and
+ * appends check bytes. The modem NRZI-encodes the whole result.
+ *
+ * @param stream      Bit-stuffed frame, bits packed LSB first
+ *                    (ax25_encoder with AX25_OPT_BIT_STUFF, no NRZI)
+ * @param stream_bits Bits up to and including the closing flag
+ * @param out         Output buffer
+ * @param out_len     Output buffer size
+ * @param written     Receives the transmission length
+ * @return SMART_QSO_OK, SMART_QSO_ERROR_NULL_PTR, SMART_QSO_ERROR_INVALID
+ *         if the stream exceeds FX25_MAX_DATA_LEN or SMART_QSO_ERROR_NO_MEM
+ */
+SmartQsoResult_t fx25_encode(const uint8_t *stream, size_t stream_bits,
+                             uint8_t *out, size_t out_len, size_t *written);
+
+/**
+ * @brief Match a tag, correct the codeword and return its data block
+ *
+ * @param in        Received bytes starting at the correlation tag
+ * @param in_len    Received length
+ * @param data      Receives the corrected data block (bit stream)
+ * @param data_len  Size of data; receives the block length
+ * @param corrected Receives the number of bytes corrected (may be NULL)
+ * @return SMART_QSO_OK, SMART_QSO_ERROR_INVALID if no tag matches or the
+ *         input is short, SMART_QSO_ERROR if uncorrectable,
+ *         SMART_QSO_ERROR_NO_MEM or SMART_QSO_ERROR_NULL_PTR
+ */
+SmartQsoResult_t fx25_decode(const uint8_t *in, size_t in_len,
+                             uint8_t *data, size_t *data_len,
+                             size_t *corrected);
+
+/*===========================================================================*/
+/* Telemetry Framing Functions                                                */
+/*===========================================================================*/
+
+/**
+ * @brief RS-encode a serialized telemetry frame
+ *
+ * @param frame     Frame from tlm_serialize() (sync word first)
+ * @param frame_len Frame length
+ * @param out       Output buffer (FEC_TLM_CODED_LEN(frame_len) bytes)
+ * @param out_len   Output buffer size
+ * @param written   Receives the coded length
+ * @return SMART_QSO_OK, SMART_QSO_ERROR_NULL_PTR, SMART_QSO_ERROR_INVALID
+ *         or SMART_QSO_ERROR_NO_MEM
+ */
+SmartQsoResult_t fec_tlm_encode(const uint8_t *frame, size_t frame_len,
+                                uint8_t *out, size_t out_len, size_t *written);
+
+/**
+ * @brief Correct an RS-coded telemetry frame and strip the check bytes
+ *
+ * @param coded     Coded frame (modified in place while correcting)
+ * @param coded_len Coded length
+ * @param frame     Receives the frame (sync word first)
+ * @param frame_len Size of frame; receives the frame length
+ * @param corrected Receives the total bytes corrected (may be NULL)
+ * @return SMART_QSO_OK, SMART_QSO_ERROR if any codeword is uncorrectable,
+ *         SMART_QSO_ERROR_INVALID, SMART_QSO_ERROR_NO_MEM or
+ *         SMART_QSO_ERROR_NULL_PTR
+ */
+SmartQsoResult_t fec_tlm_decode(uint8_t *coded, size_t coded_len,
+                                uint8_t *frame, size_t *frame_len,
+                                size_t *corrected);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SMART_QSO_FEC_H */
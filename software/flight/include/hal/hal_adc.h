@@ -88,6 +88,9 @@ SmartQsoResult_t hal_adc_read_voltage(HalAdcChannel_t channel, double *voltage);
 /**
  * @brief Read multiple channels
  *
+ * The channels are converted as one scan sequence (DMA on the target), so
+ * the samples are taken back to back and cost a single bus transaction.
+ *
  * @param channels Array of channels to read
  * @param values   Output: array of raw values
  * @param count    Number of channels
@@ -96,6 +99,20 @@ SmartQsoResult_t hal_adc_read_voltage(HalAdcChannel_t channel, double *voltage);
 SmartQsoResult_t hal_adc_read_multiple(const HalAdcChannel_t *channels,
                                         uint16_t *values, size_t count);
 
+/**
+ * @brief Convert a raw sample to the channel's value
+ *
+ * Applies the channel's front-end scaling, giving the same units as
+ * hal_adc_read_voltage() (volts, amps or degrees C).
+ *
+ * @param channel ADC channel the sample was taken on
+ * @param raw     Raw ADC value
+ * @param voltage Output: channel value
+ * @return SMART_QSO_OK on success
+ */
+SmartQsoResult_t hal_adc_raw_to_voltage(HalAdcChannel_t channel, uint16_t raw,
+                                         double *voltage);
+
 /**
  * @brief Calibrate ADC
  *
@@ -103,6 +120,40 @@ SmartQsoResult_t hal_adc_read_multiple(const HalAdcChannel_t *channels,
  */
 SmartQsoResult_t hal_adc_calibrate(void);
 
+#ifdef HAL_TARGET_SIMULATION
+/*===========================================================================*/
+/* Simulation Controls                                                        */
+/*===========================================================================*/
+
+/**
+ * @brief Simulated ADC statistics
+ */
+typedef struct {
+    uint32_t transactions;          /**< Single reads plus scan sequences */
+    uint32_t conversions;           /**< Channels converted */
+} HalAdcSimStats_t;
+
+/**
+ * @brief Set the value a simulated channel measures
+ *
+ * Samples are quantized to the configured resolution over the channel's
+ * front-end range and clamped to it.
+ *
+ * @param channel ADC channel
+ * @param value   Channel value (units of hal_adc_read_voltage())
+ * @return SMART_QSO_OK on success
+ */
+SmartQsoResult_t hal_adc_sim_set_value(HalAdcChannel_t channel, double value);
+
+/**
+ * @brief Get simulated ADC statistics (cleared by hal_adc_init())
+ *
+ * @param stats Receives the statistics
+ * @return SMART_QSO_OK on success
+ */
+SmartQsoResult_t hal_adc_sim_get_stats(HalAdcSimStats_t *stats);
+#endif /* HAL_TARGET_SIMULATION */
+
 #ifdef __cplusplus
 }
 #endif
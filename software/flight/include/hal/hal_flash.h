@@ -4,6 +4,14 @@
  *
  * Provides non-volatile memory abstraction for data persistence.
  *
+ * The region API is served by a wear-leveling layer (hal_flash_wl.c) that
+ * maps each region's sector-sized logical blocks onto a pool of physical
+ * blocks with spares. Erasing a region moves each of its blocks to the
+ * least-worn free block, blocks that fail to erase or program are retired
+ * and replaced from the pool, and per-block erase counts feed
+ * hal_flash_wear_level(). Targets only implement the physical block
+ * driver at the end of this file.
+ *
  * @requirement SRS-F060 Persist mission data to non-volatile memory
  * @requirement SRS-F041 Maintain fault log in non-volatile memory
  */
@@ -31,6 +39,36 @@ extern "C" {
  */
 #define HAL_FLASH_PAGE_SIZE     64
 
+/**
+ * @brief Rated erase cycles per block
+ */
+#define HAL_FLASH_ENDURANCE_CYCLES  10000U
+
+/**
+ * @brief Per-block metadata area after the sector data (erase count, owner)
+ */
+#define HAL_FLASH_BLOCK_META_SIZE   16U
+
+/**
+ * @brief Physical block size (sector data plus metadata)
+ */
+#define HAL_FLASH_PHYS_BLOCK_SIZE   (HAL_FLASH_SECTOR_SIZE + HAL_FLASH_BLOCK_META_SIZE)
+
+/**
+ * @brief Logical blocks across all regions (sum of region sizes in sectors)
+ */
+#define HAL_FLASH_LOGICAL_BLOCKS    287U
+
+/**
+ * @brief Spare blocks for remapping and bad-block replacement
+ */
+#define HAL_FLASH_SPARE_BLOCKS      32U
+
+/**
+ * @brief Physical blocks managed by the wear-leveling layer
+ */
+#define HAL_FLASH_PHYS_BLOCKS       (HAL_FLASH_LOGICAL_BLOCKS + HAL_FLASH_SPARE_BLOCKS)
+
 /**
  * @brief NVM storage regions
  */
@@ -40,10 +78,27 @@ typedef enum {
     FLASH_REGION_SENSOR_CONFIG  = 2,   /**< Sensor configuration */
     FLASH_REGION_FAULT_LOG      = 3,   /**< Fault log storage */
     FLASH_REGION_BACKUP         = 4,   /**< Backup storage */
-    FLASH_REGION_STATE          = 5,   /**< System state persistence */
+    FLASH_REGION_STATE          = 5,   /**< Persistent key-value store (bank A) */
+    FLASH_REGION_STATE_B        = 6,   /**< Persistent key-value store (bank B) */
     FLASH_REGION_COUNT
 } HalFlashRegion_t;
 
+/**
+ * @brief Wear-leveling statistics
+ */
+typedef struct {
+    uint32_t physical_blocks;   /**< Blocks managed */
+    uint32_t free_blocks;       /**< Blocks available for remapping */
+    uint32_t retired_blocks;    /**< Blocks retired after a failure */
+    uint32_t lost_blocks;       /**< Logical blocks left without a block */
+    uint32_t min_erase_count;   /**< Least-worn usable block */
+    uint32_t max_erase_count;   /**< Most-worn usable block */
+    uint32_t total_erases;      /**< Sum of all block erase counts */
+    uint32_t remaps;            /**< Erases moved to another block */
+    uint32_t relocations;       /**< Blocks moved after a program failure */
+    uint64_t remaining_cycles;  /**< Rated erases left across usable blocks */
+} HalFlashWearStats_t;
+
 /*===========================================================================*/
 /* Flash Functions                                                            */
 /*===========================================================================*/
@@ -83,7 +138,8 @@ SmartQsoResult_t hal_flash_write(HalFlashRegion_t region, uint32_t offset,
  * @brief Erase flash region
  *
  * @param region Flash region to erase
- * @return SMART_QSO_OK on success
+ * @return SMART_QSO_OK on success, SMART_QSO_ERROR_IO if a block was lost
+ *         (no usable spare left); the rest of the region is still erased
  */
 SmartQsoResult_t hal_flash_erase(HalFlashRegion_t region);
 
@@ -111,13 +167,181 @@ uint32_t hal_flash_region_base(HalFlashRegion_t region);
 bool hal_flash_busy(void);
 
 /**
- * @brief Get flash wear level (if supported)
+ * @brief Get flash wear level
  *
  * @param region Flash region
- * @return Estimated wear level (0-100%)
+ * @return Erase count of the region's most-worn block as a percentage of
+ *         HAL_FLASH_ENDURANCE_CYCLES (0-100%)
  */
 uint8_t hal_flash_wear_level(HalFlashRegion_t region);
 
+/**
+ * @brief Get wear-leveling statistics
+ *
+ * @param stats Receives the statistics
+ * @return SMART_QSO_OK, SMART_QSO_ERROR_NULL_PTR, or SMART_QSO_ERROR before init
+ */
+SmartQsoResult_t hal_flash_get_wear_stats(HalFlashWearStats_t *stats);
+
+/*===========================================================================*/
+/* Physical Flash Driver (implemented per target)                             */
+/*===========================================================================*/
+
+/*
+ * Used only by the wear-leveling layer. Blocks are HAL_FLASH_PHYS_BLOCK_SIZE
+ * bytes; erase sets every byte to 0xFF and program can only clear bits.
+ * Erase and program return SMART_QSO_ERROR_IO when the block has failed,
+ * and SMART_QSO_ERROR when the device is unavailable. A program that would
+ * need a 0 -> 1 returns SMART_QSO_ERROR_INVALID (the cells keep the AND of
+ * old and new data). Both wait while the device is busy.
+ */
+
+/**
+ * @brief Initialize the physical flash device
+ *
+ * @return SMART_QSO_OK on success
+ */
+SmartQsoResult_t hal_flash_phys_init(void);
+
+/**
+ * @brief Get the number of physical blocks
+ *
+ * @return Block count
+ */
+uint32_t hal_flash_phys_block_count(void);
+
+/**
+ * @brief Read from a physical block
+ *
+ * @param block  Physical block
+ * @param offset Offset within the block
+ * @param data   Buffer to store read data
+ * @param len    Number of bytes to read
+ * @return SMART_QSO_OK on success
+ */
+SmartQsoResult_t hal_flash_phys_read(uint32_t block, uint32_t offset,
+                                      uint8_t *data, size_t len);
+
+/**
+ * @brief Program part of a physical block
+ *
+ * @param block  Physical block
+ * @param offset Offset within the block
+ * @param data   Data to program
+ * @param len    Number of bytes to program
+ * @return SMART_QSO_OK on success
+ */
+SmartQsoResult_t hal_flash_phys_program(uint32_t block, uint32_t offset,
+                                         const uint8_t *data, size_t len);
+
+/**
+ * @brief Erase a physical block
+ *
+ * @param block Physical block
+ * @return SMART_QSO_OK on success
+ */
+SmartQsoResult_t hal_flash_phys_erase(uint32_t block);
+
+#ifdef HAL_TARGET_SIMULATION
+/*===========================================================================*/
+/* Simulation Controls                                                        */
+/*===========================================================================*/
+
+/*
+ * The simulated device programs a page at a time (HAL_FLASH_PAGE_SIZE by
+ * default; the metadata area is its own page). Programming only clears
+ * bits (1 -> 0); only a block erase sets them again. Each operation is charged its erase or page
+ * program time, and in real-time mode the device stays busy that long.
+ * A power loss can be scheduled to tear an operation part way; the device
+ * then rejects every operation until hal_flash_init() or
+ * hal_flash_phys_init() "powers it up" again.
+ */
+
+/**
+ * @brief Simulated device configuration
+ */
+typedef struct {
+    uint32_t page_size;             /**< Program page (bytes, divides the sector) */
+    uint32_t erase_time_us;         /**< Block erase time */
+    uint32_t page_program_time_us;  /**< Time per page programmed */
+    bool realtime;                  /**< Stay busy for the operation time */
+    bool enforce_program_rules;     /**< Reject programs that need a 0 -> 1 */
+    const char *backing_file;       /**< mmap-backed image, NULL for RAM */
+    uint32_t seed;                  /**< Seed for power-loss tear points */
+} HalFlashSimConfig_t;
+
+/**
+ * @brief Simulated device statistics
+ */
+typedef struct {
+    uint32_t erases;                /**< Block erases started */
+    uint32_t page_programs;         /**< Pages programmed */
+    uint32_t reads;                 /**< Read operations */
+    uint32_t program_violations;    /**< Programs that needed a 0 -> 1 */
+    uint32_t power_losses;          /**< Injected power losses */
+    uint64_t busy_time_us;          /**< Device time charged to operations */
+} HalFlashSimStats_t;
+
+/**
+ * @brief Get the default configuration
+ *
+ * STM32L4-class timings, rules enforced, not real-time, RAM backed.
+ *
+ * @param config Receives the configuration
+ */
+void hal_flash_sim_default_config(HalFlashSimConfig_t *config);
+
+/**
+ * @brief Configure the simulated device
+ *
+ * Detaches the current image (a RAM image is lost, a backing file is
+ * unmapped) and clears the statistics; the next hal_flash_phys_init()
+ * attaches the configured one.
+ *
+ * @param config Configuration (NULL for the defaults)
+ * @return SMART_QSO_OK or SMART_QSO_ERROR_PARAM for a bad page size
+ */
+SmartQsoResult_t hal_flash_sim_configure(const HalFlashSimConfig_t *config);
+
+/**
+ * @brief Set the simulated erase endurance
+ *
+ * Each block fails between 100% and 150% of this many erases, so tests and
+ * benchmarks can wear the device out quickly and project lifetime from
+ * the rated value. Erase counts persist in a backing file.
+ *
+ * @param cycles Erases before the weakest block fails (0 restores the rating)
+ */
+void hal_flash_sim_set_endurance(uint32_t cycles);
+
+/**
+ * @brief Make the next physical program fail as if its block had worn out
+ */
+void hal_flash_sim_fail_next_program(void);
+
+/**
+ * @brief Cut power part way through a later program or erase
+ *
+ * @param operations Programs and erases to let through first (0 cancels)
+ */
+void hal_flash_sim_power_loss_after(uint32_t operations);
+
+/**
+ * @brief Check whether the device is powered (no power loss pending reset)
+ *
+ * @return true if operations are accepted
+ */
+bool hal_flash_sim_powered(void);
+
+/**
+ * @brief Get simulated device statistics
+ *
+ * @param stats Receives the statistics
+ * @return SMART_QSO_OK or SMART_QSO_ERROR_NULL_PTR
+ */
+SmartQsoResult_t hal_flash_sim_get_stats(HalFlashSimStats_t *stats);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
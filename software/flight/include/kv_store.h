@@ -0,0 +1,202 @@
+/**
+ * @file kv_store.h
+ * @brief Log-structured key-value store for persistent module state
+ *
+ * All saved module state (system state sections, mission data, EPS
+ * configuration, fault log, deployment status) lives in one store on the
+ * HAL flash API. The store is two banks; the active bank is a log of
+ * records, each carrying its key, a type, the writer's schema version, a
+ * sequence number and a CRC over header and value.
+ *
+ * - A put appends one record; nothing is erased on the write path.
+ * - When the active bank is full, the live records are copied into the
+ *   other bank (compaction). Its header is written last, so until then
+ *   the old bank stays authoritative and a reset loses nothing.
+ * - A record torn by a reset fails its CRC and the previous value of that
+ *   key is used.
+ *
+ * Bank A is FLASH_REGION_STATE and bank B is FLASH_REGION_STATE_B. The
+ * HAL flash must be initialized before the store is mounted; simulation
+ * builds run on the simulated device, which can keep its image in a host
+ * file (hal_flash_sim_configure()).
+ *
+ * @requirement SRS-DATA-001 System shall persist mission data across resets
+ * @requirement SRS-DATA-002 System shall protect data integrity with CRC
+ */
+
+#ifndef SMART_QSO_KV_STORE_H
+#define SMART_QSO_KV_STORE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "smart_qso.h"
+
+/*===========================================================================*/
+/* Store Geometry                                                             */
+/*===========================================================================*/
+
+/** Size of each bank (bytes) */
+#define KV_BANK_SIZE            32768U
+
+/** Number of banks */
+#define KV_BANK_COUNT           2U
+
+/** Maximum number of live keys */
+#define KV_MAX_KEYS             128U
+
+/** Maximum value length (bytes) */
+#define KV_MAX_VALUE_LEN        256U
+
+/** Record header length; values are padded to a multiple of 4 */
+#define KV_RECORD_HEADER_LEN    16U
+
+/** Space a record with a value of n bytes occupies in a bank */
+#define KV_RECORD_SIZE(n)       (KV_RECORD_HEADER_LEN + ((((uint32_t)(n)) + 3U) & ~3U))
+
+/*===========================================================================*/
+/* Key Registry                                                               */
+/*===========================================================================*/
+
+/**
+ * @brief Key namespaces, one per owning module
+ */
+typedef enum {
+    KV_NS_SYSTEM    = 1,    /**< system_state sections */
+    KV_NS_MISSION   = 2,    /**< mission_data */
+    KV_NS_EPS       = 3,    /**< eps_control configuration */
+    KV_NS_FAULT     = 4,    /**< fault_mgmt log index */
+    KV_NS_FAULT_LOG = 5,    /**< fault_mgmt log entries */
+    KV_NS_DEPLOY    = 6     /**< deployment status */
+} KvNamespace_t;
+
+/** Build a key from a namespace and an 8-bit id */
+#define KV_KEY(ns, id)          ((uint16_t)(((uint32_t)(ns) << 8) | ((uint32_t)(id) & 0xFFU)))
+
+/** System state section (SysStateSection_t) */
+#define KV_KEY_SYSTEM_SECTION(s) KV_KEY(KV_NS_SYSTEM, (s))
+
+/** MissionData_t */
+#define KV_KEY_MISSION_DATA     KV_KEY(KV_NS_MISSION, 0U)
+
+/** EpsControlState_t */
+#define KV_KEY_EPS_CONFIG       KV_KEY(KV_NS_EPS, 0U)
+
+/** Fault log ring position and length */
+#define KV_KEY_FAULT_INDEX      KV_KEY(KV_NS_FAULT, 0U)
+
+/** Fault log entry at ring position i */
+#define KV_KEY_FAULT_ENTRY(i)   KV_KEY(KV_NS_FAULT_LOG, (i))
+
+/** DeploymentStatus_t */
+#define KV_KEY_DEPLOY_STATUS    KV_KEY(KV_NS_DEPLOY, 0U)
+
+/*===========================================================================*/
+/* Types                                                                      */
+/*===========================================================================*/
+
+/**
+ * @brief Record types
+ */
+typedef enum {
+    KV_TYPE_VALUE     = 1,  /**< Value of a key */
+    KV_TYPE_TOMBSTONE = 2   /**< Key deleted */
+} KvRecordType_t;
+
+/**
+ * @brief Store statistics
+ */
+typedef struct {
+    uint32_t puts;              /**< Records appended by kv_put/kv_delete */
+    uint32_t bytes_written;     /**< Bytes programmed, including compaction */
+    uint32_t erase_count;       /**< Bank erases */
+    uint32_t compactions;       /**< Bank switches */
+    uint32_t torn_records;      /**< Records rejected by CRC at mount */
+    uint32_t live_keys;         /**< Keys with a value */
+    uint32_t live_bytes;        /**< Space the live records occupy */
+    uint32_t write_offset;      /**< Next free byte in the active bank */
+    uint32_t generation;        /**< Generation of the active bank */
+    uint32_t sequence;          /**< Sequence number of the last record */
+    uint8_t active_bank;        /**< Active bank (0 = A, 1 = B) */
+} KvStats_t;
+
+/*===========================================================================*/
+/* Functions                                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief Scan the banks and rebuild the key index
+ *
+ * Called automatically by the first access; call again to re-read the
+ * store after a (simulated) reset.
+ *
+ * @return SMART_QSO_OK (an empty or unreadable store mounts empty)
+ */
+SmartQsoResult_t kv_store_mount(void);
+
+/**
+ * @brief Erase both banks, deleting every key
+ *
+ * @return SMART_QSO_OK or SMART_QSO_ERROR_IO
+ */
+SmartQsoResult_t kv_store_format(void);
+
+/**
+ * @brief Store a value
+ *
+ * @param key     Key (see KV_KEY)
+ * @param version Schema version of the value, checked by kv_get()
+ * @param data    Value bytes
+ * @param len     Value length (1..KV_MAX_VALUE_LEN)
+ * @return SMART_QSO_OK, SMART_QSO_ERROR_NULL_PTR, SMART_QSO_ERROR_INVALID,
+ *         SMART_QSO_ERROR_NO_MEM if the key index or store is full, or
+ *         SMART_QSO_ERROR_IO
+ */
+SmartQsoResult_t kv_put(uint16_t key, uint8_t version, const void *data, size_t len);
+
+/**
+ * @brief Fetch a value
+ *
+ * @param key     Key
+ * @param version Expected schema version
+ * @param data    Receives the value
+ * @param size    Size of data
+ * @param len     Receives the value length (may be NULL)
+ * @return SMART_QSO_OK, SMART_QSO_ERROR if the key is absent,
+ *         SMART_QSO_ERROR_INVALID if the stored version differs,
+ *         SMART_QSO_ERROR_NO_MEM if data is too small,
+ *         SMART_QSO_ERROR_NULL_PTR or SMART_QSO_ERROR_IO
+ */
+SmartQsoResult_t kv_get(uint16_t key, uint8_t version, void *data, size_t size,
+                        size_t *len);
+
+/**
+ * @brief Delete a key (appends a tombstone if the key exists)
+ *
+ * @param key Key
+ * @return SMART_QSO_OK (also when absent), SMART_QSO_ERROR_NO_MEM or
+ *         SMART_QSO_ERROR_IO
+ */
+SmartQsoResult_t kv_delete(uint16_t key);
+
+/**
+ * @brief Copy the live records into the other bank now
+ *
+ * @return SMART_QSO_OK, SMART_QSO_ERROR_NO_MEM or SMART_QSO_ERROR_IO
+ */
+SmartQsoResult_t kv_store_compact(void);
+
+/**
+ * @brief Get store statistics
+ *
+ * @param stats Receives the statistics
+ * @return SMART_QSO_OK or SMART_QSO_ERROR_NULL_PTR
+ */
+SmartQsoResult_t kv_store_get_stats(KvStats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SMART_QSO_KV_STORE_H */
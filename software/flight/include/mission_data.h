@@ -25,8 +25,15 @@ extern "C" {
 /* Mission Data Constants                                                     */
 /*===========================================================================*/
 
-/** Mission data file path */
-#define MISSION_DATA_FILE "/tmp/mission_data.dat"
+/** Schema version of the persisted MissionData_t (kv_store) */
+#define MISSION_DATA_SCHEMA_VERSION 1U
+
+/**
+ * Longest the uptime and energy totals go unsaved (ms). They change every
+ * tick, so on their own they are saved at this interval; any other change
+ * saves them with it.
+ */
+#define MISSION_DATA_CHECKPOINT_MS  600000U
 
 /*===========================================================================*/
 /* Mission Data Structure                                                     */
@@ -101,6 +108,8 @@ SmartQsoResult_t mission_data_set_start(uint64_t start_ms);
 /**
  * @brief Update total uptime
  *
+ * Saved at the next checkpoint (MISSION_DATA_CHECKPOINT_MS).
+ *
  * @param uptime_ms Total uptime in milliseconds
  * @return SMART_QSO_OK on success, error code otherwise
  */
@@ -116,6 +125,8 @@ SmartQsoResult_t mission_data_increment_reset(void);
 /**
  * @brief Add energy consumption
  *
+ * Saved at the next checkpoint (MISSION_DATA_CHECKPOINT_MS).
+ *
  * @param energy_wh Energy consumed in watt-hours
  * @return SMART_QSO_OK on success, error code otherwise
  */
@@ -0,0 +1,162 @@
+/**
+ * @file persistence.h
+ * @brief Write-coalescing persistence service
+ *
+ * Modules mark their persisted state dirty when it changes instead of
+ * saving it on the spot. The service saves each dirty module once its
+ * oldest unsaved change is a coalescing window old, from a low-priority
+ * slot, so a burst of changes (a fault storm, per-tick counters) costs
+ * one save per window. Only the watchdog pre-reset callback and the
+ * ground flush command save immediately.
+ *
+ * @requirement SRS-DATA-001 System shall persist mission data across resets
+ * @requirement SRS-F051 Save state before watchdog reset
+ */
+
+#ifndef SMART_QSO_PERSISTENCE_H
+#define SMART_QSO_PERSISTENCE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "smart_qso.h"
+
+/*===========================================================================*/
+/* Constants                                                                  */
+/*===========================================================================*/
+
+/** Default coalescing window (ms) */
+#define PERSIST_DEFAULT_WINDOW_MS   10000U
+
+/** Longest configurable coalescing window (ms) */
+#define PERSIST_MAX_WINDOW_MS       600000U
+
+/*===========================================================================*/
+/* Types                                                                      */
+/*===========================================================================*/
+
+/**
+ * @brief Modules with persisted state
+ */
+typedef enum {
+    PERSIST_MODULE_MISSION   = 0,   /**< mission_data */
+    PERSIST_MODULE_EPS       = 1,   /**< eps_control configuration */
+    PERSIST_MODULE_FAULT_LOG = 2,   /**< fault_mgmt log */
+    PERSIST_MODULE_COUNT     = 3
+} PersistModule_t;
+
+/**
+ * @brief Module save function
+ */
+typedef SmartQsoResult_t (*PersistSaveFunc_t)(void);
+
+/**
+ * @brief Service statistics
+ */
+typedef struct {
+    uint32_t marks;             /**< persist_mark_dirty() calls */
+    uint32_t saves;             /**< Module saves performed */
+    uint32_t save_errors;       /**< Module saves that failed */
+    uint32_t forced_flushes;    /**< persist_flush_all() calls */
+} PersistStats_t;
+
+/*===========================================================================*/
+/* Functions                                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief Initialize the service
+ *
+ * Clears registrations and dirty flags and restores the default window.
+ *
+ * @return SMART_QSO_OK
+ */
+SmartQsoResult_t persist_init(void);
+
+/**
+ * @brief Register a module's save function
+ *
+ * @param module Module
+ * @param save   Function writing the module's state to storage
+ * @return SMART_QSO_OK, SMART_QSO_ERROR_NULL_PTR or SMART_QSO_ERROR_PARAM
+ */
+SmartQsoResult_t persist_register(PersistModule_t module, PersistSaveFunc_t save);
+
+/**
+ * @brief Note that a module's persisted state changed
+ *
+ * The first mark after a save starts the module's coalescing window.
+ *
+ * @param module Module
+ */
+void persist_mark_dirty(PersistModule_t module);
+
+/**
+ * @brief Check whether a module has unsaved changes
+ *
+ * @param module Module
+ * @return true if dirty
+ */
+bool persist_is_dirty(PersistModule_t module);
+
+/**
+ * @brief Set the coalescing window
+ *
+ * @param window_ms Window (0 saves on the next service call)
+ * @return SMART_QSO_OK or SMART_QSO_ERROR_PARAM above PERSIST_MAX_WINDOW_MS
+ */
+SmartQsoResult_t persist_set_window_ms(uint32_t window_ms);
+
+/**
+ * @brief Get the coalescing window
+ *
+ * @return Window (ms)
+ */
+uint32_t persist_get_window_ms(void);
+
+/**
+ * @brief Save the modules whose window has elapsed
+ *
+ * Call from a low-priority slot. A failed save keeps the module dirty and
+ * is retried one window later.
+ *
+ * @param now_ms Current time (ms)
+ * @return Number of modules saved
+ */
+size_t persist_service(uint64_t now_ms);
+
+/**
+ * @brief Low-priority task entry (persist_service at the current time)
+ *
+ * Signature matches task_func_t for scheduler_register_task().
+ */
+void persist_task(void);
+
+/**
+ * @brief Save every dirty module now
+ *
+ * For the watchdog pre-reset callback and the ground flush command only.
+ *
+ * @return SMART_QSO_OK or SMART_QSO_ERROR_IO if any save failed
+ */
+SmartQsoResult_t persist_flush_all(void);
+
+/**
+ * @brief Watchdog pre-reset callback (WdtPreResetCallback_t)
+ */
+void persist_prereset_handler(void);
+
+/**
+ * @brief Get service statistics
+ *
+ * @param stats Receives the statistics
+ * @return SMART_QSO_OK or SMART_QSO_ERROR_NULL_PTR
+ */
+SmartQsoResult_t persist_get_stats(PersistStats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SMART_QSO_PERSISTENCE_H */
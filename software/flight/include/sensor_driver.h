@@ -0,0 +1,82 @@
+/**
+ * @file sensor_driver.h
+ * @brief Sensor driver descriptors
+ *
+ * A driver implements one sensor type: the `type` name used in sensors.yaml,
+ * its value type, an optional init hook and a batch read. The sensor module
+ * binds configured sensors to drivers through its driver table (indexed by
+ * the image type IDs in sensor_image.h) and a hashed name index, and polls
+ * all due sensors of one driver with a single read call.
+ *
+ * A driver outside the sensor module defines its descriptor in its own
+ * translation unit, declares it here and adds it to the driver table in
+ * sensors.c with a new image type ID.
+ *
+ * @requirement SRS-SENS-001 System shall support configurable sensor framework
+ */
+
+#ifndef SMART_QSO_SENSOR_DRIVER_H
+#define SMART_QSO_SENSOR_DRIVER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "smart_qso.h"
+
+/*===========================================================================*/
+/* Types                                                                      */
+/*===========================================================================*/
+
+/**
+ * @brief One reading returned by a driver
+ */
+typedef struct {
+    double value;       /**< Numeric reading */
+    char text[8];       /**< Text reading (SENSOR_VALUE_HEX2) */
+    bool valid;         /**< Set if the read succeeded */
+} SensorReading_t;
+
+/**
+ * @brief Driver init hook
+ *
+ * Called once by sensors_init(). A driver that fails to initialize keeps
+ * its sensors configured, but they are not read until the next init.
+ */
+typedef SmartQsoResult_t (*SensorDriverInitFn_t)(void);
+
+/**
+ * @brief Driver batch read
+ *
+ * @param channels Channel of each sensor (SensorImageChannel_t)
+ * @param[out] readings One reading per channel; `valid` is set per reading
+ * @param count    Number of sensors
+ */
+typedef void (*SensorDriverReadFn_t)(const uint8_t *channels, SensorReading_t *readings,
+                                     size_t count);
+
+/**
+ * @brief Sensor driver descriptor
+ */
+typedef struct {
+    const char *name;               /**< Type name in sensors.yaml */
+    SensorValueType_t value_type;   /**< Value type of its sensors */
+    SensorDriverInitFn_t init;      /**< Init hook, NULL if none */
+    SensorDriverReadFn_t read;      /**< Batch read */
+} SensorDriver_t;
+
+/*===========================================================================*/
+/* Drivers                                                                    */
+/*===========================================================================*/
+
+/** ADCS magnetometer field, channels x/y/z (uT) */
+extern const SensorDriver_t sensor_driver_magnetometer;
+
+/** ADCS sun vector, channels x/y/z (unit vector) */
+extern const SensorDriver_t sensor_driver_sun_sensor;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SMART_QSO_SENSOR_DRIVER_H */
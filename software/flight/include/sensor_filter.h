@@ -0,0 +1,144 @@
+/**
+ * @file sensor_filter.h
+ * @brief Per-sensor filtering and decimation pipeline
+ *
+ * Each numeric sensor sample passes through a configurable filter (moving
+ * average, IIR low-pass or median of the last N samples), then through a
+ * decimation window: every `decimation` filtered samples the last filtered
+ * value is published and the window's min/max/mean is kept as a summary.
+ * With no filter and a decimation of 1 every sample is published as read.
+ *
+ * State is fixed-size and stored per field across sensor slots. Samples
+ * taken in the same poll are updated as one batch, with the IIR and window
+ * statistics stages as straight loops over the batch.
+ *
+ * @requirement SRS-SENS-003 System shall validate sensor readings
+ * @requirement SRS-F071 Sample sensors at configurable rates
+ */
+
+#ifndef SMART_QSO_SENSOR_FILTER_H
+#define SMART_QSO_SENSOR_FILTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "smart_qso.h"
+
+/*===========================================================================*/
+/* Constants                                                                  */
+/*===========================================================================*/
+
+/** Longest moving-average / median window (samples) */
+#define SENSOR_FILTER_MAX_LENGTH    16U
+
+/** Longest decimation window (samples) */
+#define SENSOR_FILTER_MAX_DECIMATION 3600U
+
+/*===========================================================================*/
+/* Types                                                                      */
+/*===========================================================================*/
+
+/**
+ * @brief Filter applied to each sample
+ */
+typedef enum {
+    SENSOR_FILTER_NONE           = 0,   /**< Samples pass through */
+    SENSOR_FILTER_MOVING_AVERAGE = 1,   /**< Mean of the last `length` samples */
+    SENSOR_FILTER_IIR            = 2,   /**< y += alpha * (x - y) */
+    SENSOR_FILTER_MEDIAN         = 3    /**< Median of the last `length` samples */
+} SensorFilterKind_t;
+
+/**
+ * @brief Per-sensor pipeline configuration
+ *
+ * A zeroed configuration is valid: no filter, every sample published.
+ */
+typedef struct {
+    SensorFilterKind_t kind;    /**< Filter */
+    uint8_t length;             /**< Moving-average / median window, 0 = 1 */
+    uint16_t decimation;        /**< Filtered samples per published value, 0 = 1 */
+    double alpha;               /**< IIR coefficient in (0, 1] */
+} SensorFilterConfig_t;
+
+/**
+ * @brief Summary of the last completed decimation window
+ */
+typedef struct {
+    double min;                 /**< Smallest filtered sample */
+    double max;                 /**< Largest filtered sample */
+    double mean;                /**< Mean of the filtered samples */
+    uint16_t samples;           /**< Samples in the window, 0 before the first */
+} SensorSummary_t;
+
+/*===========================================================================*/
+/* Functions                                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief Look up a filter by its configuration name
+ *
+ * @param name "none", "moving_average", "iir" or "median"
+ * @param[out] kind Filter
+ * @return SMART_QSO_OK, SMART_QSO_ERROR_PARAM if the name is unknown
+ */
+SmartQsoResult_t sensor_filter_parse_kind(const char *name, SensorFilterKind_t *kind);
+
+/**
+ * @brief Clear the configuration and state of every slot
+ */
+void sensor_filter_reset(void);
+
+/**
+ * @brief Check a configuration without applying it
+ *
+ * @param config Configuration
+ * @return SMART_QSO_OK, SMART_QSO_ERROR_PARAM if it is out of range
+ */
+SmartQsoResult_t sensor_filter_validate(const SensorFilterConfig_t *config);
+
+/**
+ * @brief Configure a sensor slot and clear its state
+ *
+ * @param slot   Sensor slot
+ * @param config Configuration
+ * @return SMART_QSO_OK, SMART_QSO_ERROR_PARAM if the configuration is out
+ *         of range
+ */
+SmartQsoResult_t sensor_filter_configure(size_t slot, const SensorFilterConfig_t *config);
+
+/**
+ * @brief Get a slot's configuration (defaults filled in)
+ *
+ * @param slot   Sensor slot
+ * @param[out] config Configuration
+ * @return SMART_QSO_OK on success
+ */
+SmartQsoResult_t sensor_filter_get_config(size_t slot, SensorFilterConfig_t *config);
+
+/**
+ * @brief Run one sample per slot through the pipeline
+ *
+ * @param slots     Sensor slots, each at most once
+ * @param raw       Raw sample per slot
+ * @param count     Number of samples
+ * @param[out] value     Filtered value per slot
+ * @param[out] published true where the sample completed a decimation window
+ */
+void sensor_filter_update(const uint16_t *slots, const double *raw, size_t count,
+                          double *value, bool *published);
+
+/**
+ * @brief Get the summary of a slot's last completed decimation window
+ *
+ * @param slot   Sensor slot
+ * @param[out] summary Summary
+ * @return SMART_QSO_OK on success
+ */
+SmartQsoResult_t sensor_filter_get_summary(size_t slot, SensorSummary_t *summary);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SMART_QSO_SENSOR_FILTER_H */
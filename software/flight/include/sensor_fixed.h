@@ -0,0 +1,87 @@
+/**
+ * @file sensor_fixed.h
+ * @brief Fixed-point sensor values
+ *
+ * A fixed-point value is an int32_t count of 10^-decimals units: 12.345 V
+ * with 3 decimals is 12345. Each sensor publishes its value in this form
+ * with its configured decimals, so telemetry formatting and packing need
+ * only integer arithmetic. Double-precision math is emulated in software on
+ * the flight MCU; the one conversion from the filter's double output is done
+ * when a value is published.
+ *
+ * @requirement SRS-SENS-001 System shall support configurable sensor framework
+ */
+
+#ifndef SMART_QSO_SENSOR_FIXED_H
+#define SMART_QSO_SENSOR_FIXED_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "smart_qso.h"
+
+/*===========================================================================*/
+/* Constants                                                                  */
+/*===========================================================================*/
+
+/** Most decimal places of a fixed-point value */
+#define SENSOR_FIXED_MAX_DECIMALS       6U
+
+/** Decimal places of a sensor that does not configure them */
+#define SENSOR_FIXED_DEFAULT_DECIMALS   3U
+
+/** Longest formatted value including the terminator ("-2147483.648") */
+#define SENSOR_FIXED_TEXT_MAX           13U
+
+/*===========================================================================*/
+/* Functions                                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief Convert a value to fixed point
+ *
+ * Rounds half away from zero and saturates to the int32_t range; NaN
+ * converts to 0.
+ *
+ * @param value    Value
+ * @param decimals Decimal places, at most SENSOR_FIXED_MAX_DECIMALS
+ * @return value * 10^decimals
+ */
+int32_t sensor_fixed_from_double(double value, uint8_t decimals);
+
+/**
+ * @brief Change the decimal places of a fixed-point value
+ *
+ * Dropping places rounds half away from zero; adding places saturates.
+ *
+ * @param value Fixed-point value
+ * @param from  Decimal places of value
+ * @param to    Decimal places wanted
+ * @return The value with `to` decimal places
+ */
+int32_t sensor_fixed_rescale(int32_t value, uint8_t from, uint8_t to);
+
+/**
+ * @brief Saturate a fixed-point value to a 16-bit telemetry field
+ */
+int16_t sensor_fixed_to_i16(int32_t value);
+
+/**
+ * @brief Format a fixed-point value as decimal text
+ *
+ * Prints every decimal place, as "%.<decimals>f" would print the value:
+ * 12345 with 3 decimals is "12.345", -5 is "-0.005".
+ *
+ * @param value    Fixed-point value
+ * @param decimals Decimal places, at most SENSOR_FIXED_MAX_DECIMALS
+ * @param[out] text At least SENSOR_FIXED_TEXT_MAX bytes; NUL-terminated
+ * @return Characters written, excluding the terminator
+ */
+size_t sensor_fixed_format(int32_t value, uint8_t decimals, char *text);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SMART_QSO_SENSOR_FIXED_H */
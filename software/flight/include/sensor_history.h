@@ -0,0 +1,118 @@
+/**
+ * @file sensor_history.h
+ * @brief Per-sensor time series of published samples
+ *
+ * Each numeric sensor can keep a ring of its last `depth` published values
+ * with their timestamps, so consumers can look at trends or compute rates
+ * without polling the sensor again. Depth is configured per sensor; the
+ * rings are carved in slot order out of one fixed pool of
+ * SENSOR_HISTORY_POOL_SIZE samples, so the memory cost is fixed at build
+ * time whatever the configuration.
+ *
+ * @requirement SRS-F071 Sample sensors at configurable rates
+ */
+
+#ifndef SMART_QSO_SENSOR_HISTORY_H
+#define SMART_QSO_SENSOR_HISTORY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "smart_qso.h"
+
+/*===========================================================================*/
+/* Constants                                                                  */
+/*===========================================================================*/
+
+/** Deepest ring of one sensor (samples) */
+#define SENSOR_HISTORY_MAX_DEPTH    64U
+
+/** Samples shared by all rings */
+#ifndef SENSOR_HISTORY_POOL_SIZE
+#define SENSOR_HISTORY_POOL_SIZE    512U
+#endif
+
+/*===========================================================================*/
+/* Types                                                                      */
+/*===========================================================================*/
+
+/**
+ * @brief One published sample
+ */
+typedef struct {
+    uint64_t timestamp_ms;      /**< Poll time of the sample */
+    double value;               /**< Published value */
+} SensorSample_t;
+
+/*===========================================================================*/
+/* Functions                                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief Release every ring and return the pool
+ */
+void sensor_history_reset(void);
+
+/**
+ * @brief Give a slot a ring of `depth` samples from the pool
+ *
+ * Each slot is configured at most once between resets.
+ *
+ * @param slot  Sensor slot
+ * @param depth Samples kept, 0 for none
+ * @return SMART_QSO_OK, SMART_QSO_ERROR_PARAM if the depth is above
+ *         SENSOR_HISTORY_MAX_DEPTH, SMART_QSO_ERROR_NO_MEM if the pool is
+ *         exhausted, SMART_QSO_ERROR_INVALID if the slot already has a ring
+ */
+SmartQsoResult_t sensor_history_configure(size_t slot, uint16_t depth);
+
+/**
+ * @brief Get a slot's ring depth
+ */
+uint16_t sensor_history_depth(size_t slot);
+
+/**
+ * @brief Get the pool samples not yet given to a ring
+ */
+size_t sensor_history_free(void);
+
+/**
+ * @brief Append a sample to a slot's ring, dropping the oldest when full
+ *
+ * Timestamps are expected not to decrease. A slot without a ring ignores
+ * the sample.
+ */
+void sensor_history_push(size_t slot, uint64_t timestamp_ms, double value);
+
+/**
+ * @brief Get a slot's last samples
+ *
+ * @param slot Sensor slot
+ * @param max  Samples wanted
+ * @param[out] samples Up to `max` newest samples, oldest first
+ * @return Samples written
+ */
+size_t sensor_history_last(size_t slot, size_t max, SensorSample_t *samples);
+
+/**
+ * @brief Get a slot's samples taken after a time
+ *
+ * Passing the timestamp of the newest sample already seen returns only new
+ * samples. If more than `max` match, the oldest `max` are returned, so a
+ * caller can page through them.
+ *
+ * @param slot     Sensor slot
+ * @param since_ms Samples with timestamps after this are returned
+ * @param max      Samples wanted
+ * @param[out] samples Matching samples, oldest first
+ * @return Samples written
+ */
+size_t sensor_history_since(size_t slot, uint64_t since_ms, size_t max,
+                            SensorSample_t *samples);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SMART_QSO_SENSOR_HISTORY_H */
@@ -0,0 +1,130 @@
+/**
+ * @file sensor_image.h
+ * @brief Compiled sensor configuration image format
+ *
+ * The host tool software/ground/tools/sensor_image_compiler.py compiles
+ * sensors.yaml into this image. Type names and channel names are already
+ * resolved to the IDs below, so loading it needs no text parsing. The image
+ * can be loaded from memory or stored in FLASH_REGION_SENSOR_CONFIG and
+ * uploaded as one blob.
+ *
+ * Layout (all fields little-endian):
+ *
+ *   Header (16 bytes)
+ *     0  u32 magic        SENSOR_IMAGE_MAGIC
+ *     4  u16 version      SENSOR_IMAGE_VERSION
+ *     6  u16 count        sensor records
+ *     8  u16 pool_size    string pool bytes
+ *    10  u16 reserved     0
+ *    12  u32 crc32        over header bytes 0-11 and everything after the header
+ *   Records (count x 24 bytes)
+ *     0  u8  type         SensorImageType_t
+ *     1  u8  channel      SensorImageChannel_t
+ *     2  u8  filter       SensorFilterKind_t
+ *     3  u8  filter_length
+ *     4  u16 decimation
+ *     6  u16 id           string pool offset
+ *     8  u16 name         string pool offset
+ *    10  u16 units        string pool offset
+ *    12  u32 period_ms
+ *    16  u32 alpha_ppm    IIR alpha in millionths
+ *    20  u16 history      samples kept (numeric sensors)
+ *    22  u8  decimals     fixed-point decimal places (numeric sensors)
+ *    23  u8  reserved     0
+ *   String pool (pool_size bytes of NUL-terminated strings)
+ *
+ * The Python compiler mirrors these constants; keep them in step.
+ *
+ * @requirement SRS-SENS-001 System shall support configurable sensor framework
+ * @requirement SRS-DATA-002 System shall protect data integrity with CRC
+ */
+
+#ifndef SMART_QSO_SENSOR_IMAGE_H
+#define SMART_QSO_SENSOR_IMAGE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*===========================================================================*/
+/* Constants                                                                  */
+/*===========================================================================*/
+
+/** Image magic ("SQSC") */
+#define SENSOR_IMAGE_MAGIC          0x53515343U
+
+/** Image format version */
+#define SENSOR_IMAGE_VERSION        2U
+
+/** Header size (bytes) */
+#define SENSOR_IMAGE_HEADER_SIZE    16U
+
+/** Record size (bytes) */
+#define SENSOR_IMAGE_RECORD_SIZE    24U
+
+/** Header field offsets */
+#define SENSOR_IMAGE_OFF_MAGIC      0U
+#define SENSOR_IMAGE_OFF_VERSION    4U
+#define SENSOR_IMAGE_OFF_COUNT      6U
+#define SENSOR_IMAGE_OFF_POOL_SIZE  8U
+#define SENSOR_IMAGE_OFF_CRC        12U
+
+/** Record field offsets */
+#define SENSOR_IMAGE_REC_TYPE       0U
+#define SENSOR_IMAGE_REC_CHANNEL    1U
+#define SENSOR_IMAGE_REC_FILTER     2U
+#define SENSOR_IMAGE_REC_LENGTH     3U
+#define SENSOR_IMAGE_REC_DECIMATION 4U
+#define SENSOR_IMAGE_REC_ID         6U
+#define SENSOR_IMAGE_REC_NAME       8U
+#define SENSOR_IMAGE_REC_UNITS      10U
+#define SENSOR_IMAGE_REC_PERIOD     12U
+#define SENSOR_IMAGE_REC_ALPHA      16U
+#define SENSOR_IMAGE_REC_HISTORY    20U
+#define SENSOR_IMAGE_REC_DECIMALS   22U
+
+/** Largest image (the size of FLASH_REGION_SENSOR_CONFIG) */
+#define SENSOR_IMAGE_MAX_SIZE       2048U
+
+/** IIR alpha scale: alpha = alpha_ppm / SENSOR_IMAGE_ALPHA_SCALE */
+#define SENSOR_IMAGE_ALPHA_SCALE    1000000U
+
+/*===========================================================================*/
+/* Types                                                                      */
+/*===========================================================================*/
+
+/**
+ * @brief Sensor type IDs (values are part of the image format)
+ */
+typedef enum {
+    SENSOR_IMAGE_TYPE_SOFTWARE_TIMER    = 1,    /**< software_timer */
+    SENSOR_IMAGE_TYPE_EPS_VOLTAGE       = 2,    /**< eps_voltage */
+    SENSOR_IMAGE_TYPE_EPS_CURRENT       = 3,    /**< eps_current */
+    SENSOR_IMAGE_TYPE_EPS_TEMPERATURE   = 4,    /**< eps_temperature */
+    SENSOR_IMAGE_TYPE_STATUS_HEX2       = 5,    /**< status_hex2 */
+    SENSOR_IMAGE_TYPE_MAGNETOMETER      = 6,    /**< magnetometer */
+    SENSOR_IMAGE_TYPE_SUN_SENSOR        = 7,    /**< sun_sensor */
+    SENSOR_IMAGE_TYPE_COUNT             = 8
+} SensorImageType_t;
+
+/**
+ * @brief Channel IDs (values are part of the image format)
+ */
+typedef enum {
+    SENSOR_IMAGE_CHANNEL_NONE               = 0,    /**< No channel ("") */
+    SENSOR_IMAGE_CHANNEL_BATTERY            = 1,    /**< battery */
+    SENSOR_IMAGE_CHANNEL_BUS                = 2,    /**< bus */
+    SENSOR_IMAGE_CHANNEL_SOLAR              = 3,    /**< solar */
+    SENSOR_IMAGE_CHANNEL_BATTERY_DISCHARGE  = 4,    /**< battery_discharge */
+    SENSOR_IMAGE_CHANNEL_JETSON             = 5,    /**< jetson */
+    SENSOR_IMAGE_CHANNEL_X                  = 6,    /**< x */
+    SENSOR_IMAGE_CHANNEL_Y                  = 7,    /**< y */
+    SENSOR_IMAGE_CHANNEL_Z                  = 8,    /**< z */
+    SENSOR_IMAGE_CHANNEL_COUNT              = 9
+} SensorImageChannel_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SMART_QSO_SENSOR_IMAGE_H */
@@ -20,6 +20,9 @@ extern "C" {
 #endif
 
 #include "smart_qso.h"
+#include "sensor_filter.h"
+#include "sensor_history.h"
+#include "sensor_fixed.h"
 
 /*===========================================================================*/
 /* Forward Declarations                                                       */
@@ -48,7 +51,9 @@ typedef bool (*SensorReadFn_t)(struct Sensor *self, double *out_value, char *out
 /**
  * @brief Sensor Definition
  *
- * Holds complete definition and state for a single sensor.
+ * Complete definition and state for a single sensor. The module stores
+ * sensors split by access pattern (hot poll state, telemetry labels, cold
+ * metadata); sensors_get() and sensors_get_by_id() assemble this view.
  */
 typedef struct Sensor {
     char id[SMART_QSO_SENSOR_ID_LEN];         /**< Short identifier (e.g., "BV") */
@@ -61,9 +66,24 @@ typedef struct Sensor {
     SensorValueType_t value_type;              /**< Type of value */
     SensorReadFn_t read;                       /**< Read function pointer */
     double last_value;                         /**< Last numeric reading */
+    uint64_t last_update_ms;                   /**< Poll time of the last reading, 0 if none */
     char last_text[8];                         /**< Last text reading */
+    SensorFilterConfig_t filter;               /**< Filter and decimation */
+    uint16_t history;                          /**< Published samples kept (numeric) */
+    uint8_t decimals;                          /**< Fixed-point decimal places (numeric) */
 } Sensor_t;
 
+/**
+ * @brief Handle to a configured sensor (table generation and slot)
+ *
+ * Obtained from sensors_find(); invalidated when sensors_init() clears the
+ * table. 0 is never a valid handle.
+ */
+typedef uint32_t SensorHandle_t;
+
+/** Handle value that never refers to a sensor */
+#define SENSOR_HANDLE_INVALID   0U
+
 /*===========================================================================*/
 /* Sensor Management API                                                      */
 /*===========================================================================*/
@@ -89,6 +109,47 @@ SmartQsoResult_t sensors_init(void);
  */
 SmartQsoResult_t sensors_load_yaml(const char *path);
 
+/**
+ * @brief Load sensors from a compiled configuration image
+ *
+ * The image is produced by software/ground/tools/sensor_image_compiler.py
+ * (format in sensor_image.h). Types and channels are already resolved, so
+ * no text is parsed. The header, CRC and every record are checked before
+ * any sensor is added; a bad image leaves the table unchanged.
+ *
+ * @param image Image bytes
+ * @param len   Bytes available at image
+ * @return SMART_QSO_OK on success, SMART_QSO_ERROR_INVALID if the image is
+ *         corrupt, SMART_QSO_ERROR_TRUNCATED if it is incomplete,
+ *         SMART_QSO_ERROR_NO_MEM if the sensors or their histories do not
+ *         fit
+ */
+SmartQsoResult_t sensors_load_image(const uint8_t *image, size_t len);
+
+/**
+ * @brief Load sensors from the image stored in FLASH_REGION_SENSOR_CONFIG
+ *
+ * @return SMART_QSO_OK on success, SMART_QSO_ERROR if no image is stored,
+ *         otherwise as sensors_load_image() or the flash read
+ *
+ * @pre hal_flash_init() has succeeded
+ */
+SmartQsoResult_t sensors_load_flash(void);
+
+/**
+ * @brief Check a configuration image and store it in flash
+ *
+ * Replaces the stored image (e.g. one uploaded as a single blob); it takes
+ * effect at the next sensors_load_flash().
+ *
+ * @param image Image bytes
+ * @param len   Bytes available at image
+ * @return SMART_QSO_OK on success, error code otherwise
+ *
+ * @pre hal_flash_init() has succeeded
+ */
+SmartQsoResult_t sensors_store_image(const uint8_t *image, size_t len);
+
 /**
  * @brief Load default sensor configuration
  *
@@ -117,9 +178,22 @@ size_t sensors_get_count(void);
  */
 SmartQsoResult_t sensors_get(size_t index, Sensor_t *sensor);
 
+/**
+ * @brief Get the summary of a sensor's last decimation window
+ *
+ * @param index Sensor index
+ * @param[out] summary Min/max/mean of the window; samples is 0 before the
+ *             first window completes
+ * @return SMART_QSO_OK on success, error code otherwise
+ */
+SmartQsoResult_t sensors_get_summary(size_t index, SensorSummary_t *summary);
+
 /**
  * @brief Get sensor by ID
  *
+ * IDs are looked up in a hash index built as sensors are registered. If two
+ * sensors share an ID, the first registered is returned.
+ *
  * @param id Sensor ID string
  * @param[out] sensor Pointer to sensor structure to fill
  * @return SMART_QSO_OK on success, SMART_QSO_ERROR if not found
@@ -129,14 +203,140 @@ SmartQsoResult_t sensors_get(size_t index, Sensor_t *sensor);
  */
 SmartQsoResult_t sensors_get_by_id(const char *id, Sensor_t *sensor);
 
+/**
+ * @brief Get a handle to a sensor by ID
+ *
+ * Look an ID up once and keep the handle: handle access needs no string
+ * compare. Handles stay valid until sensors_init() clears the table.
+ *
+ * @param id Sensor ID string
+ * @param[out] handle Handle
+ * @return SMART_QSO_OK on success, SMART_QSO_ERROR if not found
+ *
+ * @pre id != NULL
+ * @pre handle != NULL
+ */
+SmartQsoResult_t sensors_find(const char *id, SensorHandle_t *handle);
+
+/**
+ * @brief Get sensor by handle
+ *
+ * @param handle Handle from sensors_find()
+ * @param[out] sensor Pointer to sensor structure to fill
+ * @return SMART_QSO_OK on success, SMART_QSO_ERROR_INVALID if the handle
+ *         is stale
+ *
+ * @pre sensor != NULL
+ */
+SmartQsoResult_t sensors_get_by_handle(SensorHandle_t handle, Sensor_t *sensor);
+
+/**
+ * @brief Get a sensor's last published numeric value by handle
+ *
+ * @param handle Handle from sensors_find()
+ * @param[out] value Last value
+ * @return SMART_QSO_OK on success, SMART_QSO_ERROR_INVALID if the handle
+ *         is stale
+ *
+ * @pre value != NULL
+ */
+SmartQsoResult_t sensors_get_value(SensorHandle_t handle, double *value);
+
+/**
+ * @brief Get a sensor's last published value in fixed point by handle
+ *
+ * @param handle Handle from sensors_find()
+ * @param[out] value    Last value scaled by 10^decimals
+ * @param[out] decimals The sensor's decimal places
+ * @return SMART_QSO_OK on success, SMART_QSO_ERROR_INVALID if the handle
+ *         is stale
+ *
+ * @pre value != NULL
+ * @pre decimals != NULL
+ */
+SmartQsoResult_t sensors_get_fixed(SensorHandle_t handle, int32_t *value, uint8_t *decimals);
+
+/**
+ * @brief Pack sensors' last values into 16-bit telemetry fields
+ *
+ * Each value is taken in fixed point, rescaled to the field's decimal
+ * places and saturated to int16_t, with no floating-point math. Fields hold
+ * the two's complement bits, ready for tlm_builder_put_u16_array().
+ *
+ * @param handles  Handles from sensors_find(), one per field
+ * @param count    Fields to pack
+ * @param decimals Decimal places of the fields (e.g. 1 for 0.1 uT)
+ * @param[out] fields Packed values; 0 for a stale handle
+ * @return SMART_QSO_OK on success, SMART_QSO_ERROR_PARAM if decimals is
+ *         above SENSOR_FIXED_MAX_DECIMALS, SMART_QSO_ERROR_INVALID if any
+ *         handle is stale
+ *
+ * @pre handles != NULL
+ * @pre fields != NULL
+ */
+SmartQsoResult_t sensors_pack_i16(const SensorHandle_t *handles, size_t count, uint8_t decimals,
+                                  uint16_t *fields);
+
+/**
+ * @brief Get a sensor's last published samples by handle
+ *
+ * Reads the sensor's time series (its `history` setting) without polling.
+ *
+ * @param handle Handle from sensors_find()
+ * @param max    Samples wanted
+ * @param[out] samples Up to `max` newest samples, oldest first
+ * @param[out] count   Samples written
+ * @return SMART_QSO_OK on success, SMART_QSO_ERROR_INVALID if the handle
+ *         is stale
+ *
+ * @pre samples != NULL
+ * @pre count != NULL
+ */
+SmartQsoResult_t sensors_get_samples(SensorHandle_t handle, size_t max,
+                                     SensorSample_t *samples, size_t *count);
+
+/**
+ * @brief Get a sensor's samples published after a time by handle
+ *
+ * Passing the timestamp of the newest sample already received returns only
+ * new samples; if more than `max` match, the oldest `max` are returned.
+ *
+ * @param handle   Handle from sensors_find()
+ * @param since_ms Samples with later timestamps are returned
+ * @param max      Samples wanted
+ * @param[out] samples Matching samples, oldest first
+ * @param[out] count   Samples written
+ * @return SMART_QSO_OK on success, SMART_QSO_ERROR_INVALID if the handle
+ *         is stale
+ *
+ * @pre samples != NULL
+ * @pre count != NULL
+ */
+SmartQsoResult_t sensors_get_samples_since(SensorHandle_t handle, uint64_t since_ms, size_t max,
+                                           SensorSample_t *samples, size_t *count);
+
 /**
  * @brief Poll all sensors that are due for reading
  *
+ * Sensors are kept in a queue ordered by next poll time, so only the due
+ * sensors are visited. Each polled sensor is rescheduled one period after
+ * current_ms. Numeric samples pass through the sensor's filter; the last
+ * value is updated (and logged) once per decimation window.
+ *
  * @param current_ms Current time in milliseconds
  * @return Number of sensors polled
  */
 size_t sensors_poll(uint64_t current_ms);
 
+/**
+ * @brief Get the time the next sensor falls due
+ *
+ * Lets the caller sleep until the next poll is needed.
+ *
+ * @return Earliest next poll time in milliseconds, UINT64_MAX if no sensors
+ */
+uint64_t sensors_next_poll_ms(void);
+
 /**
  * @brief Poll a specific sensor
  *
@@ -156,6 +356,11 @@ void sensors_set_environment(bool sunlit, double soc);
 /**
  * @brief Format all sensor values as telemetry string
  *
+ * Numeric values are printed from their fixed-point form with the sensor's
+ * decimal places, using integer arithmetic only. Decimated sensors are
+ * followed by the min/max/mean of their last window as ID_MIN, ID_MAX and
+ * ID_AVG fields.
+ *
  * @param[out] buffer     Output buffer
  * @param      buffer_len Size of output buffer
  * @return Number of bytes written (excluding null terminator)
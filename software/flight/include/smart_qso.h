@@ -55,7 +55,9 @@ extern "C" {
 /*===========================================================================*/
 
 /** Maximum number of sensors supported */
+#ifndef SMART_QSO_MAX_SENSORS
 #define SMART_QSO_MAX_SENSORS           32
+#endif
 
 /** Maximum fault log entries */
 #define SMART_QSO_MAX_FAULT_ENTRIES     100
@@ -250,6 +252,23 @@ uint64_t smart_qso_now_ms(void);
 /* CRC Functions                                                              */
 /*===========================================================================*/
 
+/** Initial CRC32 register value for incremental calculation */
+#define SMART_QSO_CRC32_INIT            0xFFFFFFFFU
+
+/**
+ * @brief Update a running CRC32 register
+ *
+ * Start from SMART_QSO_CRC32_INIT, feed data in any number of chunks and
+ * XOR the final register with 0xFFFFFFFF to obtain the checksum. The result
+ * is identical to smart_qso_crc32() over the concatenated data.
+ *
+ * @param crc  Running CRC register
+ * @param data Pointer to data buffer
+ * @param len  Length of data in bytes
+ * @return Updated CRC register (not finalized)
+ */
+uint32_t smart_qso_crc32_update(uint32_t crc, const void *data, size_t len);
+
 /**
  * @brief Calculate CRC32 checksum
  *
@@ -122,6 +122,22 @@ typedef struct {
     bool safe_mode_entry;           /**< Safe mode was entered */
 } MissionState_t;
 
+/**
+ * @brief Independently persisted sections of SystemState_t
+ *
+ * Each section is saved under its own key in the KV store, so a save
+ * only appends records for the sections that changed.
+ */
+typedef enum {
+    SYS_SECTION_POWER   = 0,        /**< PowerState_t */
+    SYS_SECTION_THERMAL = 1,        /**< ThermalState_t */
+    SYS_SECTION_ADCS    = 2,        /**< AdcsState_t */
+    SYS_SECTION_COMM    = 3,        /**< CommState_t */
+    SYS_SECTION_MISSION = 4,        /**< MissionState_t */
+    SYS_SECTION_CONTROL = 5,        /**< State machine context */
+    SYS_SECTION_COUNT
+} SysStateSection_t;
+
 /**
  * @brief Complete system state structure
  *
@@ -166,6 +182,9 @@ SmartQsoResult_t sys_state_init(void);
 /**
  * @brief Load system state from persistent storage
  *
+ * Applies each section's stored value from the KV store. Sections
+ * without a stored value keep their defaults.
+ *
  * @return SMART_QSO_OK on success, error if load failed
  */
 SmartQsoResult_t sys_state_load(void);
@@ -173,10 +192,19 @@ SmartQsoResult_t sys_state_load(void);
 /**
  * @brief Save system state to persistent storage
  *
+ * Puts each dirty section whose contents differ from its stored value.
+ *
  * @return SMART_QSO_OK on success
  */
 SmartQsoResult_t sys_state_save(void);
 
+/**
+ * @brief Get the sections modified since the last save
+ *
+ * @return Bit mask of (1U << SysStateSection_t)
+ */
+uint32_t sys_state_dirty_sections(void);
+
 /**
  * @brief Check if state has been modified and needs saving
  *
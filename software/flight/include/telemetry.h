@@ -21,6 +21,7 @@ extern "C" {
 #endif
 
 #include "smart_qso.h"
+#include "fec.h"
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -31,9 +32,33 @@ extern "C" {
 /** Maximum telemetry frame size */
 #define TLM_MAX_FRAME_SIZE      256U
 
+/** Maximum RS-coded telemetry frame size (tlm_serialize_fec()) */
+#define TLM_FEC_MAX_FRAME_SIZE  FEC_TLM_CODED_LEN(TLM_MAX_FRAME_SIZE)
+
 /** Telemetry sync pattern */
 #define TLM_SYNC_WORD           0x1ACFFC1DU
 
+/** Encoded frame header length (bytes) */
+#define TLM_HEADER_LEN          14U
+
+/** Encoded frame CRC length (bytes) */
+#define TLM_CRC_LEN             4U
+
+/** Maximum encoded payload length (bytes) */
+#define TLM_MAX_PAYLOAD_LEN     (TLM_MAX_FRAME_SIZE - TLM_HEADER_LEN - TLM_CRC_LEN)
+
+/** Encoded housekeeping payload length (bytes) */
+#define TLM_HK_PAYLOAD_LEN      26U
+
+/** Encoded EPS payload length (bytes) */
+#define TLM_EPS_PAYLOAD_LEN     14U
+
+/** Encoded ADCS payload length (bytes) */
+#define TLM_ADCS_PAYLOAD_LEN    20U
+
+/** Encoded beacon payload length (bytes) */
+#define TLM_BEACON_PAYLOAD_LEN  4U
+
 /** Default telemetry rate (ms) */
 #define TLM_DEFAULT_RATE_MS     60000U
 
@@ -45,6 +70,11 @@ extern "C" {
 
 /*******************************************************************************
  * Telemetry Types
+ *
+ * The structures below are host-side views of the frame fields. On the wire
+ * every multi-byte field is big-endian and fields are packed back to back in
+ * declaration order with no padding; encoding is done field by field with
+ * the wire_codec.h primitives, never by casting a buffer to a struct.
  ******************************************************************************/
 
 /**
@@ -71,7 +101,7 @@ typedef struct {
     uint16_t sequence;              /**< Sequence counter */
     uint32_t timestamp_s;           /**< Mission time (seconds) */
     uint16_t data_len;              /**< Payload length */
-} __attribute__((packed)) TlmHeader_t;
+} TlmHeader_t;
 
 /**
  * @brief Housekeeping telemetry payload
@@ -103,7 +133,7 @@ typedef struct {
     /* ADCS */
     uint8_t adcs_mode;              /**< ADCS mode */
     uint8_t detumbled;              /**< Detumble achieved */
-} __attribute__((packed)) TlmHousekeeping_t;
+} TlmHousekeeping_t;
 
 /**
  * @brief EPS telemetry payload
@@ -119,7 +149,7 @@ typedef struct {
     uint8_t payload_enabled;        /**< Payload state */
     int8_t battery_temp_c;          /**< Battery temperature */
     int8_t pcb_temp_c;              /**< EPS PCB temperature */
-} __attribute__((packed)) TlmEps_t;
+} TlmEps_t;
 
 /**
  * @brief ADCS telemetry payload
@@ -136,16 +166,19 @@ typedef struct {
     int16_t sun_z_x100;             /**< Sun vector Z (0.01) */
     uint8_t mode;                   /**< ADCS mode */
     uint8_t status;                 /**< Status flags */
-} __attribute__((packed)) TlmAdcs_t;
+} TlmAdcs_t;
 
 /**
  * @brief Complete telemetry frame
+ *
+ * Header and CRC are held in host order; the payload holds the encoded
+ * (big-endian) payload bytes exactly as they are transmitted.
  */
 typedef struct {
     TlmHeader_t header;             /**< Frame header */
-    uint8_t payload[TLM_MAX_FRAME_SIZE - sizeof(TlmHeader_t) - 4];
+    uint8_t payload[TLM_MAX_PAYLOAD_LEN]; /**< Encoded payload */
     uint32_t crc32;                 /**< Frame CRC */
-} __attribute__((packed)) TlmFrame_t;
+} TlmFrame_t;
 
 /**
  * @brief Telemetry statistics
@@ -158,6 +191,22 @@ typedef struct {
     uint16_t sequence_number;       /**< Current sequence number */
 } TlmStats_t;
 
+/**
+ * @brief Streaming telemetry frame builder
+ *
+ * Emits header, payload and CRC directly into a caller-owned transmit
+ * buffer (for example a TX ring slot). The CRC is updated as bytes are
+ * written, so no intermediate TlmFrame_t or second copy is required.
+ */
+typedef struct {
+    uint8_t *buffer;                /**< Destination buffer */
+    size_t capacity;                /**< Destination buffer size */
+    size_t pos;                     /**< Current write offset */
+    size_t payload_end;             /**< Offset where payload must end */
+    uint32_t crc;                   /**< Running CRC32 register */
+    bool overflow;                  /**< A write exceeded the payload length */
+} TlmBuilder_t;
+
 /*******************************************************************************
  * Public Function Declarations
  ******************************************************************************/
@@ -259,6 +308,158 @@ SmartQsoResult_t tlm_serialize(const TlmFrame_t *frame,
                                 size_t buffer_size,
                                 size_t *bytes_written);
 
+/**
+ * @brief Serialize a telemetry frame with Reed-Solomon FEC
+ *
+ * tlm_serialize() followed by fec_tlm_encode(): the sync word is sent
+ * as-is and the rest of the frame in RS(255,223) codewords, so the ground
+ * can correct up to 16 byte errors per codeword before checking the CRC.
+ *
+ * @param[in] frame Frame to serialize
+ * @param[in] payload_len Payload length
+ * @param[out] buffer Output buffer (TLM_FEC_MAX_FRAME_SIZE always suffices)
+ * @param[in] buffer_size Buffer size
+ * @param[out] bytes_written Actual bytes written
+ * @return SMART_QSO_OK on success
+ */
+SmartQsoResult_t tlm_serialize_fec(const TlmFrame_t *frame,
+                                    size_t payload_len,
+                                    uint8_t *buffer,
+                                    size_t buffer_size,
+                                    size_t *bytes_written);
+
+/**
+ * @brief Decode an encoded frame header
+ *
+ * @param[in] buffer Encoded frame
+ * @param[in] buffer_len Encoded frame length
+ * @param[out] header Decoded header (host order)
+ * @return SMART_QSO_OK on success, SMART_QSO_ERROR_INVALID if the buffer is
+ *         too short or the sync word does not match
+ */
+SmartQsoResult_t tlm_decode_header(const uint8_t *buffer,
+                                    size_t buffer_len,
+                                    TlmHeader_t *header);
+
+/*******************************************************************************
+ * Zero-Copy Frame Builder
+ ******************************************************************************/
+
+/**
+ * @brief Start a telemetry frame in a transmit buffer
+ *
+ * Writes the frame header (consuming a sequence number) and folds it into
+ * the running CRC. The payload length must be known up front because it is
+ * part of the CRC-covered header.
+ *
+ * @param[out] builder Builder context
+ * @param[out] buffer Destination buffer (e.g. TX ring slot)
+ * @param[in] buffer_size Destination buffer size
+ * @param[in] type Frame type
+ * @param[in] payload_len Payload length in bytes
+ * @return SMART_QSO_OK on success, SMART_QSO_ERROR_NO_MEM if the frame
+ *         would not fit
+ */
+SmartQsoResult_t tlm_builder_begin(TlmBuilder_t *builder,
+                                    uint8_t *buffer,
+                                    size_t buffer_size,
+                                    TlmType_t type,
+                                    uint16_t payload_len);
+
+/**
+ * @brief Append raw bytes to the frame payload
+ *
+ * @param[in,out] builder Builder context
+ * @param[in] data Bytes to append
+ * @param[in] len Number of bytes
+ */
+void tlm_builder_put_bytes(TlmBuilder_t *builder, const void *data, size_t len);
+
+/**
+ * @brief Append an 8-bit field to the frame payload
+ */
+void tlm_builder_put_u8(TlmBuilder_t *builder, uint8_t value);
+
+/**
+ * @brief Append a 16-bit field to the frame payload (big-endian)
+ */
+void tlm_builder_put_u16(TlmBuilder_t *builder, uint16_t value);
+
+/**
+ * @brief Append a 32-bit field to the frame payload (big-endian)
+ */
+void tlm_builder_put_u32(TlmBuilder_t *builder, uint32_t value);
+
+/**
+ * @brief Append an array of 16-bit fields to the frame payload (big-endian)
+ *
+ * @param[in,out] builder Builder context
+ * @param[in] values Field values
+ * @param[in] count Number of values
+ */
+void tlm_builder_put_u16_array(TlmBuilder_t *builder, const uint16_t *values, size_t count);
+
+/**
+ * @brief Finish a frame by appending the CRC
+ *
+ * @param[in,out] builder Builder context
+ * @param[out] bytes_written Total frame length
+ * @return SMART_QSO_OK on success, SMART_QSO_ERROR_INVALID if the payload
+ *         written does not match the length given to tlm_builder_begin()
+ */
+SmartQsoResult_t tlm_builder_finish(TlmBuilder_t *builder, size_t *bytes_written);
+
+/**
+ * @brief Build housekeeping telemetry directly into a transmit buffer
+ *
+ * Produces the same bytes as tlm_generate_housekeeping() followed by
+ * tlm_serialize(), without the intermediate frame.
+ *
+ * @param[out] buffer Destination buffer
+ * @param[in] buffer_size Destination buffer size
+ * @param[out] bytes_written Frame length
+ * @return SMART_QSO_OK on success
+ */
+SmartQsoResult_t tlm_build_housekeeping(uint8_t *buffer,
+                                         size_t buffer_size,
+                                         size_t *bytes_written);
+
+/**
+ * @brief Build EPS telemetry directly into a transmit buffer
+ *
+ * @param[out] buffer Destination buffer
+ * @param[in] buffer_size Destination buffer size
+ * @param[out] bytes_written Frame length
+ * @return SMART_QSO_OK on success
+ */
+SmartQsoResult_t tlm_build_eps(uint8_t *buffer,
+                                size_t buffer_size,
+                                size_t *bytes_written);
+
+/**
+ * @brief Build ADCS telemetry directly into a transmit buffer
+ *
+ * @param[out] buffer Destination buffer
+ * @param[in] buffer_size Destination buffer size
+ * @param[out] bytes_written Frame length
+ * @return SMART_QSO_OK on success
+ */
+SmartQsoResult_t tlm_build_adcs(uint8_t *buffer,
+                                 size_t buffer_size,
+                                 size_t *bytes_written);
+
+/**
+ * @brief Build beacon telemetry directly into a transmit buffer
+ *
+ * @param[out] buffer Destination buffer
+ * @param[in] buffer_size Destination buffer size
+ * @param[out] bytes_written Frame length
+ * @return SMART_QSO_OK on success
+ */
+SmartQsoResult_t tlm_build_beacon(uint8_t *buffer,
+                                   size_t buffer_size,
+                                   size_t *bytes_written);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,188 @@
+/**
+ * @file wire_codec.h
+ * @brief Endian-safe wire encoding primitives for SMART-QSO flight software
+ *
+ * @copyright Copyright (c) 2026 SMART-QSO Team
+ * @license MIT
+ *
+ * Inline put/get helpers that encode integers at explicit byte order into
+ * byte buffers of any alignment. All downlink formats use these instead of
+ * casting buffers to packed structs, so the wire format is identical on the
+ * x86 simulation host and on flight hardware and no unaligned multi-byte
+ * access is ever generated.
+ *
+ * The codec is selected at compile time. On GCC/Clang with a known host
+ * byte order a memcpy + byte-swap form is used, which compiles to a single
+ * load/store (plus REV/BSWAP) where the target permits unaligned access.
+ * Define WIRE_CODEC_PORTABLE to force the shift-based reference codec.
+ */
+
+#ifndef SMART_QSO_WIRE_CODEC_H
+#define SMART_QSO_WIRE_CODEC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+/*******************************************************************************
+ * Codec Selection
+ ******************************************************************************/
+
+#if !defined(WIRE_CODEC_PORTABLE) && defined(__GNUC__) && \
+    defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) && \
+    defined(__ORDER_BIG_ENDIAN__)
+#  if (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#    define WIRE_CODEC_NATIVE_LE    1
+#  elif (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#    define WIRE_CODEC_NATIVE_BE    1
+#  endif
+#endif
+
+#if defined(WIRE_CODEC_NATIVE_LE)
+#  define WIRE_TO_BE16(v)   __builtin_bswap16(v)
+#  define WIRE_TO_BE32(v)   __builtin_bswap32(v)
+#  define WIRE_TO_LE16(v)   (v)
+#  define WIRE_TO_LE32(v)   (v)
+#elif defined(WIRE_CODEC_NATIVE_BE)
+#  define WIRE_TO_BE16(v)   (v)
+#  define WIRE_TO_BE32(v)   (v)
+#  define WIRE_TO_LE16(v)   __builtin_bswap16(v)
+#  define WIRE_TO_LE32(v)   __builtin_bswap32(v)
+#endif
+
+/*******************************************************************************
+ * Big-Endian Primitives
+ ******************************************************************************/
+
+/**
+ * @brief Store a 16-bit value big-endian
+ */
+static inline void wire_put_be16(uint8_t *dst, uint16_t value)
+{
+#if defined(WIRE_TO_BE16)
+    uint16_t wire = WIRE_TO_BE16(value);
+    (void)memcpy(dst, &wire, sizeof(wire));
+#else
+    dst[0] = (uint8_t)(value >> 8);
+    dst[1] = (uint8_t)(value);
+#endif
+}
+
+/**
+ * @brief Store a 32-bit value big-endian
+ */
+static inline void wire_put_be32(uint8_t *dst, uint32_t value)
+{
+#if defined(WIRE_TO_BE32)
+    uint32_t wire = WIRE_TO_BE32(value);
+    (void)memcpy(dst, &wire, sizeof(wire));
+#else
+    dst[0] = (uint8_t)(value >> 24);
+    dst[1] = (uint8_t)(value >> 16);
+    dst[2] = (uint8_t)(value >> 8);
+    dst[3] = (uint8_t)(value);
+#endif
+}
+
+/**
+ * @brief Load a big-endian 16-bit value
+ */
+static inline uint16_t wire_get_be16(const uint8_t *src)
+{
+#if defined(WIRE_TO_BE16)
+    uint16_t wire;
+    (void)memcpy(&wire, src, sizeof(wire));
+    return (uint16_t)WIRE_TO_BE16(wire);
+#else
+    return (uint16_t)(((uint16_t)src[0] << 8) | (uint16_t)src[1]);
+#endif
+}
+
+/**
+ * @brief Load a big-endian 32-bit value
+ */
+static inline uint32_t wire_get_be32(const uint8_t *src)
+{
+#if defined(WIRE_TO_BE32)
+    uint32_t wire;
+    (void)memcpy(&wire, src, sizeof(wire));
+    return (uint32_t)WIRE_TO_BE32(wire);
+#else
+    return ((uint32_t)src[0] << 24) | ((uint32_t)src[1] << 16) |
+           ((uint32_t)src[2] << 8) | (uint32_t)src[3];
+#endif
+}
+
+/**
+ * @brief Store an array of 16-bit values big-endian
+ *
+ * Written as a simple counted loop so the compiler can vectorize the
+ * byte swap on hosts with SIMD support.
+ *
+ * @param dst Destination (2 * count bytes)
+ * @param src Source values
+ * @param count Number of values
+ */
+static inline void wire_put_be16_array(uint8_t *dst, const uint16_t *src, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        wire_put_be16(&dst[i * 2U], src[i]);
+    }
+}
+
+/*******************************************************************************
+ * Little-Endian Primitives
+ ******************************************************************************/
+
+/**
+ * @brief Store a 16-bit value little-endian (AX.25 FCS order)
+ */
+static inline void wire_put_le16(uint8_t *dst, uint16_t value)
+{
+#if defined(WIRE_TO_LE16)
+    uint16_t wire = WIRE_TO_LE16(value);
+    (void)memcpy(dst, &wire, sizeof(wire));
+#else
+    dst[0] = (uint8_t)(value);
+    dst[1] = (uint8_t)(value >> 8);
+#endif
+}
+
+/**
+ * @brief Load a little-endian 16-bit value
+ */
+static inline uint16_t wire_get_le16(const uint8_t *src)
+{
+#if defined(WIRE_TO_LE16)
+    uint16_t wire;
+    (void)memcpy(&wire, src, sizeof(wire));
+    return (uint16_t)WIRE_TO_LE16(wire);
+#else
+    return (uint16_t)((uint16_t)src[0] | ((uint16_t)src[1] << 8));
+#endif
+}
+
+/**
+ * @brief Load a little-endian 32-bit value
+ */
+static inline uint32_t wire_get_le32(const uint8_t *src)
+{
+#if defined(WIRE_TO_LE32)
+    uint32_t wire;
+    (void)memcpy(&wire, src, sizeof(wire));
+    return (uint32_t)WIRE_TO_LE32(wire);
+#else
+    return (uint32_t)src[0] | ((uint32_t)src[1] << 8) |
+           ((uint32_t)src[2] << 16) | ((uint32_t)src[3] << 24);
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SMART_QSO_WIRE_CODEC_H */
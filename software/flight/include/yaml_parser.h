@@ -3,7 +3,17 @@
  * @brief Simple YAML configuration parser for SMART-QSO CubeSat
  *
  * This module provides a lightweight YAML parser for reading configuration
- * files. It supports a subset of YAML suitable for embedded systems.
+ * files. It supports a subset of YAML suitable for embedded systems: nested
+ * mappings by indentation, "- " list items, scalar values and # comments.
+ *
+ * Two interfaces are provided:
+ * - The streaming tokenizer (yaml_tokenizer_*) returns each line as a token
+ *   of spans into the caller's buffer: the parent keys, the key and the
+ *   value. Nothing is copied except the keys of open parent mappings and a
+ *   line split across two fed chunks, so a file can be parsed from a memory
+ *   map or in fixed-size chunks in time linear in its size.
+ * - The callback interface (yaml_parse_string) builds the dotted path and a
+ *   NUL-terminated value for each key-value pair on top of the tokenizer.
  *
  * @note MISRA C:2012 compliant
  * @note Memory-safe with bounded operations
@@ -27,6 +37,8 @@ extern "C" {
 #include <stdint.h>
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
 
 /*******************************************************************************
  * Definitions
@@ -38,6 +50,15 @@ extern "C" {
 /** Maximum value length */
 #define YAML_MAX_VALUE_LEN      128U
 
+/** Maximum line length */
+#define YAML_MAX_LINE_LENGTH    256U
+
+/** Maximum parent key length */
+#define YAML_MAX_KEY_LENGTH     64U
+
+/** Maximum nesting depth */
+#define YAML_MAX_DEPTH          8U
+
 /*******************************************************************************
  * Types
  ******************************************************************************/
@@ -51,7 +72,8 @@ typedef enum {
     YAML_ERROR_PARSE,           /**< Parse error */
     YAML_ERROR_MEMORY,          /**< Memory allocation error */
     YAML_ERROR_DEPTH,           /**< Maximum nesting depth exceeded */
-    YAML_ERROR_SYNTAX           /**< Syntax error */
+    YAML_ERROR_SYNTAX,          /**< Syntax error */
+    YAML_NEED_INPUT             /**< Tokenizer consumed its input (not an error) */
 } yaml_error_t;
 
 /**
@@ -63,6 +85,59 @@ typedef enum {
  */
 typedef void (*yaml_callback_t)(const char *path, const char *value, void *user_data);
 
+/**
+ * @brief View of bytes in a parsed buffer (not NUL-terminated)
+ */
+typedef struct {
+    const char *ptr;            /**< First byte */
+    size_t len;                 /**< Length in bytes */
+} yaml_span_t;
+
+/**
+ * @brief Token kinds
+ */
+typedef enum {
+    YAML_TOKEN_SCALAR,          /**< "key: value", or "- value" with an empty key */
+    YAML_TOKEN_MAPPING          /**< "key:" opening a nested mapping */
+} yaml_token_kind_t;
+
+/**
+ * @brief One tokenized line
+ *
+ * The spans are valid until the next yaml_tokenizer_next() or
+ * yaml_tokenizer_feed() call. The key and value of a line that was not
+ * split across chunks also stay valid as long as the fed buffer does.
+ */
+typedef struct {
+    yaml_token_kind_t kind;     /**< Token kind */
+    const yaml_span_t *path;    /**< Keys of the enclosing mappings, outermost first */
+    uint8_t depth;              /**< Number of path entries */
+    bool item;                  /**< Line starts a list item ("- ") */
+    yaml_span_t key;            /**< Key, trimmed */
+    yaml_span_t value;          /**< Value, trimmed and unquoted; empty for a mapping */
+    uint32_t line;              /**< Line number (1-based) */
+} yaml_token_t;
+
+/**
+ * @brief Streaming tokenizer state
+ *
+ * Caller-owned and fixed-size; initialize with yaml_tokenizer_init().
+ */
+typedef struct {
+    const char *chunk;                          /**< Fed input */
+    size_t chunk_len;                           /**< Fed input length */
+    size_t pos;                                 /**< Next unread byte of the input */
+    bool last;                                  /**< Fed input is the end of the document */
+    char carry[YAML_MAX_LINE_LENGTH];           /**< Start of a line split across chunks */
+    size_t carry_len;                           /**< Bytes held in carry */
+    char keys[YAML_MAX_DEPTH][YAML_MAX_KEY_LENGTH]; /**< Open parent keys */
+    yaml_span_t path[YAML_MAX_DEPTH];           /**< Views of keys */
+    size_t indent[YAML_MAX_DEPTH];              /**< Key column of each open parent */
+    uint8_t depth;                              /**< Open parents */
+    uint32_t line;                              /**< Lines read */
+    yaml_error_t error;                         /**< Sticky error */
+} yaml_tokenizer_t;
+
 /*******************************************************************************
  * Public Function Prototypes
  ******************************************************************************/
@@ -132,6 +207,74 @@ uint32_t yaml_get_error_line(void);
  */
 const char *yaml_error_to_string(yaml_error_t error);
 
+/**
+ * @brief Initialize a streaming tokenizer
+ *
+ * @param tok Tokenizer
+ */
+void yaml_tokenizer_init(yaml_tokenizer_t *tok);
+
+/**
+ * @brief Feed the next chunk of the document
+ *
+ * The previous chunk must have been consumed (yaml_tokenizer_next()
+ * returned YAML_NEED_INPUT). Chunks may split lines anywhere; the buffer
+ * must stay valid while its tokens are in use.
+ *
+ * @param tok    Tokenizer
+ * @param data   Chunk (may be NULL if length is 0)
+ * @param length Chunk length
+ * @param last   true if this chunk ends the document
+ * @return YAML_OK on success, YAML_ERROR_INVALID_PARAM if the previous
+ *         chunk is unread or the document has ended
+ */
+yaml_error_t yaml_tokenizer_feed(yaml_tokenizer_t *tok, const char *data, size_t length,
+                                 bool last);
+
+/**
+ * @brief Get the next token
+ *
+ * Blank and comment lines are skipped.
+ *
+ * @param tok        Tokenizer
+ * @param[out] token Token
+ * @return YAML_OK with a token, YAML_NEED_INPUT when the fed chunk is
+ *         consumed (the document is complete if it was the last), or an
+ *         error, which is also returned by every later call:
+ *         YAML_ERROR_SYNTAX for a line without a key,
+ *         YAML_ERROR_DEPTH for nesting deeper than YAML_MAX_DEPTH,
+ *         YAML_ERROR_MEMORY for a line or parent key over its maximum length
+ */
+yaml_error_t yaml_tokenizer_next(yaml_tokenizer_t *tok, yaml_token_t *token);
+
+/**
+ * @brief Compare a span with a string
+ *
+ * @param span Span
+ * @param text NUL-terminated string
+ * @return true if equal
+ */
+bool yaml_span_equals(yaml_span_t span, const char *text);
+
+/**
+ * @brief Copy a span into a NUL-terminated buffer
+ *
+ * @param span Span
+ * @param dst  Destination
+ * @param size Destination size; longer spans are truncated
+ * @return Characters copied
+ */
+size_t yaml_span_copy(yaml_span_t span, char *dst, size_t size);
+
+/**
+ * @brief Compare a token's full key path with a dotted path
+ *
+ * @param token Token
+ * @param path  Dotted path (e.g., "sensors.magnetometer.rate")
+ * @return true if the path and key match
+ */
+bool yaml_token_path_is(const yaml_token_t *token, const char *path);
+
 /*******************************************************************************
  * Inline Helper Functions
  ******************************************************************************/
@@ -0,0 +1,237 @@
+/**
+ * @file ax25.c
+ * @brief Streaming AX.25 UI frame encoder
+ *
+ * @requirement SRS-F020 Generate beacon at configurable intervals
+ */
+
+#include "ax25.h"
+
+#include <string.h>
+#include <ctype.h>
+
+/*===========================================================================*/
+/* Private Functions                                                          */
+/*===========================================================================*/
+
+static bool encoder_bit_mode(const Ax25Encoder_t *enc)
+{
+    return (enc->options & (AX25_OPT_BIT_STUFF | AX25_OPT_NRZI)) != 0U;
+}
+
+/**
+ * @brief Emit one line bit, applying NRZI and packing LSB first
+ */
+static void emit_bit(Ax25Encoder_t *enc, uint8_t bit)
+{
+    uint8_t out = bit;
+
+    if ((enc->options & AX25_OPT_NRZI) != 0U) {
+        /* NRZI: a zero toggles the line, a one holds it */
+        if (bit == 0U) {
+            enc->level ^= 1U;
+        }
+        out = enc->level;
+    }
+
+    enc->bit_acc |= (uint8_t)(out << (enc->bit_count & 7U));
+    enc->bit_count++;
+
+    if ((enc->bit_count & 7U) == 0U) {
+        if (enc->pos < enc->capacity) {
+            enc->buffer[enc->pos++] = enc->bit_acc;
+        } else {
+            enc->overflow = true;
+        }
+        enc->bit_acc = 0;
+    }
+}
+
+/**
+ * @brief Emit one octet, LSB first, with optional zero insertion
+ */
+static void emit_octet_bits(Ax25Encoder_t *enc, uint8_t value, bool stuff)
+{
+    for (uint8_t i = 0; i < 8U; i++) {
+        uint8_t bit = (uint8_t)(((unsigned)value >> i) & 1U);
+        emit_bit(enc, bit);
+
+        if (!stuff) {
+            continue;
+        }
+        if (bit != 0U) {
+            enc->ones++;
+            if (enc->ones == 5U) {
+                emit_bit(enc, 0U);
+                enc->ones = 0;
+            }
+        } else {
+            enc->ones = 0;
+        }
+    }
+}
+
+static void emit_flag(Ax25Encoder_t *enc)
+{
+    if (encoder_bit_mode(enc)) {
+        emit_octet_bits(enc, AX25_FLAG, false);
+        enc->ones = 0;
+    } else if (enc->pos < enc->capacity) {
+        enc->buffer[enc->pos++] = AX25_FLAG;
+    } else {
+        enc->overflow = true;
+    }
+}
+
+/**
+ * @brief Emit frame body bytes without touching the FCS
+ */
+static void emit_body(Ax25Encoder_t *enc, const uint8_t *data, size_t len)
+{
+    if (encoder_bit_mode(enc)) {
+        for (size_t i = 0; i < len; i++) {
+            emit_octet_bits(enc, data[i], true);
+        }
+    } else if (len <= enc->capacity - enc->pos) {
+        memcpy(enc->buffer + enc->pos, data, len);
+        enc->pos += len;
+    } else {
+        enc->overflow = true;
+    }
+}
+
+/*===========================================================================*/
+/* Public Functions                                                           */
+/*===========================================================================*/
+
+void ax25_encode_address(const char *callsign, uint8_t ssid,
+                         uint8_t *output, bool is_last)
+{
+    size_t len = strlen(callsign);
+    size_t i;
+
+    /* Pad with spaces and shift left by 1 */
+    for (i = 0; i < 6; i++) {
+        if (i < len) {
+            output[i] = (uint8_t)(toupper((unsigned char)callsign[i]) << 1);
+        } else {
+            output[i] = ' ' << 1;
+        }
+    }
+
+    /* SSID byte: bits 1-4 = SSID, bit 0 = end flag, bits 5-6 = reserved (11) */
+    output[6] = (uint8_t)(0x60 | ((ssid & 0x0F) << 1) | (is_last ? 0x01 : 0x00));
+}
+
+SmartQsoResult_t ax25_encoder_begin(Ax25Encoder_t *enc, uint8_t *buffer,
+                                    size_t capacity, uint32_t options)
+{
+    if (enc == NULL || buffer == NULL) {
+        return SMART_QSO_ERROR_NULL_PTR;
+    }
+
+    memset(enc, 0, sizeof(*enc));
+    enc->buffer = buffer;
+    enc->capacity = capacity;
+    enc->options = options;
+    crc16_ctx_init(&enc->fcs);
+
+    emit_flag(enc);
+
+    return SMART_QSO_OK;
+}
+
+void ax25_encoder_put_address(Ax25Encoder_t *enc, const char *callsign,
+                              uint8_t ssid, bool is_last)
+{
+    uint8_t addr[AX25_ADDR_LEN];
+
+    if (enc == NULL || callsign == NULL) {
+        return;
+    }
+
+    ax25_encode_address(callsign, ssid, addr, is_last);
+    ax25_encoder_put_bytes(enc, addr, sizeof(addr));
+}
+
+void ax25_encoder_put_u8(Ax25Encoder_t *enc, uint8_t value)
+{
+    ax25_encoder_put_bytes(enc, &value, 1);
+}
+
+void ax25_encoder_put_bytes(Ax25Encoder_t *enc, const uint8_t *data, size_t len)
+{
+    if (enc == NULL || data == NULL) {
+        return;
+    }
+
+    crc16_update(&enc->fcs, data, len);
+    emit_body(enc, data, len);
+}
+
+uint8_t *ax25_encoder_reserve(Ax25Encoder_t *enc, size_t *available)
+{
+    if (available != NULL) {
+        *available = 0;
+    }
+
+    if (enc == NULL || available == NULL || encoder_bit_mode(enc) ||
+        enc->overflow || (enc->capacity - enc->pos) <= AX25_TRAILER_LEN) {
+        return NULL;
+    }
+
+    *available = enc->capacity - enc->pos - AX25_TRAILER_LEN;
+    return enc->buffer + enc->pos;
+}
+
+void ax25_encoder_commit(Ax25Encoder_t *enc, size_t len)
+{
+    if (enc == NULL || encoder_bit_mode(enc)) {
+        return;
+    }
+
+    if (len > enc->capacity - enc->pos) {
+        enc->overflow = true;
+        return;
+    }
+
+    crc16_update(&enc->fcs, enc->buffer + enc->pos, len);
+    enc->pos += len;
+}
+
+SmartQsoResult_t ax25_encoder_finish(Ax25Encoder_t *enc, size_t *bytes_written)
+{
+    if (enc == NULL || bytes_written == NULL) {
+        return SMART_QSO_ERROR_NULL_PTR;
+    }
+
+    /* FCS is sent low byte first and is not itself covered by the CRC */
+    uint16_t fcs = crc16_final(&enc->fcs);
+    uint8_t fcs_bytes[2] = {
+        (uint8_t)(fcs & 0xFFU),
+        (uint8_t)(fcs >> 8)
+    };
+    emit_body(enc, fcs_bytes, sizeof(fcs_bytes));
+    emit_flag(enc);
+
+    if (encoder_bit_mode(enc)) {
+        enc->frame_bits = enc->bit_count;
+
+        /* Pad the final byte with idle flag bits */
+        uint8_t idle_bit = 0;
+        while ((enc->bit_count & 7U) != 0U) {
+            emit_bit(enc, (uint8_t)((AX25_FLAG >> idle_bit) & 1U));
+            idle_bit++;
+        }
+    } else {
+        enc->frame_bits = enc->pos * 8U;
+    }
+
+    if (enc->overflow) {
+        *bytes_written = 0;
+        return SMART_QSO_ERROR_NO_MEM;
+    }
+
+    *bytes_written = enc->pos;
+    return SMART_QSO_OK;
+}
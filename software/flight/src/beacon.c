@@ -6,13 +6,15 @@
  */
 
 #include "beacon.h"
+#include "crc16.h"
 #include "eps_control.h"
 #include "mission_data.h"
 #include "fault_mgmt.h"
+#include "safe_string.h"
+#include "wire_codec.h"
 
 #include <stdio.h>
 #include <string.h>
-#include <ctype.h>
 
 /*===========================================================================*/
 /* Module State                                                               */
@@ -27,6 +29,60 @@ static size_t s_template_index = 0;
 /** Module initialized flag */
 static bool s_initialized = false;
 
+/** Power mode last applied by beacon_update_interval() */
+static PowerMode_t s_power_mode = POWER_MODE_ACTIVE;
+
+/*===========================================================================*/
+/* Payload Render Cache                                                       */
+/*===========================================================================*/
+
+/** Static payload header preceding the beacon text */
+#define BEACON_HEADER       "de " BEACON_CALLSIGN ": "
+#define BEACON_HEADER_LEN   (sizeof(BEACON_HEADER) - 1U)
+
+/** Longest rendered field value ("4294967295") */
+#define BEACON_FIELD_MAX    10U
+
+/**
+ * @brief Telemetry suffix fields, in render order
+ */
+typedef enum {
+    BEACON_FIELD_TIME = 0,
+    BEACON_FIELD_MODE,
+    BEACON_FIELD_SOC,
+    BEACON_FIELD_BV,
+    BEACON_FIELD_SUN,
+    BEACON_FIELD_RF,
+    BEACON_FIELD_QSO,
+    BEACON_FIELD_COUNT
+} BeaconField_t;
+
+/** Label written before each field value */
+static const char *const s_field_labels[BEACON_FIELD_COUNT] = {
+    " | T=", " M=", " SOC=", " BV=", " SUN=", " RF=", " QSO="
+};
+
+/**
+ * @brief Rendered payload with the location of each numeric field
+ *
+ * The header and beacon text change rarely, so the rendered payload is
+ * kept between beacons. Each beacon only rewrites the digits of fields
+ * whose value changed; the tail is re-rendered only when a field changes
+ * width (e.g. SOC 9 -> 10).
+ */
+typedef struct {
+    char     text[BEACON_MAX_PAYLOAD_LEN];       /**< Rendered payload */
+    size_t   len;                                /**< Rendered length */
+    size_t   text_len;                           /**< Beacon text length */
+    size_t   field_pos[BEACON_FIELD_COUNT];      /**< Offset of each value */
+    uint8_t  field_len[BEACON_FIELD_COUNT];      /**< Width of each value */
+    uint32_t field_value[BEACON_FIELD_COUNT];    /**< Value last rendered */
+    bool     valid;                              /**< Cache holds a payload */
+} BeaconRender_t;
+
+/** Payload render cache */
+static BeaconRender_t s_render;
+
 /*===========================================================================*/
 /* Beacon Template Messages                                                   */
 /*===========================================================================*/
@@ -49,25 +105,263 @@ const size_t beacon_template_count = sizeof(beacon_templates) / sizeof(beacon_te
 /*===========================================================================*/
 
 /**
- * @brief Encode callsign for AX.25 address field
+ * @brief Get the value of a telemetry field as rendered
+ *
+ * Battery voltage is kept in tenths of a volt, rounded half up, so it can
+ * be printed with integer arithmetic only.
+ */
+static uint32_t field_value(const BeaconTelemetry_t *tlm, BeaconField_t field)
+{
+    switch (field) {
+        case BEACON_FIELD_TIME:
+            return tlm->timestamp;
+        case BEACON_FIELD_MODE:
+            return tlm->power_mode;
+        case BEACON_FIELD_SOC:
+            return tlm->soc;
+        case BEACON_FIELD_BV:
+            return ((uint32_t)tlm->battery_mv + 50U) / 100U;
+        case BEACON_FIELD_SUN:
+            return tlm->sunlit;
+        case BEACON_FIELD_RF:
+            return tlm->rf_power;
+        case BEACON_FIELD_QSO:
+            return tlm->qso_count;
+        case BEACON_FIELD_COUNT:
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Format a field value without floating point
+ *
+ * @return Number of characters written to out (not NUL-terminated)
  */
-static void encode_ax25_address(const char *callsign, uint8_t ssid,
-                                 uint8_t *output, bool is_last)
-{
-    size_t len = strlen(callsign);
-    size_t i;
-
-    /* Pad with spaces and shift left by 1 */
-    for (i = 0; i < 6; i++) {
-        if (i < len) {
-            output[i] = (uint8_t)(toupper((unsigned char)callsign[i]) << 1);
-        } else {
-            output[i] = ' ' << 1;
+static size_t field_format(BeaconField_t field, uint32_t value,
+                           char out[BEACON_FIELD_MAX + 1U])
+{
+    size_t len = 0;
+
+    if (field == BEACON_FIELD_MODE) {
+        const char *name = (value == 0U) ? "SAFE" :
+                           ((value == 1U) ? "IDLE" : "ACTIVE");
+        len = strlen(name);
+        memcpy(out, name, len);
+    } else if (field == BEACON_FIELD_BV) {
+        (void)safe_utoa(value / 10U, out, BEACON_FIELD_MAX + 1U, &len);
+        out[len++] = '.';
+        out[len++] = (char)('0' + (value % 10U));
+    } else {
+        (void)safe_utoa(value, out, BEACON_FIELD_MAX + 1U, &len);
+    }
+
+    return len;
+}
+
+/**
+ * @brief Render telemetry fields from a given field to the end
+ */
+static bool render_fields_from(const BeaconTelemetry_t *tlm, BeaconField_t first,
+                               size_t pos)
+{
+    for (int f = (int)first; f < (int)BEACON_FIELD_COUNT; f++) {
+        BeaconField_t field = (BeaconField_t)f;
+        const char *label = s_field_labels[f];
+        size_t label_len = strlen(label);
+        char digits[BEACON_FIELD_MAX + 1U];
+        uint32_t value = field_value(tlm, field);
+        size_t len = field_format(field, value, digits);
+
+        if (pos + label_len + len >= sizeof(s_render.text)) {
+            return false;
+        }
+
+        memcpy(s_render.text + pos, label, label_len);
+        pos += label_len;
+        memcpy(s_render.text + pos, digits, len);
+
+        s_render.field_pos[f] = pos;
+        s_render.field_len[f] = (uint8_t)len;
+        s_render.field_value[f] = value;
+        pos += len;
+    }
+
+    s_render.len = pos;
+    return true;
+}
+
+/**
+ * @brief Bring the render cache up to date with the beacon content
+ *
+ * @return false if the payload does not fit BEACON_MAX_PAYLOAD_LEN
+ */
+static bool render_update(const BeaconContent_t *content)
+{
+    const BeaconTelemetry_t *tlm = &content->telemetry;
+    const char *end = memchr(content->text, '\0', sizeof(content->text));
+    size_t text_len = (end != NULL) ? (size_t)(end - content->text)
+                                    : sizeof(content->text);
+
+    /* Text changed (or nothing cached): rebuild the whole payload */
+    if (!s_render.valid || text_len != s_render.text_len ||
+        memcmp(s_render.text + BEACON_HEADER_LEN, content->text, text_len) != 0) {
+        s_render.valid = false;
+
+        if (BEACON_HEADER_LEN + text_len >= sizeof(s_render.text)) {
+            return false;
+        }
+
+        memcpy(s_render.text, BEACON_HEADER, BEACON_HEADER_LEN);
+        memcpy(s_render.text + BEACON_HEADER_LEN, content->text, text_len);
+        s_render.text_len = text_len;
+
+        if (!render_fields_from(tlm, BEACON_FIELD_TIME,
+                                BEACON_HEADER_LEN + text_len)) {
+            return false;
+        }
+
+        s_render.valid = true;
+        return true;
+    }
+
+    /* Same text: patch digits of the fields that changed */
+    for (int f = 0; f < (int)BEACON_FIELD_COUNT; f++) {
+        BeaconField_t field = (BeaconField_t)f;
+        uint32_t value = field_value(tlm, field);
+
+        if (value == s_render.field_value[f]) {
+            continue;
+        }
+
+        char digits[BEACON_FIELD_MAX + 1U];
+        size_t len = field_format(field, value, digits);
+
+        if (len != s_render.field_len[f]) {
+            /* Width changed: re-render this field and everything after it */
+            size_t label_start = s_render.field_pos[f] - strlen(s_field_labels[f]);
+            if (!render_fields_from(tlm, field, label_start)) {
+                s_render.valid = false;
+                return false;
+            }
+            break;
         }
+
+        memcpy(s_render.text + s_render.field_pos[f], digits, len);
+        s_render.field_value[f] = value;
+    }
+
+    return true;
+}
+
+/*===========================================================================*/
+/* Airtime Planner                                                            */
+/*===========================================================================*/
+
+/** AX.25 octets around the info field: flag, addresses, ctrl, PID, FCS, flag */
+#define BEACON_FRAME_OVERHEAD \
+    (1U + (2U * AX25_ADDR_LEN) + 2U + AX25_TRAILER_LEN)
+
+/** Longest info field per format, used before a format has been measured */
+static const size_t s_format_max_info[BEACON_FORMAT_COUNT] = {
+    BEACON_MAX_PAYLOAD_LEN, BEACON_BIN_LEN, BEACON_DIGEST_LEN
+};
+
+/**
+ * @brief Format emitted at a given interleave cycle position
+ */
+static BeaconFormat_t interleave_format(uint32_t pos)
+{
+    if (pos < s_beacon_state.text_ratio) {
+        return BEACON_FORMAT_TEXT;
+    }
+    if (pos < (uint32_t)s_beacon_state.text_ratio + s_beacon_state.binary_ratio) {
+        return BEACON_FORMAT_BINARY;
+    }
+    return BEACON_FORMAT_DIGEST;
+}
+
+/**
+ * @brief Expected airtime of the next beacon in a format
+ *
+ * Uses the last measured frame of that format, falling back to the
+ * worst-case frame length.
+ */
+static uint32_t format_airtime_estimate(BeaconFormat_t format)
+{
+    uint32_t measured = s_beacon_state.format_airtime_ms[format];
+    if (measured != 0U) {
+        return measured;
     }
+    return beacon_airtime_ms(BEACON_FRAME_OVERHEAD + s_format_max_info[format]);
+}
 
-    /* SSID byte: bits 1-4 = SSID, bit 0 = end flag, bits 5-6 = reserved (11) */
-    output[6] = (uint8_t)(0x60 | ((ssid & 0x0F) << 1) | (is_last ? 0x01 : 0x00));
+/**
+ * @brief Airtime left in the current budget window
+ */
+static uint32_t budget_remaining(void)
+{
+    if (s_beacon_state.orbit_airtime_ms >= s_beacon_state.orbit_budget_ms) {
+        return 0;
+    }
+    return s_beacon_state.orbit_budget_ms - s_beacon_state.orbit_airtime_ms;
+}
+
+/**
+ * @brief Plan the interval from the last beacon to the next one
+ *
+ * Spreads the remaining budget evenly over the remaining window. The
+ * power-mode interval is a lower bound in SAFE mode; other modes may
+ * compress to half of it when budget is plentiful. When not even a
+ * binary beacon fits, the next beacon waits for the next window.
+ *
+ * @return true if the beacon was deferred to the next window
+ */
+static bool plan_next_interval(void)
+{
+    uint32_t elapsed = s_beacon_state.last_beacon_ms - s_beacon_state.orbit_start_ms;
+    uint32_t remaining_time = (elapsed < s_beacon_state.orbit_period_ms) ?
+                              (s_beacon_state.orbit_period_ms - elapsed) : 0U;
+    uint32_t remaining_budget = budget_remaining();
+
+    uint32_t floor_ms = s_beacon_state.base_interval_ms;
+    if (s_power_mode != POWER_MODE_SAFE) {
+        floor_ms /= 2U;
+    }
+
+    if (remaining_budget < format_airtime_estimate(BEACON_FORMAT_BINARY)) {
+        s_beacon_state.interval_ms = (remaining_time > floor_ms) ? remaining_time : floor_ms;
+        return true;
+    }
+
+    uint32_t estimate = format_airtime_estimate(
+        interleave_format(s_beacon_state.interleave_pos));
+    uint64_t pace = ((uint64_t)remaining_time * estimate) / remaining_budget;
+
+    s_beacon_state.interval_ms = (pace > floor_ms) ? (uint32_t)pace : floor_ms;
+    return false;
+}
+
+uint32_t beacon_airtime_ms(size_t frame_len)
+{
+    uint64_t bits = (uint64_t)frame_len * 8U;
+    uint64_t frame_ms = ((bits * 1000U) + BEACON_BAUD_RATE - 1U) / BEACON_BAUD_RATE;
+
+    return BEACON_TX_PREAMBLE_MS + (uint32_t)frame_ms + BEACON_TX_TAIL_MS;
+}
+
+SmartQsoResult_t beacon_set_airtime_budget(uint32_t orbit_period_ms,
+                                           uint32_t budget_ms)
+{
+    if (orbit_period_ms == 0U || budget_ms > orbit_period_ms) {
+        return SMART_QSO_ERROR_INVALID;
+    }
+
+    s_beacon_state.orbit_period_ms = orbit_period_ms;
+    s_beacon_state.orbit_budget_ms = budget_ms;
+    (void)plan_next_interval();
+
+    return SMART_QSO_OK;
 }
 
 /*===========================================================================*/
@@ -79,8 +373,16 @@ SmartQsoResult_t beacon_init(void)
     memset(&s_beacon_state, 0, sizeof(s_beacon_state));
 
     s_beacon_state.interval_ms = BEACON_INTERVAL_ACTIVE_MS;
+    s_beacon_state.base_interval_ms = BEACON_INTERVAL_ACTIVE_MS;
+    s_beacon_state.orbit_period_ms = BEACON_ORBIT_PERIOD_MS;
+    s_beacon_state.orbit_budget_ms = BEACON_DEFAULT_AIRTIME_BUDGET_MS;
     s_beacon_state.ai_available = false;
+    s_beacon_state.text_ratio = BEACON_DEFAULT_TEXT_RATIO;
+    s_beacon_state.binary_ratio = BEACON_DEFAULT_BINARY_RATIO;
+    s_beacon_state.digest_ratio = BEACON_DEFAULT_DIGEST_RATIO;
     s_template_index = 0;
+    s_power_mode = POWER_MODE_ACTIVE;
+    memset(&s_render, 0, sizeof(s_render));
 
     s_initialized = true;
 
@@ -105,16 +407,19 @@ void beacon_update_interval(PowerMode_t power_mode)
 
     switch (power_mode) {
         case POWER_MODE_SAFE:
-            s_beacon_state.interval_ms = BEACON_INTERVAL_SAFE_MS;
+            s_beacon_state.base_interval_ms = BEACON_INTERVAL_SAFE_MS;
             break;
         case POWER_MODE_IDLE:
-            s_beacon_state.interval_ms = BEACON_INTERVAL_IDLE_MS;
+            s_beacon_state.base_interval_ms = BEACON_INTERVAL_IDLE_MS;
             break;
         case POWER_MODE_ACTIVE:
         default:
-            s_beacon_state.interval_ms = BEACON_INTERVAL_ACTIVE_MS;
+            s_beacon_state.base_interval_ms = BEACON_INTERVAL_ACTIVE_MS;
             break;
     }
+    s_power_mode = power_mode;
+
+    (void)plan_next_interval();
 }
 
 SmartQsoResult_t beacon_generate_content(BeaconContent_t *content,
@@ -186,6 +491,22 @@ SmartQsoResult_t beacon_generate_content(BeaconContent_t *content,
     s_beacon_state.sequence++;
     content->sequence = s_beacon_state.sequence;
 
+    /* Pick the format according to the interleave ratio */
+    content->format = interleave_format(s_beacon_state.interleave_pos);
+    s_beacon_state.interleave_pos++;
+    if ((uint32_t)s_beacon_state.interleave_pos >=
+        (uint32_t)s_beacon_state.text_ratio + s_beacon_state.binary_ratio +
+        s_beacon_state.digest_ratio) {
+        s_beacon_state.interleave_pos = 0;
+    }
+
+    /* Fall back to the short binary frame when the budget is nearly spent */
+    if (content->format != BEACON_FORMAT_BINARY &&
+        budget_remaining() < format_airtime_estimate(content->format)) {
+        content->format = BEACON_FORMAT_BINARY;
+        s_beacon_state.budget_deferrals++;
+    }
+
     return SMART_QSO_OK;
 }
 
@@ -197,24 +518,114 @@ size_t beacon_format_payload(const BeaconContent_t *content,
         return 0;
     }
 
-    int written = snprintf(buffer, buffer_len,
-        "de %s: %s | T=%u M=%s SOC=%u BV=%.1f SUN=%u RF=%u QSO=%u",
-        BEACON_CALLSIGN,
-        content->text,
-        content->telemetry.timestamp,
-        content->telemetry.power_mode == 0 ? "SAFE" :
-            (content->telemetry.power_mode == 1 ? "IDLE" : "ACTIVE"),
-        content->telemetry.soc,
-        content->telemetry.battery_mv / 1000.0,
-        content->telemetry.sunlit,
-        content->telemetry.rf_power,
-        content->telemetry.qso_count);
-
-    if (written < 0 || (size_t)written >= buffer_len) {
+    if (!render_update(content) || s_render.len >= buffer_len) {
+        return 0;
+    }
+
+    memcpy(buffer, s_render.text, s_render.len);
+    buffer[s_render.len] = '\0';
+
+    return s_render.len;
+}
+
+size_t beacon_format_binary(const BeaconContent_t *content,
+                            uint8_t *buffer,
+                            size_t buffer_len)
+{
+    if (content == NULL || buffer == NULL || buffer_len < BEACON_BIN_LEN) {
+        return 0;
+    }
+
+    const BeaconTelemetry_t *tlm = &content->telemetry;
+
+    buffer[0] = BEACON_BIN_TYPE;
+    wire_put_be32(buffer + 1, content->sequence);
+    wire_put_be32(buffer + 5, tlm->timestamp);
+    buffer[9] = tlm->power_mode;
+    buffer[10] = tlm->soc;
+    wire_put_be16(buffer + 11, tlm->battery_mv);
+    buffer[13] = (uint8_t)tlm->temp_obc;
+    buffer[14] = (uint8_t)tlm->temp_payload;
+    buffer[15] = tlm->sunlit;
+    buffer[16] = tlm->rf_power;
+    wire_put_be16(buffer + 17, tlm->qso_count);
+    wire_put_be16(buffer + 19, tlm->orbit_number);
+    buffer[21] = tlm->fault_flags;
+    buffer[22] = (uint8_t)content->source;
+    wire_put_be16(buffer + 23, crc16_x25(buffer, BEACON_BIN_LEN - 2U));
+
+    return BEACON_BIN_LEN;
+}
+
+size_t beacon_format_digest(const BeaconContent_t *content,
+                            uint8_t *buffer,
+                            size_t buffer_len)
+{
+    if (content == NULL || buffer == NULL || buffer_len < BEACON_DIGEST_LEN) {
         return 0;
     }
 
-    return (size_t)written;
+    size_t total = fault_log_get_count();
+    size_t entries = (total < BEACON_DIGEST_ENTRIES) ? total : BEACON_DIGEST_ENTRIES;
+
+    memset(buffer, 0, BEACON_DIGEST_LEN);
+    buffer[0] = BEACON_DIGEST_TYPE;
+    wire_put_be32(buffer + 1, content->sequence);
+    wire_put_be32(buffer + 5, content->telemetry.timestamp);
+    wire_put_be16(buffer + 9, (uint16_t)((total > 0xFFFFU) ? 0xFFFFU : total));
+    buffer[11] = (uint8_t)entries;
+
+    /* Most recent fault first */
+    for (size_t i = 0; i < entries; i++) {
+        FaultLogEntry_t entry;
+        if (fault_log_get_entry(total - 1U - i, &entry) != SMART_QSO_OK) {
+            break;
+        }
+        uint8_t *slot = buffer + 12U + (i * 7U);
+        slot[0] = entry.fault_type;
+        slot[1] = entry.severity;
+        slot[2] = entry.recovered ? 1U : 0U;
+        wire_put_be32(slot + 3, (uint32_t)(entry.timestamp_ms / 1000U));
+    }
+
+    wire_put_be16(buffer + BEACON_DIGEST_LEN - 2U,
+                  crc16_x25(buffer, BEACON_DIGEST_LEN - 2U));
+
+    return BEACON_DIGEST_LEN;
+}
+
+size_t beacon_format_info(const BeaconContent_t *content,
+                          uint8_t *buffer,
+                          size_t buffer_len)
+{
+    if (content == NULL) {
+        return 0;
+    }
+
+    if (content->format == BEACON_FORMAT_BINARY) {
+        return beacon_format_binary(content, buffer, buffer_len);
+    }
+
+    if (content->format == BEACON_FORMAT_DIGEST) {
+        return beacon_format_digest(content, buffer, buffer_len);
+    }
+
+    return beacon_format_payload(content, (char *)buffer, buffer_len);
+}
+
+SmartQsoResult_t beacon_set_interleave(uint8_t text_count, uint8_t binary_count,
+                                       uint8_t digest_count)
+{
+    if (text_count == 0U && binary_count == 0U && digest_count == 0U) {
+        return SMART_QSO_ERROR_INVALID;
+    }
+
+    s_beacon_state.text_ratio = text_count;
+    s_beacon_state.binary_ratio = binary_count;
+    s_beacon_state.digest_ratio = digest_count;
+    s_beacon_state.interleave_pos = 0;
+
+    return SMART_QSO_OK;
 }
 
 SmartQsoResult_t beacon_build_ax25_frame(const BeaconContent_t *content,
@@ -227,38 +638,33 @@ SmartQsoResult_t beacon_build_ax25_frame(const BeaconContent_t *content,
     memset(frame, 0, sizeof(Ax25Frame_t));
 
     /* Encode destination address (CQ broadcast) */
-    encode_ax25_address("CQ", 0, frame->dest_addr, false);
+    ax25_encode_address("CQ", 0, frame->dest_addr, false);
 
     /* Encode source address */
-    encode_ax25_address(BEACON_CALLSIGN, 1, frame->src_addr, true);
+    ax25_encode_address(BEACON_CALLSIGN, 1, frame->src_addr, true);
 
     /* Control and PID */
     frame->ctrl = AX25_CTRL_UI;
     frame->pid = AX25_PID_NO_L3;
 
     /* Format info field */
-    frame->info_len = beacon_format_payload(content,
-                                             (char *)frame->info,
-                                             sizeof(frame->info));
+    frame->info_len = beacon_format_info(content, frame->info,
+                                          sizeof(frame->info));
 
     if (frame->info_len == 0) {
         return SMART_QSO_ERROR;
     }
 
-    /* Calculate FCS (CRC-16 CCITT) */
-    uint8_t fcs_data[AX25_ADDR_LEN * 2 + 2 + BEACON_MAX_PAYLOAD_LEN];
-    size_t fcs_len = 0;
-
-    memcpy(fcs_data + fcs_len, frame->dest_addr, AX25_ADDR_LEN);
-    fcs_len += AX25_ADDR_LEN;
-    memcpy(fcs_data + fcs_len, frame->src_addr, AX25_ADDR_LEN);
-    fcs_len += AX25_ADDR_LEN;
-    fcs_data[fcs_len++] = frame->ctrl;
-    fcs_data[fcs_len++] = frame->pid;
-    memcpy(fcs_data + fcs_len, frame->info, frame->info_len);
-    fcs_len += frame->info_len;
+    /* Calculate FCS (CRC-16/X.25) over the fields in transmit order */
+    Crc16Ctx_t fcs;
+    crc16_ctx_init(&fcs);
+    crc16_update(&fcs, frame->dest_addr, AX25_ADDR_LEN);
+    crc16_update(&fcs, frame->src_addr, AX25_ADDR_LEN);
+    crc16_update_byte(&fcs, frame->ctrl);
+    crc16_update_byte(&fcs, frame->pid);
+    crc16_update(&fcs, frame->info, frame->info_len);
 
-    frame->fcs = beacon_crc16(fcs_data, fcs_len);
+    frame->fcs = crc16_final(&fcs);
 
     return SMART_QSO_OK;
 }
@@ -314,28 +720,154 @@ size_t beacon_serialize_ax25(const Ax25Frame_t *frame,
     return pos;
 }
 
-SmartQsoResult_t beacon_transmit(const BeaconContent_t *content)
+/**
+ * @brief Encode a beacon frame with a caller-owned encoder
+ *
+ * @param info_len Receives the information field length
+ */
+static SmartQsoResult_t encode_frame(const BeaconContent_t *content,
+                                     Ax25Encoder_t *enc,
+                                     uint8_t *buffer,
+                                     size_t buffer_len,
+                                     uint32_t options,
+                                     size_t *bytes_written,
+                                     size_t *info_len)
 {
-    if (content == NULL) {
+    SmartQsoResult_t result = ax25_encoder_begin(enc, buffer, buffer_len, options);
+    if (result != SMART_QSO_OK) {
+        return result;
+    }
+
+    ax25_encoder_put_address(enc, "CQ", 0, false);
+    ax25_encoder_put_address(enc, BEACON_CALLSIGN, 1, true);
+    ax25_encoder_put_u8(enc, AX25_CTRL_UI);
+    ax25_encoder_put_u8(enc, AX25_PID_NO_L3);
+
+    /* Format the info field in place when emitting octets */
+    size_t available = 0;
+    uint8_t *info = ax25_encoder_reserve(enc, &available);
+
+    if (info != NULL) {
+        if (available > BEACON_MAX_PAYLOAD_LEN) {
+            available = BEACON_MAX_PAYLOAD_LEN;
+        }
+        *info_len = beacon_format_info(content, info, available);
+        ax25_encoder_commit(enc, *info_len);
+    } else {
+        uint8_t scratch[BEACON_MAX_PAYLOAD_LEN];
+        *info_len = beacon_format_info(content, scratch, sizeof(scratch));
+        ax25_encoder_put_bytes(enc, scratch, *info_len);
+    }
+
+    if (*info_len == 0) {
+        /* Either the text does not fit this buffer or formatting failed */
+        return (info != NULL && available < BEACON_MAX_PAYLOAD_LEN) ?
+               SMART_QSO_ERROR_NO_MEM : SMART_QSO_ERROR;
+    }
+
+    return ax25_encoder_finish(enc, bytes_written);
+}
+
+SmartQsoResult_t beacon_encode_ax25(const BeaconContent_t *content,
+                                    uint8_t *buffer,
+                                    size_t buffer_len,
+                                    uint32_t options,
+                                    size_t *bytes_written)
+{
+    if (content == NULL || buffer == NULL || bytes_written == NULL) {
         return SMART_QSO_ERROR_NULL_PTR;
     }
 
-    /* Build AX.25 frame */
-    Ax25Frame_t frame;
-    SmartQsoResult_t result = beacon_build_ax25_frame(content, &frame);
+    *bytes_written = 0;
+
+    Ax25Encoder_t enc;
+    size_t info_len = 0;
+    return encode_frame(content, &enc, buffer, buffer_len, options,
+                        bytes_written, &info_len);
+}
+
+/**
+ * @brief FX.25-encode a beacon, reporting the info field length
+ */
+static SmartQsoResult_t encode_fx25(const BeaconContent_t *content,
+                                    uint8_t *buffer,
+                                    size_t buffer_len,
+                                    size_t *bytes_written,
+                                    size_t *info_len)
+{
+    uint8_t stream[AX25_BITSTREAM_MAX_LEN(AX25_MAX_FRAME_LEN)];
+    size_t stream_len = 0;
+    Ax25Encoder_t enc;
+
+    SmartQsoResult_t result = encode_frame(content, &enc, stream, sizeof(stream),
+                                           AX25_OPT_BIT_STUFF, &stream_len, info_len);
     if (result != SMART_QSO_OK) {
         return result;
     }
 
-    /* Serialize frame */
+    return fx25_encode(stream, enc.frame_bits, buffer, buffer_len, bytes_written);
+}
+
+SmartQsoResult_t beacon_encode_fx25(const BeaconContent_t *content,
+                                    uint8_t *buffer,
+                                    size_t buffer_len,
+                                    size_t *bytes_written)
+{
+    if (content == NULL || buffer == NULL || bytes_written == NULL) {
+        return SMART_QSO_ERROR_NULL_PTR;
+    }
+
+    *bytes_written = 0;
+
+    size_t info_len = 0;
+    return encode_fx25(content, buffer, buffer_len, bytes_written, &info_len);
+}
+
+void beacon_set_fec(bool enable)
+{
+    s_beacon_state.fec_enabled = enable;
+}
+
+SmartQsoResult_t beacon_transmit(const BeaconContent_t *content)
+{
+    if (content == NULL) {
+        return SMART_QSO_ERROR_NULL_PTR;
+    }
+
+    /* Encode straight into the transmit buffer: FX.25 if enabled and the
+     * frame fits one codeword, plain AX.25 otherwise */
     uint8_t tx_buffer[AX25_MAX_FRAME_LEN];
-    size_t tx_len = beacon_serialize_ax25(&frame, tx_buffer, sizeof(tx_buffer));
-    if (tx_len == 0) {
-        return SMART_QSO_ERROR;
+    size_t tx_len = 0;
+    size_t info_len = 0;
+    SmartQsoResult_t result = SMART_QSO_ERROR_INVALID;
+    bool fec = false;
+
+    if (s_beacon_state.fec_enabled) {
+        result = encode_fx25(content, tx_buffer, sizeof(tx_buffer), &tx_len, &info_len);
+        fec = (result == SMART_QSO_OK);
+    }
+    if (result == SMART_QSO_ERROR_INVALID) {
+        Ax25Encoder_t enc;
+        result = encode_frame(content, &enc, tx_buffer, sizeof(tx_buffer), 0,
+                              &tx_len, &info_len);
+    }
+    if (result != SMART_QSO_OK) {
+        return result;
     }
 
     /* Update statistics */
+    uint32_t airtime = beacon_airtime_ms(tx_len);
     s_beacon_state.total_bytes_tx += (uint32_t)tx_len;
+    s_beacon_state.useful_bytes_tx += (uint32_t)info_len;
+    if (fec) {
+        s_beacon_state.fec_beacon_count++;
+    }
+    s_beacon_state.last_airtime_ms = airtime;
+    s_beacon_state.orbit_airtime_ms += airtime;
+    s_beacon_state.total_airtime_ms += airtime;
+    if ((uint32_t)content->format < (uint32_t)BEACON_FORMAT_COUNT) {
+        s_beacon_state.format_airtime_ms[content->format] = airtime;
+    }
 
     if (content->source == BEACON_SOURCE_AI) {
         s_beacon_state.ai_beacon_count++;
@@ -345,6 +877,20 @@ SmartQsoResult_t beacon_transmit(const BeaconContent_t *content)
 
     /* Note: Actual RF transmission would be done via HAL/RF driver */
     /* For simulation, just print the beacon content */
+    if (content->format == BEACON_FORMAT_BINARY) {
+        s_beacon_state.binary_beacon_count++;
+        printf("[BEACON] TX: binary #%u (%zu bytes)\n",
+               (unsigned int)content->sequence, tx_len);
+        return SMART_QSO_OK;
+    }
+
+    if (content->format == BEACON_FORMAT_DIGEST) {
+        s_beacon_state.digest_beacon_count++;
+        printf("[BEACON] TX: digest #%u (%zu bytes)\n",
+               (unsigned int)content->sequence, tx_len);
+        return SMART_QSO_OK;
+    }
+
     char payload[BEACON_MAX_PAYLOAD_LEN];
     beacon_format_payload(content, payload, sizeof(payload));
     printf("[BEACON] TX: %s\n", payload);
@@ -359,6 +905,17 @@ void beacon_mark_transmitted(uint64_t now_ms)
     }
 
     s_beacon_state.last_beacon_ms = (uint32_t)now_ms;
+
+    /* Start a new budget window; the frame just sent counts against it */
+    uint32_t elapsed = s_beacon_state.last_beacon_ms - s_beacon_state.orbit_start_ms;
+    if (elapsed >= s_beacon_state.orbit_period_ms) {
+        s_beacon_state.orbit_start_ms = s_beacon_state.last_beacon_ms;
+        s_beacon_state.orbit_airtime_ms = s_beacon_state.last_airtime_ms;
+    }
+
+    if (plan_next_interval()) {
+        s_beacon_state.budget_deferrals++;
+    }
 }
 
 SmartQsoResult_t beacon_get_state(BeaconState_t *state)
@@ -423,20 +980,7 @@ const char *beacon_get_template(void)
 
 uint16_t beacon_crc16(const uint8_t *data, size_t len)
 {
-    uint16_t crc = CRC16_INIT;
-
-    for (size_t i = 0; i < len; i++) {
-        crc ^= data[i];
-        for (int j = 0; j < 8; j++) {
-            if (crc & 0x0001) {
-                crc = (crc >> 1) ^ CRC16_POLY;
-            } else {
-                crc >>= 1;
-            }
-        }
-    }
-
-    return crc ^ 0xFFFF;
+    return crc16_x25(data, len);
 }
 
 bool beacon_validate_text(const char *text, size_t len)
@@ -495,5 +1039,10 @@ void beacon_reset_stats(void)
     s_beacon_state.ai_beacon_count = 0;
     s_beacon_state.template_count = 0;
     s_beacon_state.total_bytes_tx = 0;
+    s_beacon_state.binary_beacon_count = 0;
+    s_beacon_state.digest_beacon_count = 0;
+    s_beacon_state.useful_bytes_tx = 0;
+    s_beacon_state.total_airtime_ms = 0;
+    s_beacon_state.budget_deferrals = 0;
     s_beacon_state.sequence = 0;
 }
@@ -11,6 +11,7 @@
 #include "cmd_handler.h"
 #include "input_validation.h"
 #include "fault_mgmt.h"
+#include "persistence.h"
 #include "system_state.h"
 #include "safe_string.h"
 #include <stddef.h>
@@ -240,6 +241,7 @@ bool cmd_is_allowed(uint8_t cmd_id)
         switch (cmd_id) {
             case CMD_SYS_GET_STATUS:
             case CMD_SYS_SET_MODE:
+            case CMD_SYS_FLUSH_NVM:
             case CMD_EPS_GET_TELEMETRY:
             case CMD_COMM_SET_BEACON:
                 return true;
@@ -333,6 +335,7 @@ const char *cmd_get_name(uint8_t cmd_id)
         case CMD_SYS_GET_STATUS:  return "GET_STATUS";
         case CMD_SYS_SET_TIME:    return "SET_TIME";
         case CMD_SYS_CLEAR_FAULTS: return "CLEAR_FAULTS";
+        case CMD_SYS_FLUSH_NVM:   return "FLUSH_NVM";
         case CMD_EPS_SET_MODE:    return "EPS_SET_MODE";
         case CMD_EPS_ENABLE_HEATER: return "EPS_ENABLE_HEATER";
         case CMD_EPS_DISABLE_HEATER: return "EPS_DISABLE_HEATER";
@@ -406,6 +409,10 @@ static CmdResult_t handle_system_cmd(const Command_t *cmd, CmdResponse_t *respon
             (void)fault_log_clear();
             return CMD_RESULT_SUCCESS;
 
+        case CMD_SYS_FLUSH_NVM:
+            return (persist_flush_all() == SMART_QSO_OK) ? CMD_RESULT_SUCCESS
+                                                         : CMD_RESULT_EXEC_FAIL;
+
         default:
             return CMD_RESULT_INVALID_CMD;
     }
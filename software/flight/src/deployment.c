@@ -12,6 +12,7 @@
 #include "deployment.h"
 #include "fault_mgmt.h"
 #include "flight_log.h"
+#include "kv_store.h"
 #include "smart_qso.h"
 #include "hal/hal_gpio.h"
 #include "hal/hal_timer.h"
@@ -330,16 +331,28 @@ bool deployment_all_complete(void) {
 bool deployment_save_state(void) {
     s_deploy_status.crc = calculate_crc(&s_deploy_status);
 
-    /* In real implementation, write to FRAM/Flash */
-    /* For simulation, state is kept in RAM */
+    if (kv_put(KV_KEY_DEPLOY_STATUS, DEPLOY_STATUS_SCHEMA_VERSION,
+               &s_deploy_status, sizeof(s_deploy_status)) != SMART_QSO_OK) {
+        LOG_WARNING("DEPLOY", "State save failed");
+        return false;
+    }
+
     LOG_INFO("DEPLOY", "State saved");
     return true;
 }
 
 bool deployment_load_state(void) {
-    /* In real implementation, read from FRAM/Flash and verify CRC */
-    /* For simulation, return false to indicate no saved state */
-    return false;
+    DeploymentStatus_t loaded;
+    size_t len = 0;
+
+    if ((kv_get(KV_KEY_DEPLOY_STATUS, DEPLOY_STATUS_SCHEMA_VERSION,
+                &loaded, sizeof(loaded), &len) != SMART_QSO_OK) ||
+        (len != sizeof(loaded)) || (calculate_crc(&loaded) != loaded.crc)) {
+        return false;
+    }
+
+    s_deploy_status = loaded;
+    return true;
 }
 
 /*===========================================================================*/
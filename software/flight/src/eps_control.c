@@ -9,6 +9,8 @@
 
 #include "eps_control.h"
 #include "fault_mgmt.h"
+#include "kv_store.h"
+#include "persistence.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -112,7 +114,7 @@ SmartQsoResult_t eps_control_payload(bool enable, double soc)
         printf("[EPS] Payload disabled\n");
     }
 
-    (void)eps_save_config();
+    persist_mark_dirty(PERSIST_MODULE_EPS);
     return SMART_QSO_OK;
 }
 
@@ -128,7 +130,7 @@ SmartQsoResult_t eps_control_radio(bool enable)
 
     printf("[EPS] Radio %s\n", enable ? "enabled" : "disabled");
 
-    (void)eps_save_config();
+    persist_mark_dirty(PERSIST_MODULE_EPS);
     return SMART_QSO_OK;
 }
 
@@ -144,7 +146,7 @@ SmartQsoResult_t eps_control_adcs(bool enable)
 
     printf("[EPS] ADCS %s\n", enable ? "enabled" : "disabled");
 
-    (void)eps_save_config();
+    persist_mark_dirty(PERSIST_MODULE_EPS);
     return SMART_QSO_OK;
 }
 
@@ -160,7 +162,7 @@ SmartQsoResult_t eps_control_beacon(bool enable)
 
     printf("[EPS] Beacon %s\n", enable ? "enabled" : "disabled");
 
-    (void)eps_save_config();
+    persist_mark_dirty(PERSIST_MODULE_EPS);
     return SMART_QSO_OK;
 }
 
@@ -212,7 +214,7 @@ SmartQsoResult_t eps_set_power_mode(PowerMode_t mode, double soc)
     }
 
     eps_update_crc();
-    (void)eps_save_config();
+    persist_mark_dirty(PERSIST_MODULE_EPS);
     return SMART_QSO_OK;
 }
 
@@ -233,41 +235,24 @@ double eps_get_power_limit(void)
 
 SmartQsoResult_t eps_save_config(void)
 {
-    FILE *f = fopen(EPS_CONFIG_FILE, "wb");
-    if (f == NULL) {
-        return SMART_QSO_ERROR_IO;
-    }
-
     eps_update_crc();
-    size_t written = fwrite(&s_eps_state, sizeof(EpsControlState_t), 1, f);
-
-    if (fclose(f) != 0) {
-        return SMART_QSO_ERROR_IO;
-    }
-
-    if (written != 1) {
-        return SMART_QSO_ERROR_IO;
-    }
-
-    return SMART_QSO_OK;
+    return kv_put(KV_KEY_EPS_CONFIG, EPS_CONFIG_SCHEMA_VERSION,
+                  &s_eps_state, sizeof(EpsControlState_t));
 }
 
 SmartQsoResult_t eps_load_config(void)
 {
-    FILE *f = fopen(EPS_CONFIG_FILE, "rb");
-    if (f == NULL) {
-        return SMART_QSO_ERROR_IO;
-    }
-
     EpsControlState_t loaded_state;
-    size_t read_count = fread(&loaded_state, sizeof(EpsControlState_t), 1, f);
+    size_t len = 0;
 
-    if (fclose(f) != 0) {
-        return SMART_QSO_ERROR_IO;
+    SmartQsoResult_t result = kv_get(KV_KEY_EPS_CONFIG, EPS_CONFIG_SCHEMA_VERSION,
+                                     &loaded_state, sizeof(loaded_state), &len);
+    if (result != SMART_QSO_OK) {
+        return result;
     }
 
-    if (read_count != 1) {
-        return SMART_QSO_ERROR_IO;
+    if (len != sizeof(EpsControlState_t)) {
+        return SMART_QSO_ERROR_INVALID;
     }
 
     /* Verify CRC */
@@ -275,7 +260,7 @@ SmartQsoResult_t eps_load_config(void)
     uint32_t calculated_crc = smart_qso_crc32(&loaded_state, crc_offset);
 
     if (calculated_crc != loaded_state.crc32) {
-        printf("[EPS] CRC mismatch in config file, using defaults\n");
+        printf("[EPS] CRC mismatch in config, using defaults\n");
         return SMART_QSO_ERROR;
     }
 
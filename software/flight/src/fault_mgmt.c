@@ -9,6 +9,8 @@
 
 #include "fault_mgmt.h"
 #include "eps_control.h"
+#include "kv_store.h"
+#include "persistence.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -16,12 +18,26 @@
 /* Module State                                                               */
 /*===========================================================================*/
 
-/** Fault log buffer (module-private) */
+/**
+ * Fault log ring (module-private). Entry i (0 = oldest) lives at ring
+ * position (head + i) % SMART_QSO_MAX_FAULT_ENTRIES; the same position
+ * keys its persisted record, so adding a fault moves nothing and writes
+ * one entry.
+ */
 static FaultLogEntry_t s_fault_log[SMART_QSO_MAX_FAULT_ENTRIES];
 
 /** Current number of entries in fault log */
 static size_t s_fault_log_count = 0;
 
+/** Ring position the next entry is written at (tail) */
+static size_t s_fault_log_next = 0;
+
+/** Ring positions changed since the last flush (bit per position) */
+static uint8_t s_fault_log_pending[(SMART_QSO_MAX_FAULT_ENTRIES + 7U) / 8U];
+
+/** Ring position or length changed since the last flush */
+static bool s_fault_index_pending = false;
+
 /** Flag indicating watchdog was triggered */
 static bool s_watchdog_triggered = false;
 
@@ -42,6 +58,70 @@ static uint32_t fault_entry_crc(const FaultLogEntry_t *entry)
     return smart_qso_crc32(entry, crc_offset);
 }
 
+/**
+ * @brief Persisted ring position and length of the log
+ */
+typedef struct {
+    uint16_t next;      /**< Ring position of the next entry */
+    uint16_t count;     /**< Entries persisted */
+} FaultLogIndex_t;
+
+/**
+ * @brief Ring position of the oldest entry (head)
+ */
+static size_t fault_log_head(void)
+{
+    return (s_fault_log_next + SMART_QSO_MAX_FAULT_ENTRIES - s_fault_log_count) %
+           SMART_QSO_MAX_FAULT_ENTRIES;
+}
+
+/**
+ * @brief Ring position of log entry index (0 = oldest)
+ */
+static size_t fault_entry_slot(size_t index)
+{
+    return (fault_log_head() + index) % SMART_QSO_MAX_FAULT_ENTRIES;
+}
+
+/**
+ * @brief Persist the entry at a ring position
+ */
+static SmartQsoResult_t fault_slot_save(size_t slot)
+{
+    return kv_put(KV_KEY_FAULT_ENTRY(slot), FAULT_LOG_SCHEMA_VERSION,
+                  &s_fault_log[slot], sizeof(FaultLogEntry_t));
+}
+
+/**
+ * @brief Persist the ring position and length
+ */
+static SmartQsoResult_t fault_index_save(void)
+{
+    FaultLogIndex_t index = {
+        .next = (uint16_t)s_fault_log_next,
+        .count = (uint16_t)s_fault_log_count,
+    };
+    return kv_put(KV_KEY_FAULT_INDEX, FAULT_LOG_SCHEMA_VERSION, &index, sizeof(index));
+}
+
+/**
+ * @brief Queue a ring position for the next flush
+ */
+static void fault_slot_mark_pending(size_t slot)
+{
+    s_fault_log_pending[slot / 8U] |= (uint8_t)(1U << (slot % 8U));
+    persist_mark_dirty(PERSIST_MODULE_FAULT_LOG);
+}
+
+/**
+ * @brief Forget queued writes (log saved in full or cleared)
+ */
+static void fault_pending_clear(void)
+{
+    memset(s_fault_log_pending, 0, sizeof(s_fault_log_pending));
+    s_fault_index_pending = false;
+}
+
 /*===========================================================================*/
 /* Public API Implementation                                                  */
 /*===========================================================================*/
@@ -51,6 +131,8 @@ SmartQsoResult_t fault_mgmt_init(void)
     /* Clear log on init - will be populated from persistent storage if available */
     memset(s_fault_log, 0, sizeof(s_fault_log));
     s_fault_log_count = 0;
+    s_fault_log_next = 0;
+    fault_pending_clear();
     s_watchdog_triggered = false;
 
     /* Try to load from persistent storage */
@@ -71,16 +153,9 @@ SmartQsoResult_t fault_log_add(FaultType_t fault_type, FaultSeverity_t severity,
     SMART_QSO_REQUIRE(severity >= FAULT_SEVERITY_INFO &&
                       severity <= FAULT_SEVERITY_CRITICAL, "Invalid severity");
 
-    /* Make room if log is full */
-    if (s_fault_log_count >= SMART_QSO_MAX_FAULT_ENTRIES) {
-        /* Shift entries to make room (lose oldest entry) */
-        memmove(&s_fault_log[0], &s_fault_log[1],
-                sizeof(FaultLogEntry_t) * (SMART_QSO_MAX_FAULT_ENTRIES - 1));
-        s_fault_log_count = SMART_QSO_MAX_FAULT_ENTRIES - 1;
-    }
-
-    /* Add new entry */
-    FaultLogEntry_t *entry = &s_fault_log[s_fault_log_count];
+    /* Add new entry at the tail; when full this overwrites the oldest */
+    size_t slot = s_fault_log_next;
+    FaultLogEntry_t *entry = &s_fault_log[slot];
     entry->timestamp_ms = smart_qso_now_ms();
     entry->fault_type = (uint8_t)fault_type;
     entry->severity = (uint8_t)severity;
@@ -92,14 +167,18 @@ SmartQsoResult_t fault_log_add(FaultType_t fault_type, FaultSeverity_t severity,
     entry->description[SMART_QSO_FAULT_DESC_LEN - 1] = '\0';
 
     entry->crc32 = fault_entry_crc(entry);
-    s_fault_log_count++;
+    s_fault_log_next = (slot + 1U) % SMART_QSO_MAX_FAULT_ENTRIES;
+    if (s_fault_log_count < SMART_QSO_MAX_FAULT_ENTRIES) {
+        s_fault_log_count++;
+    }
 
     /* Print fault message */
     printf("[FAULT] Type=%d Severity=%d: %s\n",
            fault_type, severity, description);
 
-    /* Save to persistent storage */
-    (void)fault_log_save();
+    /* Queue the new entry; the persistence service writes it later */
+    s_fault_index_pending = true;
+    fault_slot_mark_pending(slot);
 
     return SMART_QSO_OK;
 }
@@ -114,7 +193,7 @@ SmartQsoResult_t fault_log_get_entry(size_t index, FaultLogEntry_t *entry)
     SMART_QSO_REQUIRE_NOT_NULL(entry);
     SMART_QSO_REQUIRE(index < s_fault_log_count, "Index out of range");
 
-    *entry = s_fault_log[index];
+    *entry = s_fault_log[fault_entry_slot(index)];
     return SMART_QSO_OK;
 }
 
@@ -126,7 +205,7 @@ SmartQsoResult_t fault_log_get_last(FaultLogEntry_t *entry)
         return SMART_QSO_ERROR;
     }
 
-    *entry = s_fault_log[s_fault_log_count - 1];
+    *entry = s_fault_log[fault_entry_slot(s_fault_log_count - 1U)];
     return SMART_QSO_OK;
 }
 
@@ -134,62 +213,110 @@ SmartQsoResult_t fault_log_mark_recovered(size_t index)
 {
     SMART_QSO_REQUIRE(index < s_fault_log_count, "Index out of range");
 
-    s_fault_log[index].recovered = true;
-    s_fault_log[index].crc32 = fault_entry_crc(&s_fault_log[index]);
+    size_t slot = fault_entry_slot(index);
+    s_fault_log[slot].recovered = true;
+    s_fault_log[slot].crc32 = fault_entry_crc(&s_fault_log[slot]);
+    fault_slot_mark_pending(slot);
 
-    return fault_log_save();
+    return SMART_QSO_OK;
 }
 
-SmartQsoResult_t fault_log_save(void)
+SmartQsoResult_t fault_log_flush(void)
 {
-    FILE *f = fopen(FAULT_LOG_FILE, "wb");
-    if (f == NULL) {
-        return SMART_QSO_ERROR_IO;
+    /* Entries first, then the index that makes new ones visible */
+    for (size_t slot = 0; slot < SMART_QSO_MAX_FAULT_ENTRIES; slot++) {
+        uint8_t bit = (uint8_t)(1U << (slot % 8U));
+
+        if ((s_fault_log_pending[slot / 8U] & bit) != 0U) {
+            SmartQsoResult_t result = fault_slot_save(slot);
+            if (result != SMART_QSO_OK) {
+                return result;
+            }
+            s_fault_log_pending[slot / 8U] &= (uint8_t)~bit;
+        }
     }
 
-    size_t written = fwrite(s_fault_log, sizeof(FaultLogEntry_t),
-                            s_fault_log_count, f);
-
-    if (fclose(f) != 0) {
-        return SMART_QSO_ERROR_IO;
+    if (s_fault_index_pending) {
+        SmartQsoResult_t result = fault_index_save();
+        if (result != SMART_QSO_OK) {
+            return result;
+        }
+        s_fault_index_pending = false;
     }
 
-    if (written != s_fault_log_count) {
-        return SMART_QSO_ERROR_IO;
+    return SMART_QSO_OK;
+}
+
+SmartQsoResult_t fault_log_save(void)
+{
+    for (size_t i = 0; i < s_fault_log_count; i++) {
+        SmartQsoResult_t result = fault_slot_save(fault_entry_slot(i));
+        if (result != SMART_QSO_OK) {
+            return result;
+        }
     }
 
-    return SMART_QSO_OK;
+    SmartQsoResult_t result = fault_index_save();
+    if (result == SMART_QSO_OK) {
+        fault_pending_clear();
+    }
+    return result;
 }
 
 SmartQsoResult_t fault_log_load(void)
 {
-    FILE *f = fopen(FAULT_LOG_FILE, "rb");
-    if (f == NULL) {
-        return SMART_QSO_ERROR_IO;
-    }
+    FaultLogIndex_t index;
+    size_t len = 0;
 
-    s_fault_log_count = fread(s_fault_log, sizeof(FaultLogEntry_t),
-                               SMART_QSO_MAX_FAULT_ENTRIES, f);
+    SmartQsoResult_t result = kv_get(KV_KEY_FAULT_INDEX, FAULT_LOG_SCHEMA_VERSION,
+                                     &index, sizeof(index), &len);
+    if (result != SMART_QSO_OK) {
+        return result;
+    }
 
-    if (fclose(f) != 0) {
-        s_fault_log_count = 0;
-        return SMART_QSO_ERROR_IO;
+    if ((len != sizeof(index)) || (index.next >= SMART_QSO_MAX_FAULT_ENTRIES) ||
+        (index.count > SMART_QSO_MAX_FAULT_ENTRIES)) {
+        return SMART_QSO_ERROR_INVALID;
     }
 
-    /* Verify CRC of each entry */
+    s_fault_log_next = index.next;
+    s_fault_log_count = index.count;
+
+    /* Read and verify CRC of each entry into its ring position */
+    uint8_t valid[(SMART_QSO_MAX_FAULT_ENTRIES + 7U) / 8U];
     size_t valid_count = 0;
+    memset(valid, 0, sizeof(valid));
+
     for (size_t i = 0; i < s_fault_log_count; i++) {
-        uint32_t expected_crc = fault_entry_crc(&s_fault_log[i]);
-        if (expected_crc == s_fault_log[i].crc32) {
-            if (valid_count != i) {
-                s_fault_log[valid_count] = s_fault_log[i];
-            }
+        size_t slot = fault_entry_slot(i);
+        FaultLogEntry_t *entry = &s_fault_log[slot];
+        len = 0;
+
+        if ((kv_get(KV_KEY_FAULT_ENTRY(slot), FAULT_LOG_SCHEMA_VERSION,
+                    entry, sizeof(*entry), &len) == SMART_QSO_OK) &&
+            (len == sizeof(*entry)) && (fault_entry_crc(entry) == entry->crc32)) {
+            valid[i / 8U] |= (uint8_t)(1U << (i % 8U));
             valid_count++;
         } else {
             printf("[FAULT] Discarded corrupt entry %zu\n", i);
         }
     }
-    s_fault_log_count = valid_count;
+
+    if (valid_count != s_fault_log_count) {
+        /* Close the gaps in ring order and re-persist the packed ring */
+        size_t head = fault_log_head();
+        size_t kept = 0;
+        for (size_t i = 0; i < s_fault_log_count; i++) {
+            if ((valid[i / 8U] & (1U << (i % 8U))) != 0U) {
+                s_fault_log[(head + kept) % SMART_QSO_MAX_FAULT_ENTRIES] =
+                    s_fault_log[(head + i) % SMART_QSO_MAX_FAULT_ENTRIES];
+                kept++;
+            }
+        }
+        s_fault_log_count = kept;
+        s_fault_log_next = (head + kept) % SMART_QSO_MAX_FAULT_ENTRIES;
+        (void)fault_log_save();
+    }
 
     return SMART_QSO_OK;
 }
@@ -198,9 +325,14 @@ SmartQsoResult_t fault_log_clear(void)
 {
     memset(s_fault_log, 0, sizeof(s_fault_log));
     s_fault_log_count = 0;
+    s_fault_log_next = 0;
+    fault_pending_clear();
 
-    /* Remove persistent file */
-    (void)remove(FAULT_LOG_FILE);
+    /* Remove persistent entries */
+    for (size_t i = 0; i < SMART_QSO_MAX_FAULT_ENTRIES; i++) {
+        (void)kv_delete(KV_KEY_FAULT_ENTRY(i));
+    }
+    (void)kv_delete(KV_KEY_FAULT_INDEX);
 
     return SMART_QSO_OK;
 }
@@ -0,0 +1,506 @@
+/**
+ * @file fec.c
+ * @brief Reed-Solomon FEC, FX.25 and telemetry block coding
+ *
+ * RS(255,223) with table-driven GF(2^8) arithmetic. The encoder is the
+ * usual systematic LFSR; the decoder computes 32 syndromes, finds the
+ * error locator with Berlekamp-Massey, locates errors with a Chien
+ * search limited to the (possibly shortened) block, and fixes them with
+ * Forney's formula.
+ *
+ * @requirement SRS-DATA-002 System shall protect data integrity with CRC
+ */
+
+#include "fec.h"
+#include "ax25.h"
+
+#include <string.h>
+
+/*===========================================================================*/
+/* GF(2^8) Tables (pre-computed for field polynomial 0x11D)                  */
+/*===========================================================================*/
+
+/** alpha^i, i = 0..254 (entry 255 wraps to alpha^0) */
+static const uint8_t s_gf_exp[256] = {
+    0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1D, 0x3A, 0x74, 0xE8,
+    0xCD, 0x87, 0x13, 0x26, 0x4C, 0x98, 0x2D, 0x5A, 0xB4, 0x75, 0xEA, 0xC9,
+    0x8F, 0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0xC0, 0x9D, 0x27, 0x4E, 0x9C,
+    0x25, 0x4A, 0x94, 0x35, 0x6A, 0xD4, 0xB5, 0x77, 0xEE, 0xC1, 0x9F, 0x23,
+    0x46, 0x8C, 0x05, 0x0A, 0x14, 0x28, 0x50, 0xA0, 0x5D, 0xBA, 0x69, 0xD2,
+    0xB9, 0x6F, 0xDE, 0xA1, 0x5F, 0xBE, 0x61, 0xC2, 0x99, 0x2F, 0x5E, 0xBC,
+    0x65, 0xCA, 0x89, 0x0F, 0x1E, 0x3C, 0x78, 0xF0, 0xFD, 0xE7, 0xD3, 0xBB,
+    0x6B, 0xD6, 0xB1, 0x7F, 0xFE, 0xE1, 0xDF, 0xA3, 0x5B, 0xB6, 0x71, 0xE2,
+    0xD9, 0xAF, 0x43, 0x86, 0x11, 0x22, 0x44, 0x88, 0x0D, 0x1A, 0x34, 0x68,
+    0xD0, 0xBD, 0x67, 0xCE, 0x81, 0x1F, 0x3E, 0x7C, 0xF8, 0xED, 0xC7, 0x93,
+    0x3B, 0x76, 0xEC, 0xC5, 0x97, 0x33, 0x66, 0xCC, 0x85, 0x17, 0x2E, 0x5C,
+    0xB8, 0x6D, 0xDA, 0xA9, 0x4F, 0x9E, 0x21, 0x42, 0x84, 0x15, 0x2A, 0x54,
+    0xA8, 0x4D, 0x9A, 0x29, 0x52, 0xA4, 0x55, 0xAA, 0x49, 0x92, 0x39, 0x72,
+    0xE4, 0xD5, 0xB7, 0x73, 0xE6, 0xD1, 0xBF, 0x63, 0xC6, 0x91, 0x3F, 0x7E,
+    0xFC, 0xE5, 0xD7, 0xB3, 0x7B, 0xF6, 0xF1, 0xFF, 0xE3, 0xDB, 0xAB, 0x4B,
+    0x96, 0x31, 0x62, 0xC4, 0x95, 0x37, 0x6E, 0xDC, 0xA5, 0x57, 0xAE, 0x41,
+    0x82, 0x19, 0x32, 0x64, 0xC8, 0x8D, 0x07, 0x0E, 0x1C, 0x38, 0x70, 0xE0,
+    0xDD, 0xA7, 0x53, 0xA6, 0x51, 0xA2, 0x59, 0xB2, 0x79, 0xF2, 0xF9, 0xEF,
+    0xC3, 0x9B, 0x2B, 0x56, 0xAC, 0x45, 0x8A, 0x09, 0x12, 0x24, 0x48, 0x90,
+    0x3D, 0x7A, 0xF4, 0xF5, 0xF7, 0xF3, 0xFB, 0xEB, 0xCB, 0x8B, 0x0B, 0x16,
+    0x2C, 0x58, 0xB0, 0x7D, 0xFA, 0xE9, 0xCF, 0x83, 0x1B, 0x36, 0x6C, 0xD8,
+    0xAD, 0x47, 0x8E, 0x01
+};
+
+/** log_alpha(x), x = 1..255 (entry 0 unused) */
+static const uint8_t s_gf_log[256] = {
+    0x00, 0x00, 0x01, 0x19, 0x02, 0x32, 0x1A, 0xC6, 0x03, 0xDF, 0x33, 0xEE,
+    0x1B, 0x68, 0xC7, 0x4B, 0x04, 0x64, 0xE0, 0x0E, 0x34, 0x8D, 0xEF, 0x81,
+    0x1C, 0xC1, 0x69, 0xF8, 0xC8, 0x08, 0x4C, 0x71, 0x05, 0x8A, 0x65, 0x2F,
+    0xE1, 0x24, 0x0F, 0x21, 0x35, 0x93, 0x8E, 0xDA, 0xF0, 0x12, 0x82, 0x45,
+    0x1D, 0xB5, 0xC2, 0x7D, 0x6A, 0x27, 0xF9, 0xB9, 0xC9, 0x9A, 0x09, 0x78,
+    0x4D, 0xE4, 0x72, 0xA6, 0x06, 0xBF, 0x8B, 0x62, 0x66, 0xDD, 0x30, 0xFD,
+    0xE2, 0x98, 0x25, 0xB3, 0x10, 0x91, 0x22, 0x88, 0x36, 0xD0, 0x94, 0xCE,
+    0x8F, 0x96, 0xDB, 0xBD, 0xF1, 0xD2, 0x13, 0x5C, 0x83, 0x38, 0x46, 0x40,
+    0x1E, 0x42, 0xB6, 0xA3, 0xC3, 0x48, 0x7E, 0x6E, 0x6B, 0x3A, 0x28, 0x54,
+    0xFA, 0x85, 0xBA, 0x3D, 0xCA, 0x5E, 0x9B, 0x9F, 0x0A, 0x15, 0x79, 0x2B,
+    0x4E, 0xD4, 0xE5, 0xAC, 0x73, 0xF3, 0xA7, 0x57, 0x07, 0x70, 0xC0, 0xF7,
+    0x8C, 0x80, 0x63, 0x0D, 0x67, 0x4A, 0xDE, 0xED, 0x31, 0xC5, 0xFE, 0x18,
+    0xE3, 0xA5, 0x99, 0x77, 0x26, 0xB8, 0xB4, 0x7C, 0x11, 0x44, 0x92, 0xD9,
+    0x23, 0x20, 0x89, 0x2E, 0x37, 0x3F, 0xD1, 0x5B, 0x95, 0xBC, 0xCF, 0xCD,
+    0x90, 0x87, 0x97, 0xB2, 0xDC, 0xFC, 0xBE, 0x61, 0xF2, 0x56, 0xD3, 0xAB,
+    0x14, 0x2A, 0x5D, 0x9E, 0x84, 0x3C, 0x39, 0x53, 0x47, 0x6D, 0x41, 0xA2,
+    0x1F, 0x2D, 0x43, 0xD8, 0xB7, 0x7B, 0xA4, 0x76, 0xC4, 0x17, 0x49, 0xEC,
+    0x7F, 0x0C, 0x6F, 0xF6, 0x6C, 0xA1, 0x3B, 0x52, 0x29, 0x9D, 0x55, 0xAA,
+    0xFB, 0x60, 0x86, 0xB1, 0xBB, 0xCC, 0x3E, 0x5A, 0xCB, 0x59, 0x5F, 0xB0,
+    0x9C, 0xA9, 0xA0, 0x51, 0x0B, 0xF5, 0x16, 0xEB, 0x7A, 0x75, 0x2C, 0xD7,
+    0x4F, 0xAE, 0xD5, 0xE9, 0xE6, 0xE7, 0xAD, 0xE8, 0x74, 0xD6, 0xF4, 0xEA,
+    0xA8, 0x50, 0x58, 0xAF
+};
+
+/** Generator polynomial prod(x - alpha^i), i = 1..32; entry i is the x^i coefficient */
+static const uint8_t s_rs_gen[FEC_RS_PARITY + 1U] = {
+    0x2D, 0xD8, 0xEF, 0x18, 0xFD, 0x68, 0x1B, 0x28, 0x6B, 0x32, 0xA3,
+    0xD2, 0xE3, 0x86, 0xE0, 0x9E, 0x77, 0x0D, 0x9E, 0x01, 0xEE, 0xA4,
+    0x52, 0x2B, 0x0F, 0xE8, 0xF6, 0x8E, 0x32, 0xBD, 0x1D, 0xE8, 0x01
+};
+
+/*===========================================================================*/
+/* FX.25 Correlation Tags                                                     */
+/*===========================================================================*/
+
+/**
+ * @brief FX.25 codeword mode (RS(255,223) family, 32 check bytes)
+ */
+typedef struct {
+    uint64_t tag;    /**< Correlation tag */
+    uint8_t  n;      /**< Codeword length */
+    uint8_t  k;      /**< Data bytes */
+} Fx25Mode_t;
+
+/** Modes in ascending size, so the first that fits is the shortest */
+static const Fx25Mode_t s_fx25_modes[] = {
+    { 0xDBF869BD2DBB1776ULL,  64U,  32U },   /* Tag_08 */
+    { 0x1EB7B9CDBC09C00EULL,  96U,  64U },   /* Tag_07 */
+    { 0xFF94DC634F1CFF4EULL, 160U, 128U },   /* Tag_06 */
+    { 0x6E260B1AC5835FAEULL, 255U, 223U }    /* Tag_05 */
+};
+
+#define FX25_MODE_COUNT  (sizeof(s_fx25_modes) / sizeof(s_fx25_modes[0]))
+
+/*===========================================================================*/
+/* GF(2^8) Arithmetic                                                         */
+/*===========================================================================*/
+
+static uint8_t gf_mul(uint8_t a, uint8_t b)
+{
+    if (a == 0U || b == 0U) {
+        return 0U;
+    }
+    return s_gf_exp[((uint32_t)s_gf_log[a] + s_gf_log[b]) % 255U];
+}
+
+static uint8_t gf_div(uint8_t a, uint8_t b)
+{
+    if (a == 0U) {
+        return 0U;
+    }
+    return s_gf_exp[((uint32_t)s_gf_log[a] + 255U - s_gf_log[b]) % 255U];
+}
+
+/**
+ * @brief Evaluate a low-order-first polynomial at alpha^e
+ */
+static uint8_t poly_eval(const uint8_t *poly, size_t degree, uint32_t e)
+{
+    uint8_t sum = 0U;
+    for (size_t i = 0; i <= degree; i++) {
+        sum ^= gf_mul(poly[i], s_gf_exp[(e * (uint32_t)i) % 255U]);
+    }
+    return sum;
+}
+
+/*===========================================================================*/
+/* Reed-Solomon                                                               */
+/*===========================================================================*/
+
+SmartQsoResult_t fec_rs_encode(const uint8_t *data, size_t data_len,
+                               uint8_t *parity)
+{
+    if (data == NULL || parity == NULL) {
+        return SMART_QSO_ERROR_NULL_PTR;
+    }
+    if (data_len == 0U || data_len > FEC_RS_K) {
+        return SMART_QSO_ERROR_INVALID;
+    }
+
+    /* Remainder register, highest degree first */
+    uint8_t rem[FEC_RS_PARITY];
+    memset(rem, 0, sizeof(rem));
+
+    for (size_t i = 0; i < data_len; i++) {
+        uint8_t feedback = (uint8_t)(data[i] ^ rem[0]);
+        memmove(rem, rem + 1, FEC_RS_PARITY - 1U);
+        rem[FEC_RS_PARITY - 1U] = 0U;
+        if (feedback != 0U) {
+            for (size_t j = 0; j < FEC_RS_PARITY; j++) {
+                rem[j] ^= gf_mul(feedback, s_rs_gen[FEC_RS_PARITY - 1U - j]);
+            }
+        }
+    }
+
+    memcpy(parity, rem, FEC_RS_PARITY);
+    return SMART_QSO_OK;
+}
+
+SmartQsoResult_t fec_rs_decode(uint8_t *block, size_t block_len,
+                               size_t *corrected)
+{
+    if (block == NULL) {
+        return SMART_QSO_ERROR_NULL_PTR;
+    }
+    if (block_len <= FEC_RS_PARITY || block_len > FEC_RS_N) {
+        return SMART_QSO_ERROR_INVALID;
+    }
+    if (corrected != NULL) {
+        *corrected = 0U;
+    }
+
+    /* Syndromes S_i = r(alpha^(i+1)); block[0] is the highest degree */
+    uint8_t synd[FEC_RS_PARITY];
+    bool clean = true;
+    for (size_t i = 0; i < FEC_RS_PARITY; i++) {
+        uint8_t root = s_gf_exp[i + 1U];
+        uint8_t s = 0U;
+        for (size_t k = 0; k < block_len; k++) {
+            s = (uint8_t)(gf_mul(s, root) ^ block[k]);
+        }
+        synd[i] = s;
+        if (s != 0U) {
+            clean = false;
+        }
+    }
+    if (clean) {
+        return SMART_QSO_OK;
+    }
+
+    /* Berlekamp-Massey: error locator lambda(x), low order first */
+    uint8_t lambda[FEC_RS_PARITY + 1U];
+    uint8_t prev[FEC_RS_PARITY + 1U];
+    uint8_t saved[FEC_RS_PARITY + 1U];
+    memset(lambda, 0, sizeof(lambda));
+    memset(prev, 0, sizeof(prev));
+    lambda[0] = 1U;
+    prev[0] = 1U;
+
+    size_t errors = 0U;
+    size_t shift = 1U;
+    uint8_t last_disc = 1U;
+
+    for (size_t n = 0; n < FEC_RS_PARITY; n++) {
+        uint8_t disc = synd[n];
+        for (size_t i = 1; i <= errors; i++) {
+            disc ^= gf_mul(lambda[i], synd[n - i]);
+        }
+
+        if (disc == 0U) {
+            shift++;
+            continue;
+        }
+
+        uint8_t coef = gf_div(disc, last_disc);
+        bool grow = (2U * errors) <= n;
+        if (grow) {
+            memcpy(saved, lambda, sizeof(lambda));
+        }
+        for (size_t i = 0; (i + shift) <= FEC_RS_PARITY; i++) {
+            lambda[i + shift] ^= gf_mul(coef, prev[i]);
+        }
+        if (grow) {
+            errors = n + 1U - errors;
+            memcpy(prev, saved, sizeof(prev));
+            last_disc = disc;
+            shift = 1U;
+        } else {
+            shift++;
+        }
+    }
+
+    if (errors > FEC_RS_MAX_CORRECT) {
+        return SMART_QSO_ERROR;
+    }
+
+    /* Error evaluator omega(x) = S(x) lambda(x) mod x^32 */
+    uint8_t omega[FEC_RS_PARITY];
+    for (size_t i = 0; i < FEC_RS_PARITY; i++) {
+        uint8_t sum = 0U;
+        for (size_t j = 0; j <= i && j <= errors; j++) {
+            sum ^= gf_mul(synd[i - j], lambda[j]);
+        }
+        omega[i] = sum;
+    }
+
+    /* Chien search over the real (unshortened) positions, then Forney */
+    size_t positions[FEC_RS_MAX_CORRECT];
+    uint8_t values[FEC_RS_MAX_CORRECT];
+    size_t found = 0U;
+
+    for (size_t k = 0; k < block_len; k++) {
+        uint32_t inv = (255U - (uint32_t)(block_len - 1U - k)) % 255U;
+        if (poly_eval(lambda, errors, inv) != 0U) {
+            continue;
+        }
+        if (found == errors) {
+            return SMART_QSO_ERROR;
+        }
+
+        /* lambda'(x): odd-degree terms only in characteristic 2 */
+        uint8_t deriv = 0U;
+        for (size_t i = 1; i <= errors; i += 2U) {
+            deriv ^= gf_mul(lambda[i], s_gf_exp[(inv * (uint32_t)(i - 1U)) % 255U]);
+        }
+        if (deriv == 0U) {
+            return SMART_QSO_ERROR;
+        }
+
+        positions[found] = k;
+        values[found] = gf_div(poly_eval(omega, FEC_RS_PARITY - 1U, inv), deriv);
+        found++;
+    }
+
+    /* Every root must lie inside the block */
+    if (found != errors) {
+        return SMART_QSO_ERROR;
+    }
+
+    for (size_t i = 0; i < found; i++) {
+        block[positions[i]] ^= values[i];
+    }
+    if (corrected != NULL) {
+        *corrected = found;
+    }
+
+    return SMART_QSO_OK;
+}
+
+/*===========================================================================*/
+/* FX.25                                                                      */
+/*===========================================================================*/
+
+static unsigned int popcount64(uint64_t value)
+{
+    unsigned int count = 0U;
+    while (value != 0U) {
+        value &= value - 1U;
+        count++;
+    }
+    return count;
+}
+
+SmartQsoResult_t fx25_encode(const uint8_t *stream, size_t stream_bits,
+                             uint8_t *out, size_t out_len, size_t *written)
+{
+    if (stream == NULL || out == NULL || written == NULL) {
+        return SMART_QSO_ERROR_NULL_PTR;
+    }
+
+    *written = 0U;
+
+    size_t stream_len = (stream_bits + 7U) / 8U;
+    if (stream_bits == 0U || stream_len > FX25_MAX_DATA_LEN) {
+        return SMART_QSO_ERROR_INVALID;
+    }
+
+    const Fx25Mode_t *mode = &s_fx25_modes[FX25_MODE_COUNT - 1U];
+    for (size_t i = 0; i < FX25_MODE_COUNT; i++) {
+        if (s_fx25_modes[i].k >= stream_len) {
+            mode = &s_fx25_modes[i];
+            break;
+        }
+    }
+
+    size_t total = FX25_TAG_LEN + mode->n;
+    if (out_len < total) {
+        return SMART_QSO_ERROR_NO_MEM;
+    }
+
+    for (size_t i = 0; i < FX25_TAG_LEN; i++) {
+        out[i] = (uint8_t)(mode->tag >> (8U * i));
+    }
+
+    /* Stream, then idle flags continuing from the closing flag */
+    uint8_t *data = out + FX25_TAG_LEN;
+    memcpy(data, stream, stream_len);
+    for (size_t bit = stream_bits; bit < (size_t)mode->k * 8U; bit++) {
+        uint8_t mask = (uint8_t)(1U << (bit & 7U));
+        if (((AX25_FLAG >> ((bit - stream_bits) & 7U)) & 1U) != 0U) {
+            data[bit >> 3] |= mask;
+        } else {
+            data[bit >> 3] &= (uint8_t)~mask;
+        }
+    }
+
+    SmartQsoResult_t result = fec_rs_encode(data, mode->k, data + mode->k);
+    if (result != SMART_QSO_OK) {
+        return result;
+    }
+
+    *written = total;
+    return SMART_QSO_OK;
+}
+
+SmartQsoResult_t fx25_decode(const uint8_t *in, size_t in_len,
+                             uint8_t *data, size_t *data_len,
+                             size_t *corrected)
+{
+    if (in == NULL || data == NULL || data_len == NULL) {
+        return SMART_QSO_ERROR_NULL_PTR;
+    }
+    if (in_len < FX25_TAG_LEN) {
+        return SMART_QSO_ERROR_INVALID;
+    }
+
+    uint64_t tag = 0U;
+    for (size_t i = 0; i < FX25_TAG_LEN; i++) {
+        tag |= (uint64_t)in[i] << (8U * i);
+    }
+
+    /* Closest tag within tolerance */
+    const Fx25Mode_t *mode = NULL;
+    unsigned int best = FX25_TAG_MAX_ERRORS + 1U;
+    for (size_t i = 0; i < FX25_MODE_COUNT; i++) {
+        unsigned int distance = popcount64(tag ^ s_fx25_modes[i].tag);
+        if (distance < best) {
+            best = distance;
+            mode = &s_fx25_modes[i];
+        }
+    }
+    if (mode == NULL || in_len < FX25_TAG_LEN + mode->n) {
+        return SMART_QSO_ERROR_INVALID;
+    }
+    if (*data_len < mode->k) {
+        return SMART_QSO_ERROR_NO_MEM;
+    }
+
+    uint8_t block[FEC_RS_N];
+    memcpy(block, in + FX25_TAG_LEN, mode->n);
+
+    SmartQsoResult_t result = fec_rs_decode(block, mode->n, corrected);
+    if (result != SMART_QSO_OK) {
+        return result;
+    }
+
+    memcpy(data, block, mode->k);
+    *data_len = mode->k;
+    return SMART_QSO_OK;
+}
+
+/*===========================================================================*/
+/* Telemetry Framing                                                          */
+/*===========================================================================*/
+
+/**
+ * @brief Data bytes in codeword index of a body split evenly into blocks
+ */
+static size_t tlm_block_len(size_t body, size_t blocks, size_t index)
+{
+    return (body / blocks) + ((index < (body % blocks)) ? 1U : 0U);
+}
+
+SmartQsoResult_t fec_tlm_encode(const uint8_t *frame, size_t frame_len,
+                                uint8_t *out, size_t out_len, size_t *written)
+{
+    if (frame == NULL || out == NULL || written == NULL) {
+        return SMART_QSO_ERROR_NULL_PTR;
+    }
+
+    *written = 0U;
+
+    if (frame_len <= FEC_TLM_SYNC_LEN) {
+        return SMART_QSO_ERROR_INVALID;
+    }
+
+    size_t body = frame_len - FEC_TLM_SYNC_LEN;
+    size_t blocks = FEC_TLM_BLOCKS(frame_len);
+    size_t total = FEC_TLM_CODED_LEN(frame_len);
+    if (out_len < total) {
+        return SMART_QSO_ERROR_NO_MEM;
+    }
+
+    memcpy(out, frame, FEC_TLM_SYNC_LEN);
+    size_t src = FEC_TLM_SYNC_LEN;
+    size_t dst = FEC_TLM_SYNC_LEN;
+
+    for (size_t b = 0; b < blocks; b++) {
+        size_t len = tlm_block_len(body, blocks, b);
+        memcpy(out + dst, frame + src, len);
+        (void)fec_rs_encode(out + dst, len, out + dst + len);
+        src += len;
+        dst += len + FEC_RS_PARITY;
+    }
+
+    *written = total;
+    return SMART_QSO_OK;
+}
+
+SmartQsoResult_t fec_tlm_decode(uint8_t *coded, size_t coded_len,
+                                uint8_t *frame, size_t *frame_len,
+                                size_t *corrected)
+{
+    if (coded == NULL || frame == NULL || frame_len == NULL) {
+        return SMART_QSO_ERROR_NULL_PTR;
+    }
+    if (coded_len <= FEC_TLM_SYNC_LEN + FEC_RS_PARITY) {
+        return SMART_QSO_ERROR_INVALID;
+    }
+
+    /* Every codeword but the shortest is at most FEC_RS_N long */
+    size_t coded_body = coded_len - FEC_TLM_SYNC_LEN;
+    size_t blocks = (coded_body + FEC_RS_N - 1U) / FEC_RS_N;
+    if (coded_body <= blocks * FEC_RS_PARITY) {
+        return SMART_QSO_ERROR_INVALID;
+    }
+
+    size_t body = coded_body - (blocks * FEC_RS_PARITY);
+    if (*frame_len < FEC_TLM_SYNC_LEN + body) {
+        return SMART_QSO_ERROR_NO_MEM;
+    }
+
+    memcpy(frame, coded, FEC_TLM_SYNC_LEN);
+    size_t src = FEC_TLM_SYNC_LEN;
+    size_t dst = FEC_TLM_SYNC_LEN;
+    size_t total_fixed = 0U;
+
+    for (size_t b = 0; b < blocks; b++) {
+        size_t len = tlm_block_len(body, blocks, b);
+        size_t fixed = 0U;
+        SmartQsoResult_t result = fec_rs_decode(coded + src, len + FEC_RS_PARITY, &fixed);
+        if (result != SMART_QSO_OK) {
+            return result;
+        }
+        memcpy(frame + dst, coded + src, len);
+        total_fixed += fixed;
+        src += len + FEC_RS_PARITY;
+        dst += len;
+    }
+
+    *frame_len = dst;
+    if (corrected != NULL) {
+        *corrected = total_fixed;
+    }
+    return SMART_QSO_OK;
+}
@@ -0,0 +1,627 @@
+/**
+ * @file hal_flash_wl.c
+ * @brief Flash wear-leveling and bad-block management layer
+ *
+ * Implements the region API of hal_flash.h on top of the per-target
+ * physical block driver. Every region is split into sector-sized logical
+ * blocks, each mapped to one physical block. The metadata area of a
+ * physical block records its owner, erase count and a sequence number, so
+ * the map and the erase counts are rebuilt by scanning the device at init;
+ * when two blocks claim the same logical block the newer sequence wins.
+ *
+ * Erasing a logical block moves it to the least-worn free block unless its
+ * current block is less worn, so the frequently erased regions (the
+ * key-value banks) rotate through the spare pool; the block left behind is
+ * flagged obsolete so its stale contents cannot resurface. Cold regions
+ * are never moved. A block that fails to erase or program is retired by zeroing its
+ * metadata, and its data is rewritten to a replacement from the pool.
+ *
+ * @requirement SRS-F060 Persist mission data to non-volatile memory
+ * @requirement SRS-F041 Maintain fault log in non-volatile memory
+ */
+
+#include "hal/hal.h"
+
+#include <string.h>
+
+/*===========================================================================*/
+/* Layout                                                                     */
+/*===========================================================================*/
+
+/** Block metadata magic */
+#define WL_META_MAGIC       0xA5U
+
+/** Metadata obsolete flag: programmed to 0 when a newer block takes over */
+#define WL_META_LIVE        0xFFU
+
+/** Owner of a free block, and "no block" in the map */
+#define WL_NONE             0xFFFFU
+
+/** Erase count of a block whose metadata is unreadable, until the scan ends */
+#define WL_COUNT_UNKNOWN    UINT32_MAX
+
+/**
+ * @brief Physical block metadata (after the sector data)
+ *
+ * All bytes zero marks a retired block; zeros can be programmed over any
+ * contents without an erase. The obsolete flag is outside the CRC so it
+ * can be cleared after the metadata is written.
+ */
+typedef struct {
+    uint8_t magic;              /**< WL_META_MAGIC */
+    uint8_t obsolete;           /**< WL_META_LIVE, or 0 once superseded */
+    uint16_t logical;           /**< Owning logical block */
+    uint32_t erase_count;       /**< Erases of this block, including the last */
+    uint32_t sequence;          /**< Assignment order */
+    uint32_t crc32;             /**< CRC over logical, erase_count, sequence */
+} WlBlockMeta_t;
+
+_Static_assert(sizeof(WlBlockMeta_t) == HAL_FLASH_BLOCK_META_SIZE,
+               "block metadata must fill the metadata area");
+
+/**
+ * @brief Physical block states
+ */
+typedef enum {
+    WL_BLOCK_FREE = 0,          /**< Available for remapping */
+    WL_BLOCK_MAPPED = 1,        /**< Holds a logical block */
+    WL_BLOCK_RETIRED = 2        /**< Failed; never used again */
+} WlBlockState_t;
+
+/**
+ * @brief RAM copy of a physical block's metadata
+ */
+typedef struct {
+    uint32_t erase_count;       /**< Erases of this block */
+    uint32_t sequence;          /**< Sequence of its metadata */
+    uint16_t logical;           /**< Owner, or WL_NONE */
+    uint8_t state;              /**< WlBlockState_t */
+} WlBlock_t;
+
+/** Region sizes in logical blocks (HAL_FLASH_SECTOR_SIZE each) */
+static const uint16_t s_region_blocks[FLASH_REGION_COUNT] = {
+    2U,     /* MISSION_DATA */
+    1U,     /* EPS_CONFIG */
+    8U,     /* SENSOR_CONFIG (compiled sensor image, SENSOR_IMAGE_MAX_SIZE) */
+    16U,    /* FAULT_LOG */
+    4U,     /* BACKUP */
+    128U,   /* STATE (KV store bank A) */
+    128U    /* STATE_B (KV store bank B) */
+};
+
+/*===========================================================================*/
+/* Module State                                                               */
+/*===========================================================================*/
+
+static bool s_initialized = false;
+
+/** Physical blocks in use (at most HAL_FLASH_PHYS_BLOCKS) */
+static uint32_t s_phys_count = 0;
+
+static WlBlock_t s_blocks[HAL_FLASH_PHYS_BLOCKS];
+
+/** Logical to physical map */
+static uint16_t s_map[HAL_FLASH_LOGICAL_BLOCKS];
+
+/** First logical block of each region */
+static uint16_t s_region_first[FLASH_REGION_COUNT];
+
+/** Newest metadata sequence */
+static uint32_t s_sequence = 0;
+
+/** Remap and relocation counters since init */
+static uint32_t s_remaps = 0;
+static uint32_t s_relocations = 0;
+
+/*===========================================================================*/
+/* Internal Functions                                                         */
+/*===========================================================================*/
+
+static uint32_t meta_crc(const WlBlockMeta_t *meta)
+{
+    return smart_qso_crc32(&meta->logical,
+                           offsetof(WlBlockMeta_t, crc32) - offsetof(WlBlockMeta_t, logical));
+}
+
+/**
+ * @brief Take a failed block out of service
+ */
+static void retire_block(uint16_t phys)
+{
+    static const uint8_t zeros[HAL_FLASH_BLOCK_META_SIZE] = {0};
+
+    s_blocks[phys].state = (uint8_t)WL_BLOCK_RETIRED;
+    s_blocks[phys].logical = WL_NONE;
+    /* Best effort: an unmarked dead block just fails again after a reset */
+    (void)hal_flash_phys_program(phys, HAL_FLASH_SECTOR_SIZE, zeros, sizeof(zeros));
+}
+
+/**
+ * @brief Retire a block if an operation on it failed for wear
+ *
+ * Other errors (device unavailable, bad arguments) leave it in service.
+ */
+static SmartQsoResult_t block_failed(uint16_t phys, SmartQsoResult_t result)
+{
+    if (result == SMART_QSO_ERROR_IO) {
+        retire_block(phys);
+    }
+    return result;
+}
+
+/**
+ * @brief Return a superseded block to the pool
+ */
+static void release_block(uint16_t phys)
+{
+    static const uint8_t cleared = 0U;
+
+    s_blocks[phys].state = (uint8_t)WL_BLOCK_FREE;
+    s_blocks[phys].logical = WL_NONE;
+    /* Best effort: without the flag the newer sequence still wins at scan */
+    (void)hal_flash_phys_program(phys, HAL_FLASH_SECTOR_SIZE + offsetof(WlBlockMeta_t, obsolete),
+                                 &cleared, sizeof(cleared));
+}
+
+/**
+ * @brief Least-worn free block
+ *
+ * @return Physical block, or WL_NONE if the pool is empty
+ */
+static uint16_t pick_free_block(void)
+{
+    uint16_t best = WL_NONE;
+
+    for (uint32_t p = 0; p < s_phys_count; p++) {
+        if ((s_blocks[p].state == (uint8_t)WL_BLOCK_FREE) &&
+            ((best == WL_NONE) || (s_blocks[p].erase_count < s_blocks[best].erase_count))) {
+            best = (uint16_t)p;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Erase a block and assign it to a logical block (WL_NONE: free)
+ *
+ * Data (if any) is programmed before the metadata, so an interrupted
+ * assignment leaves the previous owner's block in charge after a reset.
+ * Retires the block if it fails.
+ *
+ * @param data Sector contents, or NULL to leave the block erased
+ */
+static SmartQsoResult_t assign_block(uint16_t phys, uint16_t logical, const uint8_t *data)
+{
+    WlBlock_t *block = &s_blocks[phys];
+
+    SmartQsoResult_t result;
+
+    block->erase_count++;
+    result = hal_flash_phys_erase(phys);
+    if (result != SMART_QSO_OK) {
+        return block_failed(phys, result);
+    }
+    if (data != NULL) {
+        result = hal_flash_phys_program(phys, 0U, data, HAL_FLASH_SECTOR_SIZE);
+        if (result != SMART_QSO_OK) {
+            return block_failed(phys, result);
+        }
+    }
+
+    WlBlockMeta_t meta;
+    meta.magic = WL_META_MAGIC;
+    meta.obsolete = WL_META_LIVE;
+    meta.logical = logical;
+    meta.erase_count = block->erase_count;
+    meta.sequence = ++s_sequence;
+    meta.crc32 = meta_crc(&meta);
+    result = hal_flash_phys_program(phys, HAL_FLASH_SECTOR_SIZE, (const uint8_t *)&meta,
+                                    sizeof(meta));
+    if (result != SMART_QSO_OK) {
+        return block_failed(phys, result);
+    }
+
+    block->sequence = meta.sequence;
+    block->logical = logical;
+    if (logical == WL_NONE) {
+        block->state = (uint8_t)WL_BLOCK_FREE;
+    } else {
+        block->state = (uint8_t)WL_BLOCK_MAPPED;
+        s_map[logical] = phys;
+    }
+    return SMART_QSO_OK;
+}
+
+/**
+ * @brief Erase a logical block, moving it to a less-worn block if one is free
+ */
+static SmartQsoResult_t erase_logical(uint16_t logical)
+{
+    uint16_t old = s_map[logical];
+
+    for (;;) {
+        uint16_t phys = pick_free_block();
+
+        if ((old != WL_NONE) &&
+            ((phys == WL_NONE) || (s_blocks[old].erase_count <= s_blocks[phys].erase_count))) {
+            phys = old;
+        }
+        if (phys == WL_NONE) {
+            /* Pool exhausted: the logical block is lost */
+            s_map[logical] = WL_NONE;
+            return SMART_QSO_ERROR_IO;
+        }
+
+        SmartQsoResult_t result = assign_block(phys, logical, NULL);
+        if (result == SMART_QSO_OK) {
+            if ((old != WL_NONE) && (phys != old)) {
+                release_block(old);
+                s_remaps++;
+            }
+            return SMART_QSO_OK;
+        }
+        if (result != SMART_QSO_ERROR_IO) {
+            return result;
+        }
+        if (phys == old) {
+            old = WL_NONE;
+        }
+    }
+}
+
+/**
+ * @brief Rewrite a block whose program failed into a replacement
+ *
+ * If the old block cannot be read, or the copy fails for a reason other
+ * than wear (power loss, program rules), the old block stays mapped.
+ *
+ * @param offset Offset of the failed write within the block
+ */
+static SmartQsoResult_t relocate_logical(uint16_t logical, uint32_t offset,
+                                         const uint8_t *data, size_t len)
+{
+    uint8_t sector[HAL_FLASH_SECTOR_SIZE];
+    uint16_t old = s_map[logical];
+
+    /* The old block's contents with the new data on top */
+    SmartQsoResult_t result = hal_flash_phys_read(old, 0U, sector, sizeof(sector));
+    if (result != SMART_QSO_OK) {
+        return result;
+    }
+    memcpy(&sector[offset], data, len);
+
+    /* Keep the old block out of pick_free_block() while copying */
+    uint8_t old_state = s_blocks[old].state;
+    s_blocks[old].state = (uint8_t)WL_BLOCK_RETIRED;
+
+    for (;;) {
+        uint16_t phys = pick_free_block();
+        if (phys == WL_NONE) {
+            retire_block(old);
+            s_map[logical] = WL_NONE;
+            return SMART_QSO_ERROR_IO;
+        }
+        result = assign_block(phys, logical, sector);
+        if (result == SMART_QSO_OK) {
+            retire_block(old);
+            s_relocations++;
+            return SMART_QSO_OK;
+        }
+        if (result != SMART_QSO_ERROR_IO) {
+            s_blocks[old].state = old_state;
+            return result;
+        }
+    }
+}
+
+/**
+ * @brief Rebuild the block table and map from the metadata on the device
+ */
+static void scan_blocks(void)
+{
+    uint32_t max_known = 0;
+
+    for (uint32_t l = 0; l < HAL_FLASH_LOGICAL_BLOCKS; l++) {
+        s_map[l] = WL_NONE;
+    }
+    s_sequence = 0;
+
+    for (uint32_t p = 0; p < s_phys_count; p++) {
+        WlBlock_t *block = &s_blocks[p];
+        WlBlockMeta_t meta;
+        static const uint8_t zeros[HAL_FLASH_BLOCK_META_SIZE] = {0};
+
+        block->state = (uint8_t)WL_BLOCK_FREE;
+        block->logical = WL_NONE;
+        block->erase_count = WL_COUNT_UNKNOWN;
+        block->sequence = 0;
+
+        if (hal_flash_phys_read(p, HAL_FLASH_SECTOR_SIZE, (uint8_t *)&meta,
+                                sizeof(meta)) != SMART_QSO_OK) {
+            block->state = (uint8_t)WL_BLOCK_RETIRED;
+            continue;
+        }
+        if (memcmp(&meta, zeros, sizeof(meta)) == 0) {
+            block->state = (uint8_t)WL_BLOCK_RETIRED;
+            continue;
+        }
+        if ((meta.magic != WL_META_MAGIC) || (meta.crc32 != meta_crc(&meta))) {
+            /* Never assigned, or interrupted between erase and metadata */
+            continue;
+        }
+
+        block->erase_count = meta.erase_count;
+        block->sequence = meta.sequence;
+        if (meta.erase_count > max_known) {
+            max_known = meta.erase_count;
+        }
+        if ((int32_t)(meta.sequence - s_sequence) > 0) {
+            s_sequence = meta.sequence;
+        }
+
+        if ((meta.obsolete == WL_META_LIVE) && (meta.logical < HAL_FLASH_LOGICAL_BLOCKS)) {
+            uint16_t current = s_map[meta.logical];
+
+            /* Interrupted remap: keep the newer block, flag the other */
+            if ((current != WL_NONE) &&
+                ((int32_t)(meta.sequence - s_blocks[current].sequence) <= 0)) {
+                release_block((uint16_t)p);
+                continue;
+            }
+            if (current != WL_NONE) {
+                release_block(current);
+            }
+            block->state = (uint8_t)WL_BLOCK_MAPPED;
+            block->logical = meta.logical;
+            s_map[meta.logical] = (uint16_t)p;
+        }
+    }
+
+    /* Blocks without metadata count as the most-worn known block until stamped */
+    for (uint32_t p = 0; p < s_phys_count; p++) {
+        if (s_blocks[p].erase_count == WL_COUNT_UNKNOWN) {
+            s_blocks[p].erase_count = max_known;
+        }
+    }
+}
+
+static bool region_valid(HalFlashRegion_t region, uint32_t offset, size_t len)
+{
+    return ((uint32_t)region < (uint32_t)FLASH_REGION_COUNT) &&
+           ((size_t)offset + len <= hal_flash_region_size(region));
+}
+
+/*===========================================================================*/
+/* Region API                                                                 */
+/*===========================================================================*/
+
+SmartQsoResult_t hal_flash_init(void)
+{
+    uint32_t first = 0;
+
+    s_initialized = false;
+    for (uint32_t r = 0; r < (uint32_t)FLASH_REGION_COUNT; r++) {
+        s_region_first[r] = (uint16_t)first;
+        first += s_region_blocks[r];
+    }
+    if (first != HAL_FLASH_LOGICAL_BLOCKS) {
+        return SMART_QSO_ERROR;
+    }
+
+    SmartQsoResult_t result = hal_flash_phys_init();
+    if (result != SMART_QSO_OK) {
+        return result;
+    }
+    s_phys_count = hal_flash_phys_block_count();
+    if (s_phys_count > HAL_FLASH_PHYS_BLOCKS) {
+        s_phys_count = HAL_FLASH_PHYS_BLOCKS;
+    }
+    if (s_phys_count <= HAL_FLASH_LOGICAL_BLOCKS) {
+        return SMART_QSO_ERROR_NO_MEM;
+    }
+
+    scan_blocks();
+    s_remaps = 0;
+    s_relocations = 0;
+
+    /*
+     * First boot, or a block lost since: give every logical block a home.
+     * Without spares the block stays lost (reads fail) but the rest of the
+     * device is still usable.
+     */
+    for (uint16_t l = 0; l < HAL_FLASH_LOGICAL_BLOCKS; l++) {
+        if (s_map[l] == WL_NONE) {
+            (void)erase_logical(l);
+        }
+    }
+
+    /* Record an erase count on free blocks that have none yet */
+    for (uint32_t p = 0; p < s_phys_count; p++) {
+        if ((s_blocks[p].state == (uint8_t)WL_BLOCK_FREE) && (s_blocks[p].sequence == 0U)) {
+            (void)assign_block((uint16_t)p, WL_NONE, NULL);
+        }
+    }
+
+    s_initialized = true;
+    return SMART_QSO_OK;
+}
+
+SmartQsoResult_t hal_flash_read(HalFlashRegion_t region, uint32_t offset,
+                                 uint8_t *data, size_t len)
+{
+    if (!s_initialized) {
+        return SMART_QSO_ERROR;
+    }
+    if (data == NULL) {
+        return SMART_QSO_ERROR_NULL_PTR;
+    }
+    if (!region_valid(region, offset, len)) {
+        return SMART_QSO_ERROR_INVALID;
+    }
+
+    while (len > 0U) {
+        uint16_t logical = (uint16_t)(s_region_first[region] + (offset / HAL_FLASH_SECTOR_SIZE));
+        uint32_t block_offset = offset % HAL_FLASH_SECTOR_SIZE;
+        size_t chunk = HAL_FLASH_SECTOR_SIZE - block_offset;
+        if (chunk > len) {
+            chunk = len;
+        }
+
+        if (s_map[logical] == WL_NONE) {
+            return SMART_QSO_ERROR_IO;
+        }
+        SmartQsoResult_t result = hal_flash_phys_read(s_map[logical], block_offset, data, chunk);
+        if (result != SMART_QSO_OK) {
+            return result;
+        }
+
+        data += chunk;
+        offset += (uint32_t)chunk;
+        len -= chunk;
+    }
+    return SMART_QSO_OK;
+}
+
+SmartQsoResult_t hal_flash_write(HalFlashRegion_t region, uint32_t offset,
+                                  const uint8_t *data, size_t len)
+{
+    if (!s_initialized) {
+        return SMART_QSO_ERROR;
+    }
+    if (data == NULL) {
+        return SMART_QSO_ERROR_NULL_PTR;
+    }
+    if (!region_valid(region, offset, len)) {
+        return SMART_QSO_ERROR_INVALID;
+    }
+
+    while (len > 0U) {
+        uint16_t logical = (uint16_t)(s_region_first[region] + (offset / HAL_FLASH_SECTOR_SIZE));
+        uint32_t block_offset = offset % HAL_FLASH_SECTOR_SIZE;
+        size_t chunk = HAL_FLASH_SECTOR_SIZE - block_offset;
+        if (chunk > len) {
+            chunk = len;
+        }
+
+        if (s_map[logical] == WL_NONE) {
+            return SMART_QSO_ERROR_IO;
+        }
+        SmartQsoResult_t result = hal_flash_phys_program(s_map[logical], block_offset, data, chunk);
+        if (result == SMART_QSO_ERROR_IO) {
+            /* The block wore out: move it with this write applied */
+            result = relocate_logical(logical, block_offset, data, chunk);
+        }
+        if (result != SMART_QSO_OK) {
+            return result;
+        }
+
+        data += chunk;
+        offset += (uint32_t)chunk;
+        len -= chunk;
+    }
+    return SMART_QSO_OK;
+}
+
+SmartQsoResult_t hal_flash_erase(HalFlashRegion_t region)
+{
+    SmartQsoResult_t result = SMART_QSO_OK;
+
+    if (!s_initialized) {
+        return SMART_QSO_ERROR;
+    }
+    if ((uint32_t)region >= (uint32_t)FLASH_REGION_COUNT) {
+        return SMART_QSO_ERROR_INVALID;
+    }
+
+    /* Keep going past a lost block so the rest of the region is usable */
+    for (uint16_t i = 0; i < s_region_blocks[region]; i++) {
+        if (erase_logical((uint16_t)(s_region_first[region] + i)) != SMART_QSO_OK) {
+            result = SMART_QSO_ERROR_IO;
+        }
+    }
+    return result;
+}
+
+size_t hal_flash_region_size(HalFlashRegion_t region)
+{
+    if ((uint32_t)region >= (uint32_t)FLASH_REGION_COUNT) {
+        return 0;
+    }
+    return (size_t)s_region_blocks[region] * HAL_FLASH_SECTOR_SIZE;
+}
+
+uint32_t hal_flash_region_base(HalFlashRegion_t region)
+{
+    (void)region;
+    return 0;  /* Regions are not contiguous once blocks are remapped */
+}
+
+uint8_t hal_flash_wear_level(HalFlashRegion_t region)
+{
+    uint32_t worst = 0;
+
+    if (!s_initialized || ((uint32_t)region >= (uint32_t)FLASH_REGION_COUNT)) {
+        return 0;
+    }
+
+    for (uint16_t i = 0; i < s_region_blocks[region]; i++) {
+        uint16_t phys = s_map[s_region_first[region] + i];
+        if ((phys != WL_NONE) && (s_blocks[phys].erase_count > worst)) {
+            worst = s_blocks[phys].erase_count;
+        }
+    }
+
+    if (worst >= HAL_FLASH_ENDURANCE_CYCLES) {
+        return 100U;
+    }
+    return (uint8_t)((worst * 100U) / HAL_FLASH_ENDURANCE_CYCLES);
+}
+
+SmartQsoResult_t hal_flash_get_wear_stats(HalFlashWearStats_t *stats)
+{
+    if (stats == NULL) {
+        return SMART_QSO_ERROR_NULL_PTR;
+    }
+    if (!s_initialized) {
+        return SMART_QSO_ERROR;
+    }
+
+    memset(stats, 0, sizeof(*stats));
+    stats->physical_blocks = s_phys_count;
+    stats->min_erase_count = UINT32_MAX;
+    stats->remaps = s_remaps;
+    stats->relocations = s_relocations;
+
+    for (uint32_t l = 0; l < HAL_FLASH_LOGICAL_BLOCKS; l++) {
+        if (s_map[l] == WL_NONE) {
+            stats->lost_blocks++;
+        }
+    }
+
+    for (uint32_t p = 0; p < s_phys_count; p++) {
+        const WlBlock_t *block = &s_blocks[p];
+
+        stats->total_erases += block->erase_count;
+        if (block->state == (uint8_t)WL_BLOCK_RETIRED) {
+            stats->retired_blocks++;
+            continue;
+        }
+        if (block->state == (uint8_t)WL_BLOCK_FREE) {
+            stats->free_blocks++;
+        }
+        if (block->erase_count < stats->min_erase_count) {
+            stats->min_erase_count = block->erase_count;
+        }
+        if (block->erase_count > stats->max_erase_count) {
+            stats->max_erase_count = block->erase_count;
+        }
+        if (block->erase_count < HAL_FLASH_ENDURANCE_CYCLES) {
+            stats->remaining_cycles += HAL_FLASH_ENDURANCE_CYCLES - block->erase_count;
+        }
+    }
+
+    if (stats->min_erase_count == UINT32_MAX) {
+        stats->min_erase_count = 0;
+    }
+    return SMART_QSO_OK;
+}
@@ -18,7 +18,10 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <fcntl.h>
 #include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/time.h>
 
 #include "hal/hal.h"
@@ -62,6 +65,8 @@ static uint64_t s_timer_start_us = 0;
 
 /* ADC simulation state */
 static bool s_adc_initialized = false;
+static uint16_t s_adc_full_scale = 4095U;
+static HalAdcSimStats_t s_adc_stats;
 static double s_adc_values[ADC_CHANNEL_COUNT] = {
     7.8,    /* VBATT */
     -0.5,   /* IBATT (discharging) */
@@ -72,17 +77,39 @@ static double s_adc_values[ADC_CHANNEL_COUNT] = {
     28.0    /* TEMP_BOARD */
 };
 
-/* Flash simulation state */
-static bool s_flash_initialized = false;
-static uint8_t *s_flash_data[FLASH_REGION_COUNT];
-static size_t s_flash_sizes[FLASH_REGION_COUNT] = {
-    512,    /* MISSION_DATA */
-    256,    /* EPS_CONFIG */
-    512,    /* SENSOR_CONFIG */
-    4096,   /* FAULT_LOG */
-    1024    /* BACKUP */
+/* Front-end range per channel: value at raw 0 and at full scale */
+static const struct {
+    double min;
+    double max;
+} s_adc_range[ADC_CHANNEL_COUNT] = {
+    {   0.0,   9.9 },   /* VBATT: 3:1 divider */
+    {  -2.0,   2.0 },   /* IBATT: bipolar shunt amplifier */
+    {   0.0,  13.2 },   /* VSOLAR: 4:1 divider */
+    {   0.0,   2.0 },   /* ISOLAR */
+    {   0.0,   6.6 },   /* VBUS: 2:1 divider */
+    { -50.0, 150.0 },   /* TEMP_MCU */
+    { -50.0, 150.0 },   /* TEMP_BOARD */
 };
 
+/* Flash simulation state: physical blocks under the wear-leveling layer */
+#define SIM_FLASH_DATA_SIZE   ((size_t)HAL_FLASH_PHYS_BLOCKS * HAL_FLASH_PHYS_BLOCK_SIZE)
+#define SIM_FLASH_IMAGE_SIZE  (SIM_FLASH_DATA_SIZE + sizeof(uint32_t) * HAL_FLASH_PHYS_BLOCKS)
+
+static bool s_flash_initialized = false;
+static bool s_flash_powered = false;
+static HalFlashSimConfig_t s_flash_config;
+static bool s_flash_configured = false;
+static uint8_t *s_flash_image = NULL;       /* Block data, then erase counts */
+static uint8_t *s_flash_data = NULL;
+static uint32_t *s_flash_erases = NULL;
+static int s_flash_fd = -1;
+static uint32_t s_flash_endurance = HAL_FLASH_ENDURANCE_CYCLES;
+static bool s_flash_fail_program = false;
+static uint32_t s_flash_power_loss_in = 0;  /* Operations until power loss, 0 = none */
+static uint32_t s_flash_rng = 1;
+static uint64_t s_flash_busy_until_us = 0;
+static HalFlashSimStats_t s_flash_stats;
+
 /* Watchdog simulation state */
 static bool s_wdt_initialized = false;
 static bool s_wdt_running = false;
@@ -100,6 +127,8 @@ static uint64_t get_time_us(void) {
     return (uint64_t)tv.tv_sec * 1000000ULL + (uint64_t)tv.tv_usec;
 }
 
+static void flash_detach(void);
+
 /*===========================================================================*/
 /* HAL Initialization                                                         */
 /*===========================================================================*/
@@ -123,13 +152,8 @@ SmartQsoResult_t hal_init(void) {
 }
 
 SmartQsoResult_t hal_deinit(void) {
-    /* Free flash simulation memory */
-    for (int i = 0; i < FLASH_REGION_COUNT; i++) {
-        if (s_flash_data[i]) {
-            free(s_flash_data[i]);
-            s_flash_data[i] = NULL;
-        }
-    }
+    /* Release flash simulation memory (a backing file keeps its contents) */
+    flash_detach();
 
     s_gpio_initialized = false;
     s_timer_initialized = false;
@@ -437,46 +461,88 @@ SmartQsoResult_t hal_timer_stop(HalTimerId_t timer_id) {
 /*===========================================================================*/
 
 SmartQsoResult_t hal_adc_init(HalAdcResolution_t resolution, HalAdcRef_t reference) {
-    (void)resolution;
     (void)reference;
 
+    if ((resolution < ADC_RESOLUTION_8BIT) || (resolution > ADC_RESOLUTION_16BIT)) {
+        return SMART_QSO_ERROR_INVALID;
+    }
+    s_adc_full_scale = (uint16_t)((1UL << (unsigned)resolution) - 1UL);
+    memset(&s_adc_stats, 0, sizeof(s_adc_stats));
     s_adc_initialized = true;
     return SMART_QSO_OK;
 }
 
+/* One conversion: the channel's value quantized over its front-end range */
+static uint16_t adc_convert(HalAdcChannel_t channel) {
+    double span = s_adc_range[channel].max - s_adc_range[channel].min;
+    double counts = ((s_adc_values[channel] - s_adc_range[channel].min) / span) *
+                    (double)s_adc_full_scale;
+
+    s_adc_stats.conversions++;
+    if (counts <= 0.0) return 0U;
+    if (counts >= (double)s_adc_full_scale) return s_adc_full_scale;
+    return (uint16_t)(counts + 0.5);
+}
+
 SmartQsoResult_t hal_adc_read_raw(HalAdcChannel_t channel, uint16_t *value) {
     if (!s_adc_initialized) return SMART_QSO_ERROR;
     if (!value) return SMART_QSO_ERROR_NULL_PTR;
     if (channel >= ADC_CHANNEL_COUNT) return SMART_QSO_ERROR_INVALID;
 
-    /* Convert simulated voltage to raw ADC value (assuming 12-bit, 3.3V ref) */
-    double voltage = s_adc_values[channel];
-    *value = (uint16_t)((voltage / 3.3) * 4095.0);
-
+    s_adc_stats.transactions++;
+    *value = adc_convert(channel);
     return SMART_QSO_OK;
 }
 
 SmartQsoResult_t hal_adc_read_voltage(HalAdcChannel_t channel, double *voltage) {
-    if (!s_adc_initialized) return SMART_QSO_ERROR;
+    uint16_t raw;
     if (!voltage) return SMART_QSO_ERROR_NULL_PTR;
-    if (channel >= ADC_CHANNEL_COUNT) return SMART_QSO_ERROR_INVALID;
 
-    *voltage = s_adc_values[channel];
-    return SMART_QSO_OK;
+    SmartQsoResult_t result = hal_adc_read_raw(channel, &raw);
+    if (result != SMART_QSO_OK) return result;
+    return hal_adc_raw_to_voltage(channel, raw, voltage);
 }
 
 SmartQsoResult_t hal_adc_read_multiple(const HalAdcChannel_t *channels,
                                         uint16_t *values, size_t count) {
+    if (!s_adc_initialized) return SMART_QSO_ERROR;
     if (!channels || !values) return SMART_QSO_ERROR_NULL_PTR;
 
     for (size_t i = 0; i < count; i++) {
-        SmartQsoResult_t result = hal_adc_read_raw(channels[i], &values[i]);
-        if (result != SMART_QSO_OK) return result;
+        if (channels[i] >= ADC_CHANNEL_COUNT) return SMART_QSO_ERROR_INVALID;
+    }
+
+    /* One scan sequence: every channel sampled from the same instant */
+    s_adc_stats.transactions++;
+    for (size_t i = 0; i < count; i++) {
+        values[i] = adc_convert(channels[i]);
     }
 
     return SMART_QSO_OK;
 }
 
+SmartQsoResult_t hal_adc_raw_to_voltage(HalAdcChannel_t channel, uint16_t raw,
+                                         double *voltage) {
+    if (!voltage) return SMART_QSO_ERROR_NULL_PTR;
+    if (channel >= ADC_CHANNEL_COUNT) return SMART_QSO_ERROR_INVALID;
+
+    double span = s_adc_range[channel].max - s_adc_range[channel].min;
+    *voltage = s_adc_range[channel].min + (((double)raw * span) / (double)s_adc_full_scale);
+    return SMART_QSO_OK;
+}
+
+SmartQsoResult_t hal_adc_sim_set_value(HalAdcChannel_t channel, double value) {
+    if (channel >= ADC_CHANNEL_COUNT) return SMART_QSO_ERROR_INVALID;
+    s_adc_values[channel] = value;
+    return SMART_QSO_OK;
+}
+
+SmartQsoResult_t hal_adc_sim_get_stats(HalAdcSimStats_t *stats) {
+    if (!stats) return SMART_QSO_ERROR_NULL_PTR;
+    *stats = s_adc_stats;
+    return SMART_QSO_OK;
+}
+
 SmartQsoResult_t hal_adc_calibrate(void) {
     return SMART_QSO_OK;  /* No calibration needed in simulation */
 }
@@ -485,66 +551,259 @@ SmartQsoResult_t hal_adc_calibrate(void) {
 /* Flash Implementation                                                       */
 /*===========================================================================*/
 
-SmartQsoResult_t hal_flash_init(void) {
-    /* Allocate simulation memory for each region */
-    for (int i = 0; i < FLASH_REGION_COUNT; i++) {
-        if (!s_flash_data[i]) {
-            s_flash_data[i] = (uint8_t *)calloc(1, s_flash_sizes[i]);
-            if (!s_flash_data[i]) return SMART_QSO_ERROR_NO_MEM;
+void hal_flash_sim_default_config(HalFlashSimConfig_t *config) {
+    if (!config) return;
+    memset(config, 0, sizeof(*config));
+    config->page_size = HAL_FLASH_PAGE_SIZE;
+    config->erase_time_us = 22000U;         /* STM32L4 page erase, typical */
+    config->page_program_time_us = 650U;    /* 8 double words at ~82 us */
+    config->enforce_program_rules = true;
+    config->seed = 1U;
+}
+
+static const HalFlashSimConfig_t *flash_config(void) {
+    if (!s_flash_configured) {
+        hal_flash_sim_default_config(&s_flash_config);
+        s_flash_configured = true;
+    }
+    return &s_flash_config;
+}
+
+static void flash_detach(void) {
+    if (s_flash_fd >= 0) {
+        (void)munmap(s_flash_image, SIM_FLASH_IMAGE_SIZE);
+        (void)close(s_flash_fd);
+        s_flash_fd = -1;
+    } else {
+        free(s_flash_image);
+    }
+    s_flash_image = NULL;
+    s_flash_data = NULL;
+    s_flash_erases = NULL;
+    s_flash_initialized = false;
+}
+
+/* Map the backing file; a new file starts as an erased, unworn device */
+static SmartQsoResult_t flash_attach_file(const char *path) {
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return SMART_QSO_ERROR_IO;
+
+    struct stat st;
+    bool fresh = (fstat(fd, &st) != 0) || ((size_t)st.st_size != SIM_FLASH_IMAGE_SIZE);
+    if (fresh && (ftruncate(fd, (off_t)SIM_FLASH_IMAGE_SIZE) != 0)) {
+        (void)close(fd);
+        return SMART_QSO_ERROR_IO;
+    }
+
+    void *image = mmap(NULL, SIM_FLASH_IMAGE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (image == MAP_FAILED) {
+        (void)close(fd);
+        return SMART_QSO_ERROR_IO;
+    }
+
+    s_flash_fd = fd;
+    s_flash_image = (uint8_t *)image;
+    if (fresh) {
+        memset(s_flash_image, 0xFF, SIM_FLASH_DATA_SIZE);
+        memset(&s_flash_image[SIM_FLASH_DATA_SIZE], 0, SIM_FLASH_IMAGE_SIZE - SIM_FLASH_DATA_SIZE);
+    }
+    return SMART_QSO_OK;
+}
+
+SmartQsoResult_t hal_flash_phys_init(void) {
+    const HalFlashSimConfig_t *config = flash_config();
+
+    /* A new device is fully erased and unworn */
+    if (!s_flash_image) {
+        if (config->backing_file) {
+            SmartQsoResult_t result = flash_attach_file(config->backing_file);
+            if (result != SMART_QSO_OK) return result;
+        } else {
+            s_flash_image = (uint8_t *)malloc(SIM_FLASH_IMAGE_SIZE);
+            if (!s_flash_image) return SMART_QSO_ERROR_NO_MEM;
+            memset(s_flash_image, 0xFF, SIM_FLASH_DATA_SIZE);
+            memset(&s_flash_image[SIM_FLASH_DATA_SIZE], 0, SIM_FLASH_IMAGE_SIZE - SIM_FLASH_DATA_SIZE);
         }
+        s_flash_data = s_flash_image;
+        s_flash_erases = (uint32_t *)(void *)&s_flash_image[SIM_FLASH_DATA_SIZE];
     }
 
+    /* Power-up: an interrupted operation is over */
+    s_flash_busy_until_us = 0;
+    s_flash_powered = true;
     s_flash_initialized = true;
     return SMART_QSO_OK;
 }
 
-SmartQsoResult_t hal_flash_read(HalFlashRegion_t region, uint32_t offset,
-                                 uint8_t *data, size_t len) {
-    if (!s_flash_initialized) return SMART_QSO_ERROR;
-    if (!data) return SMART_QSO_ERROR_NULL_PTR;
-    if (region >= FLASH_REGION_COUNT) return SMART_QSO_ERROR_INVALID;
-    if (offset + len > s_flash_sizes[region]) return SMART_QSO_ERROR_INVALID;
+SmartQsoResult_t hal_flash_sim_configure(const HalFlashSimConfig_t *config) {
+    HalFlashSimConfig_t next;
+
+    if (config) {
+        next = *config;
+    } else {
+        hal_flash_sim_default_config(&next);
+    }
+    if ((next.page_size == 0U) || (next.page_size > HAL_FLASH_SECTOR_SIZE) ||
+        ((HAL_FLASH_SECTOR_SIZE % next.page_size) != 0U)) {
+        return SMART_QSO_ERROR_PARAM;
+    }
 
-    memcpy(data, &s_flash_data[region][offset], len);
+    flash_detach();
+    s_flash_config = next;
+    s_flash_configured = true;
+    s_flash_rng = (next.seed != 0U) ? next.seed : 1U;
+    s_flash_power_loss_in = 0;
+    memset(&s_flash_stats, 0, sizeof(s_flash_stats));
     return SMART_QSO_OK;
 }
 
-SmartQsoResult_t hal_flash_write(HalFlashRegion_t region, uint32_t offset,
-                                  const uint8_t *data, size_t len) {
-    if (!s_flash_initialized) return SMART_QSO_ERROR;
+uint32_t hal_flash_phys_block_count(void) {
+    return HAL_FLASH_PHYS_BLOCKS;
+}
+
+/* Erases block can take before failing: 100-150% of the endurance */
+static bool flash_block_worn(uint32_t block) {
+    uint32_t spread = (block * 2654435761U) % ((s_flash_endurance / 2U) + 1U);
+    return s_flash_erases[block] > (s_flash_endurance + spread);
+}
+
+static uint8_t *flash_block(uint32_t block, uint32_t offset, size_t len) {
+    if (block >= HAL_FLASH_PHYS_BLOCKS) return NULL;
+    if (offset + len > HAL_FLASH_PHYS_BLOCK_SIZE) return NULL;
+    return &s_flash_data[(size_t)block * HAL_FLASH_PHYS_BLOCK_SIZE + offset];
+}
+
+/* Wait out the previous operation, then charge this one */
+static void flash_begin(uint32_t duration_us) {
+    if (flash_config()->realtime) {
+        uint64_t now = get_time_us();
+        while (now < s_flash_busy_until_us) {
+            usleep((useconds_t)(s_flash_busy_until_us - now));
+            now = get_time_us();
+        }
+        s_flash_busy_until_us = now + duration_us;
+    }
+    s_flash_stats.busy_time_us += duration_us;
+}
+
+/*
+ * Count down to a scheduled power loss. Returns how many of len bytes the
+ * operation gets through before power goes, or len if it completes.
+ */
+static size_t flash_power_cut(size_t len) {
+    if (s_flash_power_loss_in == 0U) return len;
+    if (--s_flash_power_loss_in > 0U) return len;
+
+    s_flash_powered = false;
+    s_flash_stats.power_losses++;
+    s_flash_rng = s_flash_rng * 1103515245U + 12345U;
+    return (size_t)((s_flash_rng >> 8) % (uint32_t)len);
+}
+
+/* Program bytes the way cells do: clear bits only */
+static size_t flash_and_program(uint8_t *dst, const uint8_t *data, size_t len) {
+    size_t violations = 0;
+    for (size_t i = 0; i < len; i++) {
+        if ((uint8_t)(dst[i] & data[i]) != data[i]) violations++;
+        dst[i] &= data[i];
+    }
+    return violations;
+}
+
+SmartQsoResult_t hal_flash_phys_read(uint32_t block, uint32_t offset,
+                                      uint8_t *data, size_t len) {
     if (!data) return SMART_QSO_ERROR_NULL_PTR;
-    if (region >= FLASH_REGION_COUNT) return SMART_QSO_ERROR_INVALID;
-    if (offset + len > s_flash_sizes[region]) return SMART_QSO_ERROR_INVALID;
+    if (!s_flash_initialized || !s_flash_powered) return SMART_QSO_ERROR;
+    uint8_t *src = flash_block(block, offset, len);
+    if (!src) return SMART_QSO_ERROR_INVALID;
 
-    memcpy(&s_flash_data[region][offset], data, len);
+    flash_begin(0U);
+    s_flash_stats.reads++;
+    memcpy(data, src, len);
     return SMART_QSO_OK;
 }
 
-SmartQsoResult_t hal_flash_erase(HalFlashRegion_t region) {
-    if (!s_flash_initialized) return SMART_QSO_ERROR;
-    if (region >= FLASH_REGION_COUNT) return SMART_QSO_ERROR_INVALID;
+SmartQsoResult_t hal_flash_phys_program(uint32_t block, uint32_t offset,
+                                         const uint8_t *data, size_t len) {
+    if (!data) return SMART_QSO_ERROR_NULL_PTR;
+    if (!s_flash_initialized || !s_flash_powered) return SMART_QSO_ERROR;
+    uint8_t *dst = flash_block(block, offset, len);
+    if (!dst) return SMART_QSO_ERROR_INVALID;
+    if (len == 0U) return SMART_QSO_OK;
+
+    const HalFlashSimConfig_t *config = flash_config();
+    uint32_t first_page = offset / config->page_size;
+    uint32_t last_page = (offset + (uint32_t)len - 1U) / config->page_size;
+    uint32_t pages = last_page - first_page + 1U;
+    flash_begin(pages * config->page_program_time_us);
+    s_flash_stats.page_programs += pages;
+
+    if (s_flash_fail_program) {
+        s_flash_fail_program = false;
+        return SMART_QSO_ERROR_IO;
+    }
+    /* A worn block only verifies bits already driven to 0 (bad-block marks) */
+    if (flash_block_worn(block)) {
+        for (size_t i = 0; i < len; i++) {
+            if (data[i] != 0U) return SMART_QSO_ERROR_IO;
+        }
+    }
+
+    size_t done = flash_power_cut(len);
+    size_t violations = flash_and_program(dst, data, done);
+    if (done < len) return SMART_QSO_ERROR;
 
-    memset(s_flash_data[region], 0xFF, s_flash_sizes[region]);
+    if (violations > 0U) {
+        s_flash_stats.program_violations++;
+        if (config->enforce_program_rules) return SMART_QSO_ERROR_INVALID;
+        memcpy(dst, data, len);
+    }
     return SMART_QSO_OK;
 }
 
-size_t hal_flash_region_size(HalFlashRegion_t region) {
-    if (region >= FLASH_REGION_COUNT) return 0;
-    return s_flash_sizes[region];
+SmartQsoResult_t hal_flash_phys_erase(uint32_t block) {
+    if (!s_flash_initialized || !s_flash_powered) return SMART_QSO_ERROR;
+    uint8_t *dst = flash_block(block, 0, HAL_FLASH_PHYS_BLOCK_SIZE);
+    if (!dst) return SMART_QSO_ERROR_INVALID;
+
+    flash_begin(flash_config()->erase_time_us);
+    s_flash_stats.erases++;
+
+    /* Worn blocks keep failing; their contents are left as they were */
+    s_flash_erases[block]++;
+    if (flash_block_worn(block)) return SMART_QSO_ERROR_IO;
+
+    /* A torn erase only reaches part of the block */
+    size_t done = flash_power_cut(HAL_FLASH_PHYS_BLOCK_SIZE);
+    memset(dst, 0xFF, done);
+    return (done < HAL_FLASH_PHYS_BLOCK_SIZE) ? SMART_QSO_ERROR : SMART_QSO_OK;
+}
+
+void hal_flash_sim_set_endurance(uint32_t cycles) {
+    s_flash_endurance = (cycles > 0U) ? cycles : HAL_FLASH_ENDURANCE_CYCLES;
 }
 
-uint32_t hal_flash_region_base(HalFlashRegion_t region) {
-    (void)region;
-    return 0;  /* Not applicable in simulation */
+void hal_flash_sim_fail_next_program(void) {
+    s_flash_fail_program = true;
 }
 
-bool hal_flash_busy(void) {
-    return false;  /* Never busy in simulation */
+void hal_flash_sim_power_loss_after(uint32_t operations) {
+    /* The operation after the ones let through is the one torn */
+    s_flash_power_loss_in = (operations > 0U) ? operations + 1U : 0U;
 }
 
-uint8_t hal_flash_wear_level(HalFlashRegion_t region) {
-    (void)region;
-    return 0;  /* No wear in simulation */
+bool hal_flash_sim_powered(void) {
+    return s_flash_powered;
+}
+
+SmartQsoResult_t hal_flash_sim_get_stats(HalFlashSimStats_t *stats) {
+    if (!stats) return SMART_QSO_ERROR_NULL_PTR;
+    *stats = s_flash_stats;
+    return SMART_QSO_OK;
+}
+
+bool hal_flash_busy(void) {
+    return s_flash_powered && (get_time_us() < s_flash_busy_until_us);
 }
 
 /*===========================================================================*/
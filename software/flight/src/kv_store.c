@@ -0,0 +1,503 @@
+/**
+ * @file kv_store.c
+ * @brief Log-structured key-value store implementation
+ *
+ * Each bank starts with a header (magic, generation, CRC) followed by an
+ * append-only log of records. The RAM index maps every live key to the
+ * offset of its newest record in the active bank and is rebuilt by
+ * replaying the log at mount.
+ *
+ * @requirement SRS-DATA-001 System shall persist mission data across resets
+ * @requirement SRS-DATA-002 System shall protect data integrity with CRC
+ */
+
+#include "kv_store.h"
+
+#include <string.h>
+
+#include "hal/hal_flash.h"
+
+/*===========================================================================*/
+/* Layout                                                                     */
+/*===========================================================================*/
+
+/** Bank header magic ("SQKV") */
+#define BANK_MAGIC          0x53514B56U
+
+/** Record magic */
+#define RECORD_MAGIC        0x4B56U
+
+/** Value of unprogrammed flash */
+#define ERASED_BYTE         0xFFU
+
+/** Marks "no bank holds a valid header" */
+#define NO_BANK             0xFFU
+
+/**
+ * @brief Bank header (offset 0 of each bank)
+ */
+typedef struct {
+    uint32_t magic;             /**< BANK_MAGIC */
+    uint32_t generation;        /**< Incremented on every compaction */
+    uint32_t crc32;             /**< CRC over magic and generation */
+    uint32_t reserved;          /**< Pads the header to 16 bytes */
+} KvBankHeader_t;
+
+/**
+ * @brief Record header (followed by the padded value)
+ */
+typedef struct {
+    uint16_t magic;             /**< RECORD_MAGIC */
+    uint16_t key;               /**< Key */
+    uint8_t type;               /**< KvRecordType_t */
+    uint8_t version;            /**< Writer's schema version */
+    uint16_t length;            /**< Value length */
+    uint32_t sequence;          /**< Monotonic sequence number */
+    uint32_t crc32;             /**< CRC over the fields above and the value */
+} KvRecordHeader_t;
+
+/**
+ * @brief Index entry for a live key
+ */
+typedef struct {
+    uint32_t offset;            /**< Record offset in the active bank */
+    uint16_t key;               /**< Key */
+    uint16_t length;            /**< Value length */
+    uint8_t version;            /**< Schema version */
+} KvIndexEntry_t;
+
+/*===========================================================================*/
+/* Module State                                                               */
+/*===========================================================================*/
+
+/** Live keys */
+static KvIndexEntry_t s_index[KV_MAX_KEYS];
+
+/** Number of live keys */
+static size_t s_index_count = 0;
+
+/** Banks have been scanned */
+static bool s_mounted = false;
+
+/** Counters and log position; active_bank is NO_BANK on an empty store */
+static KvStats_t s_stats = { .active_bank = NO_BANK };
+
+/** Record staging buffer (header plus largest padded value) */
+static uint8_t s_record_buf[KV_RECORD_SIZE(KV_MAX_VALUE_LEN)];
+
+/** Flash region backing each bank */
+static const HalFlashRegion_t s_bank_regions[KV_BANK_COUNT] = {
+    FLASH_REGION_STATE,
+    FLASH_REGION_STATE_B
+};
+
+/*===========================================================================*/
+/* Bank Access                                                                */
+/*===========================================================================*/
+
+static SmartQsoResult_t bank_read(uint8_t bank, uint32_t offset, void *data, size_t len)
+{
+    return hal_flash_read(s_bank_regions[bank], offset, (uint8_t *)data, len);
+}
+
+static SmartQsoResult_t bank_write(uint8_t bank, uint32_t offset, const void *data, size_t len)
+{
+    SmartQsoResult_t result = hal_flash_write(s_bank_regions[bank], offset,
+                                              (const uint8_t *)data, len);
+    if (result == SMART_QSO_OK) {
+        s_stats.bytes_written += (uint32_t)len;
+    }
+    return result;
+}
+
+static SmartQsoResult_t bank_erase(uint8_t bank)
+{
+    SmartQsoResult_t result = hal_flash_erase(s_bank_regions[bank]);
+    if (result == SMART_QSO_OK) {
+        s_stats.erase_count++;
+    }
+    return result;
+}
+
+/*===========================================================================*/
+/* Records                                                                    */
+/*===========================================================================*/
+
+static uint32_t record_crc(const KvRecordHeader_t *header, const uint8_t *value)
+{
+    uint32_t crc = smart_qso_crc32_update(SMART_QSO_CRC32_INIT, header,
+                                          offsetof(KvRecordHeader_t, crc32));
+    crc = smart_qso_crc32_update(crc, value, header->length);
+    return crc ^ 0xFFFFFFFFU;
+}
+
+static uint32_t bank_header_crc(const KvBankHeader_t *header)
+{
+    return smart_qso_crc32(header, offsetof(KvBankHeader_t, crc32));
+}
+
+/**
+ * @brief Read a record's header and value from the active bank and check it
+ *
+ * @return SMART_QSO_OK if the CRC verifies; the value is in s_record_buf
+ */
+static SmartQsoResult_t read_record(uint8_t bank, uint32_t offset, KvRecordHeader_t *header)
+{
+    uint8_t *value = &s_record_buf[sizeof(*header)];
+
+    if (bank_read(bank, offset, header, sizeof(*header)) != SMART_QSO_OK) {
+        return SMART_QSO_ERROR_IO;
+    }
+    if ((header->length > KV_MAX_VALUE_LEN) ||
+        ((offset + KV_RECORD_SIZE(header->length)) > KV_BANK_SIZE)) {
+        return SMART_QSO_ERROR_INVALID;
+    }
+    if (bank_read(bank, offset + (uint32_t)sizeof(*header), value, header->length) !=
+        SMART_QSO_OK) {
+        return SMART_QSO_ERROR_IO;
+    }
+    return (record_crc(header, value) == header->crc32) ? SMART_QSO_OK : SMART_QSO_ERROR;
+}
+
+/*===========================================================================*/
+/* Index                                                                      */
+/*===========================================================================*/
+
+static KvIndexEntry_t *index_find(uint16_t key)
+{
+    for (size_t i = 0; i < s_index_count; i++) {
+        if (s_index[i].key == key) {
+            return &s_index[i];
+        }
+    }
+    return NULL;
+}
+
+static void index_remove(uint16_t key)
+{
+    KvIndexEntry_t *entry = index_find(key);
+    if (entry != NULL) {
+        *entry = s_index[s_index_count - 1U];
+        s_index_count--;
+    }
+}
+
+static SmartQsoResult_t index_update(const KvRecordHeader_t *header, uint32_t offset)
+{
+    KvIndexEntry_t *entry = index_find(header->key);
+    if (entry == NULL) {
+        if (s_index_count >= KV_MAX_KEYS) {
+            return SMART_QSO_ERROR_NO_MEM;
+        }
+        entry = &s_index[s_index_count];
+        s_index_count++;
+        entry->key = header->key;
+    }
+    entry->offset = offset;
+    entry->length = header->length;
+    entry->version = header->version;
+    return SMART_QSO_OK;
+}
+
+/** Space the live records would occupy after compaction */
+static uint32_t live_bytes(void)
+{
+    uint32_t total = 0;
+    for (size_t i = 0; i < s_index_count; i++) {
+        total += KV_RECORD_SIZE(s_index[i].length);
+    }
+    return total;
+}
+
+/*===========================================================================*/
+/* Mount and Compaction                                                       */
+/*===========================================================================*/
+
+/**
+ * @brief Replay a bank's log into the index
+ *
+ * Torn records are skipped; an unparseable header ends the scan and
+ * leaves the bank full so the next put compacts.
+ */
+static void replay_bank(uint8_t bank)
+{
+    uint32_t offset = sizeof(KvBankHeader_t);
+
+    while ((offset + sizeof(KvRecordHeader_t)) <= KV_BANK_SIZE) {
+        KvRecordHeader_t header;
+        SmartQsoResult_t result = read_record(bank, offset, &header);
+
+        if (result == SMART_QSO_ERROR_IO) {
+            offset = KV_BANK_SIZE;
+            break;
+        }
+        if (header.magic == 0xFFFFU) {
+            /* End of log */
+            break;
+        }
+        if ((result == SMART_QSO_ERROR_INVALID) || (header.magic != RECORD_MAGIC)) {
+            offset = KV_BANK_SIZE;
+            break;
+        }
+
+        if (result != SMART_QSO_OK) {
+            s_stats.torn_records++;
+        } else if (header.type == (uint8_t)KV_TYPE_TOMBSTONE) {
+            index_remove(header.key);
+        } else {
+            (void)index_update(&header, offset);
+        }
+
+        if (header.sequence > s_stats.sequence) {
+            s_stats.sequence = header.sequence;
+        }
+        offset += KV_RECORD_SIZE(header.length);
+    }
+
+    s_stats.write_offset = offset;
+}
+
+/**
+ * @brief Copy the live records into the other bank and switch to it
+ */
+static SmartQsoResult_t compact(void)
+{
+    uint8_t source = s_stats.active_bank;
+    uint8_t target = (source == 0U) ? 1U : 0U;
+    uint32_t offset = sizeof(KvBankHeader_t);
+
+    SmartQsoResult_t result = bank_erase(target);
+
+    for (size_t i = 0; (i < s_index_count) && (result == SMART_QSO_OK); i++) {
+        uint32_t size = KV_RECORD_SIZE(s_index[i].length);
+
+        result = bank_read(source, s_index[i].offset, s_record_buf, size);
+        if (result == SMART_QSO_OK) {
+            result = bank_write(target, offset, s_record_buf, size);
+        }
+        s_index[i].offset = offset;
+        offset += size;
+    }
+
+    /* Commit: the new bank becomes authoritative only once this lands */
+    KvBankHeader_t header;
+    memset(&header, 0, sizeof(header));
+    header.magic = BANK_MAGIC;
+    header.generation = s_stats.generation + 1U;
+    header.crc32 = bank_header_crc(&header);
+
+    if (result == SMART_QSO_OK) {
+        result = bank_write(target, 0, &header, sizeof(header));
+    }
+    if (result != SMART_QSO_OK) {
+        /* The index now points into a half-built bank: rescan on next use */
+        s_mounted = false;
+        return SMART_QSO_ERROR_IO;
+    }
+
+    s_stats.active_bank = target;
+    s_stats.generation = header.generation;
+    s_stats.write_offset = offset;
+    s_stats.compactions++;
+    return SMART_QSO_OK;
+}
+
+static SmartQsoResult_t ensure_mounted(void)
+{
+    return s_mounted ? SMART_QSO_OK : kv_store_mount();
+}
+
+/**
+ * @brief Append a record, compacting first if the active bank is full
+ */
+static SmartQsoResult_t append(uint16_t key, KvRecordType_t type, uint8_t version,
+                               const void *data, size_t len)
+{
+    uint32_t size = KV_RECORD_SIZE(len);
+
+    if ((s_stats.active_bank == NO_BANK) || ((s_stats.write_offset + size) > KV_BANK_SIZE)) {
+        if ((sizeof(KvBankHeader_t) + live_bytes() + size) > KV_BANK_SIZE) {
+            return SMART_QSO_ERROR_NO_MEM;
+        }
+        SmartQsoResult_t result = compact();
+        if (result != SMART_QSO_OK) {
+            return result;
+        }
+    }
+
+    KvRecordHeader_t header;
+    memset(&header, 0, sizeof(header));
+    header.magic = RECORD_MAGIC;
+    header.key = key;
+    header.type = (uint8_t)type;
+    header.version = version;
+    header.length = (uint16_t)len;
+    header.sequence = s_stats.sequence + 1U;
+    header.crc32 = record_crc(&header, (const uint8_t *)data);
+
+    /* Padding stays erased so it programs nothing */
+    memset(s_record_buf, ERASED_BYTE, size);
+    memcpy(s_record_buf, &header, sizeof(header));
+    if (len > 0U) {
+        memcpy(&s_record_buf[sizeof(header)], data, len);
+    }
+
+    uint32_t offset = s_stats.write_offset;
+    if (bank_write(s_stats.active_bank, offset, s_record_buf, size) != SMART_QSO_OK) {
+        /* Part of the record may have landed: never program over it */
+        s_stats.write_offset = KV_BANK_SIZE;
+        return SMART_QSO_ERROR_IO;
+    }
+
+    s_stats.write_offset = offset + size;
+    s_stats.sequence = header.sequence;
+    s_stats.puts++;
+
+    if (type == KV_TYPE_TOMBSTONE) {
+        index_remove(key);
+        return SMART_QSO_OK;
+    }
+    return index_update(&header, offset);
+}
+
+/*===========================================================================*/
+/* Public API Implementation                                                  */
+/*===========================================================================*/
+
+SmartQsoResult_t kv_store_mount(void)
+{
+    s_index_count = 0;
+    s_stats.active_bank = NO_BANK;
+    s_stats.generation = 0;
+    s_stats.sequence = 0;
+    s_stats.write_offset = KV_BANK_SIZE;
+
+    for (uint8_t bank = 0; bank < KV_BANK_COUNT; bank++) {
+        KvBankHeader_t header;
+        if ((bank_read(bank, 0, &header, sizeof(header)) == SMART_QSO_OK) &&
+            (header.magic == BANK_MAGIC) && (header.crc32 == bank_header_crc(&header)) &&
+            ((s_stats.active_bank == NO_BANK) || (header.generation > s_stats.generation))) {
+            s_stats.active_bank = bank;
+            s_stats.generation = header.generation;
+        }
+    }
+
+    if (s_stats.active_bank != NO_BANK) {
+        replay_bank(s_stats.active_bank);
+    }
+
+    s_mounted = true;
+    return SMART_QSO_OK;
+}
+
+SmartQsoResult_t kv_store_format(void)
+{
+    SmartQsoResult_t result = SMART_QSO_OK;
+
+    for (uint8_t bank = 0; (bank < KV_BANK_COUNT) && (result == SMART_QSO_OK); bank++) {
+        result = bank_erase(bank);
+    }
+
+    s_mounted = false;
+    if (result != SMART_QSO_OK) {
+        return SMART_QSO_ERROR_IO;
+    }
+    return kv_store_mount();
+}
+
+SmartQsoResult_t kv_put(uint16_t key, uint8_t version, const void *data, size_t len)
+{
+    if (data == NULL) {
+        return SMART_QSO_ERROR_NULL_PTR;
+    }
+    if ((len == 0U) || (len > KV_MAX_VALUE_LEN)) {
+        return SMART_QSO_ERROR_INVALID;
+    }
+
+    SmartQsoResult_t result = ensure_mounted();
+    if (result != SMART_QSO_OK) {
+        return result;
+    }
+    if ((index_find(key) == NULL) && (s_index_count >= KV_MAX_KEYS)) {
+        return SMART_QSO_ERROR_NO_MEM;
+    }
+
+    return append(key, KV_TYPE_VALUE, version, data, len);
+}
+
+SmartQsoResult_t kv_get(uint16_t key, uint8_t version, void *data, size_t size,
+                        size_t *len)
+{
+    if (data == NULL) {
+        return SMART_QSO_ERROR_NULL_PTR;
+    }
+
+    SmartQsoResult_t result = ensure_mounted();
+    if (result != SMART_QSO_OK) {
+        return result;
+    }
+
+    const KvIndexEntry_t *entry = index_find(key);
+    if (entry == NULL) {
+        return SMART_QSO_ERROR;
+    }
+    if (entry->version != version) {
+        return SMART_QSO_ERROR_INVALID;
+    }
+    if (entry->length > size) {
+        return SMART_QSO_ERROR_NO_MEM;
+    }
+
+    /* Re-check the CRC: flash may have changed since mount */
+    KvRecordHeader_t header;
+    if ((read_record(s_stats.active_bank, entry->offset, &header) != SMART_QSO_OK) ||
+        (header.key != key)) {
+        return SMART_QSO_ERROR_IO;
+    }
+
+    memcpy(data, &s_record_buf[sizeof(header)], header.length);
+    if (len != NULL) {
+        *len = header.length;
+    }
+    return SMART_QSO_OK;
+}
+
+SmartQsoResult_t kv_delete(uint16_t key)
+{
+    SmartQsoResult_t result = ensure_mounted();
+    if (result != SMART_QSO_OK) {
+        return result;
+    }
+    if (index_find(key) == NULL) {
+        return SMART_QSO_OK;
+    }
+
+    uint8_t none = 0U;
+    return append(key, KV_TYPE_TOMBSTONE, 0U, &none, 0U);
+}
+
+SmartQsoResult_t kv_store_compact(void)
+{
+    SmartQsoResult_t result = ensure_mounted();
+    if (result != SMART_QSO_OK) {
+        return result;
+    }
+    return compact();
+}
+
+SmartQsoResult_t kv_store_get_stats(KvStats_t *stats)
+{
+    if (stats == NULL) {
+        return SMART_QSO_ERROR_NULL_PTR;
+    }
+
+    SmartQsoResult_t result = ensure_mounted();
+    if (result != SMART_QSO_OK) {
+        return result;
+    }
+
+    *stats = s_stats;
+    stats->live_keys = (uint32_t)s_index_count;
+    stats->live_bytes = live_bytes();
+    return SMART_QSO_OK;
+}
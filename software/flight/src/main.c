@@ -17,11 +17,15 @@
 #define _XOPEN_SOURCE 600
 
 #include "smart_qso.h"
+#include "crc32.h"
 #include "eps_control.h"
 #include "fault_mgmt.h"
 #include "sensors.h"
 #include "uart_comm.h"
 #include "mission_data.h"
+#include "persistence.h"
+#include "watchdog_mgr.h"
+#include "hal/hal.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -42,8 +46,10 @@
 /** Health check interval in milliseconds */
 #define HEALTH_CHECK_INTERVAL_MS 10000
 
-/** Data persistence interval in ticks */
-#define PERSISTENCE_INTERVAL_TICKS 100
+#ifdef HAL_TARGET_SIMULATION
+/** Host file holding the simulated flash image across runs */
+#define SIM_FLASH_IMAGE_FILE "/tmp/smart_qso_flash.img"
+#endif
 
 /*===========================================================================*/
 /* Module State                                                               */
@@ -110,6 +116,24 @@ static SmartQsoResult_t init_system(void)
     /* Record start time */
     s_program_start_ms = smart_qso_now_ms();
 
+    /* Select the fastest CRC32 engine before anything checks persisted data */
+    printf("[SYSTEM] CRC32 engine: %s\n", crc32_impl_name(crc32_init()));
+
+    /* Bring up the flash before any module loads its persisted state */
+#ifdef HAL_TARGET_SIMULATION
+    HalFlashSimConfig_t flash_config;
+    hal_flash_sim_default_config(&flash_config);
+    flash_config.backing_file = SIM_FLASH_IMAGE_FILE;
+    (void)hal_flash_sim_configure(&flash_config);
+#endif
+    bool flash_ok = (hal_flash_init() == SMART_QSO_OK);
+    if (!flash_ok) {
+        fprintf(stderr, "[SYSTEM] Flash init failed, state will not persist\n");
+    }
+
+    /* Start the persistence service before any module marks state dirty */
+    (void)persist_init();
+
     /* Initialize fault management first (for logging during init) */
     result = fault_mgmt_init();
     if (result != SMART_QSO_OK) {
@@ -138,13 +162,21 @@ static SmartQsoResult_t init_system(void)
         return result;
     }
 
-    /* Load sensor configuration */
+    /* Load sensor configuration: the compiled image in flash, else YAML */
     const char *yaml_path = getenv("SENSORS_YAML");
     if (yaml_path == NULL) {
         yaml_path = "software/flight/sensors.yaml";
     }
 
-    result = sensors_load_yaml(yaml_path);
+    result = SMART_QSO_ERROR;
+    if (flash_ok) {
+        result = sensors_load_flash();
+    }
+    if (result == SMART_QSO_OK) {
+        printf("[SYSTEM] Sensor configuration loaded from flash image\n");
+    } else {
+        result = sensors_load_yaml(yaml_path);
+    }
     if (result != SMART_QSO_OK) {
         fprintf(stderr, "[WARN] Using default sensors (could not load %s)\n", yaml_path);
         result = sensors_load_defaults();
@@ -162,6 +194,12 @@ static SmartQsoResult_t init_system(void)
                       "UART initialization failed", s_soc);
     }
 
+    /* Coalesced saves from the main loop; forced only before a reset */
+    (void)persist_register(PERSIST_MODULE_MISSION, mission_data_save);
+    (void)persist_register(PERSIST_MODULE_EPS, eps_save_config);
+    (void)persist_register(PERSIST_MODULE_FAULT_LOG, fault_log_flush);
+    (void)wdt_mgr_register_prereset_callback(persist_prereset_handler);
+
     /* Initialize timing */
     s_last_telemetry_ms = s_program_start_ms;
     s_last_health_check_ms = s_program_start_ms;
@@ -227,6 +265,8 @@ static void update_mission_state(uint64_t tick)
     uint64_t now = smart_qso_now_ms();
     if ((now - s_last_watchdog_reset_ms) > SMART_QSO_WATCHDOG_TIMEOUT_MS) {
         (void)fault_handle_watchdog(s_soc);
+        /* Simulated reset: flush as the hardware early warning would */
+        persist_prereset_handler();
         s_last_watchdog_reset_ms = now;
     }
 
@@ -422,15 +462,22 @@ static SmartQsoResult_t run_main_loop(void)
         /* Sensor polling */
         (void)sensors_poll(now);
 
-        /* Periodic data persistence */
-        if (tick % PERSISTENCE_INTERVAL_TICKS == 0) {
-            (void)mission_data_save();
-            (void)eps_save_config();
+        /* Low-priority slot: coalesced data persistence */
+        persist_task();
+
+        /* Sleep until the next sensor is due, at most one loop period */
+        long sleep_ns = MAIN_LOOP_SLEEP_NS;
+        uint64_t next_poll = sensors_next_poll_ms();
+        uint64_t after = smart_qso_now_ms();
+        if (next_poll <= after) {
+            sleep_ns = 0;
+        } else if ((next_poll - after) < (uint64_t)(MAIN_LOOP_SLEEP_NS / 1000000L)) {
+            sleep_ns = (long)(next_poll - after) * 1000000L;
+        }
+        if (sleep_ns > 0) {
+            struct timespec ts = {.tv_sec = 0, .tv_nsec = sleep_ns};
+            nanosleep(&ts, NULL);
         }
-
-        /* Sleep */
-        struct timespec ts = {.tv_sec = 0, .tv_nsec = MAIN_LOOP_SLEEP_NS};
-        nanosleep(&ts, NULL);
     }
 
     return SMART_QSO_OK;
@@ -447,10 +494,9 @@ static void shutdown_system(void)
 {
     printf("[SYSTEM] Shutting down gracefully...\n");
 
-    /* Save final state */
-    (void)mission_data_save();
-    (void)eps_save_config();
-    (void)fault_log_save();
+    /* Save final state, with the uptime and energy since the last checkpoint */
+    persist_mark_dirty(PERSIST_MODULE_MISSION);
+    (void)persist_flush_all();
 
     /* Close UART */
     (void)uart_close();
@@ -8,6 +8,8 @@
  */
 
 #include "mission_data.h"
+#include "kv_store.h"
+#include "persistence.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -22,6 +24,9 @@ static MissionData_t s_mission_data = {0};
 /** Flag indicating if module is initialized */
 static bool s_initialized = false;
 
+/** When the data was last queued for saving */
+static uint64_t s_last_checkpoint_ms = 0;
+
 /*===========================================================================*/
 /* Internal Functions                                                         */
 /*===========================================================================*/
@@ -35,6 +40,31 @@ static void mission_data_update_crc(void)
     s_mission_data.crc32 = smart_qso_crc32(&s_mission_data, crc_offset);
 }
 
+/**
+ * @brief Refresh the CRC and queue the data for the persistence service
+ */
+static void mission_data_changed(void)
+{
+    mission_data_update_crc();
+    persist_mark_dirty(PERSIST_MODULE_MISSION);
+    s_last_checkpoint_ms = smart_qso_now_ms();
+}
+
+/**
+ * @brief Refresh the CRC after a running total changed; queue the data only
+ *        once a checkpoint interval has passed
+ */
+static void mission_data_accumulated(void)
+{
+    uint64_t now = smart_qso_now_ms();
+
+    mission_data_update_crc();
+    if ((now - s_last_checkpoint_ms) >= MISSION_DATA_CHECKPOINT_MS) {
+        persist_mark_dirty(PERSIST_MODULE_MISSION);
+        s_last_checkpoint_ms = now;
+    }
+}
+
 /*===========================================================================*/
 /* Public API Implementation                                                  */
 /*===========================================================================*/
@@ -56,14 +86,14 @@ SmartQsoResult_t mission_data_init(void)
         strncpy(s_mission_data.last_fault, "System startup",
                 sizeof(s_mission_data.last_fault) - 1);
         s_mission_data.last_fault[sizeof(s_mission_data.last_fault) - 1] = '\0';
-        mission_data_update_crc();
+        mission_data_changed();
 
         printf("[MISSION] Initialized new mission data\n");
     } else {
         /* Update for this session */
         s_mission_data.reset_count++;
         s_mission_data.last_reset_ms = smart_qso_now_ms();
-        mission_data_update_crc();
+        mission_data_changed();
 
         printf("[MISSION] Loaded mission data (reset #%u)\n",
                s_mission_data.reset_count);
@@ -88,14 +118,14 @@ SmartQsoResult_t mission_data_get(MissionData_t *data)
 SmartQsoResult_t mission_data_set_start(uint64_t start_ms)
 {
     s_mission_data.mission_start_ms = start_ms;
-    mission_data_update_crc();
+    mission_data_changed();
     return SMART_QSO_OK;
 }
 
 SmartQsoResult_t mission_data_update_uptime(uint64_t uptime_ms)
 {
     s_mission_data.total_uptime_ms = uptime_ms;
-    mission_data_update_crc();
+    mission_data_accumulated();
     return SMART_QSO_OK;
 }
 
@@ -103,14 +133,14 @@ SmartQsoResult_t mission_data_increment_reset(void)
 {
     s_mission_data.reset_count++;
     s_mission_data.last_reset_ms = smart_qso_now_ms();
-    mission_data_update_crc();
+    mission_data_changed();
     return SMART_QSO_OK;
 }
 
 SmartQsoResult_t mission_data_add_energy(double energy_wh)
 {
     s_mission_data.total_energy_wh += energy_wh;
-    mission_data_update_crc();
+    mission_data_accumulated();
     return SMART_QSO_OK;
 }
 
@@ -119,7 +149,7 @@ SmartQsoResult_t mission_data_set_phase(MissionPhase_t phase)
     SMART_QSO_REQUIRE(phase <= MISSION_PHASE_EOL, "Invalid mission phase");
 
     s_mission_data.mission_phase = (uint8_t)phase;
-    mission_data_update_crc();
+    mission_data_changed();
     return SMART_QSO_OK;
 }
 
@@ -136,48 +166,31 @@ SmartQsoResult_t mission_data_record_fault(const char *description)
     strncpy(s_mission_data.last_fault, description,
             sizeof(s_mission_data.last_fault) - 1);
     s_mission_data.last_fault[sizeof(s_mission_data.last_fault) - 1] = '\0';
-    mission_data_update_crc();
+    mission_data_changed();
 
     return SMART_QSO_OK;
 }
 
 SmartQsoResult_t mission_data_save(void)
 {
-    FILE *f = fopen(MISSION_DATA_FILE, "wb");
-    if (f == NULL) {
-        return SMART_QSO_ERROR_IO;
-    }
-
     mission_data_update_crc();
-    size_t written = fwrite(&s_mission_data, sizeof(MissionData_t), 1, f);
-
-    if (fclose(f) != 0) {
-        return SMART_QSO_ERROR_IO;
-    }
-
-    if (written != 1) {
-        return SMART_QSO_ERROR_IO;
-    }
-
-    return SMART_QSO_OK;
+    return kv_put(KV_KEY_MISSION_DATA, MISSION_DATA_SCHEMA_VERSION,
+                  &s_mission_data, sizeof(MissionData_t));
 }
 
 SmartQsoResult_t mission_data_load(void)
 {
-    FILE *f = fopen(MISSION_DATA_FILE, "rb");
-    if (f == NULL) {
-        return SMART_QSO_ERROR_IO;
-    }
-
     MissionData_t loaded_data;
-    size_t read_count = fread(&loaded_data, sizeof(MissionData_t), 1, f);
+    size_t len = 0;
 
-    if (fclose(f) != 0) {
-        return SMART_QSO_ERROR_IO;
+    SmartQsoResult_t result = kv_get(KV_KEY_MISSION_DATA, MISSION_DATA_SCHEMA_VERSION,
+                                     &loaded_data, sizeof(loaded_data), &len);
+    if (result != SMART_QSO_OK) {
+        return result;
     }
 
-    if (read_count != 1) {
-        return SMART_QSO_ERROR_IO;
+    if (len != sizeof(MissionData_t)) {
+        return SMART_QSO_ERROR_INVALID;
     }
 
     /* Verify CRC */
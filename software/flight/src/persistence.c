@@ -0,0 +1,175 @@
+/**
+ * @file persistence.c
+ * @brief Write-coalescing persistence service implementation
+ *
+ * @requirement SRS-DATA-001 System shall persist mission data across resets
+ * @requirement SRS-F051 Save state before watchdog reset
+ */
+
+#include "persistence.h"
+
+#include <string.h>
+
+/*===========================================================================*/
+/* Module State                                                               */
+/*===========================================================================*/
+
+/**
+ * @brief Per-module bookkeeping
+ */
+typedef struct {
+    PersistSaveFunc_t save;     /**< Registered save function */
+    uint64_t dirty_since_ms;    /**< Time of the oldest unsaved change */
+    bool dirty;                 /**< Unsaved changes pending */
+} PersistEntry_t;
+
+/** Registered modules */
+static PersistEntry_t s_modules[PERSIST_MODULE_COUNT];
+
+/** Coalescing window (ms) */
+static uint32_t s_window_ms = PERSIST_DEFAULT_WINDOW_MS;
+
+/** Statistics */
+static PersistStats_t s_stats;
+
+/*===========================================================================*/
+/* Internal Functions                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief Save one dirty module
+ *
+ * @return true if the module is clean afterwards
+ */
+static bool save_module(PersistEntry_t *entry, uint64_t now_ms)
+{
+    if (entry->save == NULL) {
+        /* Nothing can save it yet; keep the change for later */
+        return false;
+    }
+
+    if (entry->save() != SMART_QSO_OK) {
+        s_stats.save_errors++;
+        /* Retry one window from now */
+        entry->dirty_since_ms = now_ms;
+        return false;
+    }
+
+    s_stats.saves++;
+    entry->dirty = false;
+    return true;
+}
+
+/*===========================================================================*/
+/* Public API Implementation                                                  */
+/*===========================================================================*/
+
+SmartQsoResult_t persist_init(void)
+{
+    memset(s_modules, 0, sizeof(s_modules));
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_window_ms = PERSIST_DEFAULT_WINDOW_MS;
+    return SMART_QSO_OK;
+}
+
+SmartQsoResult_t persist_register(PersistModule_t module, PersistSaveFunc_t save)
+{
+    if (save == NULL) {
+        return SMART_QSO_ERROR_NULL_PTR;
+    }
+    if ((uint32_t)module >= (uint32_t)PERSIST_MODULE_COUNT) {
+        return SMART_QSO_ERROR_PARAM;
+    }
+
+    s_modules[module].save = save;
+    return SMART_QSO_OK;
+}
+
+void persist_mark_dirty(PersistModule_t module)
+{
+    if ((uint32_t)module >= (uint32_t)PERSIST_MODULE_COUNT) {
+        return;
+    }
+
+    PersistEntry_t *entry = &s_modules[module];
+    if (!entry->dirty) {
+        entry->dirty = true;
+        entry->dirty_since_ms = smart_qso_now_ms();
+    }
+    s_stats.marks++;
+}
+
+bool persist_is_dirty(PersistModule_t module)
+{
+    if ((uint32_t)module >= (uint32_t)PERSIST_MODULE_COUNT) {
+        return false;
+    }
+    return s_modules[module].dirty;
+}
+
+SmartQsoResult_t persist_set_window_ms(uint32_t window_ms)
+{
+    if (window_ms > PERSIST_MAX_WINDOW_MS) {
+        return SMART_QSO_ERROR_PARAM;
+    }
+    s_window_ms = window_ms;
+    return SMART_QSO_OK;
+}
+
+uint32_t persist_get_window_ms(void)
+{
+    return s_window_ms;
+}
+
+size_t persist_service(uint64_t now_ms)
+{
+    size_t saved = 0;
+
+    for (size_t i = 0; i < (size_t)PERSIST_MODULE_COUNT; i++) {
+        PersistEntry_t *entry = &s_modules[i];
+
+        if (entry->dirty && ((now_ms - entry->dirty_since_ms) >= s_window_ms) &&
+            save_module(entry, now_ms)) {
+            saved++;
+        }
+    }
+
+    return saved;
+}
+
+void persist_task(void)
+{
+    (void)persist_service(smart_qso_now_ms());
+}
+
+SmartQsoResult_t persist_flush_all(void)
+{
+    SmartQsoResult_t result = SMART_QSO_OK;
+    uint64_t now_ms = smart_qso_now_ms();
+
+    s_stats.forced_flushes++;
+    for (size_t i = 0; i < (size_t)PERSIST_MODULE_COUNT; i++) {
+        PersistEntry_t *entry = &s_modules[i];
+
+        if (entry->dirty && !save_module(entry, now_ms)) {
+            result = SMART_QSO_ERROR_IO;
+        }
+    }
+
+    return result;
+}
+
+void persist_prereset_handler(void)
+{
+    (void)persist_flush_all();
+}
+
+SmartQsoResult_t persist_get_stats(PersistStats_t *stats)
+{
+    if (stats == NULL) {
+        return SMART_QSO_ERROR_NULL_PTR;
+    }
+
+    *stats = s_stats;
+    return SMART_QSO_OK;
+}
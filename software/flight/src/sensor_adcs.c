@@ -0,0 +1,92 @@
+/**
+ * @file sensor_adcs.c
+ * @brief ADCS sensor drivers
+ *
+ * Publishes the ADCS magnetometer and sun sensors through the sensor
+ * framework, so they are polled, filtered and reported in telemetry like
+ * the EPS sensors. Each batch read takes one ADCS measurement for all the
+ * axes due in the poll.
+ *
+ * @requirement SRS-SENS-001 System shall support configurable sensor framework
+ */
+
+#include "sensor_driver.h"
+#include "sensor_image.h"
+#include "adcs_control.h"
+
+/*===========================================================================*/
+/* Internal Functions                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief Fill readings with the axes of one vector
+ *
+ * @param valid false if the measurement failed; every reading is invalid
+ */
+static void read_axes(const Vec3_t *v, bool valid, const uint8_t *channels,
+                      SensorReading_t *readings, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        readings[i].valid = valid;
+        switch (channels[i]) {
+            case SENSOR_IMAGE_CHANNEL_X:
+                readings[i].value = v->x;
+                break;
+            case SENSOR_IMAGE_CHANNEL_Y:
+                readings[i].value = v->y;
+                break;
+            case SENSOR_IMAGE_CHANNEL_Z:
+                readings[i].value = v->z;
+                break;
+            default:
+                readings[i].valid = false;
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Probe the magnetometer
+ */
+static SmartQsoResult_t magnetometer_init(void)
+{
+    MagData_t mag;
+    return adcs_read_magnetometer(&mag);
+}
+
+static void magnetometer_read(const uint8_t *channels, SensorReading_t *readings, size_t count)
+{
+    MagData_t mag = {0};
+    bool valid = (adcs_read_magnetometer(&mag) == SMART_QSO_OK) && mag.valid;
+
+    read_axes(&mag.field, valid, channels, readings, count);
+}
+
+/**
+ * @brief Probe the sun sensors
+ */
+static SmartQsoResult_t sun_sensor_init(void)
+{
+    SunSensorData_t sun;
+    return adcs_read_sun_sensors(&sun);
+}
+
+static void sun_sensor_read(const uint8_t *channels, SensorReading_t *readings, size_t count)
+{
+    SunSensorData_t sun = {0};
+    bool valid = (adcs_read_sun_sensors(&sun) == SMART_QSO_OK);
+
+    read_axes(&sun.sun_vector, valid, channels, readings, count);
+}
+
+/*===========================================================================*/
+/* Drivers                                                                    */
+/*===========================================================================*/
+
+const SensorDriver_t sensor_driver_magnetometer = {
+    "magnetometer", SENSOR_VALUE_NUMERIC, magnetometer_init, magnetometer_read
+};
+
+const SensorDriver_t sensor_driver_sun_sensor = {
+    "sun_sensor", SENSOR_VALUE_NUMERIC, sun_sensor_init, sun_sensor_read
+};
@@ -0,0 +1,287 @@
+/**
+ * @file sensor_filter.c
+ * @brief Per-sensor filtering and decimation pipeline implementation
+ *
+ * @requirement SRS-SENS-003 System shall validate sensor readings
+ * @requirement SRS-F071 Sample sensors at configurable rates
+ */
+
+#include "sensor_filter.h"
+
+#include <string.h>
+
+/*===========================================================================*/
+/* Module State                                                               */
+/*===========================================================================*/
+
+/**
+ * Pipeline state, one array per field indexed by sensor slot. The window
+ * statistics of a slot are valid once win_count > 0.
+ */
+static struct {
+    SensorFilterConfig_t config[SMART_QSO_MAX_SENSORS];
+    double ring[SMART_QSO_MAX_SENSORS][SENSOR_FILTER_MAX_LENGTH]; /**< Last samples */
+    double iir[SMART_QSO_MAX_SENSORS];          /**< IIR output */
+    double win_min[SMART_QSO_MAX_SENSORS];      /**< Decimation window minimum */
+    double win_max[SMART_QSO_MAX_SENSORS];      /**< Decimation window maximum */
+    double win_sum[SMART_QSO_MAX_SENSORS];      /**< Decimation window sum */
+    SensorSummary_t summary[SMART_QSO_MAX_SENSORS]; /**< Last completed window */
+    uint16_t win_count[SMART_QSO_MAX_SENSORS];  /**< Samples in the window */
+    uint8_t ring_head[SMART_QSO_MAX_SENSORS];   /**< Next ring position */
+    uint8_t ring_count[SMART_QSO_MAX_SENSORS];  /**< Samples in the ring */
+    bool primed[SMART_QSO_MAX_SENSORS];         /**< IIR has a sample */
+} s_filter;
+
+/** Configuration names */
+static const struct {
+    const char *name;
+    SensorFilterKind_t kind;
+} s_kinds[] = {
+    {"none", SENSOR_FILTER_NONE},
+    {"moving_average", SENSOR_FILTER_MOVING_AVERAGE},
+    {"iir", SENSOR_FILTER_IIR},
+    {"median", SENSOR_FILTER_MEDIAN},
+};
+
+/*===========================================================================*/
+/* Internal Functions                                                         */
+/*===========================================================================*/
+
+static void clear_slot(size_t slot)
+{
+    memset(s_filter.ring[slot], 0, sizeof(s_filter.ring[slot]));
+    s_filter.iir[slot] = 0.0;
+    s_filter.win_min[slot] = 0.0;
+    s_filter.win_max[slot] = 0.0;
+    s_filter.win_sum[slot] = 0.0;
+    memset(&s_filter.summary[slot], 0, sizeof(s_filter.summary[slot]));
+    s_filter.win_count[slot] = 0;
+    s_filter.ring_head[slot] = 0;
+    s_filter.ring_count[slot] = 0;
+    s_filter.primed[slot] = false;
+}
+
+static void default_config(SensorFilterConfig_t *config)
+{
+    config->kind = SENSOR_FILTER_NONE;
+    config->length = 1U;
+    config->decimation = 1U;
+    config->alpha = 1.0;
+}
+
+/**
+ * @brief Fill in defaults and check a configuration's ranges
+ */
+static SmartQsoResult_t normalize_config(SensorFilterConfig_t *cfg)
+{
+    if (cfg->length == 0U) {
+        cfg->length = 1U;
+    }
+    if (cfg->decimation == 0U) {
+        cfg->decimation = 1U;
+    }
+    if (((uint32_t)cfg->kind > (uint32_t)SENSOR_FILTER_MEDIAN) ||
+        (cfg->length > SENSOR_FILTER_MAX_LENGTH) ||
+        (cfg->decimation > SENSOR_FILTER_MAX_DECIMATION)) {
+        return SMART_QSO_ERROR_PARAM;
+    }
+    if (cfg->kind == SENSOR_FILTER_IIR) {
+        if (!(cfg->alpha > 0.0) || (cfg->alpha > 1.0)) {
+            return SMART_QSO_ERROR_PARAM;
+        }
+    } else {
+        /* Only the IIR stage reads alpha; 1 passes samples through it */
+        cfg->alpha = 1.0;
+    }
+    return SMART_QSO_OK;
+}
+
+/**
+ * @brief Moving average or median over a slot's last samples
+ */
+static double window_filter(size_t slot, double x)
+{
+    const SensorFilterConfig_t *config = &s_filter.config[slot];
+    double *ring = s_filter.ring[slot];
+    uint8_t count = s_filter.ring_count[slot];
+
+    ring[s_filter.ring_head[slot]] = x;
+    s_filter.ring_head[slot] = (uint8_t)((s_filter.ring_head[slot] + 1U) % config->length);
+    if (count < config->length) {
+        count++;
+        s_filter.ring_count[slot] = count;
+    }
+
+    if (config->kind == SENSOR_FILTER_MOVING_AVERAGE) {
+        double sum = 0.0;
+        for (uint8_t k = 0; k < count; k++) {
+            sum += ring[k];
+        }
+        return sum / (double)count;
+    }
+
+    /* Median: insertion sort of at most SENSOR_FILTER_MAX_LENGTH samples */
+    double sorted[SENSOR_FILTER_MAX_LENGTH];
+    for (uint8_t k = 0; k < count; k++) {
+        double v = ring[k];
+        uint8_t j = k;
+        while ((j > 0U) && (sorted[j - 1U] > v)) {
+            sorted[j] = sorted[j - 1U];
+            j--;
+        }
+        sorted[j] = v;
+    }
+    if ((count % 2U) != 0U) {
+        return sorted[count / 2U];
+    }
+    return (sorted[(count / 2U) - 1U] + sorted[count / 2U]) / 2.0;
+}
+
+/*===========================================================================*/
+/* Public API Implementation                                                  */
+/*===========================================================================*/
+
+SmartQsoResult_t sensor_filter_parse_kind(const char *name, SensorFilterKind_t *kind)
+{
+    if ((name == NULL) || (kind == NULL)) {
+        return SMART_QSO_ERROR_NULL_PTR;
+    }
+    for (size_t i = 0; i < sizeof(s_kinds) / sizeof(s_kinds[0]); i++) {
+        if (strcmp(name, s_kinds[i].name) == 0) {
+            *kind = s_kinds[i].kind;
+            return SMART_QSO_OK;
+        }
+    }
+    return SMART_QSO_ERROR_PARAM;
+}
+
+void sensor_filter_reset(void)
+{
+    memset(&s_filter, 0, sizeof(s_filter));
+    for (size_t slot = 0; slot < SMART_QSO_MAX_SENSORS; slot++) {
+        default_config(&s_filter.config[slot]);
+    }
+}
+
+SmartQsoResult_t sensor_filter_validate(const SensorFilterConfig_t *config)
+{
+    if (config == NULL) {
+        return SMART_QSO_ERROR_NULL_PTR;
+    }
+    SensorFilterConfig_t cfg = *config;
+    return normalize_config(&cfg);
+}
+
+SmartQsoResult_t sensor_filter_configure(size_t slot, const SensorFilterConfig_t *config)
+{
+    if (config == NULL) {
+        return SMART_QSO_ERROR_NULL_PTR;
+    }
+    if (slot >= SMART_QSO_MAX_SENSORS) {
+        return SMART_QSO_ERROR_PARAM;
+    }
+
+    SensorFilterConfig_t cfg = *config;
+    SmartQsoResult_t result = normalize_config(&cfg);
+    if (result != SMART_QSO_OK) {
+        return result;
+    }
+
+    s_filter.config[slot] = cfg;
+    clear_slot(slot);
+    return SMART_QSO_OK;
+}
+
+SmartQsoResult_t sensor_filter_get_config(size_t slot, SensorFilterConfig_t *config)
+{
+    if (config == NULL) {
+        return SMART_QSO_ERROR_NULL_PTR;
+    }
+    if (slot >= SMART_QSO_MAX_SENSORS) {
+        return SMART_QSO_ERROR_PARAM;
+    }
+    *config = s_filter.config[slot];
+    return SMART_QSO_OK;
+}
+
+void sensor_filter_update(const uint16_t *slots, const double *raw, size_t count,
+                          double *value, bool *published)
+{
+    double prev[SMART_QSO_MAX_SENSORS];
+    double alpha[SMART_QSO_MAX_SENSORS];
+    double y[SMART_QSO_MAX_SENSORS];
+    double wmin[SMART_QSO_MAX_SENSORS];
+    double wmax[SMART_QSO_MAX_SENSORS];
+    double wsum[SMART_QSO_MAX_SENSORS];
+    uint16_t wcount[SMART_QSO_MAX_SENSORS];
+
+    SMART_QSO_REQUIRE(count <= SMART_QSO_MAX_SENSORS, "Batch larger than the sensor table");
+
+    /* Gather: a sensor without IIR history starts from its sample */
+    for (size_t n = 0; n < count; n++) {
+        size_t i = slots[n];
+        bool history = s_filter.primed[i] && (s_filter.config[i].kind == SENSOR_FILTER_IIR);
+        prev[n] = history ? s_filter.iir[i] : raw[n];
+        alpha[n] = s_filter.config[i].alpha;
+        wmin[n] = s_filter.win_min[i];
+        wmax[n] = s_filter.win_max[i];
+        wsum[n] = s_filter.win_sum[i];
+        wcount[n] = s_filter.win_count[i];
+    }
+
+    /* IIR stage; other sensors pass through (prev == raw) */
+    for (size_t n = 0; n < count; n++) {
+        y[n] = prev[n] + alpha[n] * (raw[n] - prev[n]);
+    }
+
+    /* Window filters */
+    for (size_t n = 0; n < count; n++) {
+        SensorFilterKind_t kind = s_filter.config[slots[n]].kind;
+        if ((kind == SENSOR_FILTER_MOVING_AVERAGE) || (kind == SENSOR_FILTER_MEDIAN)) {
+            y[n] = window_filter(slots[n], y[n]);
+        }
+    }
+
+    /* Decimation window statistics */
+    for (size_t n = 0; n < count; n++) {
+        bool first = (wcount[n] == 0U);
+        wmin[n] = (first || (y[n] < wmin[n])) ? y[n] : wmin[n];
+        wmax[n] = (first || (y[n] > wmax[n])) ? y[n] : wmax[n];
+        wsum[n] = (first ? 0.0 : wsum[n]) + y[n];
+        wcount[n]++;
+    }
+
+    /* Scatter and publish completed windows */
+    for (size_t n = 0; n < count; n++) {
+        size_t i = slots[n];
+
+        s_filter.iir[i] = y[n];
+        s_filter.primed[i] = true;
+        value[n] = y[n];
+        published[n] = (wcount[n] >= s_filter.config[i].decimation);
+
+        if (published[n]) {
+            s_filter.summary[i].min = wmin[n];
+            s_filter.summary[i].max = wmax[n];
+            s_filter.summary[i].mean = wsum[n] / (double)wcount[n];
+            s_filter.summary[i].samples = wcount[n];
+            wcount[n] = 0;
+        }
+        s_filter.win_min[i] = wmin[n];
+        s_filter.win_max[i] = wmax[n];
+        s_filter.win_sum[i] = wsum[n];
+        s_filter.win_count[i] = wcount[n];
+    }
+}
+
+SmartQsoResult_t sensor_filter_get_summary(size_t slot, SensorSummary_t *summary)
+{
+    if (summary == NULL) {
+        return SMART_QSO_ERROR_NULL_PTR;
+    }
+    if (slot >= SMART_QSO_MAX_SENSORS) {
+        return SMART_QSO_ERROR_PARAM;
+    }
+    *summary = s_filter.summary[slot];
+    return SMART_QSO_OK;
+}
@@ -0,0 +1,134 @@
+/**
+ * @file sensor_fixed.c
+ * @brief Fixed-point sensor values implementation
+ *
+ * @requirement SRS-SENS-001 System shall support configurable sensor framework
+ */
+
+#include "sensor_fixed.h"
+
+#include <math.h>
+
+/*===========================================================================*/
+/* Internal Data                                                              */
+/*===========================================================================*/
+
+/** 10^n for n up to SENSOR_FIXED_MAX_DECIMALS */
+static const int32_t s_pow10[SENSOR_FIXED_MAX_DECIMALS + 1U] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000
+};
+
+/*===========================================================================*/
+/* Internal Functions                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief Clamp a decimal place count to the supported range
+ */
+static uint8_t clamp_decimals(uint8_t decimals)
+{
+    return (decimals > SENSOR_FIXED_MAX_DECIMALS) ? (uint8_t)SENSOR_FIXED_MAX_DECIMALS : decimals;
+}
+
+/*===========================================================================*/
+/* Public API Implementation                                                  */
+/*===========================================================================*/
+
+int32_t sensor_fixed_from_double(double value, uint8_t decimals)
+{
+    double scaled = value * (double)s_pow10[clamp_decimals(decimals)];
+
+    if (isnan(scaled)) {
+        return 0;
+    }
+    if (scaled >= 2147483647.0) {
+        return INT32_MAX;
+    }
+    if (scaled <= -2147483648.0) {
+        return INT32_MIN;
+    }
+
+    /* The fraction left after truncation is exact, so halves round as in
+     * lround() */
+    int32_t whole = (int32_t)scaled;
+    double frac = scaled - (double)whole;
+    if (frac >= 0.5) {
+        whole++;
+    } else if (frac <= -0.5) {
+        whole--;
+    } else {
+        /* Already nearest */
+    }
+    return whole;
+}
+
+int32_t sensor_fixed_rescale(int32_t value, uint8_t from, uint8_t to)
+{
+    if (from == to) {
+        return value;
+    }
+    from = clamp_decimals(from);
+    to = clamp_decimals(to);
+
+    if (to > from) {
+        int64_t scaled = (int64_t)value * s_pow10[to - from];
+        if (scaled > INT32_MAX) {
+            return INT32_MAX;
+        }
+        if (scaled < INT32_MIN) {
+            return INT32_MIN;
+        }
+        return (int32_t)scaled;
+    }
+
+    int32_t div = s_pow10[from - to];
+    int32_t q = value / div;
+    int32_t r = value % div;
+    if (r >= (div - r)) {
+        q++;
+    } else if (-r >= (div + r)) {
+        q--;
+    } else {
+        /* Already nearest */
+    }
+    return q;
+}
+
+int16_t sensor_fixed_to_i16(int32_t value)
+{
+    if (value > INT16_MAX) {
+        return INT16_MAX;
+    }
+    if (value < INT16_MIN) {
+        return INT16_MIN;
+    }
+    return (int16_t)value;
+}
+
+size_t sensor_fixed_format(int32_t value, uint8_t decimals, char *text)
+{
+    char digits[10];
+    size_t num_digits = 0;
+    size_t len = 0;
+
+    decimals = clamp_decimals(decimals);
+
+    /* Digits least significant first, at least one before the point */
+    uint32_t mag = (value < 0) ? (0U - (uint32_t)value) : (uint32_t)value;
+    do {
+        digits[num_digits++] = (char)('0' + (mag % 10U));
+        mag /= 10U;
+    } while ((mag > 0U) || (num_digits <= decimals));
+
+    if (value < 0) {
+        text[len++] = '-';
+    }
+    while (num_digits > 0U) {
+        if (num_digits == decimals) {
+            text[len++] = '.';
+        }
+        text[len++] = digits[--num_digits];
+    }
+    text[len] = '\0';
+    return len;
+}
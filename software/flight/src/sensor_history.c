@@ -0,0 +1,153 @@
+/**
+ * @file sensor_history.c
+ * @brief Per-sensor time series of published samples implementation
+ *
+ * @requirement SRS-F071 Sample sensors at configurable rates
+ */
+
+#include "sensor_history.h"
+
+#include <string.h>
+
+_Static_assert(SENSOR_HISTORY_POOL_SIZE <= 65535, "Ring offsets are 16-bit");
+
+/*===========================================================================*/
+/* Module State                                                               */
+/*===========================================================================*/
+
+/** Sample pool, one array per field; slot rings are consecutive ranges */
+static struct {
+    uint64_t timestamp_ms[SENSOR_HISTORY_POOL_SIZE];
+    double value[SENSOR_HISTORY_POOL_SIZE];
+} s_pool;
+
+/** Pool samples handed out */
+static size_t s_pool_used = 0;
+
+/** Ring of each slot, indexed by sensor slot */
+static struct {
+    uint16_t base[SMART_QSO_MAX_SENSORS];       /**< First pool sample */
+    uint16_t depth[SMART_QSO_MAX_SENSORS];      /**< Ring size */
+    uint16_t head[SMART_QSO_MAX_SENSORS];       /**< Next ring position */
+    uint16_t count[SMART_QSO_MAX_SENSORS];      /**< Samples in the ring */
+    bool configured[SMART_QSO_MAX_SENSORS];     /**< Ring assigned */
+} s_rings;
+
+/*===========================================================================*/
+/* Internal Functions                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief Copy `n` consecutive ring samples, starting `back` samples before
+ *        the head, to `samples`
+ */
+static void copy_out(size_t slot, size_t back, size_t n, SensorSample_t *samples)
+{
+    size_t depth = s_rings.depth[slot];
+    size_t pos = (s_rings.head[slot] + depth - back) % depth;
+
+    for (size_t i = 0; i < n; i++) {
+        size_t p = s_rings.base[slot] + pos;
+        samples[i].timestamp_ms = s_pool.timestamp_ms[p];
+        samples[i].value = s_pool.value[p];
+        pos = (pos + 1U == depth) ? 0U : pos + 1U;
+    }
+}
+
+/*===========================================================================*/
+/* Public API Implementation                                                  */
+/*===========================================================================*/
+
+void sensor_history_reset(void)
+{
+    memset(&s_rings, 0, sizeof(s_rings));
+    s_pool_used = 0;
+}
+
+SmartQsoResult_t sensor_history_configure(size_t slot, uint16_t depth)
+{
+    if ((slot >= SMART_QSO_MAX_SENSORS) || (depth > SENSOR_HISTORY_MAX_DEPTH)) {
+        return SMART_QSO_ERROR_PARAM;
+    }
+    if (s_rings.configured[slot]) {
+        return SMART_QSO_ERROR_INVALID;
+    }
+    if (depth > (SENSOR_HISTORY_POOL_SIZE - s_pool_used)) {
+        return SMART_QSO_ERROR_NO_MEM;
+    }
+
+    s_rings.base[slot] = (uint16_t)s_pool_used;
+    s_rings.depth[slot] = depth;
+    s_rings.head[slot] = 0;
+    s_rings.count[slot] = 0;
+    s_rings.configured[slot] = true;
+    s_pool_used += depth;
+    return SMART_QSO_OK;
+}
+
+uint16_t sensor_history_depth(size_t slot)
+{
+    return (slot < SMART_QSO_MAX_SENSORS) ? s_rings.depth[slot] : 0U;
+}
+
+size_t sensor_history_free(void)
+{
+    return SENSOR_HISTORY_POOL_SIZE - s_pool_used;
+}
+
+void sensor_history_push(size_t slot, uint64_t timestamp_ms, double value)
+{
+    if ((slot >= SMART_QSO_MAX_SENSORS) || (s_rings.depth[slot] == 0U)) {
+        return;
+    }
+
+    size_t p = s_rings.base[slot] + s_rings.head[slot];
+    s_pool.timestamp_ms[p] = timestamp_ms;
+    s_pool.value[p] = value;
+
+    s_rings.head[slot]++;
+    if (s_rings.head[slot] == s_rings.depth[slot]) {
+        s_rings.head[slot] = 0;
+    }
+    if (s_rings.count[slot] < s_rings.depth[slot]) {
+        s_rings.count[slot]++;
+    }
+}
+
+size_t sensor_history_last(size_t slot, size_t max, SensorSample_t *samples)
+{
+    if ((slot >= SMART_QSO_MAX_SENSORS) || (samples == NULL)) {
+        return 0U;
+    }
+
+    size_t n = (max < s_rings.count[slot]) ? max : s_rings.count[slot];
+    if (n > 0U) {
+        copy_out(slot, n, n, samples);
+    }
+    return n;
+}
+
+size_t sensor_history_since(size_t slot, uint64_t since_ms, size_t max,
+                            SensorSample_t *samples)
+{
+    if ((slot >= SMART_QSO_MAX_SENSORS) || (samples == NULL)) {
+        return 0U;
+    }
+
+    /* Walk back from the newest sample to the first one not after since_ms */
+    size_t depth = s_rings.depth[slot];
+    size_t matched = 0;
+    while (matched < s_rings.count[slot]) {
+        size_t pos = (s_rings.head[slot] + depth - matched - 1U) % depth;
+        if (s_pool.timestamp_ms[s_rings.base[slot] + pos] <= since_ms) {
+            break;
+        }
+        matched++;
+    }
+
+    size_t n = (max < matched) ? max : matched;
+    if (n > 0U) {
+        copy_out(slot, matched, n, samples);
+    }
+    return n;
+}
@@ -8,23 +8,137 @@
  */
 
 #include "sensors.h"
+#include "sensor_image.h"
+#include "sensor_driver.h"
+#include "wire_codec.h"
+#include "yaml_parser.h"
 #include "fault_mgmt.h"
 #include "eps_control.h"
+#include "hal/hal.h"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+/*===========================================================================*/
+/* Internal Types                                                             */
+/*===========================================================================*/
+
+/**
+ * Measurement channel, resolved from the configured channel name at load.
+ * Values are the configuration image's channel IDs.
+ */
+typedef enum {
+    SENSOR_CHANNEL_NONE = SENSOR_IMAGE_CHANNEL_NONE,
+    SENSOR_CHANNEL_BATTERY = SENSOR_IMAGE_CHANNEL_BATTERY,
+    SENSOR_CHANNEL_BUS = SENSOR_IMAGE_CHANNEL_BUS,
+    SENSOR_CHANNEL_SOLAR = SENSOR_IMAGE_CHANNEL_SOLAR,
+    SENSOR_CHANNEL_BATTERY_DISCHARGE = SENSOR_IMAGE_CHANNEL_BATTERY_DISCHARGE,
+    SENSOR_CHANNEL_JETSON = SENSOR_IMAGE_CHANNEL_JETSON,
+    SENSOR_CHANNEL_X = SENSOR_IMAGE_CHANNEL_X,
+    SENSOR_CHANNEL_Y = SENSOR_IMAGE_CHANNEL_Y,
+    SENSOR_CHANNEL_Z = SENSOR_IMAGE_CHANNEL_Z
+} SensorChannel_t;
+
+/**
+ * @brief Per-channel read function of the built-in drivers
+ */
+typedef bool (*SensorSampleFn_t)(SensorChannel_t channel, double *out_value, char *out_text);
+
+/** Telemetry label: the only strings formatting touches */
+typedef struct {
+    char id[SMART_QSO_SENSOR_ID_LEN];         /**< Short identifier */
+    char units[SMART_QSO_SENSOR_UNITS_LEN];   /**< Units string */
+} SensorLabel_t;
+
+/** Cold metadata: only read by sensors_get() views and console output */
+typedef struct {
+    char name[SMART_QSO_SENSOR_NAME_LEN];     /**< Full name */
+    char type[SMART_QSO_SENSOR_TYPE_LEN];     /**< Sensor type for binding */
+    char channel[SMART_QSO_SENSOR_CHANNEL_LEN]; /**< Channel identifier */
+    SensorReadFn_t read;                       /**< Read function for views */
+} SensorMeta_t;
+
 /*===========================================================================*/
 /* Module State                                                               */
 /*===========================================================================*/
 
-/** Sensor array */
-static Sensor_t s_sensors[SMART_QSO_MAX_SENSORS];
+/**
+ * Hot sensor state, one array per field indexed by sensor slot. Polling and
+ * telemetry formatting walk these without touching the sensor strings.
+ */
+static struct {
+    uint64_t next_poll_ms[SMART_QSO_MAX_SENSORS];  /**< Next poll time */
+    double last_value[SMART_QSO_MAX_SENSORS];      /**< Last numeric reading */
+    int32_t last_fixed[SMART_QSO_MAX_SENSORS];     /**< Last numeric reading, fixed point */
+    uint64_t last_update_ms[SMART_QSO_MAX_SENSORS]; /**< Poll time of the last reading */
+    uint32_t period_ms[SMART_QSO_MAX_SENSORS];     /**< Poll period in ms */
+    uint8_t driver[SMART_QSO_MAX_SENSORS];         /**< SensorImageType_t */
+    uint8_t channel[SMART_QSO_MAX_SENSORS];        /**< SensorChannel_t */
+    uint8_t adc_channel[SMART_QSO_MAX_SENSORS];    /**< HalAdcChannel_t, COUNT if none */
+    uint8_t value_type[SMART_QSO_MAX_SENSORS];     /**< SensorValueType_t */
+    uint8_t decimals[SMART_QSO_MAX_SENSORS];       /**< Fixed-point decimal places */
+    bool decimated[SMART_QSO_MAX_SENSORS];         /**< Reports window summaries */
+    bool summarized[SMART_QSO_MAX_SENSORS];        /**< A window has completed */
+    int32_t summary_fixed[SMART_QSO_MAX_SENSORS][3]; /**< Last window min/max/mean, fixed point */
+    char last_text[SMART_QSO_MAX_SENSORS][8];      /**< Last text reading */
+} s_hot;
+
+/** Telemetry labels, indexed by sensor slot */
+static SensorLabel_t s_labels[SMART_QSO_MAX_SENSORS];
+
+/** Cold metadata, indexed by sensor slot */
+static SensorMeta_t s_meta[SMART_QSO_MAX_SENSORS];
 
 /** Number of registered sensors */
 static size_t s_num_sensors = 0;
 
+/**
+ * Poll queue: min-heap of sensor indices ordered by next_poll_ms (ties by
+ * index, so sensors due together are polled in table order). Holds every
+ * registered sensor.
+ */
+static uint16_t s_poll_heap[SMART_QSO_MAX_SENSORS];
+
+_Static_assert(SMART_QSO_MAX_SENSORS <= 65535, "Poll heap indices are 16-bit");
+
+/** ID index size: open addressing at a load factor of at most one half */
+#define SENSOR_ID_INDEX_SIZE    (2U * SMART_QSO_MAX_SENSORS)
+
+/**
+ * ID index: open-addressing hash table (linear probing) from sensor ID to
+ * slot + 1, 0 marking an empty bucket. Filled as sensors are registered and
+ * cleared by sensors_init(), so it changes only when the table is reloaded.
+ */
+static uint16_t s_id_index[SENSOR_ID_INDEX_SIZE];
+
+/** Hash of each slot's ID, compared before the string */
+static uint32_t s_id_hash[SMART_QSO_MAX_SENSORS];
+
+/** Table generation, carried in handles; bumped by sensors_init(), never 0 */
+static uint16_t s_generation = 1;
+
+/** Driver name index size: open addressing at a load factor of at most one half */
+#define SENSOR_DRIVER_INDEX_SIZE    16U
+
+_Static_assert((2U * SENSOR_IMAGE_TYPE_COUNT) <= SENSOR_DRIVER_INDEX_SIZE,
+               "Driver index load factor above one half");
+_Static_assert(SENSOR_IMAGE_TYPE_COUNT <= 32, "Driver masks are 32-bit");
+
+/** Driver name index: type name to type ID by linear probing, 0 marking an empty bucket */
+static uint8_t s_driver_index[SENSOR_DRIVER_INDEX_SIZE];
+
+/** Drivers whose init succeeded (bit per SensorImageType_t) */
+static uint32_t s_driver_ready = 0;
+
+/** Latest ADC scan in channel units, indexed by HalAdcChannel_t */
+static double s_adc_scan[ADC_CHANNEL_COUNT];
+
+/** Channels the latest scan sampled (bit per HalAdcChannel_t) */
+static uint32_t s_adc_fresh = 0;
+
+_Static_assert(ADC_CHANNEL_COUNT <= 32, "ADC scan mask is 32-bit");
+
 /** Environment state: sunlit flag */
 static bool s_sunlit = true;
 
@@ -46,13 +160,221 @@ static double rnd_unit(void)
     return (double)rand() / (double)RAND_MAX;
 }
 
+/*===========================================================================*/
+/* Internal: Poll Queue                                                       */
+/*===========================================================================*/
+
+/**
+ * @brief True if sensor a is due before sensor b
+ */
+static bool poll_before(uint16_t a, uint16_t b)
+{
+    uint64_t due_a = s_hot.next_poll_ms[a];
+    uint64_t due_b = s_hot.next_poll_ms[b];
+
+    return (due_a < due_b) || ((due_a == due_b) && (a < b));
+}
+
+static void poll_heap_swap(size_t i, size_t j)
+{
+    uint16_t tmp = s_poll_heap[i];
+    s_poll_heap[i] = s_poll_heap[j];
+    s_poll_heap[j] = tmp;
+}
+
+static void poll_heap_sift_up(size_t pos)
+{
+    while (pos > 0U) {
+        size_t parent = (pos - 1U) / 2U;
+        if (!poll_before(s_poll_heap[pos], s_poll_heap[parent])) {
+            break;
+        }
+        poll_heap_swap(pos, parent);
+        pos = parent;
+    }
+}
+
+static void poll_heap_sift_down(size_t pos)
+{
+    for (;;) {
+        size_t first = pos;
+        size_t left = (2U * pos) + 1U;
+        size_t right = left + 1U;
+
+        if ((left < s_num_sensors) && poll_before(s_poll_heap[left], s_poll_heap[first])) {
+            first = left;
+        }
+        if ((right < s_num_sensors) && poll_before(s_poll_heap[right], s_poll_heap[first])) {
+            first = right;
+        }
+        if (first == pos) {
+            break;
+        }
+        poll_heap_swap(pos, first);
+        pos = first;
+    }
+}
+
+/*===========================================================================*/
+/* Internal: ID Index                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief FNV-1a hash of a sensor ID (or driver name)
+ */
+static uint32_t id_hash(const char *id)
+{
+    uint32_t h = 2166136261U;
+
+    while (*id != '\0') {
+        h = (h ^ (uint8_t)*id) * 16777619U;
+        id++;
+    }
+    return h;
+}
+
+/**
+ * @brief Find a sensor's slot by ID
+ *
+ * @return The first registered slot with the ID, SMART_QSO_MAX_SENSORS if
+ *         none
+ */
+static size_t id_lookup(const char *id, uint32_t h)
+{
+    size_t pos = h % SENSOR_ID_INDEX_SIZE;
+
+    for (size_t probe = 0; probe < SENSOR_ID_INDEX_SIZE; probe++) {
+        uint16_t entry = s_id_index[pos];
+        if (entry == 0U) {
+            break;
+        }
+        size_t slot = (size_t)entry - 1U;
+        if ((s_id_hash[slot] == h) && (strcmp(s_labels[slot].id, id) == 0)) {
+            return slot;
+        }
+        pos = (pos + 1U == SENSOR_ID_INDEX_SIZE) ? 0U : pos + 1U;
+    }
+    return SMART_QSO_MAX_SENSORS;
+}
+
+/**
+ * @brief Index a newly registered slot; a repeated ID keeps the first slot
+ */
+static void id_insert(size_t slot)
+{
+    uint32_t h = id_hash(s_labels[slot].id);
+
+    s_id_hash[slot] = h;
+    if (id_lookup(s_labels[slot].id, h) != SMART_QSO_MAX_SENSORS) {
+        return;
+    }
+
+    /* At most half full, so an empty bucket is always found */
+    size_t pos = h % SENSOR_ID_INDEX_SIZE;
+    while (s_id_index[pos] != 0U) {
+        pos = (pos + 1U == SENSOR_ID_INDEX_SIZE) ? 0U : pos + 1U;
+    }
+    s_id_index[pos] = (uint16_t)(slot + 1U);
+}
+
+/**
+ * @brief Slot a handle refers to
+ *
+ * @return The slot, SMART_QSO_MAX_SENSORS if the handle is stale or invalid
+ */
+static size_t handle_slot(SensorHandle_t handle)
+{
+    size_t slot = (size_t)(handle & 0xFFFFU);
+
+    if (((handle >> 16) != s_generation) || (slot >= s_num_sensors)) {
+        return SMART_QSO_MAX_SENSORS;
+    }
+    return slot;
+}
+
+/*===========================================================================*/
+/* Internal: ADC Acquisition                                                  */
+/*===========================================================================*/
+
+#ifdef HAL_TARGET_SIMULATION
+/**
+ * @brief Drive the simulated ADC channels from the environment model
+ */
+static void sim_drive_adc(void)
+{
+    bool payload_enabled = eps_is_payload_enabled();
+    double discharge = s_sunlit ? 0.05 : (payload_enabled ? 0.8 : 0.25);
+
+    (void)hal_adc_sim_set_value(ADC_CHANNEL_VBATT,
+                                8.1 + 0.15 * (s_soc - 0.5) + 0.02 * (rnd_unit() - 0.5));
+    (void)hal_adc_sim_set_value(ADC_CHANNEL_VBUS, 5.0 + 0.02 * (rnd_unit() - 0.5));
+    (void)hal_adc_sim_set_value(ADC_CHANNEL_VSOLAR,
+                                (s_sunlit ? 7.5 : 0.2) + 0.02 * (rnd_unit() - 0.5));
+    (void)hal_adc_sim_set_value(ADC_CHANNEL_IBATT, -discharge);
+    (void)hal_adc_sim_set_value(ADC_CHANNEL_ISOLAR,
+                                s_sunlit ? (0.6 + 0.1 * (rnd_unit() - 0.5)) : 0.0);
+}
+#endif
+
+/**
+ * @brief Sample ADC channels in one scan sequence
+ *
+ * Replaces the previous scan; only the channels sampled here are fresh.
+ *
+ * @param channels Channels to sample
+ * @param count    Number of channels
+ * @return true if the scan succeeded
+ */
+static bool acquire_adc(const HalAdcChannel_t *channels, size_t count)
+{
+    uint16_t raw[ADC_CHANNEL_COUNT];
+
+    s_adc_fresh = 0;
+    if (count == 0U) {
+        return true;
+    }
+    SMART_QSO_REQUIRE(count <= ADC_CHANNEL_COUNT, "Too many ADC channels");
+
+#ifdef HAL_TARGET_SIMULATION
+    sim_drive_adc();
+#endif
+    if (hal_adc_read_multiple(channels, raw, count) != SMART_QSO_OK) {
+        return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (hal_adc_raw_to_voltage(channels[i], raw[i], &s_adc_scan[channels[i]]) == SMART_QSO_OK) {
+            s_adc_fresh |= (uint32_t)1U << (uint32_t)channels[i];
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Get a channel's value from the latest scan
+ *
+ * @return false if the channel was not sampled
+ */
+static bool adc_value(HalAdcChannel_t channel, double *value)
+{
+    if ((s_adc_fresh & ((uint32_t)1U << (uint32_t)channel)) == 0U) {
+        return false;
+    }
+    *value = s_adc_scan[channel];
+    return true;
+}
+
 /*===========================================================================*/
 /* Sensor Read Implementations                                                */
 /*===========================================================================*/
 
-static bool read_software_timer(Sensor_t *self, double *out_value, char *out_text)
+/*
+ * ADC-backed types (eps_voltage and the battery and solar eps_current
+ * channels) read the latest scan: the channel must be acquired first.
+ */
+
+static bool read_software_timer(SensorChannel_t channel, double *out_value, char *out_text)
 {
-    (void)self;
+    (void)channel;
     (void)out_text;
     static uint64_t s_start_ms = 0;
 
@@ -65,56 +387,68 @@ static bool read_software_timer(Sensor_t *self, double *out_value, char *out_tex
     return true;
 }
 
-static bool read_eps_voltage(Sensor_t *self, double *out_value, char *out_text)
+static bool read_eps_voltage(SensorChannel_t channel, double *out_value, char *out_text)
 {
     (void)out_text;
-    double base = 0.0;
+    double val = 0.0;
 
-    if (strcmp(self->channel, "battery") == 0) {
-        base = 8.1 + 0.15 * (s_soc - 0.5);
-        if (base < 7.0) {
+    if (channel == SENSOR_CHANNEL_BATTERY) {
+        if (!adc_value(ADC_CHANNEL_VBATT, &val)) {
+            return false;
+        }
+        if (val < 7.0) {
             fault_log_add(FAULT_TYPE_VOLTAGE_LOW, FAULT_SEVERITY_ERROR,
                           "Low battery voltage detected", s_soc);
         }
-    } else if (strcmp(self->channel, "bus") == 0) {
-        base = 5.0;
-        if (base < 4.5 || base > 5.5) {
+    } else if (channel == SENSOR_CHANNEL_BUS) {
+        if (!adc_value(ADC_CHANNEL_VBUS, &val)) {
+            return false;
+        }
+        if (val < 4.5 || val > 5.5) {
             fault_log_add(FAULT_TYPE_VOLTAGE_RANGE, FAULT_SEVERITY_ERROR,
                           "Bus voltage out of range", s_soc);
         }
-    } else if (strcmp(self->channel, "solar") == 0) {
-        base = s_sunlit ? 7.5 : 0.2;
+    } else if (channel == SENSOR_CHANNEL_SOLAR) {
+        if (!adc_value(ADC_CHANNEL_VSOLAR, &val)) {
+            return false;
+        }
     }
 
-    *out_value = base + 0.02 * (rnd_unit() - 0.5);
+    *out_value = val;
     return true;
 }
 
-static bool read_eps_current(Sensor_t *self, double *out_value, char *out_text)
+static bool read_eps_current(SensorChannel_t channel, double *out_value, char *out_text)
 {
     (void)out_text;
     double val = 0.0;
-    bool payload_enabled = eps_is_payload_enabled();
 
-    if (strcmp(self->channel, "battery_discharge") == 0) {
-        val = s_sunlit ? 0.05 : (payload_enabled ? 0.8 : 0.25);
+    if (channel == SENSOR_CHANNEL_BATTERY_DISCHARGE) {
+        /* Battery current is negative while discharging */
+        if (!adc_value(ADC_CHANNEL_IBATT, &val)) {
+            return false;
+        }
+        val = -val;
         if (val > 1.0) {
             fault_log_add(FAULT_TYPE_CURRENT_HIGH, FAULT_SEVERITY_ERROR,
                           "Excessive battery discharge current", s_soc);
         }
-    } else if (strcmp(self->channel, "jetson") == 0) {
-        val = payload_enabled ? 0.7 + 0.05 * (rnd_unit() - 0.5) : 0.0;
-    } else if (strcmp(self->channel, "solar") == 0) {
-        val = s_sunlit ? (0.6 + 0.1 * (rnd_unit() - 0.5)) : 0.0;
+    } else if (channel == SENSOR_CHANNEL_JETSON) {
+        /* Reported by the payload power switch, not sampled on the ADC */
+        val = eps_is_payload_enabled() ? 0.7 + 0.05 * (rnd_unit() - 0.5) : 0.0;
+    } else if (channel == SENSOR_CHANNEL_SOLAR) {
+        if (!adc_value(ADC_CHANNEL_ISOLAR, &val)) {
+            return false;
+        }
     }
 
     *out_value = val;
     return true;
 }
 
-static bool read_eps_temperature(Sensor_t *self, double *out_value, char *out_text)
+static bool read_eps_temperature(SensorChannel_t channel, double *out_value, char *out_text)
 {
-    (void)self;
+    (void)channel;
     (void)out_text;
     bool payload_enabled = eps_is_payload_enabled();
 
@@ -136,9 +470,9 @@ static bool read_eps_temperature(Sensor_t *self, double *out_value, char *out_te
     return true;
 }
 
-static bool read_status_hex2(Sensor_t *self, double *out_value, char *out_text)
+static bool read_status_hex2(SensorChannel_t channel, double *out_value, char *out_text)
 {
-    (void)self;
+    (void)channel;
     (void)out_value;
     bool payload_enabled = eps_is_payload_enabled();
     PowerMode_t power_mode = eps_get_power_mode();
@@ -190,123 +524,537 @@ static bool read_status_hex2(Sensor_t *self, double *out_value, char *out_text)
 }
 
 /*===========================================================================*/
-/* Sensor Binding                                                             */
+/* Sensor Drivers                                                             */
 /*===========================================================================*/
 
 /**
- * @brief Bind read function to sensor based on type
+ * @brief Read each channel of a batch with a per-channel read function
  */
-static bool bind_sensor_behavior(Sensor_t *s)
+static void read_each(SensorSampleFn_t sample, const uint8_t *channels,
+                      SensorReading_t *readings, size_t count)
 {
-    SMART_QSO_REQUIRE_NOT_NULL(s);
+    for (size_t i = 0; i < count; i++) {
+        readings[i].valid = sample((SensorChannel_t)channels[i], &readings[i].value,
+                                   readings[i].text);
+    }
+}
 
-    if (strcmp(s->type, "software_timer") == 0) {
-        s->value_type = SENSOR_VALUE_NUMERIC;
-        s->read = read_software_timer;
-        return true;
-    } else if (strcmp(s->type, "eps_voltage") == 0) {
-        s->value_type = SENSOR_VALUE_NUMERIC;
-        s->read = read_eps_voltage;
-        return true;
-    } else if (strcmp(s->type, "eps_current") == 0) {
-        s->value_type = SENSOR_VALUE_NUMERIC;
-        s->read = read_eps_current;
-        return true;
-    } else if (strcmp(s->type, "eps_temperature") == 0) {
-        s->value_type = SENSOR_VALUE_NUMERIC;
-        s->read = read_eps_temperature;
-        return true;
-    } else if (strcmp(s->type, "status_hex2") == 0) {
-        s->value_type = SENSOR_VALUE_HEX2;
-        s->read = read_status_hex2;
-        return true;
+static void batch_software_timer(const uint8_t *channels, SensorReading_t *readings, size_t count)
+{
+    read_each(read_software_timer, channels, readings, count);
+}
+
+static void batch_eps_voltage(const uint8_t *channels, SensorReading_t *readings, size_t count)
+{
+    read_each(read_eps_voltage, channels, readings, count);
+}
+
+static void batch_eps_current(const uint8_t *channels, SensorReading_t *readings, size_t count)
+{
+    read_each(read_eps_current, channels, readings, count);
+}
+
+static void batch_eps_temperature(const uint8_t *channels, SensorReading_t *readings, size_t count)
+{
+    read_each(read_eps_temperature, channels, readings, count);
+}
+
+static void batch_status_hex2(const uint8_t *channels, SensorReading_t *readings, size_t count)
+{
+    read_each(read_status_hex2, channels, readings, count);
+}
+
+static const SensorDriver_t s_driver_software_timer = {
+    "software_timer", SENSOR_VALUE_NUMERIC, NULL, batch_software_timer
+};
+
+static const SensorDriver_t s_driver_eps_voltage = {
+    "eps_voltage", SENSOR_VALUE_NUMERIC, NULL, batch_eps_voltage
+};
+
+static const SensorDriver_t s_driver_eps_current = {
+    "eps_current", SENSOR_VALUE_NUMERIC, NULL, batch_eps_current
+};
+
+static const SensorDriver_t s_driver_eps_temperature = {
+    "eps_temperature", SENSOR_VALUE_NUMERIC, NULL, batch_eps_temperature
+};
+
+static const SensorDriver_t s_driver_status_hex2 = {
+    "status_hex2", SENSOR_VALUE_HEX2, NULL, batch_status_hex2
+};
+
+/**
+ * Driver table, indexed by SensorImageType_t (the image's type IDs). A new
+ * sensor type is added here with its image type ID; nothing else in this
+ * module names a type.
+ */
+static const SensorDriver_t *const s_drivers[SENSOR_IMAGE_TYPE_COUNT] = {
+    [SENSOR_IMAGE_TYPE_SOFTWARE_TIMER] = &s_driver_software_timer,
+    [SENSOR_IMAGE_TYPE_EPS_VOLTAGE] = &s_driver_eps_voltage,
+    [SENSOR_IMAGE_TYPE_EPS_CURRENT] = &s_driver_eps_current,
+    [SENSOR_IMAGE_TYPE_EPS_TEMPERATURE] = &s_driver_eps_temperature,
+    [SENSOR_IMAGE_TYPE_STATUS_HEX2] = &s_driver_status_hex2,
+    [SENSOR_IMAGE_TYPE_MAGNETOMETER] = &sensor_driver_magnetometer,
+    [SENSOR_IMAGE_TYPE_SUN_SENSOR] = &sensor_driver_sun_sensor,
+};
+
+/**
+ * @brief Index the driver names and run each driver's init hook
+ */
+static void drivers_init(void)
+{
+    memset(s_driver_index, 0, sizeof(s_driver_index));
+    s_driver_ready = 0;
+
+    for (size_t type = 1; type < (size_t)SENSOR_IMAGE_TYPE_COUNT; type++) {
+        const SensorDriver_t *driver = s_drivers[type];
+        size_t pos = id_hash(driver->name) % SENSOR_DRIVER_INDEX_SIZE;
+
+        while (s_driver_index[pos] != 0U) {
+            pos = (pos + 1U) % SENSOR_DRIVER_INDEX_SIZE;
+        }
+        s_driver_index[pos] = (uint8_t)type;
+
+        if ((driver->init == NULL) || (driver->init() == SMART_QSO_OK)) {
+            s_driver_ready |= (uint32_t)1U << type;
+        } else {
+            fault_log_add(FAULT_TYPE_INIT, FAULT_SEVERITY_WARNING,
+                          "Sensor driver init failed", s_soc);
+        }
+    }
+}
+
+/**
+ * @brief Find a driver by type name
+ *
+ * @return The driver's SensorImageType_t, 0 if none
+ */
+static size_t driver_lookup(const char *name)
+{
+    size_t pos = id_hash(name) % SENSOR_DRIVER_INDEX_SIZE;
+
+    while (s_driver_index[pos] != 0U) {
+        size_t type = s_driver_index[pos];
+        if (strcmp(name, s_drivers[type]->name) == 0) {
+            return type;
+        }
+        pos = (pos + 1U) % SENSOR_DRIVER_INDEX_SIZE;
     }
+    return 0U;
+}
 
-    return false;
+/**
+ * @brief Read a batch of sensors of one driver
+ *
+ * Readings of a driver that failed its init are all invalid.
+ */
+static void driver_read(size_t type, const uint8_t *channels, SensorReading_t *readings,
+                        size_t count)
+{
+    memset(readings, 0, count * sizeof(readings[0]));
+    if ((s_driver_ready & ((uint32_t)1U << type)) != 0U) {
+        s_drivers[type]->read(channels, readings, count);
+    }
 }
 
 /*===========================================================================*/
-/* YAML Parsing                                                               */
+/* Sensor Views                                                               */
 /*===========================================================================*/
 
+/** Configured channel names, indexed by SensorChannel_t */
+static const char *const s_channel_names[SENSOR_IMAGE_CHANNEL_COUNT] = {
+    [SENSOR_CHANNEL_NONE] = "",
+    [SENSOR_CHANNEL_BATTERY] = "battery",
+    [SENSOR_CHANNEL_BUS] = "bus",
+    [SENSOR_CHANNEL_SOLAR] = "solar",
+    [SENSOR_CHANNEL_BATTERY_DISCHARGE] = "battery_discharge",
+    [SENSOR_CHANNEL_JETSON] = "jetson",
+    [SENSOR_CHANNEL_X] = "x",
+    [SENSOR_CHANNEL_Y] = "y",
+    [SENSOR_CHANNEL_Z] = "z",
+};
+
+/**
+ * @brief Resolve a configured channel name
+ */
+static SensorChannel_t channel_from_name(const char *name)
+{
+    for (size_t i = 1; i < (size_t)SENSOR_IMAGE_CHANNEL_COUNT; i++) {
+        if (strcmp(name, s_channel_names[i]) == 0) {
+            return (SensorChannel_t)i;
+        }
+    }
+    return SENSOR_CHANNEL_NONE;
+}
+
 /**
- * @brief Trim whitespace from string
+ * @brief ADC channel an ADC-backed sensor samples
+ *
+ * @param type SensorImageType_t
+ * @return The channel, ADC_CHANNEL_COUNT if the sensor is read directly
  */
-static void trim(char *s)
+static HalAdcChannel_t adc_channel_for(size_t type, SensorChannel_t channel)
 {
-    size_t n = strlen(s);
-    while (n > 0 && (s[n - 1] == '\n' || s[n - 1] == '\r' ||
-                     s[n - 1] == ' ' || s[n - 1] == '\t')) {
-        s[--n] = '\0';
+    static const struct {
+        SensorImageType_t type;
+        SensorChannel_t channel;
+        HalAdcChannel_t adc;
+    } adc_map[] = {
+        {SENSOR_IMAGE_TYPE_EPS_VOLTAGE, SENSOR_CHANNEL_BATTERY, ADC_CHANNEL_VBATT},
+        {SENSOR_IMAGE_TYPE_EPS_VOLTAGE, SENSOR_CHANNEL_BUS, ADC_CHANNEL_VBUS},
+        {SENSOR_IMAGE_TYPE_EPS_VOLTAGE, SENSOR_CHANNEL_SOLAR, ADC_CHANNEL_VSOLAR},
+        {SENSOR_IMAGE_TYPE_EPS_CURRENT, SENSOR_CHANNEL_BATTERY_DISCHARGE, ADC_CHANNEL_IBATT},
+        {SENSOR_IMAGE_TYPE_EPS_CURRENT, SENSOR_CHANNEL_SOLAR, ADC_CHANNEL_ISOLAR},
+    };
+
+    for (size_t i = 0; i < sizeof(adc_map) / sizeof(adc_map[0]); i++) {
+        if (((size_t)adc_map[i].type == type) && (adc_map[i].channel == channel)) {
+            return adc_map[i].adc;
+        }
     }
+    return ADC_CHANNEL_COUNT;
+}
+
+/**
+ * @brief Read function handed out in Sensor_t views
+ *
+ * For callers that read a sensor through its view rather than through the
+ * module: resolves the driver and channel from the view and samples the
+ * sensor on its own, acquiring its ADC channel if any.
+ */
+static bool view_read(Sensor_t *self, double *out_value, char *out_text)
+{
+    size_t type = driver_lookup(self->type);
+    uint8_t channel = (uint8_t)channel_from_name(self->channel);
+    HalAdcChannel_t adc = adc_channel_for(type, (SensorChannel_t)channel);
+    SensorReading_t reading;
 
-    size_t i = 0;
-    while (s[i] == ' ' || s[i] == '\t') {
-        i++;
+    if ((type == 0U) || ((adc != ADC_CHANNEL_COUNT) && !acquire_adc(&adc, 1U))) {
+        return false;
     }
-    if (i > 0) {
-        memmove(s, s + i, strlen(s + i) + 1);
+    driver_read(type, &channel, &reading, 1U);
+    if (!reading.valid) {
+        return false;
     }
+    *out_value = reading.value;
+    (void)memcpy(out_text, reading.text, sizeof(reading.text));
+    return true;
 }
 
 /**
- * @brief Parse key:value pair from YAML line
+ * @brief Assemble the Sensor_t view of a slot
  */
-static void parse_keyval(const char *line, char *key, size_t ksz,
-                         char *val, size_t vsz)
+static void sensor_view(size_t index, Sensor_t *out)
 {
-    const char *colon = strchr(line, ':');
-    if (colon == NULL) {
-        key[0] = '\0';
-        val[0] = '\0';
-        return;
+    memset(out, 0, sizeof(*out));
+    (void)memcpy(out->id, s_labels[index].id, sizeof(out->id));
+    (void)memcpy(out->units, s_labels[index].units, sizeof(out->units));
+    (void)memcpy(out->name, s_meta[index].name, sizeof(out->name));
+    (void)memcpy(out->type, s_meta[index].type, sizeof(out->type));
+    (void)memcpy(out->channel, s_meta[index].channel, sizeof(out->channel));
+    out->period_ms = s_hot.period_ms[index];
+    out->next_poll_ms = s_hot.next_poll_ms[index];
+    out->value_type = (SensorValueType_t)s_hot.value_type[index];
+    out->read = s_meta[index].read;
+    out->last_value = s_hot.last_value[index];
+    out->last_update_ms = s_hot.last_update_ms[index];
+    (void)memcpy(out->last_text, s_hot.last_text[index], sizeof(out->last_text));
+    (void)sensor_filter_get_config(index, &out->filter);
+    out->history = sensor_history_depth(index);
+    out->decimals = s_hot.decimals[index];
+}
+
+/*===========================================================================*/
+/* Sensor Binding                                                             */
+/*===========================================================================*/
+
+/**
+ * @brief Bind a sensor to its driver by type ID
+ *
+ * @param s    Sensor definition; type, value_type and read are filled in
+ * @param type SensorImageType_t
+ */
+static bool bind_sensor_type(Sensor_t *s, size_t type)
+{
+    if ((type == 0U) || (type >= (size_t)SENSOR_IMAGE_TYPE_COUNT)) {
+        return false;
     }
+    (void)snprintf(s->type, sizeof(s->type), "%s", s_drivers[type]->name);
+    s->value_type = s_drivers[type]->value_type;
+    s->read = view_read;
+    return true;
+}
 
-    /* Extract key */
-    size_t klen = 0;
-    while (line[klen] != '\0' && line + klen < colon && klen + 1 < ksz) {
-        key[klen] = line[klen];
-        klen++;
+/**
+ * @brief Bind a sensor to its driver by type name
+ *
+ * @param s Sensor definition; value_type and read are filled in
+ * @param[out] type SensorImageType_t
+ */
+static bool bind_sensor_behavior(Sensor_t *s, size_t *type)
+{
+    SMART_QSO_REQUIRE_NOT_NULL(s);
+
+    *type = driver_lookup(s->type);
+    return bind_sensor_type(s, *type);
+}
+
+/**
+ * @brief Split a bound sensor into the tables and add it to the poll queue
+ *
+ * @param s       Bound sensor
+ * @param type    SensorImageType_t
+ * @param channel Resolved channel
+ */
+static bool register_sensor(const Sensor_t *s, size_t type, SensorChannel_t channel)
+{
+    if ((s_num_sensors >= SMART_QSO_MAX_SENSORS) || (s->decimals > SENSOR_FIXED_MAX_DECIMALS)) {
+        return false;
     }
-    key[klen] = '\0';
+    size_t slot = s_num_sensors;
 
-    /* Extract value */
-    const char *p = colon + 1;
-    while (*p == ' ' || *p == '\t') {
-        p++;
+    if (sensor_filter_configure(slot, &s->filter) != SMART_QSO_OK) {
+        return false;
     }
-    size_t vlen = 0;
-    while (p[vlen] != '\0' && vlen + 1 < vsz) {
-        val[vlen] = p[vlen];
-        vlen++;
+    uint16_t depth = (s->value_type == SENSOR_VALUE_NUMERIC) ? s->history : 0U;
+    if (sensor_history_configure(slot, depth) != SMART_QSO_OK) {
+        return false;
     }
-    val[vlen] = '\0';
+    s_hot.next_poll_ms[slot] = s->next_poll_ms;
+    s_hot.last_value[slot] = s->last_value;
+    s_hot.last_fixed[slot] = sensor_fixed_from_double(s->last_value, s->decimals);
+    s_hot.last_update_ms[slot] = s->last_update_ms;
+    s_hot.period_ms[slot] = s->period_ms;
+    s_hot.driver[slot] = (uint8_t)type;
+    s_hot.channel[slot] = (uint8_t)channel;
+    s_hot.adc_channel[slot] = (uint8_t)adc_channel_for(type, channel);
+    s_hot.value_type[slot] = (uint8_t)s->value_type;
+    s_hot.decimals[slot] = s->decimals;
+    s_hot.decimated[slot] = (s->filter.decimation > 1U);
+    (void)memcpy(s_hot.last_text[slot], s->last_text, sizeof(s_hot.last_text[slot]));
+    (void)memcpy(s_labels[slot].id, s->id, sizeof(s_labels[slot].id));
+    (void)memcpy(s_labels[slot].units, s->units, sizeof(s_labels[slot].units));
+    (void)memcpy(s_meta[slot].name, s->name, sizeof(s_meta[slot].name));
+    (void)memcpy(s_meta[slot].type, s->type, sizeof(s_meta[slot].type));
+    (void)memcpy(s_meta[slot].channel, s->channel, sizeof(s_meta[slot].channel));
+    s_meta[slot].read = s->read;
+
+    s_poll_heap[slot] = (uint16_t)slot;
+    s_num_sensors++;
+    poll_heap_sift_up(slot);
+    id_insert(slot);
+    return true;
+}
 
-    trim(key);
-    trim(val);
+/*===========================================================================*/
+/* YAML Parsing                                                               */
+/*===========================================================================*/
 
-    /* Remove quotes if present */
-    if ((val[0] == '"' || val[0] == '\'') && strlen(val) >= 2) {
-        size_t L = strlen(val);
-        if (val[L - 1] == '"' || val[L - 1] == '\'') {
-            val[L - 1] = '\0';
-            memmove(val, val + 1, L - 1);
-        }
+/** Bytes of sensors.yaml read per chunk */
+#define SENSORS_YAML_CHUNK_SIZE 512U
+
+/**
+ * @brief Parse an unsigned decimal field value
+ */
+static unsigned long span_to_ulong(yaml_span_t value)
+{
+    char text[24];
+    (void)yaml_span_copy(value, text, sizeof(text));
+    return strtoul(text, NULL, 10);
+}
+
+/**
+ * @brief Apply one "key: value" field of a sensor item
+ *
+ * @param cur   Sensor being parsed
+ * @param token Field
+ * @param valid Cleared if the field fails to parse
+ */
+static void apply_field(Sensor_t *cur, const yaml_token_t *token, bool *valid)
+{
+    yaml_span_t key = token->key;
+    yaml_span_t val = token->value;
+
+    /* Strings are truncated to their fields; values are validated externally */
+    if (yaml_span_equals(key, "id")) {
+        (void)yaml_span_copy(val, cur->id, sizeof(cur->id));
+    } else if (yaml_span_equals(key, "name")) {
+        (void)yaml_span_copy(val, cur->name, sizeof(cur->name));
+    } else if (yaml_span_equals(key, "type")) {
+        (void)yaml_span_copy(val, cur->type, sizeof(cur->type));
+    } else if (yaml_span_equals(key, "units")) {
+        (void)yaml_span_copy(val, cur->units, sizeof(cur->units));
+    } else if (yaml_span_equals(key, "channel")) {
+        (void)yaml_span_copy(val, cur->channel, sizeof(cur->channel));
+    } else if (yaml_span_equals(key, "period_ms")) {
+        cur->period_ms = (uint32_t)span_to_ulong(val);
+    } else if (yaml_span_equals(key, "filter")) {
+        char name[24];
+        (void)yaml_span_copy(val, name, sizeof(name));
+        *valid = *valid && (sensor_filter_parse_kind(name, &cur->filter.kind) == SMART_QSO_OK);
+    } else if (yaml_span_equals(key, "filter_length")) {
+        /* Out-of-range values saturate and are rejected at registration */
+        unsigned long n = span_to_ulong(val);
+        cur->filter.length = (uint8_t)((n > UINT8_MAX) ? UINT8_MAX : n);
+    } else if (yaml_span_equals(key, "filter_alpha")) {
+        char text[32];
+        (void)yaml_span_copy(val, text, sizeof(text));
+        cur->filter.alpha = strtod(text, NULL);
+    } else if (yaml_span_equals(key, "decimation")) {
+        unsigned long n = span_to_ulong(val);
+        cur->filter.decimation = (uint16_t)((n > UINT16_MAX) ? UINT16_MAX : n);
+    } else if (yaml_span_equals(key, "history")) {
+        unsigned long n = span_to_ulong(val);
+        cur->history = (uint16_t)((n > UINT16_MAX) ? UINT16_MAX : n);
+    } else if (yaml_span_equals(key, "decimals")) {
+        unsigned long n = span_to_ulong(val);
+        cur->decimals = (uint8_t)((n > UINT8_MAX) ? UINT8_MAX : n);
+    } else {
+        /* Unknown fields are ignored */
     }
 }
 
 /**
  * @brief Add sensor from parsed fields
+ *
+ * @param cur   Parsed sensor
+ * @param valid false if a field failed to parse; the sensor is skipped
  */
-static void add_sensor_from_fields(Sensor_t *cur)
+static void add_sensor_from_fields(Sensor_t *cur, bool valid)
 {
-    if (s_num_sensors >= SMART_QSO_MAX_SENSORS) {
+    size_t type = 0;
+
+    if (!valid || !bind_sensor_behavior(cur, &type)) {
         return;
     }
-    if (!bind_sensor_behavior(cur)) {
-        return;
+    (void)register_sensor(cur, type, channel_from_name(cur->channel));
+}
+
+/*===========================================================================*/
+/* Configuration Image                                                        */
+/*===========================================================================*/
+
+/** Flash copy of the image while it is loaded */
+static uint8_t s_image_buf[SENSOR_IMAGE_MAX_SIZE];
+
+/**
+ * @brief Get a string from the image's string pool
+ *
+ * @param max_len Field size including the terminator
+ * @return The string, NULL if the offset or length is out of range
+ */
+static const char *image_string(const uint8_t *pool, size_t pool_size, uint16_t offset,
+                                size_t max_len)
+{
+    if (offset >= pool_size) {
+        return NULL;
+    }
+    size_t avail = pool_size - offset;
+    if (memchr(&pool[offset], '\0', (avail < max_len) ? avail : max_len) == NULL) {
+        return NULL;
+    }
+    return (const char *)&pool[offset];
+}
+
+/**
+ * @brief Image size from its header
+ *
+ * @return Header, records and string pool size in bytes
+ */
+static size_t image_size(const uint8_t *image)
+{
+    return SENSOR_IMAGE_HEADER_SIZE +
+           ((size_t)wire_get_le16(&image[SENSOR_IMAGE_OFF_COUNT]) * SENSOR_IMAGE_RECORD_SIZE) +
+           wire_get_le16(&image[SENSOR_IMAGE_OFF_POOL_SIZE]);
+}
+
+/**
+ * @brief Decode one record into a bound sensor
+ *
+ * @param[out] s       Sensor
+ * @param[out] type    SensorImageType_t
+ * @param[out] channel Channel
+ * @return true if every field is valid
+ */
+static bool image_record(const uint8_t *image, size_t index, Sensor_t *s,
+                         size_t *type, SensorChannel_t *channel)
+{
+    size_t count = wire_get_le16(&image[SENSOR_IMAGE_OFF_COUNT]);
+    size_t pool_size = wire_get_le16(&image[SENSOR_IMAGE_OFF_POOL_SIZE]);
+    const uint8_t *rec = &image[SENSOR_IMAGE_HEADER_SIZE + (index * SENSOR_IMAGE_RECORD_SIZE)];
+    const uint8_t *pool = &image[SENSOR_IMAGE_HEADER_SIZE + (count * SENSOR_IMAGE_RECORD_SIZE)];
+
+    const char *id = image_string(pool, pool_size, wire_get_le16(&rec[SENSOR_IMAGE_REC_ID]),
+                                  sizeof(s->id));
+    const char *name = image_string(pool, pool_size, wire_get_le16(&rec[SENSOR_IMAGE_REC_NAME]),
+                                    sizeof(s->name));
+    const char *units = image_string(pool, pool_size, wire_get_le16(&rec[SENSOR_IMAGE_REC_UNITS]),
+                                     sizeof(s->units));
+    uint8_t chan = rec[SENSOR_IMAGE_REC_CHANNEL];
+    uint8_t kind = rec[SENSOR_IMAGE_REC_FILTER];
+
+    memset(s, 0, sizeof(*s));
+    if ((id == NULL) || (name == NULL) || (units == NULL) ||
+        (chan >= (uint8_t)SENSOR_IMAGE_CHANNEL_COUNT) ||
+        (kind > (uint8_t)SENSOR_FILTER_MEDIAN) ||
+        !bind_sensor_type(s, rec[SENSOR_IMAGE_REC_TYPE])) {
+        return false;
+    }
+
+    (void)memcpy(s->id, id, strlen(id) + 1U);
+    (void)memcpy(s->name, name, strlen(name) + 1U);
+    (void)memcpy(s->units, units, strlen(units) + 1U);
+    (void)memcpy(s->channel, s_channel_names[chan], strlen(s_channel_names[chan]) + 1U);
+    s->period_ms = wire_get_le32(&rec[SENSOR_IMAGE_REC_PERIOD]);
+    s->filter.kind = (SensorFilterKind_t)kind;
+    s->filter.length = rec[SENSOR_IMAGE_REC_LENGTH];
+    s->filter.decimation = wire_get_le16(&rec[SENSOR_IMAGE_REC_DECIMATION]);
+    s->filter.alpha = (double)wire_get_le32(&rec[SENSOR_IMAGE_REC_ALPHA]) /
+                      (double)SENSOR_IMAGE_ALPHA_SCALE;
+    s->history = wire_get_le16(&rec[SENSOR_IMAGE_REC_HISTORY]);
+    s->decimals = rec[SENSOR_IMAGE_REC_DECIMALS];
+    *type = rec[SENSOR_IMAGE_REC_TYPE];
+    *channel = (SensorChannel_t)chan;
+
+    return (sensor_filter_validate(&s->filter) == SMART_QSO_OK) &&
+           (s->history <= SENSOR_HISTORY_MAX_DEPTH) &&
+           (s->decimals <= SENSOR_FIXED_MAX_DECIMALS);
+}
+
+/**
+ * @brief Check an image's header, CRC and every record
+ */
+static SmartQsoResult_t image_check(const uint8_t *image, size_t len)
+{
+    if ((len < SENSOR_IMAGE_HEADER_SIZE) ||
+        (wire_get_le32(&image[SENSOR_IMAGE_OFF_MAGIC]) != SENSOR_IMAGE_MAGIC) ||
+        (wire_get_le16(&image[SENSOR_IMAGE_OFF_VERSION]) != SENSOR_IMAGE_VERSION)) {
+        return SMART_QSO_ERROR_INVALID;
+    }
+
+    size_t size = image_size(image);
+    if ((size > len) || (size > SENSOR_IMAGE_MAX_SIZE)) {
+        return SMART_QSO_ERROR_TRUNCATED;
+    }
+
+    uint32_t crc = smart_qso_crc32_update(SMART_QSO_CRC32_INIT, image, SENSOR_IMAGE_OFF_CRC);
+    crc = smart_qso_crc32_update(crc, &image[SENSOR_IMAGE_HEADER_SIZE],
+                                 size - SENSOR_IMAGE_HEADER_SIZE) ^ 0xFFFFFFFFU;
+    if (crc != wire_get_le32(&image[SENSOR_IMAGE_OFF_CRC])) {
+        return SMART_QSO_ERROR_INVALID;
+    }
+
+    size_t count = wire_get_le16(&image[SENSOR_IMAGE_OFF_COUNT]);
+    for (size_t i = 0; i < count; i++) {
+        Sensor_t s;
+        size_t type = 0;
+        SensorChannel_t channel = SENSOR_CHANNEL_NONE;
+        if (!image_record(image, i, &s, &type, &channel)) {
+            return SMART_QSO_ERROR_INVALID;
+        }
     }
-    s_sensors[s_num_sensors++] = *cur;
+    return SMART_QSO_OK;
 }
 
 /*===========================================================================*/
@@ -315,85 +1063,81 @@ static void add_sensor_from_fields(Sensor_t *cur)
 
 SmartQsoResult_t sensors_init(void)
 {
-    memset(s_sensors, 0, sizeof(s_sensors));
+    memset(&s_hot, 0, sizeof(s_hot));
+    memset(s_labels, 0, sizeof(s_labels));
+    memset(s_meta, 0, sizeof(s_meta));
+    memset(s_poll_heap, 0, sizeof(s_poll_heap));
+    memset(s_id_index, 0, sizeof(s_id_index));
+    memset(s_id_hash, 0, sizeof(s_id_hash));
+    s_generation = (s_generation == UINT16_MAX) ? 1U : (uint16_t)(s_generation + 1U);
+    sensor_filter_reset();
+    sensor_history_reset();
     s_num_sensors = 0;
+    s_adc_fresh = 0;
     s_sunlit = true;
     s_soc = 0.75;
-    s_initialized = true;
-    return SMART_QSO_OK;
+    drivers_init();
+
+    SmartQsoResult_t result = hal_adc_init(ADC_RESOLUTION_12BIT, ADC_REF_VDD);
+    s_initialized = (result == SMART_QSO_OK);
+    return result;
 }
 
 SmartQsoResult_t sensors_load_yaml(const char *path)
 {
     SMART_QSO_REQUIRE_NOT_NULL(path);
 
-    FILE *f = fopen(path, "r");
+    FILE *f = fopen(path, "rb");
     if (f == NULL) {
         return SMART_QSO_ERROR_IO;
     }
 
-    char line[256];
-    bool in_list = false;
+    /* The file is tokenized in fixed-size chunks; field values are read
+     * straight out of the chunk */
+    static yaml_tokenizer_t tok;
+    static char chunk[SENSORS_YAML_CHUNK_SIZE];
+    yaml_token_t token;
+    yaml_error_t err = YAML_NEED_INPUT;
     bool have_item = false;
+    bool valid = true;
+    bool last = false;
     Sensor_t cur;
     memset(&cur, 0, sizeof(cur));
-
-    while (fgets(line, sizeof(line), f) != NULL) {
-        trim(line);
-        if (line[0] == '#' || line[0] == '\0') {
-            continue;
-        }
-
-        if (!in_list) {
-            if (strcmp(line, "sensors:") == 0) {
-                in_list = true;
+    cur.decimals = SENSOR_FIXED_DEFAULT_DECIMALS;
+    yaml_tokenizer_init(&tok);
+
+    while ((err == YAML_NEED_INPUT) && !last) {
+        size_t n = fread(chunk, 1, sizeof(chunk), f);
+        last = (n < sizeof(chunk));
+        (void)yaml_tokenizer_feed(&tok, chunk, n, last);
+
+        while ((err = yaml_tokenizer_next(&tok, &token)) == YAML_OK) {
+            /* Only the items of the top-level "sensors" list are read */
+            if ((token.depth != 1U) || !yaml_span_equals(token.path[0], "sensors")) {
+                continue;
             }
-            continue;
-        }
-
-        if (strncmp(line, "- ", 2) == 0 || strcmp(line, "-") == 0) {
-            if (have_item) {
-                add_sensor_from_fields(&cur);
-                memset(&cur, 0, sizeof(cur));
+            if (token.item) {
+                if (have_item) {
+                    add_sensor_from_fields(&cur, valid);
+                    memset(&cur, 0, sizeof(cur));
+                    cur.decimals = SENSOR_FIXED_DEFAULT_DECIMALS;
+                    valid = true;
+                }
+                have_item = true;
+            }
+            if (have_item && (token.kind == YAML_TOKEN_SCALAR)) {
+                apply_field(&cur, &token, &valid);
             }
-            have_item = true;
-            continue;
-        }
-
-        char key[64], val[128];
-        parse_keyval(line, key, sizeof(key), val, sizeof(val));
-        if (key[0] == '\0') {
-            continue;
-        }
-
-        /* Intentional truncation - values are validated externally */
-#if defined(__GNUC__) && !defined(__clang__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wformat-truncation"
-#endif
-        if (strcmp(key, "id") == 0) {
-            (void)snprintf(cur.id, sizeof(cur.id), "%s", val);
-        } else if (strcmp(key, "name") == 0) {
-            (void)snprintf(cur.name, sizeof(cur.name), "%s", val);
-        } else if (strcmp(key, "type") == 0) {
-            (void)snprintf(cur.type, sizeof(cur.type), "%s", val);
-        } else if (strcmp(key, "units") == 0) {
-            (void)snprintf(cur.units, sizeof(cur.units), "%s", val);
-        } else if (strcmp(key, "channel") == 0) {
-            (void)snprintf(cur.channel, sizeof(cur.channel), "%s", val);
-#if defined(__GNUC__) && !defined(__clang__)
-#pragma GCC diagnostic pop
-#endif
-        } else if (strcmp(key, "period_ms") == 0) {
-            cur.period_ms = (uint32_t)strtoul(val, NULL, 10);
         }
     }
 
-    if (have_item) {
-        add_sensor_from_fields(&cur);
+    /* A malformed line ends the table; the item it interrupted is dropped */
+    if (have_item && (err == YAML_NEED_INPUT)) {
+        add_sensor_from_fields(&cur, valid);
     }
 
-    if (fclose(f) != 0) {
+    bool read_error = (ferror(f) != 0);
+    if ((fclose(f) != 0) || read_error) {
         return SMART_QSO_ERROR_IO;
     }
 
@@ -431,15 +1175,98 @@ SmartQsoResult_t sensors_load_defaults(void)
         strncpy(s.units, defs[i].units, sizeof(s.units) - 1);
         strncpy(s.channel, defs[i].channel, sizeof(s.channel) - 1);
         s.period_ms = defs[i].period;
+        s.decimals = SENSOR_FIXED_DEFAULT_DECIMALS;
 
-        if (bind_sensor_behavior(&s)) {
-            s_sensors[s_num_sensors++] = s;
+        size_t type = 0;
+        if (bind_sensor_behavior(&s, &type)) {
+            (void)register_sensor(&s, type, channel_from_name(s.channel));
         }
     }
 
     return SMART_QSO_OK;
 }
 
+SmartQsoResult_t sensors_load_image(const uint8_t *image, size_t len)
+{
+    SMART_QSO_REQUIRE_NOT_NULL(image);
+
+    /* All or nothing: a bad record leaves the table as it was */
+    SmartQsoResult_t result = image_check(image, len);
+    if (result != SMART_QSO_OK) {
+        return result;
+    }
+    size_t count = wire_get_le16(&image[SENSOR_IMAGE_OFF_COUNT]);
+    if (count > (SMART_QSO_MAX_SENSORS - s_num_sensors)) {
+        return SMART_QSO_ERROR_NO_MEM;
+    }
+    size_t history = 0;
+    for (size_t i = 0; i < count; i++) {
+        Sensor_t s;
+        size_t type = 0;
+        SensorChannel_t channel = SENSOR_CHANNEL_NONE;
+        (void)image_record(image, i, &s, &type, &channel);
+        history += (s.value_type == SENSOR_VALUE_NUMERIC) ? s.history : 0U;
+    }
+    if (history > sensor_history_free()) {
+        return SMART_QSO_ERROR_NO_MEM;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        Sensor_t s;
+        size_t type = 0;
+        SensorChannel_t channel = SENSOR_CHANNEL_NONE;
+        (void)image_record(image, i, &s, &type, &channel);
+        (void)register_sensor(&s, type, channel);
+    }
+
+    return (s_num_sensors > 0U) ? SMART_QSO_OK : SMART_QSO_ERROR;
+}
+
+SmartQsoResult_t sensors_load_flash(void)
+{
+    SmartQsoResult_t result = hal_flash_read(FLASH_REGION_SENSOR_CONFIG, 0U, s_image_buf,
+                                             SENSOR_IMAGE_HEADER_SIZE);
+    if (result != SMART_QSO_OK) {
+        return result;
+    }
+    if (wire_get_le32(&s_image_buf[SENSOR_IMAGE_OFF_MAGIC]) != SENSOR_IMAGE_MAGIC) {
+        return SMART_QSO_ERROR;     /* No image stored */
+    }
+
+    size_t size = image_size(s_image_buf);
+    if ((size > sizeof(s_image_buf)) ||
+        (size > hal_flash_region_size(FLASH_REGION_SENSOR_CONFIG))) {
+        return SMART_QSO_ERROR_TRUNCATED;
+    }
+    result = hal_flash_read(FLASH_REGION_SENSOR_CONFIG, SENSOR_IMAGE_HEADER_SIZE,
+                            &s_image_buf[SENSOR_IMAGE_HEADER_SIZE],
+                            size - SENSOR_IMAGE_HEADER_SIZE);
+    if (result != SMART_QSO_OK) {
+        return result;
+    }
+    return sensors_load_image(s_image_buf, size);
+}
+
+SmartQsoResult_t sensors_store_image(const uint8_t *image, size_t len)
+{
+    SMART_QSO_REQUIRE_NOT_NULL(image);
+
+    SmartQsoResult_t result = image_check(image, len);
+    if (result != SMART_QSO_OK) {
+        return result;
+    }
+    size_t size = image_size(image);
+    if (size > hal_flash_region_size(FLASH_REGION_SENSOR_CONFIG)) {
+        return SMART_QSO_ERROR_NO_MEM;
+    }
+
+    result = hal_flash_erase(FLASH_REGION_SENSOR_CONFIG);
+    if (result == SMART_QSO_OK) {
+        result = hal_flash_write(FLASH_REGION_SENSOR_CONFIG, 0U, image, size);
+    }
+    return result;
+}
+
 size_t sensors_get_count(void)
 {
     return s_num_sensors;
@@ -450,74 +1277,369 @@ SmartQsoResult_t sensors_get(size_t index, Sensor_t *sensor)
     SMART_QSO_REQUIRE_NOT_NULL(sensor);
     SMART_QSO_REQUIRE(index < s_num_sensors, "Index out of range");
 
-    *sensor = s_sensors[index];
+    sensor_view(index, sensor);
     return SMART_QSO_OK;
 }
 
+SmartQsoResult_t sensors_get_summary(size_t index, SensorSummary_t *summary)
+{
+    SMART_QSO_REQUIRE_NOT_NULL(summary);
+    SMART_QSO_REQUIRE(index < s_num_sensors, "Index out of range");
+
+    return sensor_filter_get_summary(index, summary);
+}
+
 SmartQsoResult_t sensors_get_by_id(const char *id, Sensor_t *sensor)
 {
     SMART_QSO_REQUIRE_NOT_NULL(id);
     SMART_QSO_REQUIRE_NOT_NULL(sensor);
 
-    for (size_t i = 0; i < s_num_sensors; i++) {
-        if (strcmp(s_sensors[i].id, id) == 0) {
-            *sensor = s_sensors[i];
-            return SMART_QSO_OK;
+    size_t slot = id_lookup(id, id_hash(id));
+    if (slot == SMART_QSO_MAX_SENSORS) {
+        return SMART_QSO_ERROR;
+    }
+
+    sensor_view(slot, sensor);
+    return SMART_QSO_OK;
+}
+
+SmartQsoResult_t sensors_find(const char *id, SensorHandle_t *handle)
+{
+    SMART_QSO_REQUIRE_NOT_NULL(id);
+    SMART_QSO_REQUIRE_NOT_NULL(handle);
+
+    size_t slot = id_lookup(id, id_hash(id));
+    if (slot == SMART_QSO_MAX_SENSORS) {
+        return SMART_QSO_ERROR;
+    }
+
+    *handle = ((SensorHandle_t)s_generation << 16) | (SensorHandle_t)slot;
+    return SMART_QSO_OK;
+}
+
+SmartQsoResult_t sensors_get_by_handle(SensorHandle_t handle, Sensor_t *sensor)
+{
+    SMART_QSO_REQUIRE_NOT_NULL(sensor);
+
+    size_t slot = handle_slot(handle);
+    if (slot == SMART_QSO_MAX_SENSORS) {
+        return SMART_QSO_ERROR_INVALID;
+    }
+
+    sensor_view(slot, sensor);
+    return SMART_QSO_OK;
+}
+
+SmartQsoResult_t sensors_get_value(SensorHandle_t handle, double *value)
+{
+    SMART_QSO_REQUIRE_NOT_NULL(value);
+
+    size_t slot = handle_slot(handle);
+    if (slot == SMART_QSO_MAX_SENSORS) {
+        return SMART_QSO_ERROR_INVALID;
+    }
+
+    *value = s_hot.last_value[slot];
+    return SMART_QSO_OK;
+}
+
+SmartQsoResult_t sensors_get_fixed(SensorHandle_t handle, int32_t *value, uint8_t *decimals)
+{
+    SMART_QSO_REQUIRE_NOT_NULL(value);
+    SMART_QSO_REQUIRE_NOT_NULL(decimals);
+
+    size_t slot = handle_slot(handle);
+    if (slot == SMART_QSO_MAX_SENSORS) {
+        return SMART_QSO_ERROR_INVALID;
+    }
+
+    *value = s_hot.last_fixed[slot];
+    *decimals = s_hot.decimals[slot];
+    return SMART_QSO_OK;
+}
+
+SmartQsoResult_t sensors_pack_i16(const SensorHandle_t *handles, size_t count, uint8_t decimals,
+                                  uint16_t *fields)
+{
+    SMART_QSO_REQUIRE_NOT_NULL(handles);
+    SMART_QSO_REQUIRE_NOT_NULL(fields);
+
+    if (decimals > SENSOR_FIXED_MAX_DECIMALS) {
+        return SMART_QSO_ERROR_PARAM;
+    }
+
+    SmartQsoResult_t result = SMART_QSO_OK;
+    for (size_t n = 0; n < count; n++) {
+        size_t slot = handle_slot(handles[n]);
+        if (slot == SMART_QSO_MAX_SENSORS) {
+            fields[n] = 0;
+            result = SMART_QSO_ERROR_INVALID;
+            continue;
         }
+        int32_t value = sensor_fixed_rescale(s_hot.last_fixed[slot], s_hot.decimals[slot],
+                                             decimals);
+        fields[n] = (uint16_t)sensor_fixed_to_i16(value);
+    }
+    return result;
+}
+
+SmartQsoResult_t sensors_get_samples(SensorHandle_t handle, size_t max,
+                                     SensorSample_t *samples, size_t *count)
+{
+    SMART_QSO_REQUIRE_NOT_NULL(samples);
+    SMART_QSO_REQUIRE_NOT_NULL(count);
+
+    size_t slot = handle_slot(handle);
+    if (slot == SMART_QSO_MAX_SENSORS) {
+        return SMART_QSO_ERROR_INVALID;
+    }
+
+    *count = sensor_history_last(slot, max, samples);
+    return SMART_QSO_OK;
+}
+
+SmartQsoResult_t sensors_get_samples_since(SensorHandle_t handle, uint64_t since_ms, size_t max,
+                                           SensorSample_t *samples, size_t *count)
+{
+    SMART_QSO_REQUIRE_NOT_NULL(samples);
+    SMART_QSO_REQUIRE_NOT_NULL(count);
+
+    size_t slot = handle_slot(handle);
+    if (slot == SMART_QSO_MAX_SENSORS) {
+        return SMART_QSO_ERROR_INVALID;
+    }
+
+    *count = sensor_history_since(slot, since_ms, max, samples);
+    return SMART_QSO_OK;
+}
+
+/**
+ * @brief Take a driver reading for a sensor
+ *
+ * Text readings go straight to the hot state; numeric readings are returned
+ * for the filter pipeline.
+ *
+ * @param index Sensor index
+ * @param reading Driver reading
+ * @param now_ms Poll time
+ * @param[out] raw Numeric reading
+ * @return true if the read succeeded
+ */
+static bool take_reading(size_t index, const SensorReading_t *reading, uint64_t now_ms,
+                         double *raw)
+{
+    if (!reading->valid) {
+        return false;
     }
 
-    return SMART_QSO_ERROR;
+    if (s_hot.value_type[index] == (uint8_t)SENSOR_VALUE_NUMERIC) {
+        *raw = reading->value;
+    } else {
+        (void)snprintf(s_hot.last_text[index], sizeof(s_hot.last_text[index]), "%s",
+                       reading->text);
+        s_hot.last_update_ms[index] = now_ms;
+    }
+    return true;
+}
+
+/**
+ * @brief Publish a filtered numeric value
+ *
+ * The fixed-point forms of the value and, for a decimated sensor, of its
+ * window summary are taken here, once per published value, so telemetry
+ * needs no floating point.
+ *
+ * @param index Sensor index
+ * @param value Filtered value
+ * @param now_ms Poll time
+ */
+static void publish_value(size_t index, double value, uint64_t now_ms)
+{
+    uint8_t decimals = s_hot.decimals[index];
+    SensorSummary_t summary;
+
+    s_hot.last_value[index] = value;
+    s_hot.last_fixed[index] = sensor_fixed_from_double(value, decimals);
+    s_hot.last_update_ms[index] = now_ms;
+    sensor_history_push(index, now_ms, value);
+
+    if (s_hot.decimated[index] && (sensor_filter_get_summary(index, &summary) == SMART_QSO_OK) &&
+        (summary.samples > 0U)) {
+        s_hot.summary_fixed[index][0] = sensor_fixed_from_double(summary.min, decimals);
+        s_hot.summary_fixed[index][1] = sensor_fixed_from_double(summary.max, decimals);
+        s_hot.summary_fixed[index][2] = sensor_fixed_from_double(summary.mean, decimals);
+        s_hot.summarized[index] = true;
+    }
 }
 
 size_t sensors_poll(uint64_t current_ms)
 {
+    uint16_t due[SMART_QSO_MAX_SENSORS];
+    size_t num_due = 0;
+    HalAdcChannel_t channels[ADC_CHANNEL_COUNT];
+    size_t num_channels = 0;
+    uint32_t wanted = 0;
+    uint32_t drivers = 0;
+    uint16_t group[SMART_QSO_MAX_SENSORS];
+    uint8_t group_channels[SMART_QSO_MAX_SENSORS];
+    SensorReading_t readings[SMART_QSO_MAX_SENSORS];
+    uint16_t batch[SMART_QSO_MAX_SENSORS];
+    double raw[SMART_QSO_MAX_SENSORS];
+    double filtered[SMART_QSO_MAX_SENSORS];
+    bool published[SMART_QSO_MAX_SENSORS];
+    size_t num_batch = 0;
     size_t count = 0;
 
-    for (size_t i = 0; i < s_num_sensors; ++i) {
-        Sensor_t *s = &s_sensors[i];
-        if (current_ms >= s->next_poll_ms) {
+    /* Only due sensors are visited: each is rescheduled past current_ms */
+    while (s_num_sensors > 0U) {
+        size_t i = s_poll_heap[0];
+        if (current_ms < s_hot.next_poll_ms[i]) {
+            break;
+        }
+        due[num_due++] = (uint16_t)i;
+
+        uint32_t period = s_hot.period_ms[i];
+        s_hot.next_poll_ms[i] = current_ms + (period > 0 ? period : 1000);
+        poll_heap_sift_down(0U);
+    }
+
+    /* One ADC scan for every channel the due sensors sample */
+    for (size_t n = 0; n < num_due; n++) {
+        drivers |= (uint32_t)1U << s_hot.driver[due[n]];
+        uint8_t adc = s_hot.adc_channel[due[n]];
+        if ((adc < (uint8_t)ADC_CHANNEL_COUNT) && ((wanted & ((uint32_t)1U << adc)) == 0U)) {
+            wanted |= (uint32_t)1U << adc;
+            channels[num_channels++] = (HalAdcChannel_t)adc;
+        }
+    }
+    (void)acquire_adc(channels, num_channels);
+
+    /* One read per driver for its due sensors. Text sensors are logged as
+     * read; numeric samples are batched */
+    for (size_t type = 1; type < (size_t)SENSOR_IMAGE_TYPE_COUNT; type++) {
+        size_t num_group = 0;
+        if ((drivers & ((uint32_t)1U << type)) == 0U) {
+            continue;
+        }
+        for (size_t n = 0; n < num_due; n++) {
+            if (s_hot.driver[due[n]] == type) {
+                group[num_group] = due[n];
+                group_channels[num_group] = s_hot.channel[due[n]];
+                num_group++;
+            }
+        }
+        driver_read(type, group_channels, readings, num_group);
+
+        for (size_t n = 0; n < num_group; n++) {
+            size_t i = group[n];
             double val = 0.0;
-            char text[8] = {0};
-
-            if (s->read != NULL && s->read(s, &val, text)) {
-                if (s->value_type == SENSOR_VALUE_NUMERIC) {
-                    s->last_value = val;
-                    printf("[READ] id=%s name=\"%s\" value=%.3f units=%s\n",
-                           s->id, s->name, s->last_value, s->units);
-                } else {
-                    (void)snprintf(s->last_text, sizeof(s->last_text), "%s", text);
-                    printf("[READ] id=%s name=\"%s\" value=%s units=%s\n",
-                           s->id, s->name, s->last_text, s->units);
-                }
-                count++;
+            if (!take_reading(i, &readings[n], current_ms, &val)) {
+                continue;
             }
+            count++;
+            if (s_hot.value_type[i] == (uint8_t)SENSOR_VALUE_NUMERIC) {
+                batch[num_batch] = (uint16_t)i;
+                raw[num_batch] = val;
+                num_batch++;
+            } else {
+                printf("[READ] id=%s name=\"%s\" value=%s units=%s\n",
+                       s_labels[i].id, s_meta[i].name, s_hot.last_text[i], s_labels[i].units);
+            }
+        }
+    }
 
-            s->next_poll_ms = current_ms + (s->period_ms > 0 ? s->period_ms : 1000);
+    /* One filter update for the batch; decimated sensors publish per window */
+    sensor_filter_update(batch, raw, num_batch, filtered, published);
+    for (size_t n = 0; n < num_batch; n++) {
+        size_t i = batch[n];
+        if (published[n]) {
+            publish_value(i, filtered[n], current_ms);
+            printf("[READ] id=%s name=\"%s\" value=%.3f units=%s\n",
+                   s_labels[i].id, s_meta[i].name, s_hot.last_value[i], s_labels[i].units);
         }
     }
 
     return count;
 }
 
+uint64_t sensors_next_poll_ms(void)
+{
+    if (s_num_sensors == 0U) {
+        return UINT64_MAX;
+    }
+    return s_hot.next_poll_ms[s_poll_heap[0]];
+}
+
 SmartQsoResult_t sensors_poll_one(size_t index)
 {
     SMART_QSO_REQUIRE(index < s_num_sensors, "Index out of range");
 
-    Sensor_t *s = &s_sensors[index];
-    double val = 0.0;
-    char text[8] = {0};
+    HalAdcChannel_t adc = (HalAdcChannel_t)s_hot.adc_channel[index];
+    if ((adc != ADC_CHANNEL_COUNT) && !acquire_adc(&adc, 1U)) {
+        return SMART_QSO_ERROR;
+    }
 
-    if (s->read == NULL || !s->read(s, &val, text)) {
+    SensorReading_t reading;
+    uint64_t now_ms = smart_qso_now_ms();
+    double raw = 0.0;
+    driver_read(s_hot.driver[index], &s_hot.channel[index], &reading, 1U);
+    if (!take_reading(index, &reading, now_ms, &raw)) {
         return SMART_QSO_ERROR;
     }
+    if (s_hot.value_type[index] == (uint8_t)SENSOR_VALUE_NUMERIC) {
+        uint16_t slot = (uint16_t)index;
+        double filtered = 0.0;
+        bool published = false;
+
+        sensor_filter_update(&slot, &raw, 1U, &filtered, &published);
+        if (published) {
+            publish_value(index, filtered, now_ms);
+        }
+    }
+    return SMART_QSO_OK;
+}
+
+/** Longest telemetry field: ID, suffix, '=', value, units, ',' */
+#define SENSOR_FIELD_MAX    (SMART_QSO_SENSOR_ID_LEN + 4U + SENSOR_FIXED_TEXT_MAX + \
+                             SMART_QSO_SENSOR_UNITS_LEN)
+
+/**
+ * @brief Copy a string without its terminator
+ *
+ * @return Characters copied
+ */
+static size_t put_text(char *out, const char *text)
+{
+    size_t len = strlen(text);
+    (void)memcpy(out, text, len);
+    return len;
+}
 
-    if (s->value_type == SENSOR_VALUE_NUMERIC) {
-        s->last_value = val;
+/**
+ * @brief Format one "ID<suffix>=<value><units>," telemetry field
+ *
+ * @param[out] field SENSOR_FIELD_MAX bytes; not terminated
+ * @param index  Sensor index
+ * @param suffix Appended to the ID
+ * @param value  Fixed-point value; text sensors print their last text
+ * @return Characters written
+ */
+static size_t format_field(char *field, size_t index, const char *suffix, int32_t value)
+{
+    char text[SENSOR_FIXED_TEXT_MAX];
+    size_t len = put_text(field, s_labels[index].id);
+
+    len += put_text(&field[len], suffix);
+    field[len++] = '=';
+    if (s_hot.value_type[index] == (uint8_t)SENSOR_VALUE_NUMERIC) {
+        (void)sensor_fixed_format(value, s_hot.decimals[index], text);
+        len += put_text(&field[len], text);
     } else {
-        (void)snprintf(s->last_text, sizeof(s->last_text), "%s", text);
+        len += put_text(&field[len], s_hot.last_text[index]);
     }
-
-    return SMART_QSO_OK;
+    len += put_text(&field[len], s_labels[index].units);
+    field[len++] = ',';
+    return len;
 }
 
 void sensors_set_environment(bool sunlit, double soc)
@@ -532,23 +1654,28 @@ size_t sensors_format_telemetry(char *buffer, size_t buffer_len)
     SMART_QSO_REQUIRE(buffer_len > 0, "Invalid buffer length");
 
     size_t offset = 0;
+    char field[3U * SENSOR_FIELD_MAX];
 
     for (size_t i = 0; i < s_num_sensors; ++i) {
-        Sensor_t *s = &s_sensors[i];
-        int written;
-
-        if (s->value_type == SENSOR_VALUE_NUMERIC) {
-            written = snprintf(buffer + offset, buffer_len - offset,
-                               "%s=%.3f%s,", s->id, s->last_value, s->units);
-        } else {
-            written = snprintf(buffer + offset, buffer_len - offset,
-                               "%s=%s%s,", s->id, s->last_text, s->units);
-        }
-
-        if (written < 0 || (size_t)written >= buffer_len - offset) {
+        size_t len = format_field(field, i, "", s_hot.last_fixed[i]);
+        if (len >= buffer_len - offset) {
             break;  /* Truncation detected */
         }
-        offset += (size_t)written;
+        (void)memcpy(&buffer[offset], field, len);
+        offset += len;
+        buffer[offset] = '\0';
+
+        if (s_hot.summarized[i]) {
+            len = format_field(field, i, "_MIN", s_hot.summary_fixed[i][0]);
+            len += format_field(&field[len], i, "_MAX", s_hot.summary_fixed[i][1]);
+            len += format_field(&field[len], i, "_AVG", s_hot.summary_fixed[i][2]);
+            if (len >= buffer_len - offset) {
+                break;  /* Truncation detected */
+            }
+            (void)memcpy(&buffer[offset], field, len);
+            offset += len;
+            buffer[offset] = '\0';
+        }
     }
 
     return offset;
@@ -10,18 +10,35 @@
  */
 
 #include "system_state.h"
+#include "kv_store.h"
 #include "safe_string.h"
 #include <stddef.h>
 
-/* For simulation builds, use standard file I/O for persistence */
-/* For flight builds, use HAL flash interface instead */
-#ifdef SIMULATION_BUILD
-#include <stdio.h>
-/** Persistence file path (simulation only) */
-static const char *STATE_FILE = "/tmp/smart_qso_state.dat";
-#else
-#include "hal/hal_flash.h"
-#endif
+/*******************************************************************************
+ * Persistence Layout
+ *
+ * Each section is stored under its own key (KV_KEY_SYSTEM_SECTION), so a
+ * save appends records only for the sections that changed.
+ ******************************************************************************/
+
+/** Schema version of the persisted sections */
+#define SYS_STATE_SCHEMA_VERSION    1U
+
+/** Location and size of each section within SystemState_t */
+static const struct {
+    size_t offset;
+    size_t size;
+} s_sections[SYS_SECTION_COUNT] = {
+    { offsetof(SystemState_t, power),      sizeof(PowerState_t) },
+    { offsetof(SystemState_t, thermal),    sizeof(ThermalState_t) },
+    { offsetof(SystemState_t, adcs),       sizeof(AdcsState_t) },
+    { offsetof(SystemState_t, comm),       sizeof(CommState_t) },
+    { offsetof(SystemState_t, mission),    sizeof(MissionState_t) },
+    { offsetof(SystemState_t, sm_context), sizeof(SmContext_t) },
+};
+
+/** Bit mask of every section */
+#define ALL_SECTIONS        ((1U << (uint32_t)SYS_SECTION_COUNT) - 1U)
 
 /*******************************************************************************
  * Private Data
@@ -30,19 +47,42 @@ static const char *STATE_FILE = "/tmp/smart_qso_state.dat";
 /** Single instance of system state - all access through accessors */
 static SystemState_t s_state;
 
+/** Sections modified since the last save */
+static uint32_t s_dirty_sections;
+
+/** CRC of each section as last persisted (0 = not persisted) */
+static uint32_t s_persisted_crc[SYS_SECTION_COUNT];
+
 /*******************************************************************************
  * Private Functions
  ******************************************************************************/
 
 /**
- * @brief Mark state as dirty (needs saving)
+ * @brief Mark a section as dirty (needs saving)
  */
-static void mark_dirty(void)
+static void mark_dirty(SysStateSection_t section)
 {
+    s_dirty_sections |= 1U << (uint32_t)section;
     s_state.persistence_dirty = true;
     s_state.last_update_ms = smart_qso_now_ms();
 }
 
+/**
+ * @brief Address of a section within s_state
+ */
+static uint8_t *section_data(SysStateSection_t section)
+{
+    return (uint8_t *)&s_state + s_sections[section].offset;
+}
+
+/**
+ * @brief CRC of a section's current contents
+ */
+static uint32_t section_crc(SysStateSection_t section)
+{
+    return smart_qso_crc32(section_data(section), s_sections[section].size);
+}
+
 /*******************************************************************************
  * Initialization Functions
  ******************************************************************************/
@@ -51,6 +91,7 @@ SmartQsoResult_t sys_state_init(void)
 {
     /* Clear all state to zero */
     (void)safe_memset(&s_state, sizeof(s_state), 0, sizeof(s_state));
+    s_dirty_sections = 0;
 
     /* Initialize power state defaults */
     s_state.power.battery_voltage = 3.7;
@@ -91,55 +132,33 @@ SmartQsoResult_t sys_state_init(void)
 
 SmartQsoResult_t sys_state_load(void)
 {
-#ifdef SIMULATION_BUILD
-    FILE *fp = fopen(STATE_FILE, "rb");
-    if (fp == NULL) {
-        /* No saved state, use defaults */
-        return sys_state_init();
+    /* Sections without a stored record keep their defaults */
+    SmartQsoResult_t result = sys_state_init();
+    if (result != SMART_QSO_OK) {
+        return result;
     }
 
-    SystemState_t loaded_state;
-    size_t read_count = fread(&loaded_state, sizeof(loaded_state), 1, fp);
-    (void)fclose(fp);
+    (void)safe_memset(s_persisted_crc, sizeof(s_persisted_crc), 0, sizeof(s_persisted_crc));
 
-    if (read_count != 1) {
-        /* Read failed, use defaults */
-        return sys_state_init();
-    }
-#else
-    /* Flight build: use HAL flash interface */
-    SystemState_t loaded_state;
-    SmartQsoResult_t flash_result = hal_flash_read(
-        FLASH_REGION_STATE,
-        0,
-        (uint8_t *)&loaded_state,
-        sizeof(loaded_state));
-
-    if (flash_result != SMART_QSO_OK) {
-        /* No saved state or read error, use defaults */
-        return sys_state_init();
-    }
-#endif
+    for (uint32_t i = 0; i < (uint32_t)SYS_SECTION_COUNT; i++) {
+        SysStateSection_t section = (SysStateSection_t)i;
+        size_t len = 0;
 
-    /* Verify CRC before accepting loaded state */
-    uint32_t saved_crc = loaded_state.crc32;
-    loaded_state.crc32 = 0;
-    uint32_t calc_crc = smart_qso_crc32(&loaded_state, sizeof(loaded_state) - sizeof(uint32_t));
-
-    if (saved_crc != calc_crc) {
-        /* CRC mismatch, use defaults */
-        return sys_state_init();
+        if ((kv_get(KV_KEY_SYSTEM_SECTION(i), SYS_STATE_SCHEMA_VERSION, section_data(section),
+                    s_sections[i].size, &len) == SMART_QSO_OK) &&
+            (len == s_sections[i].size)) {
+            s_persisted_crc[i] = section_crc(section);
+        }
     }
 
-    /* Accept loaded state */
-    (void)safe_memcpy(&s_state, sizeof(s_state), &loaded_state, sizeof(loaded_state));
-
     /* Re-initialize state machine (context needs fresh init) */
     SmState_t last_state = s_state.sm_context.current_state;
     (void)sm_init(&s_state.sm_context, last_state);
 
     s_state.initialized = true;
     s_state.persistence_dirty = false;
+    s_dirty_sections = 0;
+    (void)sys_state_update_crc();
 
     return SMART_QSO_OK;
 }
@@ -153,37 +172,32 @@ SmartQsoResult_t sys_state_save(void)
     /* Update CRC before saving */
     (void)sys_state_update_crc();
 
-#ifdef SIMULATION_BUILD
-    FILE *fp = fopen(STATE_FILE, "wb");
-    if (fp == NULL) {
-        return SMART_QSO_ERROR_IO;
-    }
-
-    size_t written = fwrite(&s_state, sizeof(s_state), 1, fp);
-    (void)fclose(fp);
-
-    if (written != 1) {
-        return SMART_QSO_ERROR_IO;
+    /*
+     * The state machine context is changed through sys_get_sm_context(),
+     * so it is always a candidate, as is any section with no stored value;
+     * any candidate whose contents match the stored value is skipped.
+     */
+    uint32_t candidates = s_dirty_sections | (1U << (uint32_t)SYS_SECTION_CONTROL);
+
+    for (uint32_t i = 0; i < (uint32_t)SYS_SECTION_COUNT; i++) {
+        SysStateSection_t section = (SysStateSection_t)i;
+        uint32_t crc = section_crc(section);
+
+        if (s_persisted_crc[i] == 0U) {
+            candidates |= 1U << i;
+        }
+        if (((candidates & (1U << i)) == 0U) || (crc == s_persisted_crc[i])) {
+            continue;
+        }
+
+        if (kv_put(KV_KEY_SYSTEM_SECTION(i), SYS_STATE_SCHEMA_VERSION, section_data(section),
+                   s_sections[i].size) != SMART_QSO_OK) {
+            return SMART_QSO_ERROR_IO;
+        }
+        s_persisted_crc[i] = crc;
     }
-#else
-    /* Flight build: use HAL flash interface */
-    SmartQsoResult_t flash_result = hal_flash_erase(FLASH_REGION_STATE);
-
-    if (flash_result != SMART_QSO_OK) {
-        return SMART_QSO_ERROR_IO;
-    }
-
-    flash_result = hal_flash_write(
-        FLASH_REGION_STATE,
-        0,
-        (const uint8_t *)&s_state,
-        sizeof(s_state));
-
-    if (flash_result != SMART_QSO_OK) {
-        return SMART_QSO_ERROR_IO;
-    }
-#endif
 
+    s_dirty_sections = 0;
     s_state.persistence_dirty = false;
     s_state.last_persist_ms = smart_qso_now_ms();
 
@@ -197,9 +211,15 @@ bool sys_state_is_dirty(void)
 
 void sys_state_clear_dirty(void)
 {
+    s_dirty_sections = 0;
     s_state.persistence_dirty = false;
 }
 
+uint32_t sys_state_dirty_sections(void)
+{
+    return s_dirty_sections & ALL_SECTIONS;
+}
+
 /*******************************************************************************
  * Power State Accessors
  ******************************************************************************/
@@ -217,14 +237,14 @@ SmartQsoResult_t sys_get_power_state(PowerState_t *state)
 SmartQsoResult_t sys_set_battery_voltage(double voltage_v)
 {
     s_state.power.battery_voltage = voltage_v;
-    mark_dirty();
+    mark_dirty(SYS_SECTION_POWER);
     return SMART_QSO_OK;
 }
 
 SmartQsoResult_t sys_set_battery_current(double current_a)
 {
     s_state.power.battery_current = current_a;
-    mark_dirty();
+    mark_dirty(SYS_SECTION_POWER);
     return SMART_QSO_OK;
 }
 
@@ -238,7 +258,7 @@ SmartQsoResult_t sys_set_state_of_charge(double soc)
     }
 
     s_state.power.state_of_charge = soc;
-    mark_dirty();
+    mark_dirty(SYS_SECTION_POWER);
     return SMART_QSO_OK;
 }
 
@@ -251,7 +271,7 @@ SmartQsoResult_t sys_set_power_mode(PowerMode_t mode)
 {
     s_state.power.power_mode = mode;
     s_state.power.mode_entry_time_ms = (uint32_t)smart_qso_now_ms();
-    mark_dirty();
+    mark_dirty(SYS_SECTION_POWER);
     return SMART_QSO_OK;
 }
 
@@ -263,7 +283,7 @@ PowerMode_t sys_get_power_mode(void)
 SmartQsoResult_t sys_set_payload_enabled(bool enabled)
 {
     s_state.power.payload_enabled = enabled;
-    mark_dirty();
+    mark_dirty(SYS_SECTION_POWER);
     return SMART_QSO_OK;
 }
 
@@ -312,7 +332,7 @@ SmartQsoResult_t sys_set_temperature(uint8_t sensor, float temp_c)
     s_state.thermal.over_temp_flag = (temp_c > 60.0f);
     s_state.thermal.under_temp_flag = (temp_c < -20.0f);
 
-    mark_dirty();
+    mark_dirty(SYS_SECTION_THERMAL);
     return SMART_QSO_OK;
 }
 
@@ -341,7 +361,7 @@ SmartQsoResult_t sys_set_magnetometer(float x, float y, float z)
     s_state.adcs.mag_y_ut = y;
     s_state.adcs.mag_z_ut = z;
     s_state.adcs.last_update_ms = (uint32_t)smart_qso_now_ms();
-    mark_dirty();
+    mark_dirty(SYS_SECTION_ADCS);
     return SMART_QSO_OK;
 }
 
@@ -351,14 +371,14 @@ SmartQsoResult_t sys_set_gyroscope(float x, float y, float z)
     s_state.adcs.gyro_y_dps = y;
     s_state.adcs.gyro_z_dps = z;
     s_state.adcs.last_update_ms = (uint32_t)smart_qso_now_ms();
-    mark_dirty();
+    mark_dirty(SYS_SECTION_ADCS);
     return SMART_QSO_OK;
 }
 
 SmartQsoResult_t sys_set_detumbled(bool achieved)
 {
     s_state.adcs.detumbled = achieved;
-    mark_dirty();
+    mark_dirty(SYS_SECTION_ADCS);
     return SMART_QSO_OK;
 }
 
@@ -384,21 +404,21 @@ SmartQsoResult_t sys_get_comm_state(CommState_t *state)
 SmartQsoResult_t sys_increment_packets_sent(void)
 {
     s_state.comm.packets_sent++;
-    mark_dirty();
+    mark_dirty(SYS_SECTION_COMM);
     return SMART_QSO_OK;
 }
 
 SmartQsoResult_t sys_increment_packets_received(void)
 {
     s_state.comm.packets_received++;
-    mark_dirty();
+    mark_dirty(SYS_SECTION_COMM);
     return SMART_QSO_OK;
 }
 
 SmartQsoResult_t sys_increment_beacon_count(void)
 {
     s_state.comm.beacon_count++;
-    mark_dirty();
+    mark_dirty(SYS_SECTION_COMM);
     return SMART_QSO_OK;
 }
 
@@ -406,7 +426,7 @@ SmartQsoResult_t sys_update_ground_contact(void)
 {
     s_state.comm.last_ground_contact_ms = (uint32_t)smart_qso_now_ms();
     s_state.comm.comm_active = true;
-    mark_dirty();
+    mark_dirty(SYS_SECTION_COMM);
     return SMART_QSO_OK;
 }
 
@@ -418,7 +438,7 @@ SmartQsoResult_t sys_set_beacon_interval(uint16_t interval_s)
     }
 
     s_state.comm.beacon_interval_s = interval_s;
-    mark_dirty();
+    mark_dirty(SYS_SECTION_COMM);
     return SMART_QSO_OK;
 }
 
@@ -439,7 +459,7 @@ SmartQsoResult_t sys_get_mission_state(MissionState_t *state)
 SmartQsoResult_t sys_increment_boot_count(void)
 {
     s_state.mission.boot_count++;
-    mark_dirty();
+    mark_dirty(SYS_SECTION_MISSION);
     return SMART_QSO_OK;
 }
 
@@ -465,7 +485,7 @@ SmartQsoResult_t sys_update_uptime(void)
         s_state.mission.total_uptime_s += elapsed_s;
         s_state.mission.mission_time_ms += elapsed_ms;
         s_last_uptime_update = now;
-        mark_dirty();
+        mark_dirty(SYS_SECTION_MISSION);
     }
 
     return SMART_QSO_OK;
@@ -479,21 +499,21 @@ uint32_t sys_get_uptime_s(void)
 SmartQsoResult_t sys_increment_qso_count(void)
 {
     s_state.mission.qso_count++;
-    mark_dirty();
+    mark_dirty(SYS_SECTION_MISSION);
     return SMART_QSO_OK;
 }
 
 SmartQsoResult_t sys_increment_command_count(void)
 {
     s_state.mission.command_count++;
-    mark_dirty();
+    mark_dirty(SYS_SECTION_MISSION);
     return SMART_QSO_OK;
 }
 
 SmartQsoResult_t sys_increment_anomaly_count(void)
 {
     s_state.mission.anomaly_count++;
-    mark_dirty();
+    mark_dirty(SYS_SECTION_MISSION);
     return SMART_QSO_OK;
 }
 
@@ -9,7 +9,9 @@
 #include "telemetry.h"
 #include "system_state.h"
 #include "safe_string.h"
+#include "wire_codec.h"
 #include <stddef.h>
+#include <string.h>
 
 /*******************************************************************************
  * Private Data
@@ -34,6 +36,9 @@ static bool s_initialized = false;
  * Private Functions
  ******************************************************************************/
 
+/** Frame payload encoder */
+typedef void (*TlmEncodeFn_t)(TlmBuilder_t *builder);
+
 /**
  * @brief Fill telemetry header
  */
@@ -48,51 +53,23 @@ static void fill_header(TlmHeader_t *header, TlmType_t type, uint16_t data_len)
 }
 
 /**
- * @brief Calculate frame CRC
+ * @brief Encode a frame header in wire order
  */
-static uint32_t calculate_frame_crc(const TlmFrame_t *frame, size_t payload_len)
-{
-    size_t crc_len = sizeof(TlmHeader_t) + payload_len;
-    return smart_qso_crc32(frame, crc_len);
-}
-
-/*******************************************************************************
- * Public Functions
- ******************************************************************************/
-
-SmartQsoResult_t tlm_init(void)
-{
-    (void)safe_memset(&s_stats, sizeof(s_stats), 0, sizeof(s_stats));
-    s_rate_ms = TLM_DEFAULT_RATE_MS;
-    s_last_tlm_time_ms = 0;
-    s_initialized = true;
-
-    return SMART_QSO_OK;
-}
-
-SmartQsoResult_t tlm_set_rate(uint32_t rate_ms)
-{
-    if (rate_ms < TLM_MIN_RATE_MS) {
-        rate_ms = TLM_MIN_RATE_MS;
-    } else if (rate_ms > TLM_MAX_RATE_MS) {
-        rate_ms = TLM_MAX_RATE_MS;
-    }
-
-    s_rate_ms = rate_ms;
-    return SMART_QSO_OK;
-}
-
-uint32_t tlm_get_rate(void)
+static void encode_header(uint8_t *dst, const TlmHeader_t *header)
 {
-    return s_rate_ms;
+    wire_put_be32(&dst[0], header->sync_word);
+    dst[4] = header->version;
+    dst[5] = header->type;
+    wire_put_be16(&dst[6], header->sequence);
+    wire_put_be32(&dst[8], header->timestamp_s);
+    wire_put_be16(&dst[12], header->data_len);
 }
 
-SmartQsoResult_t tlm_generate_housekeeping(TlmFrame_t *frame, size_t *frame_len)
+/**
+ * @brief Encode housekeeping payload fields
+ */
+static void encode_housekeeping(TlmBuilder_t *builder)
 {
-    if ((frame == NULL) || (frame_len == NULL)) {
-        return SMART_QSO_ERROR_NULL_PTR;
-    }
-
     /* Get system state */
     PowerState_t power;
     ThermalState_t thermal;
@@ -104,141 +81,216 @@ SmartQsoResult_t tlm_generate_housekeeping(TlmFrame_t *frame, size_t *frame_len)
     (void)sys_get_comm_state(&comm);
     (void)sys_get_adcs_state(&adcs);
 
-    /* Fill housekeeping payload */
-    TlmHousekeeping_t *hk = (TlmHousekeeping_t *)frame->payload;
-
     /* Power */
-    hk->battery_voltage_mv = (uint16_t)(power.battery_voltage * 1000.0);
-    hk->battery_current_ma = (int16_t)(power.battery_current * 1000.0);
-    hk->state_of_charge = (uint8_t)(power.state_of_charge * 100.0);
-    hk->power_mode = (uint8_t)power.power_mode;
+    tlm_builder_put_u16(builder, (uint16_t)(power.battery_voltage * 1000.0));
+    tlm_builder_put_u16(builder, (uint16_t)(int16_t)(power.battery_current * 1000.0));
+    tlm_builder_put_u8(builder, (uint8_t)(power.state_of_charge * 100.0));
+    tlm_builder_put_u8(builder, (uint8_t)power.power_mode);
 
     /* Thermal */
-    hk->obc_temp_c = (int8_t)thermal.obc_temp_c;
-    hk->eps_temp_c = (int8_t)thermal.eps_temp_c;
-    hk->battery_temp_c = (int8_t)thermal.battery_temp_c;
-    hk->payload_temp_c = (int8_t)thermal.payload_temp_c;
+    tlm_builder_put_u8(builder, (uint8_t)(int8_t)thermal.obc_temp_c);
+    tlm_builder_put_u8(builder, (uint8_t)(int8_t)thermal.eps_temp_c);
+    tlm_builder_put_u8(builder, (uint8_t)(int8_t)thermal.battery_temp_c);
+    tlm_builder_put_u8(builder, (uint8_t)(int8_t)thermal.payload_temp_c);
 
     /* Status */
-    hk->op_state = (uint8_t)sys_get_operational_state();
-    hk->fault_flags = sys_has_thermal_fault() ? 0x01U : 0x00U;
-    hk->boot_count = (uint16_t)sys_get_boot_count();
-    hk->uptime_s = sys_get_uptime_s();
+    tlm_builder_put_u8(builder, (uint8_t)sys_get_operational_state());
+    tlm_builder_put_u8(builder, sys_has_thermal_fault() ? 0x01U : 0x00U);
+    tlm_builder_put_u16(builder, (uint16_t)sys_get_boot_count());
+    tlm_builder_put_u32(builder, sys_get_uptime_s());
 
     /* Communications */
-    hk->packets_sent = (uint16_t)comm.packets_sent;
-    hk->packets_received = (uint16_t)comm.packets_received;
-    hk->beacon_count = (uint16_t)comm.beacon_count;
+    tlm_builder_put_u16(builder, (uint16_t)comm.packets_sent);
+    tlm_builder_put_u16(builder, (uint16_t)comm.packets_received);
+    tlm_builder_put_u16(builder, (uint16_t)comm.beacon_count);
 
     /* ADCS */
-    hk->adcs_mode = 0;  /* Would come from ADCS module */
-    hk->detumbled = adcs.detumbled ? 1U : 0U;
-
-    /* Fill header */
-    fill_header(&frame->header, TLM_TYPE_HOUSEKEEPING, sizeof(TlmHousekeeping_t));
+    tlm_builder_put_u8(builder, 0U);  /* Would come from ADCS module */
+    tlm_builder_put_u8(builder, adcs.detumbled ? 1U : 0U);
+}
 
-    /* Calculate CRC */
-    frame->crc32 = calculate_frame_crc(frame, sizeof(TlmHousekeeping_t));
+/**
+ * @brief Encode EPS payload fields
+ */
+static void encode_eps(TlmBuilder_t *builder)
+{
+    PowerState_t power;
+    ThermalState_t thermal;
 
-    *frame_len = sizeof(TlmHeader_t) + sizeof(TlmHousekeeping_t) + sizeof(uint32_t);
-    s_stats.frames_generated++;
+    (void)sys_get_power_state(&power);
+    (void)sys_get_thermal_state(&thermal);
 
-    return SMART_QSO_OK;
+    tlm_builder_put_u16(builder, (uint16_t)(power.battery_voltage * 1000.0));
+    tlm_builder_put_u16(builder, (uint16_t)(int16_t)(power.battery_current * 1000.0));
+    tlm_builder_put_u16(builder, (uint16_t)(power.solar_power * 100.0));  /* Simplified */
+    tlm_builder_put_u16(builder, 0U);
+    tlm_builder_put_u8(builder, (uint8_t)(power.state_of_charge * 100.0));
+    tlm_builder_put_u8(builder, (uint8_t)power.power_mode);
+    tlm_builder_put_u8(builder, thermal.heater_enabled ? 1U : 0U);
+    tlm_builder_put_u8(builder, power.payload_enabled ? 1U : 0U);
+    tlm_builder_put_u8(builder, (uint8_t)(int8_t)thermal.battery_temp_c);
+    tlm_builder_put_u8(builder, (uint8_t)(int8_t)thermal.eps_temp_c);
 }
 
-SmartQsoResult_t tlm_generate_eps(TlmFrame_t *frame, size_t *frame_len)
+/**
+ * @brief Encode ADCS payload fields
+ */
+static void encode_adcs(TlmBuilder_t *builder)
 {
-    if ((frame == NULL) || (frame_len == NULL)) {
-        return SMART_QSO_ERROR_NULL_PTR;
-    }
+    AdcsState_t adcs;
+    (void)sys_get_adcs_state(&adcs);
 
-    PowerState_t power;
-    ThermalState_t thermal;
+    /* Scaled vector block, encoded in one pass */
+    const uint16_t vectors[9] = {
+        (uint16_t)(int16_t)(adcs.mag_x_ut * 10.0f),
+        (uint16_t)(int16_t)(adcs.mag_y_ut * 10.0f),
+        (uint16_t)(int16_t)(adcs.mag_z_ut * 10.0f),
+        (uint16_t)(int16_t)(adcs.gyro_x_dps * 10.0f),
+        (uint16_t)(int16_t)(adcs.gyro_y_dps * 10.0f),
+        (uint16_t)(int16_t)(adcs.gyro_z_dps * 10.0f),
+        (uint16_t)(int16_t)(adcs.sun_vector_x * 100.0f),
+        (uint16_t)(int16_t)(adcs.sun_vector_y * 100.0f),
+        (uint16_t)(int16_t)(adcs.sun_vector_z * 100.0f)
+    };
+    tlm_builder_put_u16_array(builder, vectors, sizeof(vectors) / sizeof(vectors[0]));
+
+    tlm_builder_put_u8(builder, 0U);
+    tlm_builder_put_u8(builder, (uint8_t)((adcs.detumbled ? 0x01U : 0x00U) |
+                                          (adcs.sun_acquired ? 0x02U : 0x00U)));
+}
 
+/**
+ * @brief Encode condensed beacon payload fields
+ */
+static void encode_beacon(TlmBuilder_t *builder)
+{
+    PowerState_t power;
     (void)sys_get_power_state(&power);
-    (void)sys_get_thermal_state(&thermal);
 
-    TlmEps_t *eps = (TlmEps_t *)frame->payload;
+    tlm_builder_put_u8(builder, (uint8_t)sys_get_operational_state());
+    tlm_builder_put_u8(builder, (uint8_t)(power.state_of_charge * 100.0));
+    tlm_builder_put_u8(builder, (uint8_t)power.power_mode);
+    tlm_builder_put_u8(builder, sys_has_thermal_fault() ? 0x01U : 0x00U);
+}
+
+/**
+ * @brief Build a complete frame into a byte buffer
+ */
+static SmartQsoResult_t build_frame(uint8_t *buffer,
+                                    size_t buffer_size,
+                                    TlmType_t type,
+                                    uint16_t payload_len,
+                                    TlmEncodeFn_t encode,
+                                    size_t *bytes_written,
+                                    uint32_t *crc)
+{
+    TlmBuilder_t builder;
 
-    eps->battery_voltage_mv = (uint16_t)(power.battery_voltage * 1000.0);
-    eps->battery_current_ma = (int16_t)(power.battery_current * 1000.0);
-    eps->solar_voltage_mv = (uint16_t)(power.solar_power * 100.0);  /* Simplified */
-    eps->solar_current_ma = 0;
-    eps->state_of_charge = (uint8_t)(power.state_of_charge * 100.0);
-    eps->power_mode = (uint8_t)power.power_mode;
-    eps->heater_enabled = thermal.heater_enabled ? 1U : 0U;
-    eps->payload_enabled = power.payload_enabled ? 1U : 0U;
-    eps->battery_temp_c = (int8_t)thermal.battery_temp_c;
-    eps->pcb_temp_c = (int8_t)thermal.eps_temp_c;
+    SmartQsoResult_t result = tlm_builder_begin(&builder, buffer, buffer_size,
+                                                type, payload_len);
+    if (result != SMART_QSO_OK) {
+        return result;
+    }
 
-    fill_header(&frame->header, TLM_TYPE_EPS, sizeof(TlmEps_t));
-    frame->crc32 = calculate_frame_crc(frame, sizeof(TlmEps_t));
+    encode(&builder);
 
-    *frame_len = sizeof(TlmHeader_t) + sizeof(TlmEps_t) + sizeof(uint32_t);
-    s_stats.frames_generated++;
+    result = tlm_builder_finish(&builder, bytes_written);
+    if ((result == SMART_QSO_OK) && (crc != NULL)) {
+        *crc = builder.crc;
+    }
 
-    return SMART_QSO_OK;
+    return result;
 }
 
-SmartQsoResult_t tlm_generate_adcs(TlmFrame_t *frame, size_t *frame_len)
+/**
+ * @brief Generate a frame into a TlmFrame_t
+ *
+ * Encodes the frame once in wire order, then decodes the header back into
+ * the host-order view held by TlmFrame_t.
+ */
+static SmartQsoResult_t generate_frame(TlmFrame_t *frame,
+                                       size_t *frame_len,
+                                       TlmType_t type,
+                                       uint16_t payload_len,
+                                       TlmEncodeFn_t encode)
 {
     if ((frame == NULL) || (frame_len == NULL)) {
         return SMART_QSO_ERROR_NULL_PTR;
     }
 
-    AdcsState_t adcs;
-    (void)sys_get_adcs_state(&adcs);
+    uint8_t wire[TLM_MAX_FRAME_SIZE];
+    uint32_t crc = 0;
+    SmartQsoResult_t result = build_frame(wire, sizeof(wire), type, payload_len,
+                                          encode, frame_len, &crc);
+    if (result != SMART_QSO_OK) {
+        return result;
+    }
 
-    TlmAdcs_t *tlm_adcs = (TlmAdcs_t *)frame->payload;
-
-    tlm_adcs->mag_x_ut_x10 = (int16_t)(adcs.mag_x_ut * 10.0f);
-    tlm_adcs->mag_y_ut_x10 = (int16_t)(adcs.mag_y_ut * 10.0f);
-    tlm_adcs->mag_z_ut_x10 = (int16_t)(adcs.mag_z_ut * 10.0f);
-    tlm_adcs->gyro_x_dps_x10 = (int16_t)(adcs.gyro_x_dps * 10.0f);
-    tlm_adcs->gyro_y_dps_x10 = (int16_t)(adcs.gyro_y_dps * 10.0f);
-    tlm_adcs->gyro_z_dps_x10 = (int16_t)(adcs.gyro_z_dps * 10.0f);
-    tlm_adcs->sun_x_x100 = (int16_t)(adcs.sun_vector_x * 100.0f);
-    tlm_adcs->sun_y_x100 = (int16_t)(adcs.sun_vector_y * 100.0f);
-    tlm_adcs->sun_z_x100 = (int16_t)(adcs.sun_vector_z * 100.0f);
-    tlm_adcs->mode = 0;
-    tlm_adcs->status = (adcs.detumbled ? 0x01U : 0x00U) |
-                       (adcs.sun_acquired ? 0x02U : 0x00U);
-
-    fill_header(&frame->header, TLM_TYPE_ADCS, sizeof(TlmAdcs_t));
-    frame->crc32 = calculate_frame_crc(frame, sizeof(TlmAdcs_t));
-
-    *frame_len = sizeof(TlmHeader_t) + sizeof(TlmAdcs_t) + sizeof(uint32_t);
-    s_stats.frames_generated++;
+    (void)tlm_decode_header(wire, *frame_len, &frame->header);
+    (void)memcpy(frame->payload, &wire[TLM_HEADER_LEN], payload_len);
+    frame->crc32 = crc;
 
     return SMART_QSO_OK;
 }
 
-SmartQsoResult_t tlm_generate_beacon(TlmFrame_t *frame, size_t *frame_len)
+/*******************************************************************************
+ * Public Functions
+ ******************************************************************************/
+
+SmartQsoResult_t tlm_init(void)
 {
-    if ((frame == NULL) || (frame_len == NULL)) {
-        return SMART_QSO_ERROR_NULL_PTR;
+    (void)safe_memset(&s_stats, sizeof(s_stats), 0, sizeof(s_stats));
+    s_rate_ms = TLM_DEFAULT_RATE_MS;
+    s_last_tlm_time_ms = 0;
+    s_initialized = true;
+
+    return SMART_QSO_OK;
+}
+
+SmartQsoResult_t tlm_set_rate(uint32_t rate_ms)
+{
+    if (rate_ms < TLM_MIN_RATE_MS) {
+        rate_ms = TLM_MIN_RATE_MS;
+    } else if (rate_ms > TLM_MAX_RATE_MS) {
+        rate_ms = TLM_MAX_RATE_MS;
     }
 
-    /* Beacon is a condensed housekeeping */
-    PowerState_t power;
-    (void)sys_get_power_state(&power);
+    s_rate_ms = rate_ms;
+    return SMART_QSO_OK;
+}
 
-    /* Minimal beacon payload */
-    uint8_t *beacon = frame->payload;
-    beacon[0] = (uint8_t)sys_get_operational_state();
-    beacon[1] = (uint8_t)(power.state_of_charge * 100.0);
-    beacon[2] = (uint8_t)power.power_mode;
-    beacon[3] = sys_has_thermal_fault() ? 0x01U : 0x00U;
+uint32_t tlm_get_rate(void)
+{
+    return s_rate_ms;
+}
 
-    fill_header(&frame->header, TLM_TYPE_BEACON, 4);
-    frame->crc32 = calculate_frame_crc(frame, 4);
+SmartQsoResult_t tlm_generate_housekeeping(TlmFrame_t *frame, size_t *frame_len)
+{
+    return generate_frame(frame, frame_len, TLM_TYPE_HOUSEKEEPING,
+                          TLM_HK_PAYLOAD_LEN, encode_housekeeping);
+}
 
-    *frame_len = sizeof(TlmHeader_t) + 4 + sizeof(uint32_t);
-    s_stats.frames_generated++;
+SmartQsoResult_t tlm_generate_eps(TlmFrame_t *frame, size_t *frame_len)
+{
+    return generate_frame(frame, frame_len, TLM_TYPE_EPS,
+                          TLM_EPS_PAYLOAD_LEN, encode_eps);
+}
 
-    (void)sys_increment_beacon_count();
+SmartQsoResult_t tlm_generate_adcs(TlmFrame_t *frame, size_t *frame_len)
+{
+    return generate_frame(frame, frame_len, TLM_TYPE_ADCS,
+                          TLM_ADCS_PAYLOAD_LEN, encode_adcs);
+}
 
-    return SMART_QSO_OK;
+SmartQsoResult_t tlm_generate_beacon(TlmFrame_t *frame, size_t *frame_len)
+{
+    SmartQsoResult_t result = generate_frame(frame, frame_len, TLM_TYPE_BEACON,
+                                             TLM_BEACON_PAYLOAD_LEN, encode_beacon);
+    if (result == SMART_QSO_OK) {
+        (void)sys_increment_beacon_count();
+    }
+
+    return result;
 }
 
 bool tlm_is_due(void)
@@ -286,26 +338,279 @@ SmartQsoResult_t tlm_serialize(const TlmFrame_t *frame,
         return SMART_QSO_ERROR_NULL_PTR;
     }
 
-    size_t total_len = sizeof(TlmHeader_t) + payload_len + sizeof(uint32_t);
+    if (payload_len > TLM_MAX_PAYLOAD_LEN) {
+        return SMART_QSO_ERROR_INVALID;
+    }
+
+    size_t total_len = TLM_HEADER_LEN + payload_len + TLM_CRC_LEN;
     if (buffer_size < total_len) {
         return SMART_QSO_ERROR_NO_MEM;
     }
 
-    /* Copy header */
-    (void)safe_memcpy(buffer, buffer_size, &frame->header, sizeof(TlmHeader_t));
+    /* Header */
+    encode_header(buffer, &frame->header);
 
-    /* Copy payload */
-    (void)safe_memcpy(&buffer[sizeof(TlmHeader_t)],
-                      buffer_size - sizeof(TlmHeader_t),
+    /* Payload (already encoded) */
+    (void)safe_memcpy(&buffer[TLM_HEADER_LEN],
+                      buffer_size - TLM_HEADER_LEN,
                       frame->payload, payload_len);
 
-    /* Copy CRC at end */
-    size_t crc_offset = sizeof(TlmHeader_t) + payload_len;
-    buffer[crc_offset] = (uint8_t)(frame->crc32 >> 24);
-    buffer[crc_offset + 1] = (uint8_t)(frame->crc32 >> 16);
-    buffer[crc_offset + 2] = (uint8_t)(frame->crc32 >> 8);
-    buffer[crc_offset + 3] = (uint8_t)(frame->crc32);
+    /* CRC at end */
+    wire_put_be32(&buffer[TLM_HEADER_LEN + payload_len], frame->crc32);
 
     *bytes_written = total_len;
     return SMART_QSO_OK;
 }
+
+SmartQsoResult_t tlm_serialize_fec(const TlmFrame_t *frame,
+                                    size_t payload_len,
+                                    uint8_t *buffer,
+                                    size_t buffer_size,
+                                    size_t *bytes_written)
+{
+    if (bytes_written == NULL) {
+        return SMART_QSO_ERROR_NULL_PTR;
+    }
+
+    uint8_t plain[TLM_MAX_FRAME_SIZE];
+    size_t plain_len = 0;
+    SmartQsoResult_t result = tlm_serialize(frame, payload_len, plain,
+                                            sizeof(plain), &plain_len);
+    if (result != SMART_QSO_OK) {
+        return result;
+    }
+
+    return fec_tlm_encode(plain, plain_len, buffer, buffer_size, bytes_written);
+}
+
+SmartQsoResult_t tlm_decode_header(const uint8_t *buffer,
+                                    size_t buffer_len,
+                                    TlmHeader_t *header)
+{
+    if ((buffer == NULL) || (header == NULL)) {
+        return SMART_QSO_ERROR_NULL_PTR;
+    }
+
+    if (buffer_len < TLM_HEADER_LEN) {
+        return SMART_QSO_ERROR_INVALID;
+    }
+
+    uint32_t sync = wire_get_be32(&buffer[0]);
+    if (sync != TLM_SYNC_WORD) {
+        return SMART_QSO_ERROR_INVALID;
+    }
+
+    header->sync_word = sync;
+    header->version = buffer[4];
+    header->type = buffer[5];
+    header->sequence = wire_get_be16(&buffer[6]);
+    header->timestamp_s = wire_get_be32(&buffer[8]);
+    header->data_len = wire_get_be16(&buffer[12]);
+
+    return SMART_QSO_OK;
+}
+
+/*******************************************************************************
+ * Zero-Copy Frame Builder
+ ******************************************************************************/
+
+SmartQsoResult_t tlm_builder_begin(TlmBuilder_t *builder,
+                                    uint8_t *buffer,
+                                    size_t buffer_size,
+                                    TlmType_t type,
+                                    uint16_t payload_len)
+{
+    if ((builder == NULL) || (buffer == NULL)) {
+        return SMART_QSO_ERROR_NULL_PTR;
+    }
+
+    size_t total_len = TLM_HEADER_LEN + (size_t)payload_len + TLM_CRC_LEN;
+    if (buffer_size < total_len) {
+        return SMART_QSO_ERROR_NO_MEM;
+    }
+
+    TlmHeader_t header;
+    fill_header(&header, type, payload_len);
+    encode_header(buffer, &header);
+
+    builder->buffer = buffer;
+    builder->capacity = buffer_size;
+    builder->pos = TLM_HEADER_LEN;
+    builder->payload_end = TLM_HEADER_LEN + (size_t)payload_len;
+    builder->crc = smart_qso_crc32_update(SMART_QSO_CRC32_INIT, buffer, TLM_HEADER_LEN);
+    builder->overflow = false;
+
+    return SMART_QSO_OK;
+}
+
+/**
+ * @brief Reserve payload space in the builder
+ *
+ * @return Pointer to the reserved bytes, or NULL on overflow
+ */
+static uint8_t *builder_reserve(TlmBuilder_t *builder, size_t len)
+{
+    if ((builder->overflow) || (len > (builder->payload_end - builder->pos))) {
+        builder->overflow = true;
+        return NULL;
+    }
+
+    return &builder->buffer[builder->pos];
+}
+
+/**
+ * @brief Fold freshly written bytes into the CRC and advance
+ */
+static void builder_commit(TlmBuilder_t *builder, const uint8_t *dst, size_t len)
+{
+    builder->crc = smart_qso_crc32_update(builder->crc, dst, len);
+    builder->pos += len;
+}
+
+void tlm_builder_put_bytes(TlmBuilder_t *builder, const void *data, size_t len)
+{
+    if ((builder == NULL) || (data == NULL)) {
+        return;
+    }
+
+    uint8_t *dst = builder_reserve(builder, len);
+    if (dst != NULL) {
+        (void)memcpy(dst, data, len);
+        builder_commit(builder, dst, len);
+    }
+}
+
+void tlm_builder_put_u8(TlmBuilder_t *builder, uint8_t value)
+{
+    if (builder == NULL) {
+        return;
+    }
+
+    uint8_t *dst = builder_reserve(builder, 1U);
+    if (dst != NULL) {
+        dst[0] = value;
+        builder_commit(builder, dst, 1U);
+    }
+}
+
+void tlm_builder_put_u16(TlmBuilder_t *builder, uint16_t value)
+{
+    if (builder == NULL) {
+        return;
+    }
+
+    uint8_t *dst = builder_reserve(builder, 2U);
+    if (dst != NULL) {
+        wire_put_be16(dst, value);
+        builder_commit(builder, dst, 2U);
+    }
+}
+
+void tlm_builder_put_u32(TlmBuilder_t *builder, uint32_t value)
+{
+    if (builder == NULL) {
+        return;
+    }
+
+    uint8_t *dst = builder_reserve(builder, 4U);
+    if (dst != NULL) {
+        wire_put_be32(dst, value);
+        builder_commit(builder, dst, 4U);
+    }
+}
+
+void tlm_builder_put_u16_array(TlmBuilder_t *builder, const uint16_t *values, size_t count)
+{
+    if ((builder == NULL) || (values == NULL)) {
+        return;
+    }
+
+    if (count > (TLM_MAX_PAYLOAD_LEN / 2U)) {
+        builder->overflow = true;
+        return;
+    }
+
+    uint8_t *dst = builder_reserve(builder, count * 2U);
+    if (dst != NULL) {
+        wire_put_be16_array(dst, values, count);
+        builder_commit(builder, dst, count * 2U);
+    }
+}
+
+SmartQsoResult_t tlm_builder_finish(TlmBuilder_t *builder, size_t *bytes_written)
+{
+    if ((builder == NULL) || (bytes_written == NULL)) {
+        return SMART_QSO_ERROR_NULL_PTR;
+    }
+
+    if ((builder->overflow) || (builder->pos != builder->payload_end)) {
+        return SMART_QSO_ERROR_INVALID;
+    }
+
+    uint32_t crc = builder->crc ^ 0xFFFFFFFFU;
+    wire_put_be32(&builder->buffer[builder->pos], crc);
+
+    builder->crc = crc;
+    builder->pos += TLM_CRC_LEN;
+    *bytes_written = builder->pos;
+    s_stats.frames_generated++;
+
+    return SMART_QSO_OK;
+}
+
+SmartQsoResult_t tlm_build_housekeeping(uint8_t *buffer,
+                                         size_t buffer_size,
+                                         size_t *bytes_written)
+{
+    if (bytes_written == NULL) {
+        return SMART_QSO_ERROR_NULL_PTR;
+    }
+
+    return build_frame(buffer, buffer_size, TLM_TYPE_HOUSEKEEPING,
+                       TLM_HK_PAYLOAD_LEN, encode_housekeeping,
+                       bytes_written, NULL);
+}
+
+SmartQsoResult_t tlm_build_eps(uint8_t *buffer,
+                                size_t buffer_size,
+                                size_t *bytes_written)
+{
+    if (bytes_written == NULL) {
+        return SMART_QSO_ERROR_NULL_PTR;
+    }
+
+    return build_frame(buffer, buffer_size, TLM_TYPE_EPS,
+                       TLM_EPS_PAYLOAD_LEN, encode_eps,
+                       bytes_written, NULL);
+}
+
+SmartQsoResult_t tlm_build_adcs(uint8_t *buffer,
+                                 size_t buffer_size,
+                                 size_t *bytes_written)
+{
+    if (bytes_written == NULL) {
+        return SMART_QSO_ERROR_NULL_PTR;
+    }
+
+    return build_frame(buffer, buffer_size, TLM_TYPE_ADCS,
+                       TLM_ADCS_PAYLOAD_LEN, encode_adcs,
+                       bytes_written, NULL);
+}
+
+SmartQsoResult_t tlm_build_beacon(uint8_t *buffer,
+                                   size_t buffer_size,
+                                   size_t *bytes_written)
+{
+    if (bytes_written == NULL) {
+        return SMART_QSO_ERROR_NULL_PTR;
+    }
+
+    SmartQsoResult_t result = build_frame(buffer, buffer_size, TLM_TYPE_BEACON,
+                                          TLM_BEACON_PAYLOAD_LEN, encode_beacon,
+                                          bytes_written, NULL);
+    if (result == SMART_QSO_OK) {
+        (void)sys_increment_beacon_count();
+    }
+
+    return result;
+}
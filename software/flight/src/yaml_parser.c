@@ -14,60 +14,34 @@
  */
 
 #include "yaml_parser.h"
-#include "safe_string.h"
-#include "crc32.h"
+#include <stdio.h>
 #include <string.h>
-#include <stdlib.h>
-#include <ctype.h>
 
 /*******************************************************************************
  * Private Definitions
  ******************************************************************************/
 
-/** Maximum line length in YAML file */
-#define YAML_MAX_LINE_LENGTH    256U
-
-/** Maximum key length */
-#define YAML_MAX_KEY_LENGTH     64U
-
-/** Maximum value length */
-#define YAML_MAX_VALUE_LENGTH   128U
-
-/** Maximum nesting depth */
-#define YAML_MAX_DEPTH          8U
-
 /** Comment character */
 #define YAML_COMMENT_CHAR       '#'
 
 /** Key-value separator */
 #define YAML_SEPARATOR          ':'
 
+/** List item marker */
+#define YAML_ITEM_CHAR          '-'
+
+/** Path separator for the callback interface */
+#define YAML_PATH_SEPARATOR     '.'
+
 /*******************************************************************************
  * Private Types
  ******************************************************************************/
 
 /**
- * @brief Parser state machine states
- */
-typedef enum {
-    YAML_STATE_IDLE,
-    YAML_STATE_KEY,
-    YAML_STATE_VALUE,
-    YAML_STATE_COMMENT,
-    YAML_STATE_ERROR
-} yaml_state_t;
-
-/**
- * @brief Parser context
+ * @brief Parser context for the callback interface
  */
 typedef struct {
-    yaml_state_t state;
-    uint8_t indent_level;
-    uint8_t indent_stack[YAML_MAX_DEPTH];
-    char current_key[YAML_MAX_KEY_LENGTH];
-    char current_value[YAML_MAX_VALUE_LENGTH];
-    char path[YAML_MAX_KEY_LENGTH * YAML_MAX_DEPTH];
-    uint32_t line_number;
+    yaml_tokenizer_t tokenizer;
     yaml_error_t last_error;
 } yaml_context_t;
 
@@ -88,12 +62,13 @@ static void *g_yaml_user_data = NULL;
  * Private Function Prototypes
  ******************************************************************************/
 
-static yaml_error_t yaml_parse_line(const char *line);
-static uint8_t yaml_count_indent(const char *line);
-static yaml_error_t yaml_extract_key_value(const char *line, char *key, char *value);
-static void yaml_trim_whitespace(char *str);
-static bool yaml_is_comment_or_empty(const char *line);
-static void yaml_update_path(uint8_t new_indent);
+static yaml_error_t yaml_next_line(yaml_tokenizer_t *tok, const char **line, size_t *length);
+static yaml_error_t yaml_tokenize_line(yaml_tokenizer_t *tok, const char *line, size_t length,
+                                       yaml_token_t *token, bool *produced);
+static bool yaml_is_blank(char c);
+static yaml_span_t yaml_trim_span(const char *start, size_t length);
+static yaml_span_t yaml_unquote(yaml_span_t span);
+static void yaml_emit(const yaml_token_t *token);
 
 /*******************************************************************************
  * Public Functions
@@ -107,7 +82,6 @@ static void yaml_update_path(uint8_t new_indent);
 yaml_error_t yaml_parser_init(void)
 {
     memset(&g_yaml_ctx, 0, sizeof(g_yaml_ctx));
-    g_yaml_ctx.state = YAML_STATE_IDLE;
     g_yaml_callback = NULL;
     g_yaml_user_data = NULL;
 
@@ -150,49 +124,24 @@ yaml_error_t yaml_parse_string(const char *yaml_string, size_t length)
         return YAML_ERROR_INVALID_PARAM;
     }
 
-    /* Reset parser state */
-    g_yaml_ctx.state = YAML_STATE_IDLE;
-    g_yaml_ctx.indent_level = 0U;
-    g_yaml_ctx.line_number = 0U;
-    g_yaml_ctx.path[0] = '\0';
-    memset(g_yaml_ctx.indent_stack, 0, sizeof(g_yaml_ctx.indent_stack));
-
-    char line_buffer[YAML_MAX_LINE_LENGTH];
-    size_t line_start = 0U;
-    size_t i;
-
-    for (i = 0U; i <= length; i++) {
-        /* Check for end of line or end of string */
-        if ((i == length) || (yaml_string[i] == '\n') || (yaml_string[i] == '\r')) {
-            size_t line_len = i - line_start;
-
-            if (line_len > 0U) {
-                /* Copy line to buffer */
-                if (line_len >= YAML_MAX_LINE_LENGTH) {
-                    line_len = YAML_MAX_LINE_LENGTH - 1U;
-                }
-                memcpy(line_buffer, &yaml_string[line_start], line_len);
-                line_buffer[line_len] = '\0';
-
-                /* Parse the line */
-                g_yaml_ctx.line_number++;
-                yaml_error_t err = yaml_parse_line(line_buffer);
-                if (err != YAML_OK) {
-                    g_yaml_ctx.last_error = err;
-                    return err;
-                }
-            }
-
-            /* Skip carriage return if followed by newline */
-            if ((i < length) && (yaml_string[i] == '\r') &&
-                ((i + 1U) < length) && (yaml_string[i + 1U] == '\n')) {
-                i++;
-            }
-
-            line_start = i + 1U;
+    yaml_tokenizer_t *tok = &g_yaml_ctx.tokenizer;
+    yaml_token_t token;
+    yaml_error_t err;
+
+    yaml_tokenizer_init(tok);
+    (void)yaml_tokenizer_feed(tok, yaml_string, length, true);
+
+    while ((err = yaml_tokenizer_next(tok, &token)) == YAML_OK) {
+        if ((token.kind == YAML_TOKEN_SCALAR) && (token.key.len > 0U)) {
+            yaml_emit(&token);
         }
     }
 
+    if (err != YAML_NEED_INPUT) {
+        g_yaml_ctx.last_error = err;
+        return err;
+    }
+
     return YAML_OK;
 }
 
@@ -229,7 +178,7 @@ yaml_error_t yaml_get_last_error(void)
  */
 uint32_t yaml_get_error_line(void)
 {
-    return g_yaml_ctx.line_number;
+    return g_yaml_ctx.tokenizer.line;
 }
 
 /**
@@ -253,197 +202,375 @@ const char *yaml_error_to_string(yaml_error_t error)
             return "Maximum nesting depth exceeded";
         case YAML_ERROR_SYNTAX:
             return "Syntax error";
+        case YAML_NEED_INPUT:
+            return "More input needed";
         default:
             return "Unknown error";
     }
 }
 
-/*******************************************************************************
- * Private Functions
- ******************************************************************************/
+/**
+ * @brief Initialize a streaming tokenizer
+ *
+ * @param tok Tokenizer
+ */
+void yaml_tokenizer_init(yaml_tokenizer_t *tok)
+{
+    if (tok != NULL) {
+        memset(tok, 0, sizeof(*tok));
+    }
+}
 
 /**
- * @brief Parse a single line of YAML
+ * @brief Feed the next chunk of the document
+ *
+ * @param tok Tokenizer
+ * @param data Chunk
+ * @param length Chunk length
+ * @param last true if this chunk ends the document
+ * @return YAML_OK on success
  */
-static yaml_error_t yaml_parse_line(const char *line)
+yaml_error_t yaml_tokenizer_feed(yaml_tokenizer_t *tok, const char *data, size_t length,
+                                 bool last)
 {
-    /* Check for comment or empty line */
-    if (yaml_is_comment_or_empty(line)) {
-        return YAML_OK;
+    if ((tok == NULL) || ((data == NULL) && (length > 0U))) {
+        return YAML_ERROR_INVALID_PARAM;
+    }
+    if (tok->error != YAML_OK) {
+        return tok->error;
+    }
+    if ((tok->pos < tok->chunk_len) || tok->last) {
+        return YAML_ERROR_INVALID_PARAM;
     }
 
-    /* Count indentation */
-    uint8_t indent = yaml_count_indent(line);
+    tok->chunk = data;
+    tok->chunk_len = length;
+    tok->pos = 0U;
+    tok->last = last;
 
-    /* Update path based on indentation */
-    yaml_update_path(indent);
+    return YAML_OK;
+}
 
-    /* Extract key and value */
-    char key[YAML_MAX_KEY_LENGTH];
-    char value[YAML_MAX_VALUE_LENGTH];
+/**
+ * @brief Get the next token
+ *
+ * @param tok Tokenizer
+ * @param token Token
+ * @return YAML_OK with a token, YAML_NEED_INPUT, or an error
+ */
+yaml_error_t yaml_tokenizer_next(yaml_tokenizer_t *tok, yaml_token_t *token)
+{
+    if ((tok == NULL) || (token == NULL)) {
+        return YAML_ERROR_INVALID_PARAM;
+    }
 
-    yaml_error_t err = yaml_extract_key_value(line, key, value);
-    if (err != YAML_OK) {
-        return err;
+    while (tok->error == YAML_OK) {
+        const char *line = NULL;
+        size_t length = 0U;
+        bool produced = false;
+
+        yaml_error_t err = yaml_next_line(tok, &line, &length);
+        if (err == YAML_OK) {
+            err = yaml_tokenize_line(tok, line, length, token, &produced);
+        }
+        if (err == YAML_NEED_INPUT) {
+            return err;
+        }
+        if (err != YAML_OK) {
+            tok->error = err;
+        } else if (produced) {
+            return YAML_OK;
+        } else {
+            /* Blank or comment line */
+        }
     }
 
-    /* Build full path */
-    char full_path[YAML_MAX_KEY_LENGTH * YAML_MAX_DEPTH];
-    if (g_yaml_ctx.path[0] != '\0') {
-        snprintf(full_path, sizeof(full_path), "%s.%s", g_yaml_ctx.path, key);
-    } else {
-        strncpy(full_path, key, sizeof(full_path) - 1U);
-        full_path[sizeof(full_path) - 1U] = '\0';
+    return tok->error;
+}
+
+/**
+ * @brief Compare a span with a string
+ *
+ * @param span Span
+ * @param text NUL-terminated string
+ * @return true if equal
+ */
+bool yaml_span_equals(yaml_span_t span, const char *text)
+{
+    if (text == NULL) {
+        return false;
+    }
+
+    size_t length = strlen(text);
+    return (span.len == length) &&
+           ((length == 0U) || (memcmp(span.ptr, text, length) == 0));
+}
+
+/**
+ * @brief Copy a span into a NUL-terminated buffer
+ *
+ * @param span Span
+ * @param dst Destination
+ * @param size Destination size
+ * @return Characters copied
+ */
+size_t yaml_span_copy(yaml_span_t span, char *dst, size_t size)
+{
+    if ((dst == NULL) || (size == 0U)) {
+        return 0U;
     }
 
-    /* If value is empty, this is a parent key - update path */
-    if (value[0] == '\0') {
-        strncpy(g_yaml_ctx.path, full_path, sizeof(g_yaml_ctx.path) - 1U);
-        g_yaml_ctx.path[sizeof(g_yaml_ctx.path) - 1U] = '\0';
-        g_yaml_ctx.indent_level = indent;
-        if (indent < YAML_MAX_DEPTH) {
-            g_yaml_ctx.indent_stack[indent] = 1U;
+    size_t length = (span.len < size) ? span.len : (size - 1U);
+    if (length > 0U) {
+        memcpy(dst, span.ptr, length);
+    }
+    dst[length] = '\0';
+
+    return length;
+}
+
+/**
+ * @brief Compare a token's full key path with a dotted path
+ *
+ * @param token Token
+ * @param path Dotted path
+ * @return true if the path and key match
+ */
+bool yaml_token_path_is(const yaml_token_t *token, const char *path)
+{
+    if ((token == NULL) || (path == NULL)) {
+        return false;
+    }
+
+    const char *segment = path;
+    for (uint8_t d = 0U; d <= token->depth; d++) {
+        const char *end = strchr(segment, YAML_PATH_SEPARATOR);
+        size_t length = (end != NULL) ? (size_t)(end - segment) : strlen(segment);
+        yaml_span_t key = (d < token->depth) ? token->path[d] : token->key;
+
+        if ((key.len != length) || ((length > 0U) && (memcmp(key.ptr, segment, length) != 0))) {
+            return false;
         }
-    } else {
-        /* Call callback with key-value pair */
-        if (g_yaml_callback != NULL) {
-            g_yaml_callback(full_path, value, g_yaml_user_data);
+        if (d == token->depth) {
+            return end == NULL;
         }
+        if (end == NULL) {
+            return false;
+        }
+        segment = end + 1;
     }
 
-    return YAML_OK;
+    return false;
 }
 
+/*******************************************************************************
+ * Private Functions
+ ******************************************************************************/
+
 /**
- * @brief Count leading spaces/tabs for indentation
+ * @brief Take the next complete line from the fed input
+ *
+ * Lines inside the chunk are returned in place. A line that runs off the
+ * end of a chunk that is not the last is held in the carry buffer and
+ * returned once its end arrives.
  */
-static uint8_t yaml_count_indent(const char *line)
+static yaml_error_t yaml_next_line(yaml_tokenizer_t *tok, const char **line, size_t *length)
 {
-    uint8_t indent = 0U;
+    size_t avail = tok->chunk_len - tok->pos;
+    const char *start = (avail > 0U) ? &tok->chunk[tok->pos] : NULL;
+    const char *nl = (avail > 0U) ? (const char *)memchr(start, '\n', avail) : NULL;
 
-    while ((*line == ' ') || (*line == '\t')) {
-        if (*line == '\t') {
-            indent += 2U;  /* Treat tab as 2 spaces */
-        } else {
-            indent++;
+    if ((tok->carry_len > 0U) || ((nl == NULL) && !tok->last)) {
+        size_t take = (nl != NULL) ? (size_t)(nl - start) : avail;
+
+        if ((tok->carry_len + take) >= YAML_MAX_LINE_LENGTH) {
+            tok->line++;
+            return YAML_ERROR_MEMORY;
+        }
+        if (take > 0U) {
+            memcpy(&tok->carry[tok->carry_len], start, take);
         }
-        line++;
+        tok->carry_len += take;
+        tok->pos += take + ((nl != NULL) ? 1U : 0U);
+
+        if ((nl == NULL) && (!tok->last || (tok->carry_len == 0U))) {
+            return YAML_NEED_INPUT;
+        }
+
+        *line = tok->carry;
+        *length = tok->carry_len;
+        tok->carry_len = 0U;
+    } else if (nl != NULL) {
+        *line = start;
+        *length = (size_t)(nl - start);
+        tok->pos += *length + 1U;
+    } else if (avail > 0U) {
+        /* Last line of the document without a newline */
+        *line = start;
+        *length = avail;
+        tok->pos = tok->chunk_len;
+    } else {
+        return YAML_NEED_INPUT;
+    }
+
+    tok->line++;
+    if (*length >= YAML_MAX_LINE_LENGTH) {
+        return YAML_ERROR_MEMORY;
+    }
+    if ((*length > 0U) && ((*line)[*length - 1U] == '\r')) {
+        (*length)--;
     }
 
-    /* Normalize to indent levels (2 spaces = 1 level) */
-    return indent / 2U;
+    return YAML_OK;
 }
 
 /**
- * @brief Extract key and value from a line
+ * @brief Tokenize one line
+ *
+ * Indentation is measured in columns (a tab counts as two). A line closes
+ * every open mapping whose key column is not left of its own key column.
  */
-static yaml_error_t yaml_extract_key_value(const char *line, char *key, char *value)
+static yaml_error_t yaml_tokenize_line(yaml_tokenizer_t *tok, const char *line, size_t length,
+                                       yaml_token_t *token, bool *produced)
 {
-    /* Skip leading whitespace */
-    while ((*line == ' ') || (*line == '\t')) {
-        line++;
+    size_t i = 0U;
+    size_t column = 0U;
+    bool item = false;
+
+    while ((i < length) && yaml_is_blank(line[i])) {
+        column += (line[i] == '\t') ? 2U : 1U;
+        i++;
+    }
+    if ((i == length) || (line[i] == YAML_COMMENT_CHAR)) {
+        return YAML_OK;
     }
 
-    /* Find separator */
-    const char *sep = strchr(line, YAML_SEPARATOR);
-    if (sep == NULL) {
-        return YAML_ERROR_SYNTAX;
+    if ((line[i] == YAML_ITEM_CHAR) && (((i + 1U) == length) || yaml_is_blank(line[i + 1U]))) {
+        item = true;
+        i++;
+        column++;
+        while ((i < length) && yaml_is_blank(line[i])) {
+            column += (line[i] == '\t') ? 2U : 1U;
+            i++;
+        }
     }
 
-    /* Extract key */
-    size_t key_len = (size_t)(sep - line);
-    if (key_len >= YAML_MAX_KEY_LENGTH) {
-        key_len = YAML_MAX_KEY_LENGTH - 1U;
+    while ((tok->depth > 0U) && (tok->indent[tok->depth - 1U] >= column)) {
+        tok->depth--;
     }
-    memcpy(key, line, key_len);
-    key[key_len] = '\0';
-    yaml_trim_whitespace(key);
 
-    /* Extract value */
-    const char *val_start = sep + 1;
-    while (*val_start == ' ') {
-        val_start++;
+    yaml_span_t text = yaml_trim_span(&line[i], length - i);
+    const char *sep = (text.len > 0U) ? (const char *)memchr(text.ptr, YAML_SEPARATOR, text.len)
+                                      : NULL;
+
+    token->path = tok->path;
+    token->depth = tok->depth;
+    token->item = item;
+    token->line = tok->line;
+    token->kind = YAML_TOKEN_SCALAR;
+
+    if (sep == NULL) {
+        /* "- value" or a bare "-" */
+        if (!item) {
+            return YAML_ERROR_SYNTAX;
+        }
+        token->key.ptr = text.ptr;
+        token->key.len = 0U;
+        token->value = yaml_unquote(text);
+        *produced = true;
+        return YAML_OK;
     }
 
-    strncpy(value, val_start, YAML_MAX_VALUE_LENGTH - 1U);
-    value[YAML_MAX_VALUE_LENGTH - 1U] = '\0';
-    yaml_trim_whitespace(value);
+    token->key = yaml_trim_span(text.ptr, (size_t)(sep - text.ptr));
+    yaml_span_t raw = yaml_trim_span(sep + 1, text.len - (size_t)(sep - text.ptr) - 1U);
+    token->value = yaml_unquote(raw);
+    if (token->key.len == 0U) {
+        return YAML_ERROR_SYNTAX;
+    }
 
-    /* Remove quotes if present */
-    size_t val_len = strlen(value);
-    if (val_len >= 2U) {
-        if ((value[0] == '"' && value[val_len - 1U] == '"') ||
-            (value[0] == '\'' && value[val_len - 1U] == '\'')) {
-            memmove(value, value + 1, val_len - 2U);
-            value[val_len - 2U] = '\0';
+    if (raw.len == 0U) {
+        /* Parent key: its children are indented past its column */
+        if (tok->depth >= YAML_MAX_DEPTH) {
+            return YAML_ERROR_DEPTH;
         }
+        if (token->key.len >= YAML_MAX_KEY_LENGTH) {
+            return YAML_ERROR_MEMORY;
+        }
+        memcpy(tok->keys[tok->depth], token->key.ptr, token->key.len);
+        tok->path[tok->depth].ptr = tok->keys[tok->depth];
+        tok->path[tok->depth].len = token->key.len;
+        tok->indent[tok->depth] = column;
+        tok->depth++;
+        token->kind = YAML_TOKEN_MAPPING;
     }
 
+    *produced = true;
     return YAML_OK;
 }
 
 /**
- * @brief Trim leading and trailing whitespace
+ * @brief Check for a space or tab
  */
-static void yaml_trim_whitespace(char *str)
+static bool yaml_is_blank(char c)
 {
-    if (str == NULL || str[0] == '\0') {
-        return;
-    }
+    return (c == ' ') || (c == '\t');
+}
 
-    /* Trim trailing */
-    size_t len = strlen(str);
-    while (len > 0U && (str[len - 1U] == ' ' || str[len - 1U] == '\t' ||
-                        str[len - 1U] == '\r' || str[len - 1U] == '\n')) {
-        str[--len] = '\0';
-    }
+/**
+ * @brief Span with leading and trailing whitespace removed
+ */
+static yaml_span_t yaml_trim_span(const char *start, size_t length)
+{
+    yaml_span_t span = { start, length };
 
-    /* Trim leading */
-    char *start = str;
-    while (*start == ' ' || *start == '\t') {
-        start++;
+    while ((span.len > 0U) && yaml_is_blank(span.ptr[0])) {
+        span.ptr++;
+        span.len--;
     }
-
-    if (start != str) {
-        memmove(str, start, strlen(start) + 1U);
+    while ((span.len > 0U) && yaml_is_blank(span.ptr[span.len - 1U])) {
+        span.len--;
     }
+
+    return span;
 }
 
 /**
- * @brief Check if line is a comment or empty
+ * @brief Span without matching surrounding quotes
  */
-static bool yaml_is_comment_or_empty(const char *line)
+static yaml_span_t yaml_unquote(yaml_span_t span)
 {
-    /* Skip whitespace */
-    while (*line == ' ' || *line == '\t') {
-        line++;
+    if ((span.len >= 2U) &&
+        (((span.ptr[0] == '"') && (span.ptr[span.len - 1U] == '"')) ||
+         ((span.ptr[0] == '\'') && (span.ptr[span.len - 1U] == '\'')))) {
+        span.ptr++;
+        span.len -= 2U;
     }
 
-    /* Check for empty or comment */
-    return (*line == '\0' || *line == '\n' || *line == '\r' ||
-            *line == YAML_COMMENT_CHAR);
+    return span;
 }
 
 /**
- * @brief Update the current path based on new indentation level
+ * @brief Invoke the registered callback with a dotted path and a value
  */
-static void yaml_update_path(uint8_t new_indent)
+static void yaml_emit(const yaml_token_t *token)
 {
-    if (new_indent < g_yaml_ctx.indent_level) {
-        /* Going back up - truncate path */
-        char *last_dot = NULL;
-        uint8_t levels_to_remove = g_yaml_ctx.indent_level - new_indent;
-
-        char *p = g_yaml_ctx.path;
-        while (levels_to_remove > 0U && (last_dot = strrchr(p, '.')) != NULL) {
-            *last_dot = '\0';
-            levels_to_remove--;
-        }
+    char path[YAML_MAX_PATH_LENGTH];
+    char value[YAML_MAX_VALUE_LEN];
+    size_t n = 0U;
+
+    if (g_yaml_callback == NULL) {
+        return;
+    }
 
-        if (levels_to_remove > 0U) {
-            g_yaml_ctx.path[0] = '\0';
+    for (uint8_t d = 0U; d < token->depth; d++) {
+        n += yaml_span_copy(token->path[d], &path[n], sizeof(path) - n);
+        if ((n + 1U) < sizeof(path)) {
+            path[n] = YAML_PATH_SEPARATOR;
+            n++;
         }
     }
+    (void)yaml_span_copy(token->key, &path[n], sizeof(path) - n);
+    (void)yaml_span_copy(token->value, value, sizeof(value));
 
-    g_yaml_ctx.indent_level = new_indent;
+    g_yaml_callback(path, value, g_yaml_user_data);
 }
@@ -0,0 +1,112 @@
+/**
+ * @file bench_beacon.c
+ * @brief Beacon payload rendering benchmark
+ *
+ * Compares the original snprintf() payload format (with its double
+ * precision %.1f conversion) against beacon_format_payload(), which keeps
+ * the rendered payload cached and patches only changed numeric fields.
+ * The telemetry changes every iteration the way it does in flight: the
+ * timestamp always, battery voltage and SOC occasionally.
+ *
+ * Usage: bench_beacon [iterations]
+ */
+
+/* Required for clock_gettime on POSIX-compliant systems */
+#define _XOPEN_SOURCE 600
+
+#include "bench_common.h"
+#include "beacon.h"
+
+#include <string.h>
+
+/** Default iteration count */
+#define BENCH_BEACON_ITERATIONS 500000U
+
+/**
+ * @brief Original snprintf-based payload format
+ */
+static size_t reference_format(const BeaconContent_t *content,
+                               char *buffer, size_t buffer_len)
+{
+    int written = snprintf(buffer, buffer_len,
+        "de %s: %s | T=%u M=%s SOC=%u BV=%.1f SUN=%u RF=%u QSO=%u",
+        BEACON_CALLSIGN,
+        content->text,
+        content->telemetry.timestamp,
+        content->telemetry.power_mode == 0 ? "SAFE" :
+            (content->telemetry.power_mode == 1 ? "IDLE" : "ACTIVE"),
+        content->telemetry.soc,
+        content->telemetry.battery_mv / 1000.0,
+        content->telemetry.sunlit,
+        content->telemetry.rf_power,
+        content->telemetry.qso_count);
+
+    if (written < 0 || (size_t)written >= buffer_len) {
+        return 0;
+    }
+    return (size_t)written;
+}
+
+/**
+ * @brief Advance telemetry the way consecutive beacons see it
+ */
+static void step_telemetry(BeaconContent_t *content, uint32_t i)
+{
+    content->telemetry.timestamp = 1700000000U + i * 30U;
+    content->telemetry.soc = (uint8_t)(60U + ((i / 64U) % 40U));
+    content->telemetry.battery_mv = (uint16_t)(7000U + ((i / 16U) % 1200U));
+    content->telemetry.qso_count = (uint16_t)(i / 256U);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t iterations = bench_iterations(argc, argv, BENCH_BEACON_ITERATIONS);
+    char expected[BEACON_MAX_PAYLOAD_LEN];
+    char actual[BEACON_MAX_PAYLOAD_LEN];
+    uint32_t sink = 0;
+    BeaconContent_t content;
+
+    (void)beacon_init();
+    memset(&content, 0, sizeof(content));
+    content.text_len = strlen(beacon_templates[0]);
+    memcpy(content.text, beacon_templates[0], content.text_len + 1U);
+    content.telemetry.power_mode = 2;
+    content.telemetry.sunlit = 1;
+    content.telemetry.rf_power = 1;
+
+    /* Conformance over the same sequence (voltage ties excluded by step) */
+    for (uint32_t i = 0; i < 20000U; i++) {
+        step_telemetry(&content, i);
+        if ((content.telemetry.battery_mv % 100U) == 50U) {
+            continue;
+        }
+        size_t expected_len = reference_format(&content, expected, sizeof(expected));
+        size_t actual_len = beacon_format_payload(&content, actual, sizeof(actual));
+        if (expected_len != actual_len || strcmp(expected, actual) != 0) {
+            printf("  mismatch at step %u:\n    %s\n    %s\n", i, expected, actual);
+            return BENCH_FAIL;
+        }
+    }
+
+    printf("Beacon payload rendering (%u iterations)\n", iterations);
+
+    uint64_t start = bench_now_ns();
+    for (uint32_t i = 0; i < iterations; i++) {
+        step_telemetry(&content, i);
+        sink += (uint32_t)reference_format(&content, expected, sizeof(expected));
+    }
+    uint64_t snprintf_ns = bench_now_ns() - start;
+
+    start = bench_now_ns();
+    for (uint32_t i = 0; i < iterations; i++) {
+        step_telemetry(&content, i);
+        sink += (uint32_t)beacon_format_payload(&content, actual, sizeof(actual));
+    }
+    uint64_t cached_ns = bench_now_ns() - start;
+
+    bench_report_rate("snprintf %.1f", iterations, snprintf_ns, "beacons");
+    bench_report_rate("cached + digit patch", iterations, cached_ns, "beacons");
+
+    printf("  (checksum %u)\n", sink);
+    return 0;
+}
@@ -0,0 +1,79 @@
+/**
+ * @file bench_common.h
+ * @brief Shared helpers for SMART-QSO host performance benchmarks
+ *
+ * Benchmarks run on the simulation host only. Each benchmark verifies that
+ * the optimized path produces the same output as the reference path before
+ * reporting timings, so a benchmark run also serves as a conformance check.
+ */
+
+#ifndef SMART_QSO_BENCH_COMMON_H
+#define SMART_QSO_BENCH_COMMON_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/** Benchmark exit code on conformance failure */
+#define BENCH_FAIL  1
+
+/**
+ * @brief Monotonic time in nanoseconds
+ */
+static inline uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Parse iteration count from argv[1], falling back to a default
+ */
+static inline uint32_t bench_iterations(int argc, char **argv, uint32_t def)
+{
+    if (argc > 1) {
+        unsigned long n = strtoul(argv[1], NULL, 10);
+        if ((n > 0UL) && (n <= 0xFFFFFFFFUL)) {
+            return (uint32_t)n;
+        }
+    }
+    return def;
+}
+
+/**
+ * @brief Report an operation rate
+ *
+ * @param label Benchmark case name
+ * @param ops Operations performed
+ * @param elapsed_ns Elapsed time
+ * @param unit Operation unit (e.g. "frames")
+ */
+static inline void bench_report_rate(const char *label, uint64_t ops,
+                                     uint64_t elapsed_ns, const char *unit)
+{
+    double secs = (double)elapsed_ns / 1e9;
+    double rate = (secs > 0.0) ? ((double)ops / secs) : 0.0;
+    double ns_per_op = (ops > 0U) ? ((double)elapsed_ns / (double)ops) : 0.0;
+
+    printf("  %-32s %12.0f %s/s  %9.1f ns/op\n", label, rate, unit, ns_per_op);
+}
+
+/**
+ * @brief Report a data throughput
+ *
+ * @param label Benchmark case name
+ * @param bytes Bytes processed
+ * @param elapsed_ns Elapsed time
+ */
+static inline void bench_report_throughput(const char *label, uint64_t bytes,
+                                           uint64_t elapsed_ns)
+{
+    double secs = (double)elapsed_ns / 1e9;
+    double mbps = (secs > 0.0) ? ((double)bytes / secs / 1e6) : 0.0;
+
+    printf("  %-32s %10.1f MB/s\n", label, mbps);
+}
+
+#endif /* SMART_QSO_BENCH_COMMON_H */
@@ -0,0 +1,91 @@
+/**
+ * @file bench_crc16.c
+ * @brief CRC-16/X.25 (AX.25 FCS) throughput benchmark
+ *
+ * Compares the former 8-iteration bit loop against the table-driven
+ * crc16_x25() over AX.25 frame-sized buffers, after checking that both
+ * produce the same FCS.
+ *
+ * Usage: bench_crc16 [iterations]
+ */
+
+/* Required for clock_gettime on POSIX-compliant systems */
+#define _XOPEN_SOURCE 600
+
+#include "bench_common.h"
+#include "crc16.h"
+
+/** Default iteration count */
+#define BENCH_CRC16_ITERATIONS  200000U
+
+/** Buffer sizes: minimal UI frame, typical beacon, maximum AX.25 frame */
+static const size_t s_sizes[] = { 18U, 120U, 330U };
+
+static uint8_t s_data[330];
+
+/**
+ * @brief Bitwise reference (the former beacon_crc16 loop)
+ */
+static uint16_t crc16_bitwise(const uint8_t *data, size_t len)
+{
+    uint16_t crc = CRC16_X25_INIT;
+
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int j = 0; j < 8; j++) {
+            if (crc & 0x0001U) {
+                crc = (uint16_t)((crc >> 1) ^ 0x8408U);
+            } else {
+                crc >>= 1;
+            }
+        }
+    }
+
+    return (uint16_t)(crc ^ CRC16_X25_XOROUT);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t iterations = bench_iterations(argc, argv, BENCH_CRC16_ITERATIONS);
+    uint32_t sink = 0;
+
+    for (size_t i = 0; i < sizeof(s_data); i++) {
+        s_data[i] = (uint8_t)((i * 2654435761U) >> 24);
+    }
+
+    for (size_t len = 0; len <= sizeof(s_data); len++) {
+        if (crc16_bitwise(s_data, len) != crc16_x25(s_data, len)) {
+            printf("  mismatch at len %zu\n", len);
+            return BENCH_FAIL;
+        }
+    }
+
+    printf("CRC-16/X.25 throughput (%u iterations per size)\n", iterations);
+
+    for (size_t s = 0; s < sizeof(s_sizes) / sizeof(s_sizes[0]); s++) {
+        size_t len = s_sizes[s];
+        char label[48];
+
+        uint64_t start = bench_now_ns();
+        for (uint32_t i = 0; i < iterations; i++) {
+            s_data[0] = (uint8_t)i;
+            sink += crc16_bitwise(s_data, len);
+        }
+        uint64_t bitwise_ns = bench_now_ns() - start;
+
+        start = bench_now_ns();
+        for (uint32_t i = 0; i < iterations; i++) {
+            s_data[0] = (uint8_t)i;
+            sink += crc16_x25(s_data, len);
+        }
+        uint64_t table_ns = bench_now_ns() - start;
+
+        (void)snprintf(label, sizeof(label), "bitwise %zu B", len);
+        bench_report_throughput(label, (uint64_t)iterations * len, bitwise_ns);
+        (void)snprintf(label, sizeof(label), "table %zu B", len);
+        bench_report_throughput(label, (uint64_t)iterations * len, table_ns);
+    }
+
+    printf("  (checksum %u)\n", sink);
+    return 0;
+}
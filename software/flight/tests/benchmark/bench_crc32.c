@@ -0,0 +1,123 @@
+/**
+ * @file bench_crc32.c
+ * @brief CRC32 throughput benchmark per implementation
+ *
+ * Runs every CRC32 engine supported on this host over buffers from a
+ * telemetry-frame size up to a flash-sector size and reports MB/s. Before
+ * timing, each engine is checked against the bytewise reference over
+ * random lengths and misaligned starts.
+ *
+ * Usage: bench_crc32 [iterations]
+ *        (iterations = number of 4 KiB-equivalent passes per buffer size)
+ */
+
+/* Required for clock_gettime on POSIX-compliant systems */
+#define _XOPEN_SOURCE 600
+
+#include "bench_common.h"
+#include "crc32.h"
+
+#include <stdlib.h>
+
+/** Default iteration count */
+#define BENCH_CRC_ITERATIONS    20000U
+
+/** Bytes per iteration unit */
+#define BENCH_CRC_UNIT          4096U
+
+/** Largest buffer, plus slack for misaligned starts */
+#define BENCH_CRC_MAX_LEN       65536U
+#define BENCH_CRC_BUF_LEN       (BENCH_CRC_MAX_LEN + 16U)
+
+/** Random conformance cases per engine */
+#define BENCH_CRC_CHECKS        2000U
+
+static uint8_t s_data[BENCH_CRC_BUF_LEN];
+
+/** Buffer sizes: telemetry frame, beacon, config record, flash sector */
+static const size_t s_sizes[] = { 44U, 256U, 4096U, BENCH_CRC_MAX_LEN };
+
+/**
+ * @brief Verify an engine against the bytewise reference
+ */
+static int check_conformance(Crc32Impl_t impl)
+{
+    srand(0x5AFE);
+
+    for (uint32_t i = 0; i < BENCH_CRC_CHECKS; i++) {
+        size_t offset = (size_t)rand() % 16U;
+        size_t len = (size_t)rand() % (BENCH_CRC_MAX_LEN / 16U);
+        size_t split = (len > 0U) ? ((size_t)rand() % len) : 0U;
+
+        (void)crc32_select(CRC32_IMPL_BYTEWISE);
+        uint32_t expected = smart_qso_crc32_update(SMART_QSO_CRC32_INIT,
+                                                   s_data + offset, len);
+
+        (void)crc32_select(impl);
+        Crc32Ctx_t ctx;
+        crc32_ctx_init(&ctx);
+        crc32_update(&ctx, s_data + offset, split);
+        crc32_update(&ctx, s_data + offset + split, len - split);
+
+        if (crc32_final(&ctx) != (expected ^ 0xFFFFFFFFU)) {
+            printf("  %s: mismatch at offset %zu len %zu\n",
+                   crc32_impl_name(impl), offset, len);
+            return BENCH_FAIL;
+        }
+    }
+
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t iterations = bench_iterations(argc, argv, BENCH_CRC_ITERATIONS);
+    uint32_t sink = 0;
+    int status = 0;
+
+    for (size_t i = 0; i < sizeof(s_data); i++) {
+        s_data[i] = (uint8_t)((i * 2654435761U) >> 24);
+    }
+
+    printf("CRC32 throughput (%u x %u bytes per size, default engine %s)\n",
+           iterations, BENCH_CRC_UNIT, crc32_impl_name(crc32_init()));
+
+    for (int impl = 0; impl < (int)CRC32_IMPL_COUNT; impl++) {
+        if (!crc32_impl_supported((Crc32Impl_t)impl)) {
+            printf("  %-32s unsupported on this host\n",
+                   crc32_impl_name((Crc32Impl_t)impl));
+            continue;
+        }
+
+        if (check_conformance((Crc32Impl_t)impl) != 0) {
+            status = BENCH_FAIL;
+            continue;
+        }
+
+        (void)crc32_select((Crc32Impl_t)impl);
+
+        for (size_t s = 0; s < sizeof(s_sizes) / sizeof(s_sizes[0]); s++) {
+            size_t len = s_sizes[s];
+            uint64_t total = (uint64_t)iterations * BENCH_CRC_UNIT;
+            uint64_t passes = total / len;
+            char label[48];
+
+            if (passes == 0U) {
+                passes = 1U;
+            }
+
+            uint64_t start = bench_now_ns();
+            for (uint64_t p = 0; p < passes; p++) {
+                sink += smart_qso_crc32(s_data, len);
+            }
+            uint64_t elapsed = bench_now_ns() - start;
+
+            (void)snprintf(label, sizeof(label), "%s %zu B",
+                           crc32_impl_name((Crc32Impl_t)impl), len);
+            bench_report_throughput(label, passes * len, elapsed);
+        }
+    }
+
+    printf("  (checksum %08x)\n", sink);
+    return status;
+}
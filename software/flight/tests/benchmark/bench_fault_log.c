@@ -0,0 +1,240 @@
+/**
+ * @file bench_fault_log.c
+ * @brief Fault storm benchmark: circular journal vs shift-and-rewrite log
+ *
+ * Injects a burst of faults through fault_log_add() (ring buffer) and
+ * through a reference model of the previous log (memmove when full, whole
+ * log rewritten to a file on every fault), comparing time and bytes
+ * written. The ring is persisted two ways: flushed after every fault (one
+ * journal record per fault) and through the persistence service with a
+ * short coalescing window. The surviving entries must match the reference
+ * after a reload before timings are reported.
+ *
+ * Usage: bench_fault_log [faults]
+ */
+
+/* Required for clock_gettime, dup and dup2 on POSIX-compliant systems */
+#define _XOPEN_SOURCE 600
+
+#include "bench_common.h"
+#include "fault_mgmt.h"
+#include "kv_store.h"
+#include "hal/hal_flash.h"
+#include "persistence.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+/** Default number of injected faults */
+#define BENCH_FAULT_COUNT   10000U
+
+/** Coalescing window used for the fault storm (ms) */
+#define BENCH_WINDOW_MS     10U
+
+/** File the reference log is rewritten to */
+#define BENCH_LEGACY_FILE   "/tmp/smart_qso_bench_fault_log.dat"
+
+/** Reference log: entries shifted down when full */
+static FaultLogEntry_t s_legacy_log[SMART_QSO_MAX_FAULT_ENTRIES];
+static size_t s_legacy_count = 0;
+
+/** stdout while fault messages are discarded */
+static int s_saved_stdout = -1;
+
+/**
+ * @brief Discard fault_log_add() console output while timing
+ */
+static void quiet_begin(void)
+{
+    (void)fflush(stdout);
+    s_saved_stdout = dup(STDOUT_FILENO);
+    int null_fd = open("/dev/null", O_WRONLY);
+    if (null_fd >= 0) {
+        (void)dup2(null_fd, STDOUT_FILENO);
+        (void)close(null_fd);
+    }
+}
+
+static void quiet_end(void)
+{
+    (void)fflush(stdout);
+    if (s_saved_stdout >= 0) {
+        (void)dup2(s_saved_stdout, STDOUT_FILENO);
+        (void)close(s_saved_stdout);
+        s_saved_stdout = -1;
+    }
+}
+
+static void fault_description(uint32_t i, char *desc)
+{
+    (void)snprintf(desc, SMART_QSO_FAULT_DESC_LEN, "Storm fault %u", i);
+}
+
+static FaultType_t fault_type(uint32_t i)
+{
+    return (FaultType_t)(1U + (i % 10U));
+}
+
+/**
+ * @brief Previous fault_log_add(): shift when full, rewrite the whole file
+ *
+ * @return Bytes written
+ */
+static size_t legacy_add(uint32_t i)
+{
+    if (s_legacy_count >= SMART_QSO_MAX_FAULT_ENTRIES) {
+        memmove(&s_legacy_log[0], &s_legacy_log[1],
+                sizeof(FaultLogEntry_t) * (SMART_QSO_MAX_FAULT_ENTRIES - 1U));
+        s_legacy_count = SMART_QSO_MAX_FAULT_ENTRIES - 1U;
+    }
+
+    FaultLogEntry_t *entry = &s_legacy_log[s_legacy_count];
+    memset(entry, 0, sizeof(*entry));
+    entry->timestamp_ms = smart_qso_now_ms();
+    entry->fault_type = (uint8_t)fault_type(i);
+    entry->severity = (uint8_t)FAULT_SEVERITY_WARNING;
+    entry->soc_at_fault = 0.5;
+    fault_description(i, entry->description);
+    entry->crc32 = smart_qso_crc32(entry, offsetof(FaultLogEntry_t, crc32));
+    s_legacy_count++;
+
+    printf("[FAULT] Type=%d Severity=%d: %s\n", entry->fault_type, entry->severity,
+           entry->description);
+
+    size_t written = 0;
+    FILE *fp = fopen(BENCH_LEGACY_FILE, "wb");
+    if (fp != NULL) {
+        written = fwrite(s_legacy_log, sizeof(FaultLogEntry_t), s_legacy_count, fp);
+        (void)fclose(fp);
+    }
+    return written * sizeof(FaultLogEntry_t);
+}
+
+/**
+ * @brief Check the log matches the reference, then reload it and check again
+ */
+static int check_log(void)
+{
+    for (int pass = 0; pass < 2; pass++) {
+        if (fault_log_get_count() != s_legacy_count) {
+            printf("  entry count %zu, expected %zu\n", fault_log_get_count(), s_legacy_count);
+            return BENCH_FAIL;
+        }
+        for (size_t i = 0; i < s_legacy_count; i++) {
+            FaultLogEntry_t entry;
+            if ((fault_log_get_entry(i, &entry) != SMART_QSO_OK) ||
+                (entry.fault_type != s_legacy_log[i].fault_type) ||
+                (strcmp(entry.description, s_legacy_log[i].description) != 0)) {
+                printf("  entry %zu differs from reference\n", i);
+                return BENCH_FAIL;
+            }
+        }
+        quiet_begin();
+        (void)kv_store_mount();
+        (void)fault_mgmt_init();
+        quiet_end();
+    }
+    return 0;
+}
+
+/**
+ * @brief Run the storm through fault_log_add()
+ *
+ * @param coalesce Flush through the persistence service instead of per fault
+ * @param stats    Receives the store statistics delta
+ * @return Elapsed time (ns)
+ */
+static uint64_t ring_storm(uint32_t faults, bool coalesce, KvStats_t *stats)
+{
+    char desc[SMART_QSO_FAULT_DESC_LEN];
+    KvStats_t before;
+
+    quiet_begin();
+    (void)kv_store_format();
+    (void)persist_init();
+    (void)persist_register(PERSIST_MODULE_FAULT_LOG, fault_log_flush);
+    (void)persist_set_window_ms(BENCH_WINDOW_MS);
+    (void)fault_mgmt_init();
+    (void)kv_store_get_stats(&before);
+
+    uint64_t start = bench_now_ns();
+    for (uint32_t i = 0; i < faults; i++) {
+        fault_description(i, desc);
+        (void)fault_log_add(fault_type(i), FAULT_SEVERITY_WARNING, desc, 0.5);
+        if (coalesce) {
+            persist_task();
+        } else {
+            (void)fault_log_flush();
+        }
+    }
+    (void)persist_flush_all();
+    uint64_t elapsed = bench_now_ns() - start;
+    quiet_end();
+
+    (void)kv_store_get_stats(stats);
+    stats->bytes_written -= before.bytes_written;
+    stats->erase_count -= before.erase_count;
+    stats->puts -= before.puts;
+    return elapsed;
+}
+
+static void report_bytes(const char *label, uint64_t bytes, uint32_t faults, uint32_t erases)
+{
+    printf("  %-32s %12llu bytes (%.0f per fault, %u erases)\n", label,
+           (unsigned long long)bytes, (double)bytes / (double)faults, erases);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t faults = bench_iterations(argc, argv, BENCH_FAULT_COUNT);
+    KvStats_t journal;
+    KvStats_t coalesced;
+
+    printf("Fault storm (%u faults, log of %u entries, %u ms window)\n", faults,
+           SMART_QSO_MAX_FAULT_ENTRIES, BENCH_WINDOW_MS);
+    if (hal_flash_init() != SMART_QSO_OK) {
+        printf("  flash init failed\n");
+        return BENCH_FAIL;
+    }
+
+    /* Reference: shift and rewrite */
+    uint64_t legacy_bytes = 0;
+    quiet_begin();
+    uint64_t start = bench_now_ns();
+    for (uint32_t i = 0; i < faults; i++) {
+        legacy_bytes += legacy_add(i);
+    }
+    uint64_t legacy_ns = bench_now_ns() - start;
+    quiet_end();
+
+    uint64_t journal_ns = ring_storm(faults, false, &journal);
+    if (check_log() != 0) {
+        return BENCH_FAIL;
+    }
+    uint64_t coalesced_ns = ring_storm(faults, true, &coalesced);
+    if (check_log() != 0) {
+        return BENCH_FAIL;
+    }
+
+    bench_report_rate("shift + rewrite", faults, legacy_ns, "faults");
+    bench_report_rate("ring + journal per fault", faults, journal_ns, "faults");
+    bench_report_rate("ring + coalesced flush", faults, coalesced_ns, "faults");
+    report_bytes("shift + rewrite written", legacy_bytes, faults, 0U);
+    report_bytes("journal per fault written", journal.bytes_written, faults,
+                 journal.erase_count);
+    report_bytes("coalesced flush written", coalesced.bytes_written, faults,
+                 coalesced.erase_count);
+
+    (void)remove(BENCH_LEGACY_FILE);
+    (void)kv_store_format();
+
+    /* Once the log is full the journal must write far less than a rewrite */
+    if ((faults > SMART_QSO_MAX_FAULT_ENTRIES) &&
+        ((journal.bytes_written >= legacy_bytes) ||
+         (coalesced.bytes_written > journal.bytes_written))) {
+        printf("  persisted more than the path it replaces\n");
+        return BENCH_FAIL;
+    }
+    return 0;
+}
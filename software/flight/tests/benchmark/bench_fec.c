@@ -0,0 +1,185 @@
+/**
+ * @file bench_fec.c
+ * @brief Reed-Solomon FEC throughput and BER-vs-frame-loss benchmark
+ *
+ * Times RS(255,223) encode and decode (clean and with 16 byte errors),
+ * then sends a typical 120-byte beacon through a binary symmetric channel
+ * at several bit error rates, comparing frame loss and goodput of plain
+ * AX.25 (lost on any bit error) against FX.25.
+ *
+ * Usage: bench_fec [frames_per_ber]
+ */
+
+/* Required for clock_gettime on POSIX-compliant systems */
+#define _XOPEN_SOURCE 600
+
+#include "bench_common.h"
+#include "ax25.h"
+#include "fec.h"
+
+#include <string.h>
+
+/** Default frames simulated per bit error rate */
+#define BENCH_FEC_FRAMES    10000U
+
+/** Information field length of the simulated beacon */
+#define BENCH_FEC_INFO_LEN  120U
+
+/** Bit error rates swept, in errors per million bits */
+static const uint32_t s_ber_ppm[] = { 100U, 300U, 1000U, 2000U, 3000U, 5000U, 10000U };
+
+/** Channel noise generator state */
+static uint32_t s_rng = 1U;
+
+static uint32_t next_rand(void)
+{
+    s_rng = (s_rng * 1103515245U + 12345U) & 0x7FFFFFFFU;
+    return s_rng;
+}
+
+/**
+ * @brief Flip each bit with probability ppm / 1e6
+ *
+ * @return Number of bits flipped
+ */
+static size_t add_noise(uint8_t *data, size_t len, uint32_t ppm)
+{
+    uint32_t threshold = (uint32_t)(((uint64_t)ppm << 31) / 1000000U);
+    size_t flips = 0;
+
+    for (size_t i = 0; i < len * 8U; i++) {
+        if (next_rand() < threshold) {
+            data[i >> 3] ^= (uint8_t)(1U << (i & 7U));
+            flips++;
+        }
+    }
+    return flips;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t frames = bench_iterations(argc, argv, BENCH_FEC_FRAMES);
+    uint8_t info[BENCH_FEC_INFO_LEN];
+    uint8_t block[FEC_RS_N];
+    uint8_t work[FEC_RS_N];
+    uint32_t sink = 0;
+
+    for (size_t i = 0; i < sizeof(info); i++) {
+        info[i] = (uint8_t)(0x20U + ((i * 7U) % 95U));
+    }
+
+    /* Conformance: a full codeword with 16 byte errors decodes exactly */
+    for (size_t i = 0; i < FEC_RS_K; i++) {
+        block[i] = (uint8_t)((i * 2654435761U) >> 24);
+    }
+    (void)fec_rs_encode(block, FEC_RS_K, block + FEC_RS_K);
+    memcpy(work, block, sizeof(work));
+    for (size_t i = 0; i < FEC_RS_MAX_CORRECT; i++) {
+        work[i * 15U] ^= 0xA5U;
+    }
+    size_t corrected = 0;
+    if (fec_rs_decode(work, FEC_RS_N, &corrected) != SMART_QSO_OK ||
+        corrected != FEC_RS_MAX_CORRECT || memcmp(work, block, FEC_RS_N) != 0) {
+        printf("  RS(255,223) failed to correct %u errors\n", FEC_RS_MAX_CORRECT);
+        return BENCH_FAIL;
+    }
+
+    /* Codec throughput */
+    uint32_t iterations = frames;
+    printf("RS(255,223) codec (%u codewords)\n", iterations);
+
+    uint64_t start = bench_now_ns();
+    for (uint32_t i = 0; i < iterations; i++) {
+        block[0] = (uint8_t)i;
+        (void)fec_rs_encode(block, FEC_RS_K, block + FEC_RS_K);
+        sink += block[FEC_RS_K];
+    }
+    bench_report_throughput("encode", (uint64_t)iterations * FEC_RS_K, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (uint32_t i = 0; i < iterations; i++) {
+        memcpy(work, block, sizeof(work));
+        sink += (fec_rs_decode(work, FEC_RS_N, NULL) == SMART_QSO_OK) ? 1U : 0U;
+    }
+    bench_report_throughput("decode clean", (uint64_t)iterations * FEC_RS_K,
+                            bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (uint32_t i = 0; i < iterations; i++) {
+        memcpy(work, block, sizeof(work));
+        for (size_t e = 0; e < FEC_RS_MAX_CORRECT; e++) {
+            work[(e * 15U + i) % FEC_RS_N] ^= 0x5AU;
+        }
+        sink += (fec_rs_decode(work, FEC_RS_N, NULL) == SMART_QSO_OK) ? 1U : 0U;
+    }
+    bench_report_throughput("decode 16 errors", (uint64_t)iterations * FEC_RS_K,
+                            bench_now_ns() - start);
+
+    /* Build the beacon both ways */
+    uint8_t stream[AX25_BITSTREAM_MAX_LEN(AX25_MAX_FRAME_LEN)];
+    size_t stream_len = 0;
+    Ax25Encoder_t enc;
+    (void)ax25_encoder_begin(&enc, stream, sizeof(stream), AX25_OPT_BIT_STUFF);
+    ax25_encoder_put_address(&enc, "CQ", 0, false);
+    ax25_encoder_put_address(&enc, "SQSO", 1, true);
+    ax25_encoder_put_u8(&enc, AX25_CTRL_UI);
+    ax25_encoder_put_u8(&enc, AX25_PID_NO_L3);
+    ax25_encoder_put_bytes(&enc, info, sizeof(info));
+    if (ax25_encoder_finish(&enc, &stream_len) != SMART_QSO_OK) {
+        return BENCH_FAIL;
+    }
+    size_t plain_bits = enc.frame_bits;
+
+    uint8_t fx25[FX25_MAX_LEN];
+    size_t fx25_len = 0;
+    if (fx25_encode(stream, plain_bits, fx25, sizeof(fx25), &fx25_len) != SMART_QSO_OK) {
+        return BENCH_FAIL;
+    }
+
+    printf("Beacon loss vs BER (%zu-byte info; AX.25 %zu bits, FX.25 %zu bits; %u frames/point)\n",
+           sizeof(info), plain_bits, fx25_len * 8U, frames);
+    printf("  %8s %11s %11s %14s %14s\n", "BER", "AX.25 loss", "FX.25 loss",
+           "AX.25 goodput", "FX.25 goodput");
+
+    for (size_t b = 0; b < sizeof(s_ber_ppm) / sizeof(s_ber_ppm[0]); b++) {
+        uint32_t plain_lost = 0;
+        uint32_t fec_lost = 0;
+
+        for (uint32_t f = 0; f < frames; f++) {
+            /* Plain AX.25: the FCS rejects any damaged frame */
+            uint8_t rx_plain[sizeof(stream)];
+            memcpy(rx_plain, stream, (plain_bits + 7U) / 8U);
+            if (add_noise(rx_plain, (plain_bits + 7U) / 8U, s_ber_ppm[b]) != 0U) {
+                plain_lost++;
+            }
+
+            uint8_t rx[FX25_MAX_LEN];
+            uint8_t data[FEC_RS_K];
+            size_t data_len = sizeof(data);
+            memcpy(rx, fx25, fx25_len);
+            (void)add_noise(rx, fx25_len, s_ber_ppm[b]);
+            if (fx25_decode(rx, fx25_len, data, &data_len, NULL) != SMART_QSO_OK ||
+                memcmp(data, stream, plain_bits / 8U) != 0) {
+                fec_lost++;
+            }
+        }
+
+        double plain_loss = (double)plain_lost / (double)frames;
+        double fec_loss = (double)fec_lost / (double)frames;
+        /* Goodput relative to an error-free plain AX.25 link */
+        double fec_goodput = (1.0 - fec_loss) * (double)plain_bits / ((double)fx25_len * 8.0);
+
+        printf("  %8.0e %10.2f%% %10.2f%% %13.1f%% %13.1f%%\n",
+               (double)s_ber_ppm[b] / 1e6, plain_loss * 100.0, fec_loss * 100.0,
+               (1.0 - plain_loss) * 100.0, fec_goodput * 100.0);
+
+        /* FEC must never lose more than plain at these error rates */
+        if (fec_lost > plain_lost) {
+            printf("  FX.25 lost more frames than plain AX.25\n");
+            return BENCH_FAIL;
+        }
+    }
+
+    printf("  (checksum %u)\n", sink);
+    return 0;
+}
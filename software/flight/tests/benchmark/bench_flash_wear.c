@@ -0,0 +1,194 @@
+/**
+ * @file bench_flash_wear.c
+ * @brief Flash lifetime benchmark: wear leveling vs erase in place
+ *
+ * Runs the key-value store's flash pattern (erase a bank, fill it, switch
+ * banks) on the simulated device with a low erase endurance until data is
+ * lost, once through the wear-leveling layer and once through a reference
+ * model that erases the same physical blocks in place (no spares, no
+ * retirement). Every bank fill is read back before the next compaction.
+ * Lifetime scales linearly with endurance, so the compaction counts are
+ * projected to the rated endurance and the mission compaction rate. The
+ * simulated device also charges erase and page program times, giving the
+ * flash time one compaction costs on the target.
+ *
+ * Usage: bench_flash_wear [simulated endurance]
+ */
+
+/* Required for clock_gettime on POSIX-compliant systems */
+#define _XOPEN_SOURCE 600
+
+#include "bench_common.h"
+#include "hal/hal.h"
+#include "kv_store.h"
+#include "mission_data.h"
+
+#include <string.h>
+
+/** Default simulated erase endurance */
+#define BENCH_ENDURANCE             1000U
+
+/** Sectors per key-value bank */
+#define BENCH_BANK_BLOCKS           (KV_BANK_SIZE / HAL_FLASH_SECTOR_SIZE)
+
+_Static_assert((KV_BANK_SIZE % HAL_FLASH_SECTOR_SIZE) == 0U, "Banks must be whole sectors");
+
+/** Mission record checkpoints per day, the store's steady writer */
+#define BENCH_CHECKPOINTS_PER_DAY   (86400000U / MISSION_DATA_CHECKPOINT_MS)
+
+/**
+ * Bank compactions per day: the checkpointed mission record, doubled to
+ * leave room for event-driven saves (faults, configuration, phase changes).
+ */
+#define BENCH_COMPACTIONS_PER_DAY   \
+    (2.0 * (double)BENCH_CHECKPOINTS_PER_DAY * (double)KV_RECORD_SIZE(sizeof(MissionData_t)) / \
+     (double)KV_BANK_SIZE)
+
+static const HalFlashRegion_t s_banks[2] = { FLASH_REGION_STATE, FLASH_REGION_STATE_B };
+
+static void fill_pattern(uint8_t *buf, uint32_t seed)
+{
+    for (size_t i = 0; i < HAL_FLASH_SECTOR_SIZE; i++) {
+        buf[i] = (uint8_t)(seed + (i * 13U));
+    }
+}
+
+/**
+ * @brief Reference: both banks erased and filled in place on fixed blocks
+ *
+ * @return Compactions completed before an erase failed
+ */
+static uint32_t in_place_lifetime(uint32_t endurance, uint64_t *elapsed_ns)
+{
+    uint8_t sector[HAL_FLASH_SECTOR_SIZE];
+    uint32_t compactions = 0;
+
+    (void)hal_deinit();
+    (void)hal_flash_sim_configure(NULL);
+    hal_flash_sim_set_endurance(endurance);
+    if (hal_flash_phys_init() != SMART_QSO_OK) {
+        return 0;
+    }
+
+    uint64_t start = bench_now_ns();
+    for (;;) {
+        uint32_t first = (compactions % 2U) * BENCH_BANK_BLOCKS;
+        bool failed = false;
+
+        fill_pattern(sector, compactions);
+        for (uint32_t b = first; (b < first + BENCH_BANK_BLOCKS) && !failed; b++) {
+            failed = (hal_flash_phys_erase(b) != SMART_QSO_OK) ||
+                     (hal_flash_phys_program(b, 0U, sector, sizeof(sector)) != SMART_QSO_OK);
+        }
+        if (failed) {
+            break;
+        }
+        compactions++;
+    }
+    *elapsed_ns = bench_now_ns() - start;
+    return compactions;
+}
+
+/**
+ * @brief The same pattern through the wear-leveling layer
+ *
+ * @return Compactions completed before a block was lost, or 0 on a
+ *         read-back mismatch
+ */
+static uint32_t wear_leveled_lifetime(uint32_t endurance, uint64_t *elapsed_ns,
+                                      HalFlashWearStats_t *stats)
+{
+    uint8_t sector[HAL_FLASH_SECTOR_SIZE];
+    uint8_t check[HAL_FLASH_SECTOR_SIZE];
+    uint32_t compactions = 0;
+
+    (void)hal_deinit();
+    (void)hal_flash_sim_configure(NULL);
+    hal_flash_sim_set_endurance(endurance);
+    if (hal_flash_init() != SMART_QSO_OK) {
+        return 0;
+    }
+
+    uint64_t start = bench_now_ns();
+    for (;;) {
+        HalFlashRegion_t bank = s_banks[compactions % 2U];
+
+        if (hal_flash_erase(bank) != SMART_QSO_OK) {
+            break;
+        }
+        fill_pattern(sector, compactions);
+        for (uint32_t b = 0; b < BENCH_BANK_BLOCKS; b++) {
+            if (hal_flash_write(bank, b * HAL_FLASH_SECTOR_SIZE, sector,
+                                sizeof(sector)) != SMART_QSO_OK) {
+                printf("  write failed after %u compactions\n", compactions);
+                return 0;
+            }
+        }
+        for (uint32_t b = 0; b < BENCH_BANK_BLOCKS; b++) {
+            if ((hal_flash_read(bank, b * HAL_FLASH_SECTOR_SIZE, check,
+                                sizeof(check)) != SMART_QSO_OK) ||
+                (memcmp(check, sector, sizeof(sector)) != 0)) {
+                printf("  bank contents wrong after %u compactions\n", compactions);
+                return 0;
+            }
+        }
+        compactions++;
+    }
+    *elapsed_ns = bench_now_ns() - start;
+    (void)hal_flash_get_wear_stats(stats);
+    return compactions;
+}
+
+/**
+ * @brief Simulated flash time per compaction since the last configure
+ */
+static double device_ms_per_compaction(uint32_t compactions)
+{
+    HalFlashSimStats_t sim;
+    (void)hal_flash_sim_get_stats(&sim);
+    return (double)sim.busy_time_us / 1000.0 / (double)compactions;
+}
+
+static void report_lifetime(const char *label, uint32_t compactions, uint32_t endurance)
+{
+    double rated = (double)compactions * (double)HAL_FLASH_ENDURANCE_CYCLES / (double)endurance;
+    double years = rated / BENCH_COMPACTIONS_PER_DAY / 365.25;
+
+    printf("  %-24s %8u compactions -> %.1f years at %u cycles\n", label, compactions, years,
+           HAL_FLASH_ENDURANCE_CYCLES);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t endurance = bench_iterations(argc, argv, BENCH_ENDURANCE);
+    uint64_t in_place_ns = 0;
+    uint64_t leveled_ns = 0;
+    HalFlashWearStats_t stats;
+
+    printf("Flash lifetime (simulated endurance %u, %u spare blocks, %.2f compactions/day)\n",
+           endurance, HAL_FLASH_SPARE_BLOCKS, BENCH_COMPACTIONS_PER_DAY);
+
+    uint32_t in_place = in_place_lifetime(endurance, &in_place_ns);
+    double in_place_ms = (in_place > 0U) ? device_ms_per_compaction(in_place) : 0.0;
+    uint32_t leveled = wear_leveled_lifetime(endurance, &leveled_ns, &stats);
+    if ((in_place == 0U) || (leveled == 0U)) {
+        return BENCH_FAIL;
+    }
+    double leveled_ms = device_ms_per_compaction(leveled);
+
+    bench_report_rate("in-place compaction", in_place, in_place_ns, "compactions");
+    bench_report_rate("wear-leveled compaction", leveled, leveled_ns, "compactions");
+    report_lifetime("in place", in_place, endurance);
+    report_lifetime("wear leveled", leveled, endurance);
+    printf("  %u remaps, %u blocks retired, erase counts %u..%u\n", stats.remaps,
+           stats.retired_blocks, stats.min_erase_count, stats.max_erase_count);
+    printf("  device time per compaction: %.1f ms in place, %.1f ms wear leveled\n",
+           in_place_ms, leveled_ms);
+
+    /* Spares and retirement must outlast the weakest block */
+    if (leveled <= in_place) {
+        printf("  wear leveling did not extend the lifetime\n");
+        return BENCH_FAIL;
+    }
+    return 0;
+}
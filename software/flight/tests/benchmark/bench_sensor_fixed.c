@@ -0,0 +1,229 @@
+/**
+ * @file bench_sensor_fixed.c
+ * @brief Sensor telemetry from fixed-point values vs doubles
+ *
+ * Runs the two ways telemetry consumes sensor values over a large generated
+ * table, from the published fixed-point values and from the double values
+ * as the reference model of the previous path:
+ * - sensors_format_telemetry(), which prints each value with integer
+ *   arithmetic, against the previous "%.3f" snprintf formatter.
+ * - sensors_pack_i16(), which rescales and saturates each value into a
+ *   16-bit field, against scaling and rounding the double value.
+ * Output must match the reference before timings are reported.
+ *
+ * The host has a double-precision FPU; on the flight MCU every double
+ * operation of the reference path is a software library call, so these
+ * ratios understate the difference there.
+ *
+ * Usage: bench_sensor_fixed [formats]
+ */
+
+/* Required for clock_gettime on POSIX-compliant systems */
+#define _XOPEN_SOURCE 600
+
+#include "bench_common.h"
+#include "sensors.h"
+
+#include <math.h>
+#include <string.h>
+
+/** Default telemetry formats per case */
+#define BENCH_FORMATS       2000U
+
+/** Table packs per format */
+#define BENCH_PACKS_PER_FORMAT  4U
+
+/** Sensors in the generated table */
+#define BENCH_SENSORS       SMART_QSO_MAX_SENSORS
+
+/** Telemetry buffer: every sensor formatted with room to spare */
+#define BENCH_BUFFER_SIZE   (BENCH_SENSORS * 32U)
+
+/** Decimal places of the packed fields (mV, mA, mC) */
+#define BENCH_PACK_DECIMALS 3U
+
+/** Generated sensor configuration */
+#define BENCH_YAML_FILE     "/tmp/smart_qso_bench_sensor_fixed.yaml"
+
+_Static_assert(BENCH_SENSORS >= 1024, "Benchmark needs a build with 1024+ sensors");
+
+/** Reference model: labels and double values */
+static struct {
+    char id[SMART_QSO_SENSOR_ID_LEN];
+    char units[SMART_QSO_SENSOR_UNITS_LEN];
+} s_ref_labels[BENCH_SENSORS];
+static SensorHandle_t s_handles[BENCH_SENSORS];
+
+static char s_out[BENCH_BUFFER_SIZE];
+static char s_ref_out[BENCH_BUFFER_SIZE];
+static uint16_t s_fields[BENCH_SENSORS];
+static uint16_t s_ref_fields[BENCH_SENSORS];
+
+/**
+ * @brief Write a sensor table mixing the numeric sensor types
+ */
+static int write_config(void)
+{
+    static const char *const types[] = { "eps_voltage", "eps_current", "eps_temperature" };
+    static const char *const channels[] = { "battery", "solar", "battery" };
+    static const char *const units[] = { "V", "A", "C" };
+
+    FILE *f = fopen(BENCH_YAML_FILE, "w");
+    if (f == NULL) {
+        return -1;
+    }
+    (void)fprintf(f, "sensors:\n");
+    for (uint32_t i = 0; i < BENCH_SENSORS; i++) {
+        (void)fprintf(f, "  - id: S%04u\n    name: Bench Sensor %u\n", i, i);
+        (void)fprintf(f, "    type: %s\n    channel: %s\n", types[i % 3U], channels[i % 3U]);
+        (void)fprintf(f, "    units: %s\n    period_ms: 1000\n", units[i % 3U]);
+    }
+    return (fclose(f) == 0) ? 0 : -1;
+}
+
+/**
+ * @brief Load the table, take one reading per sensor and copy the labels
+ *        and handles to the reference
+ */
+static int load_sensors(void)
+{
+    (void)sensors_init();
+    if ((sensors_load_yaml(BENCH_YAML_FILE) != SMART_QSO_OK) ||
+        (sensors_get_count() != BENCH_SENSORS)) {
+        return -1;
+    }
+    for (size_t i = 0; i < BENCH_SENSORS; i++) {
+        Sensor_t s;
+        if ((sensors_poll_one(i) != SMART_QSO_OK) || (sensors_get(i, &s) != SMART_QSO_OK) ||
+            (s.decimals != 3U) || (sensors_find(s.id, &s_handles[i]) != SMART_QSO_OK)) {
+            return -1;
+        }
+        (void)memcpy(s_ref_labels[i].id, s.id, sizeof(s.id));
+        (void)memcpy(s_ref_labels[i].units, s.units, sizeof(s.units));
+    }
+    return 0;
+}
+
+/**
+ * @brief Reference: the previous formatter over the double values
+ */
+static size_t ref_format_telemetry(char *buffer, size_t buffer_len)
+{
+    size_t offset = 0;
+
+    for (size_t i = 0; i < BENCH_SENSORS; ++i) {
+        double value = 0.0;
+        (void)sensors_get_value(s_handles[i], &value);
+
+        int written = snprintf(buffer + offset, buffer_len - offset, "%s=%.3f%s,",
+                               s_ref_labels[i].id, value, s_ref_labels[i].units);
+        if (written < 0 || (size_t)written >= buffer_len - offset) {
+            break;  /* Truncation detected */
+        }
+        offset += (size_t)written;
+    }
+
+    return offset;
+}
+
+/**
+ * @brief Reference: scale, round and saturate the double values
+ */
+static void ref_pack(const SensorHandle_t *handles, size_t count, uint16_t *fields)
+{
+    for (size_t n = 0; n < count; n++) {
+        double value = 0.0;
+        (void)sensors_get_value(handles[n], &value);
+
+        double scaled = value * 1000.0;
+        if (scaled > (double)INT16_MAX) {
+            scaled = (double)INT16_MAX;
+        } else if (scaled < (double)INT16_MIN) {
+            scaled = (double)INT16_MIN;
+        } else {
+            /* In range */
+        }
+        fields[n] = (uint16_t)(int16_t)lround(scaled);
+    }
+}
+
+/**
+ * @brief Fixed-point path with the reference's signature
+ */
+static void fixed_pack(const SensorHandle_t *handles, size_t count, uint16_t *fields)
+{
+    (void)sensors_pack_i16(handles, count, BENCH_PACK_DECIMALS, fields);
+}
+
+/**
+ * @brief Time formats of the whole table
+ */
+static uint64_t time_formats(size_t (*format)(char *, size_t), char *out, uint32_t formats)
+{
+    uint64_t start = bench_now_ns();
+    for (uint32_t n = 0; n < formats; n++) {
+        (void)format(out, BENCH_BUFFER_SIZE);
+    }
+    return bench_now_ns() - start;
+}
+
+/**
+ * @brief Time packs of the whole table
+ *
+ * @param[out] sink Sum of the first field of every pack
+ */
+static uint64_t time_packs(void (*pack)(const SensorHandle_t *, size_t, uint16_t *),
+                           uint16_t *fields, uint32_t packs, uint32_t *sink)
+{
+    uint64_t start = bench_now_ns();
+    for (uint32_t n = 0; n < packs; n++) {
+        pack(s_handles, BENCH_SENSORS, fields);
+        *sink += fields[n % BENCH_SENSORS];
+    }
+    return bench_now_ns() - start;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t formats = bench_iterations(argc, argv, BENCH_FORMATS);
+    uint32_t packs = formats * BENCH_PACKS_PER_FORMAT;
+    uint32_t sink = 0;
+
+    printf("Sensor telemetry, fixed point vs double (%u sensors)\n", BENCH_SENSORS);
+    if ((write_config() != 0) || (load_sensors() != 0)) {
+        printf("  failed to load the sensor table\n");
+        return BENCH_FAIL;
+    }
+
+    size_t len = sensors_format_telemetry(s_out, sizeof(s_out));
+    size_t ref_len = ref_format_telemetry(s_ref_out, sizeof(s_ref_out));
+    if ((len == 0U) || (len != ref_len) || (memcmp(s_out, s_ref_out, len) != 0)) {
+        printf("  telemetry differs from the reference\n");
+        return BENCH_FAIL;
+    }
+
+    fixed_pack(s_handles, BENCH_SENSORS, s_fields);
+    ref_pack(s_handles, BENCH_SENSORS, s_ref_fields);
+    if (memcmp(s_fields, s_ref_fields, sizeof(s_fields)) != 0) {
+        printf("  packed fields differ from the reference\n");
+        return BENCH_FAIL;
+    }
+
+    uint64_t ref_format_ns = time_formats(ref_format_telemetry, s_ref_out, formats);
+    uint64_t format_ns = time_formats(sensors_format_telemetry, s_out, formats);
+    uint64_t ref_pack_ns = time_packs(ref_pack, s_ref_fields, packs, &sink);
+    uint64_t pack_ns = time_packs(fixed_pack, s_fields, packs, &sink);
+
+    bench_report_rate("double %.3f format", formats, ref_format_ns, "formats");
+    bench_report_rate("fixed-point format", formats, format_ns, "formats");
+    bench_report_throughput("double telemetry", (uint64_t)len * formats, ref_format_ns);
+    bench_report_throughput("fixed-point telemetry", (uint64_t)len * formats, format_ns);
+    bench_report_rate("double scale and round pack", (uint64_t)packs * BENCH_SENSORS,
+                      ref_pack_ns, "fields");
+    bench_report_rate("fixed-point rescale pack", (uint64_t)packs * BENCH_SENSORS,
+                      pack_ns, "fields");
+    printf("  (checksum %u)\n", sink);
+
+    (void)remove(BENCH_YAML_FILE);
+    return 0;
+}
@@ -0,0 +1,237 @@
+/**
+ * @file bench_sensor_poll.c
+ * @brief Sensor polling benchmark: deadline queue vs full table scan
+ *
+ * Loads a large generated sensor table and steps a simulated main loop
+ * (one tick every 20 ms) through sensors_poll(), which keeps the sensors in
+ * a queue ordered by next poll time, and through a reference model of the
+ * previous poll that checks every sensor on every tick. Both paths call the
+ * same read functions and print the same [READ] lines, so the difference is
+ * the scheduling cost. Every tick must poll the same number of sensors in
+ * both paths, and sensors_next_poll_ms() must equal the reference's
+ * earliest deadline, before timings are reported.
+ *
+ * Usage: bench_sensor_poll [simulated seconds]
+ */
+
+/* Required for clock_gettime, dup and dup2 on POSIX-compliant systems */
+#define _XOPEN_SOURCE 600
+
+#include "bench_common.h"
+#include "sensors.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+/** Default simulated run length (s) */
+#define BENCH_SECONDS       600U
+
+/** Sensors in the generated table */
+#define BENCH_SENSORS       SMART_QSO_MAX_SENSORS
+
+/** Main loop period (ms) */
+#define BENCH_TICK_MS       20U
+
+/** Generated sensor configuration */
+#define BENCH_YAML_FILE     "/tmp/smart_qso_bench_sensors.yaml"
+
+_Static_assert(BENCH_SENSORS >= 256, "Benchmark needs a build with 256+ sensors");
+
+/** Reference model: the sensor table scanned in full every tick */
+static Sensor_t s_ref[BENCH_SENSORS];
+static size_t s_ref_count = 0;
+
+/** stdout while [READ] lines are discarded */
+static int s_saved_stdout = -1;
+
+/**
+ * @brief Discard per-read console output while timing
+ */
+static void quiet_begin(void)
+{
+    (void)fflush(stdout);
+    s_saved_stdout = dup(STDOUT_FILENO);
+    int null_fd = open("/dev/null", O_WRONLY);
+    if (null_fd >= 0) {
+        (void)dup2(null_fd, STDOUT_FILENO);
+        (void)close(null_fd);
+    }
+}
+
+static void quiet_end(void)
+{
+    (void)fflush(stdout);
+    if (s_saved_stdout >= 0) {
+        (void)dup2(s_saved_stdout, STDOUT_FILENO);
+        (void)close(s_saved_stdout);
+        s_saved_stdout = -1;
+    }
+}
+
+/**
+ * @brief Write a sensor table mixing the flight sensor types and periods
+ */
+static int write_config(void)
+{
+    static const char *const types[] = {
+        "eps_voltage", "eps_current", "eps_temperature", "software_timer"
+    };
+    static const char *const channels[] = { "battery", "solar", "battery", "" };
+    static const uint32_t periods[] = { 1000U, 2000U, 1000U, 5000U, 1000U };
+
+    FILE *f = fopen(BENCH_YAML_FILE, "w");
+    if (f == NULL) {
+        return -1;
+    }
+    (void)fprintf(f, "sensors:\n");
+    for (uint32_t i = 0; i < BENCH_SENSORS; i++) {
+        (void)fprintf(f, "  - id: S%03u\n    name: Bench Sensor %u\n", i, i);
+        (void)fprintf(f, "    type: %s\n    channel: %s\n", types[i % 4U], channels[i % 4U]);
+        (void)fprintf(f, "    units: V\n    period_ms: %u\n", periods[i % 5U]);
+    }
+    return (fclose(f) == 0) ? 0 : -1;
+}
+
+/**
+ * @brief Fresh module load; the reference copies the loaded table
+ */
+static int load_sensors(void)
+{
+    (void)sensors_init();
+    if ((sensors_load_yaml(BENCH_YAML_FILE) != SMART_QSO_OK) ||
+        (sensors_get_count() != BENCH_SENSORS)) {
+        return -1;
+    }
+    s_ref_count = sensors_get_count();
+    for (size_t i = 0; i < s_ref_count; i++) {
+        (void)sensors_get(i, &s_ref[i]);
+    }
+    return 0;
+}
+
+/**
+ * @brief Reference: the previous sensors_poll(), every sensor checked
+ */
+static size_t ref_poll(uint64_t current_ms)
+{
+    size_t count = 0;
+
+    for (size_t i = 0; i < s_ref_count; ++i) {
+        Sensor_t *s = &s_ref[i];
+        if (current_ms >= s->next_poll_ms) {
+            double val = 0.0;
+            char text[8] = {0};
+
+            if (s->read != NULL && s->read(s, &val, text)) {
+                s->last_value = val;
+                printf("[READ] id=%s name=\"%s\" value=%.3f units=%s\n",
+                       s->id, s->name, s->last_value, s->units);
+                count++;
+            }
+
+            s->next_poll_ms = current_ms + (s->period_ms > 0 ? s->period_ms : 1000);
+        }
+    }
+
+    return count;
+}
+
+static uint64_t ref_next_poll_ms(void)
+{
+    uint64_t next = UINT64_MAX;
+    for (size_t i = 0; i < s_ref_count; i++) {
+        if (s_ref[i].next_poll_ms < next) {
+            next = s_ref[i].next_poll_ms;
+        }
+    }
+    return next;
+}
+
+/**
+ * @brief Step both paths tick by tick and compare them
+ *
+ * @param ticks Loop ticks to run
+ * @param[out] mismatch_ms Time of the first mismatching tick
+ * @return Sensor reads in the run, or 0 on a mismatch
+ */
+static uint64_t check_conformance(uint32_t ticks, uint64_t *mismatch_ms)
+{
+    uint64_t reads = 0;
+
+    if (load_sensors() != 0) {
+        return 0;
+    }
+    for (uint32_t t = 0; t < ticks; t++) {
+        uint64_t now = (uint64_t)t * BENCH_TICK_MS;
+        size_t polled = sensors_poll(now);
+        if ((polled != ref_poll(now)) || (sensors_next_poll_ms() != ref_next_poll_ms())) {
+            *mismatch_ms = now;
+            return 0;
+        }
+        reads += polled;
+    }
+    return reads;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t seconds = bench_iterations(argc, argv, BENCH_SECONDS);
+    uint32_t ticks = (seconds * 1000U) / BENCH_TICK_MS;
+
+    printf("Sensor polling (%u sensors, %u ms ticks, %u simulated seconds)\n",
+           BENCH_SENSORS, BENCH_TICK_MS, seconds);
+    if (write_config() != 0) {
+        return BENCH_FAIL;
+    }
+
+    uint64_t mismatch_ms = 0;
+    quiet_begin();
+    uint64_t reads = check_conformance(ticks, &mismatch_ms);
+    if (reads == 0U) {
+        quiet_end();
+        printf("  poll mismatch at %llu ms\n", (unsigned long long)mismatch_ms);
+        return BENCH_FAIL;
+    }
+
+    /* Timed runs from a fresh load */
+    (void)load_sensors();
+    uint64_t start = bench_now_ns();
+    for (uint32_t t = 0; t < ticks; t++) {
+        (void)ref_poll((uint64_t)t * BENCH_TICK_MS);
+    }
+    uint64_t scan_ns = bench_now_ns() - start;
+
+    (void)load_sensors();
+    start = bench_now_ns();
+    for (uint32_t t = 0; t < ticks; t++) {
+        (void)sensors_poll((uint64_t)t * BENCH_TICK_MS);
+    }
+    uint64_t queue_ns = bench_now_ns() - start;
+
+    /* Ticks with nothing due: the common case between 1 s deadlines */
+    (void)load_sensors();
+    (void)ref_poll(0U);
+    (void)sensors_poll(0U);
+    start = bench_now_ns();
+    for (uint32_t t = 0; t < ticks; t++) {
+        (void)ref_poll(1U + (t % 999U));
+    }
+    uint64_t scan_idle_ns = bench_now_ns() - start;
+    start = bench_now_ns();
+    for (uint32_t t = 0; t < ticks; t++) {
+        (void)sensors_poll(1U + (t % 999U));
+    }
+    uint64_t queue_idle_ns = bench_now_ns() - start;
+    quiet_end();
+
+    printf("  %llu sensor reads per run\n", (unsigned long long)reads);
+    bench_report_rate("full scan (loop ticks)", ticks, scan_ns, "ticks");
+    bench_report_rate("deadline queue (loop ticks)", ticks, queue_ns, "ticks");
+    bench_report_rate("full scan (idle ticks)", ticks, scan_idle_ns, "ticks");
+    bench_report_rate("deadline queue (idle ticks)", ticks, queue_idle_ns, "ticks");
+    printf("  sensors checked per idle tick: %u scan, 1 queue\n", BENCH_SENSORS);
+
+    (void)remove(BENCH_YAML_FILE);
+    return 0;
+}
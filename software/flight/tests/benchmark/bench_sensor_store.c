@@ -0,0 +1,317 @@
+/**
+ * @file bench_sensor_store.c
+ * @brief Sensor table scans: split sensor store vs Sensor_t array
+ *
+ * Runs the two full-table scans of the sensor module over a large generated
+ * table, and the same scans over an array of full Sensor_t records (names,
+ * types and channels interleaved with the values) as the reference model
+ * of the previous store:
+ * - sensors_format_telemetry(), which reads the hot value arrays and the
+ *   compact id/units labels. Telemetry is formatted once a minute in
+ *   flight, so the caches are cold by then; this case is timed warm and
+ *   after evicting the caches.
+ * - sensors_get_by_id(), which finds the slot through the ID hash index,
+ *   and sensors_find(), which returns a handle without assembling a view,
+ *   against a strcmp scan of the records; then value reads by handle.
+ * Output and lookups must match the reference before timings are reported.
+ *
+ * Usage: bench_sensor_store [formats]
+ */
+
+/* Required for clock_gettime on POSIX-compliant systems */
+#define _XOPEN_SOURCE 600
+
+#include "bench_common.h"
+#include "sensors.h"
+
+#include <string.h>
+
+/** Default telemetry formats per case */
+#define BENCH_FORMATS       2000U
+
+/** Sensors in the generated table */
+#define BENCH_SENSORS       SMART_QSO_MAX_SENSORS
+
+/** Telemetry buffer: every sensor formatted with room to spare */
+#define BENCH_BUFFER_SIZE   (BENCH_SENSORS * 32U)
+
+/** Bytes written between formats to evict the caches */
+#define BENCH_EVICT_SIZE    (16U * 1024U * 1024U)
+
+/** ID lookups per format */
+#define BENCH_LOOKUPS_PER_FORMAT    16U
+
+/** Bytes per sensor the split formatter reads: id, units, value, value type */
+#define BENCH_HOT_BYTES     (SMART_QSO_SENSOR_ID_LEN + SMART_QSO_SENSOR_UNITS_LEN + sizeof(double) + 1U)
+
+/** Generated sensor configuration */
+#define BENCH_YAML_FILE     "/tmp/smart_qso_bench_sensor_store.yaml"
+
+_Static_assert(BENCH_SENSORS >= 1024, "Benchmark needs a build with 1024+ sensors");
+
+/** Reference model: one full record per sensor */
+static Sensor_t s_ref[BENCH_SENSORS];
+static size_t s_ref_count = 0;
+
+static char s_out[BENCH_BUFFER_SIZE];
+static char s_ref_out[BENCH_BUFFER_SIZE];
+
+/**
+ * @brief Write a sensor table mixing the numeric sensor types
+ */
+static int write_config(void)
+{
+    static const char *const types[] = { "eps_voltage", "eps_current", "eps_temperature" };
+    static const char *const channels[] = { "battery", "solar", "battery" };
+    static const char *const units[] = { "V", "A", "C" };
+
+    FILE *f = fopen(BENCH_YAML_FILE, "w");
+    if (f == NULL) {
+        return -1;
+    }
+    (void)fprintf(f, "sensors:\n");
+    for (uint32_t i = 0; i < BENCH_SENSORS; i++) {
+        (void)fprintf(f, "  - id: S%04u\n    name: Bench Sensor %u\n", i, i);
+        (void)fprintf(f, "    type: %s\n    channel: %s\n", types[i % 3U], channels[i % 3U]);
+        (void)fprintf(f, "    units: %s\n    period_ms: 1000\n", units[i % 3U]);
+    }
+    return (fclose(f) == 0) ? 0 : -1;
+}
+
+/**
+ * @brief Reference: the previous formatter over Sensor_t records
+ */
+static size_t ref_format_telemetry(char *buffer, size_t buffer_len)
+{
+    size_t offset = 0;
+
+    for (size_t i = 0; i < s_ref_count; ++i) {
+        Sensor_t *s = &s_ref[i];
+        int written;
+
+        if (s->value_type == SENSOR_VALUE_NUMERIC) {
+            written = snprintf(buffer + offset, buffer_len - offset,
+                               "%s=%.3f%s,", s->id, s->last_value, s->units);
+        } else {
+            written = snprintf(buffer + offset, buffer_len - offset,
+                               "%s=%s%s,", s->id, s->last_text, s->units);
+        }
+
+        if (written < 0 || (size_t)written >= buffer_len - offset) {
+            break;  /* Truncation detected */
+        }
+        offset += (size_t)written;
+    }
+
+    return offset;
+}
+
+/**
+ * @brief Reference: the previous ID lookup over Sensor_t records
+ */
+static SmartQsoResult_t ref_get_by_id(const char *id, Sensor_t *sensor)
+{
+    for (size_t i = 0; i < s_ref_count; i++) {
+        if (strcmp(s_ref[i].id, id) == 0) {
+            *sensor = s_ref[i];
+            return SMART_QSO_OK;
+        }
+    }
+
+    return SMART_QSO_ERROR;
+}
+
+/**
+ * @brief Reference: the previous strcmp scan, returning the slot
+ */
+static SmartQsoResult_t ref_find(const char *id, SensorHandle_t *handle)
+{
+    for (size_t i = 0; i < s_ref_count; i++) {
+        if (strcmp(s_ref[i].id, id) == 0) {
+            *handle = (SensorHandle_t)i;
+            return SMART_QSO_OK;
+        }
+    }
+
+    return SMART_QSO_ERROR;
+}
+
+/**
+ * @brief Find IDs spread over the table
+ *
+ * @return Sum of the handles found
+ */
+static uint32_t run_finds(SmartQsoResult_t (*find)(const char *, SensorHandle_t *),
+                          uint32_t lookups)
+{
+    char id[SMART_QSO_SENSOR_ID_LEN];
+    SensorHandle_t handle = SENSOR_HANDLE_INVALID;
+    uint32_t sum = 0;
+
+    for (uint32_t n = 0; n < lookups; n++) {
+        (void)snprintf(id, sizeof(id), "S%04u", (n * 389U) % BENCH_SENSORS);
+        if (find(id, &handle) == SMART_QSO_OK) {
+            sum += handle;
+        }
+    }
+    return sum;
+}
+
+/**
+ * @brief Look up IDs spread over the table
+ *
+ * @return Lookups that found their sensor
+ */
+static uint32_t run_lookups(SmartQsoResult_t (*get_by_id)(const char *, Sensor_t *),
+                            uint32_t lookups)
+{
+    char id[SMART_QSO_SENSOR_ID_LEN];
+    Sensor_t sensor;
+    uint32_t found = 0;
+
+    for (uint32_t n = 0; n < lookups; n++) {
+        (void)snprintf(id, sizeof(id), "S%04u", (n * 389U) % BENCH_SENSORS);
+        if ((get_by_id(id, &sensor) == SMART_QSO_OK) &&
+            (strcmp(sensor.id, id) == 0)) {
+            found++;
+        }
+    }
+    return found;
+}
+
+/**
+ * @brief Load the table, take one reading per sensor and copy it to the
+ *        reference
+ */
+static int load_sensors(void)
+{
+    (void)sensors_init();
+    if ((sensors_load_yaml(BENCH_YAML_FILE) != SMART_QSO_OK) ||
+        (sensors_get_count() != BENCH_SENSORS)) {
+        return -1;
+    }
+    s_ref_count = sensors_get_count();
+    for (size_t i = 0; i < s_ref_count; i++) {
+        if ((sensors_poll_one(i) != SMART_QSO_OK) || (sensors_get(i, &s_ref[i]) != SMART_QSO_OK)) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Write over a buffer larger than the caches
+ */
+static void evict_caches(uint8_t *evict, uint32_t round)
+{
+    for (size_t i = 0; i < BENCH_EVICT_SIZE; i += 64U) {
+        evict[i] = (uint8_t)(round + i);
+    }
+}
+
+/**
+ * @brief Time formats, optionally evicting the caches before each one
+ *
+ * Eviction time is excluded.
+ */
+static uint64_t time_formats(size_t (*format)(char *, size_t), char *out,
+                             uint32_t formats, uint8_t *evict)
+{
+    uint64_t elapsed = 0;
+
+    for (uint32_t n = 0; n < formats; n++) {
+        if (evict != NULL) {
+            evict_caches(evict, n);
+        }
+        uint64_t start = bench_now_ns();
+        (void)format(out, BENCH_BUFFER_SIZE);
+        elapsed += bench_now_ns() - start;
+    }
+    return elapsed;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t formats = bench_iterations(argc, argv, BENCH_FORMATS);
+    uint32_t cold_formats = (formats / 10U > 0U) ? (formats / 10U) : 1U;
+
+    printf("Telemetry formatting (%u sensors, %zu vs %zu bytes read per sensor)\n",
+           BENCH_SENSORS, (size_t)BENCH_HOT_BYTES, sizeof(Sensor_t));
+    if ((write_config() != 0) || (load_sensors() != 0)) {
+        printf("  failed to load the sensor table\n");
+        return BENCH_FAIL;
+    }
+
+    size_t len = sensors_format_telemetry(s_out, sizeof(s_out));
+    size_t ref_len = ref_format_telemetry(s_ref_out, sizeof(s_ref_out));
+    if ((len == 0U) || (len != ref_len) || (memcmp(s_out, s_ref_out, len) != 0)) {
+        printf("  telemetry differs from the reference\n");
+        return BENCH_FAIL;
+    }
+
+    uint32_t lookups = formats * BENCH_LOOKUPS_PER_FORMAT;
+    if ((run_lookups(sensors_get_by_id, BENCH_SENSORS) != BENCH_SENSORS) ||
+        (run_lookups(ref_get_by_id, BENCH_SENSORS) != BENCH_SENSORS)) {
+        printf("  ID lookup failed\n");
+        return BENCH_FAIL;
+    }
+
+    /* Handles reach the sensor of their ID */
+    static SensorHandle_t handles[BENCH_SENSORS];
+    for (size_t i = 0; i < BENCH_SENSORS; i++) {
+        Sensor_t sensor;
+        if ((sensors_find(s_ref[i].id, &handles[i]) != SMART_QSO_OK) ||
+            (sensors_get_by_handle(handles[i], &sensor) != SMART_QSO_OK) ||
+            (strcmp(sensor.id, s_ref[i].id) != 0)) {
+            printf("  handle lookup failed\n");
+            return BENCH_FAIL;
+        }
+    }
+
+    uint8_t *evict = malloc(BENCH_EVICT_SIZE);
+    if (evict == NULL) {
+        return BENCH_FAIL;
+    }
+
+    uint64_t ref_warm_ns = time_formats(ref_format_telemetry, s_ref_out, formats, NULL);
+    uint64_t warm_ns = time_formats(sensors_format_telemetry, s_out, formats, NULL);
+    uint64_t ref_cold_ns = time_formats(ref_format_telemetry, s_ref_out, cold_formats, evict);
+    uint64_t cold_ns = time_formats(sensors_format_telemetry, s_out, cold_formats, evict);
+    free(evict);
+
+    uint64_t start = bench_now_ns();
+    (void)run_lookups(ref_get_by_id, lookups);
+    uint64_t ref_lookup_ns = bench_now_ns() - start;
+    start = bench_now_ns();
+    (void)run_lookups(sensors_get_by_id, lookups);
+    uint64_t lookup_ns = bench_now_ns() - start;
+    start = bench_now_ns();
+    uint32_t sink = run_finds(ref_find, lookups);
+    uint64_t ref_find_ns = bench_now_ns() - start;
+    start = bench_now_ns();
+    sink += run_finds(sensors_find, lookups);
+    uint64_t find_ns = bench_now_ns() - start;
+    double total = 0.0;
+    start = bench_now_ns();
+    for (uint32_t n = 0; n < lookups; n++) {
+        double value = 0.0;
+        (void)sensors_get_value(handles[(n * 389U) % BENCH_SENSORS], &value);
+        total += value;
+    }
+    uint64_t handle_ns = bench_now_ns() - start;
+
+    bench_report_rate("Sensor_t array (warm)", formats, ref_warm_ns, "formats");
+    bench_report_rate("split store (warm)", formats, warm_ns, "formats");
+    bench_report_rate("Sensor_t array (cold)", cold_formats, ref_cold_ns, "formats");
+    bench_report_rate("split store (cold)", cold_formats, cold_ns, "formats");
+    bench_report_throughput("split store telemetry (warm)", (uint64_t)len * formats, warm_ns);
+    bench_report_rate("Sensor_t array ID lookup", lookups, ref_lookup_ns, "lookups");
+    bench_report_rate("split store ID lookup", lookups, lookup_ns, "lookups");
+    bench_report_rate("strcmp scan ID to slot", lookups, ref_find_ns, "lookups");
+    bench_report_rate("hashed ID to handle", lookups, find_ns, "lookups");
+    bench_report_rate("value by handle", lookups, handle_ns, "reads");
+    printf("  (checksum %u, %.1f)\n", sink, total);
+
+    (void)remove(BENCH_YAML_FILE);
+    return 0;
+}
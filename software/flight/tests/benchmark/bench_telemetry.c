@@ -0,0 +1,140 @@
+/**
+ * @file bench_telemetry.c
+ * @brief Telemetry frame generation throughput benchmark
+ *
+ * Compares the legacy path (generate into a TlmFrame_t, then copy into the
+ * transmit buffer with tlm_serialize()) against the zero-copy builder that
+ * writes header, payload and CRC straight into a TX ring slot.
+ *
+ * Usage: bench_telemetry [iterations]
+ */
+
+/* Required for clock_gettime on POSIX-compliant systems */
+#define _XOPEN_SOURCE 600
+
+#include "bench_common.h"
+#include "telemetry.h"
+#include "system_state.h"
+
+#include <string.h>
+
+/** Default iteration count */
+#define BENCH_TLM_ITERATIONS    200000U
+
+/** Number of TX ring slots */
+#define BENCH_TX_SLOTS          8U
+
+/** Simulated transmit ring */
+static uint8_t s_tx_ring[BENCH_TX_SLOTS][TLM_MAX_FRAME_SIZE];
+
+/** Frame generator under test */
+typedef SmartQsoResult_t (*LegacyGenFn_t)(TlmFrame_t *frame, size_t *frame_len);
+typedef SmartQsoResult_t (*BuildFn_t)(uint8_t *buffer, size_t size, size_t *written);
+
+typedef struct {
+    const char *name;
+    LegacyGenFn_t legacy;
+    BuildFn_t build;
+} TlmCase_t;
+
+static const TlmCase_t s_cases[] = {
+    { "housekeeping", tlm_generate_housekeeping, tlm_build_housekeeping },
+    { "eps",          tlm_generate_eps,          tlm_build_eps },
+    { "adcs",         tlm_generate_adcs,         tlm_build_adcs },
+    { "beacon",       tlm_generate_beacon,       tlm_build_beacon },
+};
+
+/**
+ * @brief Legacy path: generate frame, then serialize into the TX slot
+ */
+static size_t run_legacy(LegacyGenFn_t gen, uint8_t *slot)
+{
+    TlmFrame_t frame;
+    size_t frame_len = 0;
+    size_t written = 0;
+
+    if (gen(&frame, &frame_len) != SMART_QSO_OK) {
+        return 0;
+    }
+
+    size_t payload_len = frame_len - TLM_HEADER_LEN - TLM_CRC_LEN;
+    if (tlm_serialize(&frame, payload_len, slot, TLM_MAX_FRAME_SIZE,
+                      &written) != SMART_QSO_OK) {
+        return 0;
+    }
+
+    return written;
+}
+
+/**
+ * @brief Verify both paths emit byte-identical frames
+ */
+static int check_conformance(const TlmCase_t *tc)
+{
+    uint8_t legacy_buf[TLM_MAX_FRAME_SIZE];
+    uint8_t build_buf[TLM_MAX_FRAME_SIZE];
+    size_t build_len = 0;
+
+    (void)tlm_init();
+    size_t legacy_len = run_legacy(tc->legacy, legacy_buf);
+
+    (void)tlm_init();
+    if (tc->build(build_buf, sizeof(build_buf), &build_len) != SMART_QSO_OK) {
+        printf("  %s: build failed\n", tc->name);
+        return BENCH_FAIL;
+    }
+
+    if ((legacy_len == 0U) || (legacy_len != build_len) ||
+        (memcmp(legacy_buf, build_buf, build_len) != 0)) {
+        printf("  %s: output mismatch (legacy %zu bytes, build %zu bytes)\n",
+               tc->name, legacy_len, build_len);
+        return BENCH_FAIL;
+    }
+
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t iterations = bench_iterations(argc, argv, BENCH_TLM_ITERATIONS);
+    uint32_t sink = 0;
+    int status = 0;
+
+    (void)sys_state_init();
+
+    printf("Telemetry frame generation (%u iterations)\n", iterations);
+
+    for (size_t c = 0; c < sizeof(s_cases) / sizeof(s_cases[0]); c++) {
+        const TlmCase_t *tc = &s_cases[c];
+        char label[48];
+
+        if (check_conformance(tc) != 0) {
+            status = BENCH_FAIL;
+            continue;
+        }
+
+        uint64_t start = bench_now_ns();
+        for (uint32_t i = 0; i < iterations; i++) {
+            uint8_t *slot = s_tx_ring[i % BENCH_TX_SLOTS];
+            sink += (uint32_t)run_legacy(tc->legacy, slot);
+        }
+        uint64_t legacy_ns = bench_now_ns() - start;
+
+        start = bench_now_ns();
+        for (uint32_t i = 0; i < iterations; i++) {
+            uint8_t *slot = s_tx_ring[i % BENCH_TX_SLOTS];
+            size_t written = 0;
+            (void)tc->build(slot, TLM_MAX_FRAME_SIZE, &written);
+            sink += (uint32_t)written;
+        }
+        uint64_t build_ns = bench_now_ns() - start;
+
+        (void)snprintf(label, sizeof(label), "%s generate+serialize", tc->name);
+        bench_report_rate(label, iterations, legacy_ns, "frames");
+        (void)snprintf(label, sizeof(label), "%s zero-copy build", tc->name);
+        bench_report_rate(label, iterations, build_ns, "frames");
+    }
+
+    printf("  (checksum %u)\n", sink);
+    return status;
+}
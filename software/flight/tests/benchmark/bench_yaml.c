@@ -0,0 +1,352 @@
+/**
+ * @file bench_yaml.c
+ * @brief YAML parsing throughput: streaming tokenizer vs line-copy parser
+ *
+ * Parses a large generated mission configuration with:
+ * - the former yaml_parse_string() as the reference model: each line is
+ *   copied into a line buffer, key and value into their own buffers, and the
+ *   dotted path rebuilt with snprintf for every pair;
+ * - the streaming tokenizer over the whole buffer (as from a memory map),
+ *   reading keys and values in place;
+ * - the tokenizer fed in 512-byte chunks (as sensors_load_yaml() reads a
+ *   file), which copies only lines split across chunks;
+ * - yaml_parse_string(), which builds the dotted path on top of the
+ *   tokenizer for its callback.
+ * Each path hashes every "path=value" pair and must match the reference
+ * before timings are reported.
+ *
+ * Usage: bench_yaml [passes]
+ */
+
+/* Required for clock_gettime on POSIX-compliant systems */
+#define _XOPEN_SOURCE 600
+
+#include "bench_common.h"
+#include "yaml_parser.h"
+
+#include <string.h>
+
+/** Default passes over the document */
+#define BENCH_PASSES        20U
+
+/** Sensors in the generated configuration */
+#define BENCH_SENSORS       4000U
+
+/** Document buffer */
+#define BENCH_DOC_SIZE      (BENCH_SENSORS * 256U)
+
+/** Chunk size of the chunked case */
+#define BENCH_CHUNK_SIZE    512U
+
+/** FNV-1a */
+#define FNV_OFFSET          2166136261U
+#define FNV_PRIME           16777619U
+
+static char s_doc[BENCH_DOC_SIZE];
+static size_t s_doc_len = 0;
+
+/** Hash and pair count of the pairs seen */
+static uint32_t s_hash;
+static uint32_t s_pairs;
+
+static uint32_t fnv(uint32_t h, const char *p, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        h = (h ^ (uint8_t)p[i]) * FNV_PRIME;
+    }
+    return h;
+}
+
+static void hash_pair(const char *path, const char *value)
+{
+    s_hash = fnv(s_hash, path, strlen(path));
+    s_hash = fnv(s_hash, "=", 1U);
+    s_hash = fnv(s_hash, value, strlen(value));
+    s_hash = fnv(s_hash, "\n", 1U);
+    s_pairs++;
+}
+
+/**
+ * @brief Write a mission configuration of nested mappings
+ */
+static void build_doc(void)
+{
+    static const char *const types[] = { "eps_voltage", "eps_current", "eps_temperature" };
+    size_t n = 0;
+
+    n += (size_t)snprintf(&s_doc[n], sizeof(s_doc) - n,
+                          "# generated mission configuration\nmission:\n  name: SMART-QSO\n"
+                          "  beacon:\n    period_s: 60\n    text: \"SMART-QSO AI beacon\"\n"
+                          "sensors:\n");
+    for (uint32_t i = 0; i < BENCH_SENSORS; i++) {
+        n += (size_t)snprintf(&s_doc[n], sizeof(s_doc) - n,
+                              "  s%04u:\n    id: S%04u\n    name: Bench Sensor %u\n"
+                              "    type: %s\n    units: V\n    period_ms: %u\n"
+                              "    limits:\n      min: -%u.5\n      max: %u.25\n",
+                              i, i, i, types[i % 3U], 1000U + (i % 7U) * 250U, i % 40U,
+                              i % 90U);
+    }
+    s_doc_len = n;
+}
+
+/*===========================================================================*/
+/* Reference: the former line-copy parser                                     */
+/*===========================================================================*/
+
+static struct {
+    uint8_t indent_level;
+    char path[64 * 8];
+} s_ref;
+
+static void ref_trim(char *str)
+{
+    size_t len = strlen(str);
+    while ((len > 0U) && ((str[len - 1U] == ' ') || (str[len - 1U] == '\t') ||
+                          (str[len - 1U] == '\r') || (str[len - 1U] == '\n'))) {
+        str[--len] = '\0';
+    }
+    char *start = str;
+    while ((*start == ' ') || (*start == '\t')) {
+        start++;
+    }
+    if (start != str) {
+        memmove(str, start, strlen(start) + 1U);
+    }
+}
+
+static int ref_line(const char *line)
+{
+    const char *p = line;
+    uint8_t indent = 0;
+
+    while ((*p == ' ') || (*p == '\t')) {
+        indent = (uint8_t)(indent + ((*p == '\t') ? 2U : 1U));
+        p++;
+    }
+    if ((*p == '\0') || (*p == '#')) {
+        return 0;
+    }
+    indent /= 2U;
+
+    if (indent < s_ref.indent_level) {
+        uint8_t remove = (uint8_t)(s_ref.indent_level - indent);
+        char *dot;
+        while ((remove > 0U) && ((dot = strrchr(s_ref.path, '.')) != NULL)) {
+            *dot = '\0';
+            remove--;
+        }
+        if (remove > 0U) {
+            s_ref.path[0] = '\0';
+        }
+    }
+    s_ref.indent_level = indent;
+
+    char key[64];
+    char value[128];
+    const char *sep = strchr(p, ':');
+    if (sep == NULL) {
+        return -1;
+    }
+    size_t key_len = (size_t)(sep - p);
+    if (key_len >= sizeof(key)) {
+        key_len = sizeof(key) - 1U;
+    }
+    memcpy(key, p, key_len);
+    key[key_len] = '\0';
+    ref_trim(key);
+    const char *v = sep + 1;
+    while (*v == ' ') {
+        v++;
+    }
+    strncpy(value, v, sizeof(value) - 1U);
+    value[sizeof(value) - 1U] = '\0';
+    ref_trim(value);
+    size_t val_len = strlen(value);
+    if ((val_len >= 2U) && (((value[0] == '"') && (value[val_len - 1U] == '"')) ||
+                            ((value[0] == '\'') && (value[val_len - 1U] == '\'')))) {
+        memmove(value, value + 1, val_len - 2U);
+        value[val_len - 2U] = '\0';
+    }
+
+    char full_path[sizeof(s_ref.path)];
+    if (s_ref.path[0] != '\0') {
+        /* Intentional truncation, as in the former parser */
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-truncation"
+#endif
+        (void)snprintf(full_path, sizeof(full_path), "%s.%s", s_ref.path, key);
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+    } else {
+        strncpy(full_path, key, sizeof(full_path) - 1U);
+        full_path[sizeof(full_path) - 1U] = '\0';
+    }
+
+    if (value[0] == '\0') {
+        strncpy(s_ref.path, full_path, sizeof(s_ref.path) - 1U);
+        s_ref.path[sizeof(s_ref.path) - 1U] = '\0';
+    } else {
+        hash_pair(full_path, value);
+    }
+    return 0;
+}
+
+static int ref_parse(const char *doc, size_t length)
+{
+    char line[256];
+    size_t start = 0;
+
+    memset(&s_ref, 0, sizeof(s_ref));
+    for (size_t i = 0; i <= length; i++) {
+        if ((i == length) || (doc[i] == '\n')) {
+            size_t n = i - start;
+            if (n > 0U) {
+                if (n >= sizeof(line)) {
+                    n = sizeof(line) - 1U;
+                }
+                memcpy(line, &doc[start], n);
+                line[n] = '\0';
+                if (ref_line(line) != 0) {
+                    return -1;
+                }
+            }
+            start = i + 1U;
+        }
+    }
+    return 0;
+}
+
+/*===========================================================================*/
+/* Tokenizer cases                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief Hash a token's pair from its spans, without building the path
+ */
+static void hash_token(const yaml_token_t *token)
+{
+    for (uint8_t d = 0; d < token->depth; d++) {
+        s_hash = fnv(s_hash, token->path[d].ptr, token->path[d].len);
+        s_hash = fnv(s_hash, ".", 1U);
+    }
+    s_hash = fnv(s_hash, token->key.ptr, token->key.len);
+    s_hash = fnv(s_hash, "=", 1U);
+    s_hash = fnv(s_hash, token->value.ptr, token->value.len);
+    s_hash = fnv(s_hash, "\n", 1U);
+    s_pairs++;
+}
+
+static int tokenize(const char *doc, size_t length, size_t chunk)
+{
+    yaml_tokenizer_t tok;
+    yaml_token_t token;
+    yaml_error_t err = YAML_NEED_INPUT;
+
+    yaml_tokenizer_init(&tok);
+    for (size_t pos = 0; (err == YAML_NEED_INPUT) && (pos < length); pos += chunk) {
+        size_t n = ((length - pos) < chunk) ? (length - pos) : chunk;
+        (void)yaml_tokenizer_feed(&tok, &doc[pos], n, (pos + n) == length);
+        while ((err = yaml_tokenizer_next(&tok, &token)) == YAML_OK) {
+            if (token.kind == YAML_TOKEN_SCALAR) {
+                hash_token(&token);
+            }
+        }
+    }
+    return (err == YAML_NEED_INPUT) ? 0 : -1;
+}
+
+static void callback_pair(const char *path, const char *value, void *user_data)
+{
+    (void)user_data;
+    hash_pair(path, value);
+}
+
+static int parse_callback(const char *doc, size_t length)
+{
+    return (yaml_parse_string(doc, length) == YAML_OK) ? 0 : -1;
+}
+
+/*===========================================================================*/
+/* Main                                                                       */
+/*===========================================================================*/
+
+/**
+ * @brief Run one case once, returning its hash and pair count
+ */
+static int run_case(int which, uint32_t *hash, uint32_t *pairs)
+{
+    int rc;
+
+    s_hash = FNV_OFFSET;
+    s_pairs = 0;
+    switch (which) {
+        case 0:
+            rc = ref_parse(s_doc, s_doc_len);
+            break;
+        case 1:
+            rc = tokenize(s_doc, s_doc_len, s_doc_len);
+            break;
+        case 2:
+            rc = tokenize(s_doc, s_doc_len, BENCH_CHUNK_SIZE);
+            break;
+        default:
+            rc = parse_callback(s_doc, s_doc_len);
+            break;
+    }
+    *hash = s_hash;
+    *pairs = s_pairs;
+    return rc;
+}
+
+int main(int argc, char **argv)
+{
+    static const char *const labels[] = {
+        "line-copy parser (reference)",
+        "tokenizer, whole buffer",
+        "tokenizer, 512 B chunks",
+        "yaml_parse_string() callback",
+    };
+    uint32_t passes = bench_iterations(argc, argv, BENCH_PASSES);
+    uint32_t ref_hash = 0;
+    uint32_t ref_pairs = 0;
+    uint32_t sink = 0;
+
+    build_doc();
+    (void)yaml_parser_init();
+    (void)yaml_register_callback(callback_pair, NULL);
+
+    for (int c = 0; c < 4; c++) {
+        uint32_t hash = 0;
+        uint32_t pairs = 0;
+        if (run_case(c, &hash, &pairs) != 0) {
+            printf("  %s: parse error\n", labels[c]);
+            return BENCH_FAIL;
+        }
+        if (c == 0) {
+            ref_hash = hash;
+            ref_pairs = pairs;
+        } else if ((hash != ref_hash) || (pairs != ref_pairs)) {
+            printf("  %s: %u pairs hash %08X, reference %u pairs hash %08X\n",
+                   labels[c], pairs, hash, ref_pairs, ref_hash);
+            return BENCH_FAIL;
+        }
+    }
+
+    printf("YAML parsing throughput (%zu B, %u pairs, %u passes)\n", s_doc_len, ref_pairs, passes);
+
+    for (int c = 0; c < 4; c++) {
+        uint32_t hash = 0;
+        uint32_t pairs = 0;
+        uint64_t start = bench_now_ns();
+        for (uint32_t i = 0; i < passes; i++) {
+            (void)run_case(c, &hash, &pairs);
+            sink += hash;
+        }
+        bench_report_throughput(labels[c], (uint64_t)passes * s_doc_len, bench_now_ns() - start);
+    }
+
+    printf("  (checksum %u)\n", sink);
+    return 0;
+}
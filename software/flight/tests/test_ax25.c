@@ -0,0 +1,281 @@
+/**
+ * @file test_ax25.c
+ * @brief Unit tests for the streaming AX.25 encoder
+ *
+ * Checks octet output against the two-step build/serialize path and
+ * round-trips the bit-stuffed / NRZI bit stream through a reference
+ * receiver.
+ *
+ * @requirement SRS-F020 Generate beacon at configurable intervals
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <string.h>
+
+/* Include the module under test */
+#include "ax25.h"
+#include "beacon.h"
+#include "eps_control.h"
+#include "fault_mgmt.h"
+#include "mission_data.h"
+
+/*===========================================================================*/
+/* Test Helpers                                                               */
+/*===========================================================================*/
+
+/** Info field with long runs of ones to exercise bit stuffing */
+static const uint8_t s_info[] = { 0xFF, 0xFF, 0x7E, 0x3F, 0x00, 0xF8, 'O', 'K' };
+
+/**
+ * @brief Encode a fixed UI frame with the given options
+ */
+static SmartQsoResult_t encode_test_frame(uint8_t *buffer, size_t size,
+                                          uint32_t options, size_t *written)
+{
+    Ax25Encoder_t enc;
+    SmartQsoResult_t result = ax25_encoder_begin(&enc, buffer, size, options);
+    if (result != SMART_QSO_OK) {
+        return result;
+    }
+
+    ax25_encoder_put_address(&enc, "CQ", 0, false);
+    ax25_encoder_put_address(&enc, "SQSO-1", 1, true);
+    ax25_encoder_put_u8(&enc, AX25_CTRL_UI);
+    ax25_encoder_put_u8(&enc, AX25_PID_NO_L3);
+    ax25_encoder_put_bytes(&enc, s_info, sizeof(s_info));
+
+    return ax25_encoder_finish(&enc, written);
+}
+
+/**
+ * @brief Reference receiver: NRZI decode, strip flags, remove stuffed zeros
+ *
+ * @return Number of frame octets recovered between the first two flags
+ */
+static size_t receive_bitstream(const uint8_t *stream, size_t nbits, bool nrzi,
+                                uint8_t *out, size_t out_size)
+{
+    uint8_t level = 0;
+    uint8_t shift = 0;
+    uint8_t ones = 0;
+    uint8_t acc = 0;
+    uint8_t acc_bits = 0;
+    size_t out_len = 0;
+    bool in_frame = false;
+
+    for (size_t i = 0; i < nbits; i++) {
+        uint8_t line = (uint8_t)(((unsigned)stream[i / 8U] >> (i % 8U)) & 1U);
+        uint8_t bit = line;
+
+        if (nrzi) {
+            bit = (line == level) ? 1U : 0U;
+            level = line;
+        }
+
+        shift = (uint8_t)((shift >> 1) | (bit << 7));
+
+        if (shift == AX25_FLAG) {
+            if (in_frame && out_len > 0U) {
+                return out_len;
+            }
+            in_frame = true;
+            ones = 0;
+            acc = 0;
+            acc_bits = 0;
+            continue;
+        }
+
+        if (!in_frame) {
+            continue;
+        }
+
+        if (ones == 5U && bit == 0U) {
+            ones = 0;
+            continue;  /* stuffed zero */
+        }
+        ones = (bit != 0U) ? (uint8_t)(ones + 1U) : 0U;
+
+        acc = (uint8_t)((acc >> 1) | (bit << 7));
+        acc_bits++;
+        if (acc_bits == 8U) {
+            if (out_len < out_size) {
+                out[out_len++] = acc;
+            }
+            acc = 0;
+            acc_bits = 0;
+        }
+    }
+
+    return 0;
+}
+
+/*===========================================================================*/
+/* Test Cases                                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief Test octet output layout and FCS
+ */
+static void test_ax25_octet_frame(void **state) {
+    (void)state;
+
+    uint8_t out[64];
+    size_t len = 0;
+
+    assert_int_equal(encode_test_frame(out, sizeof(out), 0, &len), SMART_QSO_OK);
+    assert_int_equal(len, 1U + 14U + 2U + sizeof(s_info) + 2U + 1U);
+
+    uint8_t dest[AX25_ADDR_LEN];
+    ax25_encode_address("CQ", 0, dest, false);
+
+    assert_int_equal(out[0], AX25_FLAG);
+    assert_memory_equal(out + 1, dest, AX25_ADDR_LEN);
+    assert_int_equal(out[15], AX25_CTRL_UI);
+    assert_int_equal(out[16], AX25_PID_NO_L3);
+    assert_memory_equal(out + 17, s_info, sizeof(s_info));
+    assert_int_equal(out[len - 1U], AX25_FLAG);
+
+    /* Receiver check over address..FCS yields the good-frame residue */
+    assert_int_equal(crc16_x25_update(CRC16_X25_INIT, out + 1, len - 2U),
+                     CRC16_X25_RESIDUE);
+}
+
+/**
+ * @brief Test bit-stuffed stream round-trips to the octet frame
+ */
+static void test_ax25_bit_stuffing(void **state) {
+    (void)state;
+
+    uint8_t octets[64];
+    uint8_t stream[AX25_BITSTREAM_MAX_LEN(64U)];
+    uint8_t recovered[64];
+    size_t octet_len = 0;
+    size_t stream_len = 0;
+    Ax25Encoder_t enc;
+
+    assert_int_equal(encode_test_frame(octets, sizeof(octets), 0, &octet_len),
+                     SMART_QSO_OK);
+
+    assert_int_equal(ax25_encoder_begin(&enc, stream, sizeof(stream),
+                                        AX25_OPT_BIT_STUFF), SMART_QSO_OK);
+    ax25_encoder_put_address(&enc, "CQ", 0, false);
+    ax25_encoder_put_address(&enc, "SQSO-1", 1, true);
+    ax25_encoder_put_u8(&enc, AX25_CTRL_UI);
+    ax25_encoder_put_u8(&enc, AX25_PID_NO_L3);
+    ax25_encoder_put_bytes(&enc, s_info, sizeof(s_info));
+    assert_int_equal(ax25_encoder_finish(&enc, &stream_len), SMART_QSO_OK);
+
+    /* Stuffing added bits, and the padded length covers them */
+    assert_true(enc.frame_bits > octet_len * 8U);
+    assert_int_equal(stream_len, (enc.frame_bits + 7U) / 8U);
+
+    size_t n = receive_bitstream(stream, stream_len * 8U, false,
+                                 recovered, sizeof(recovered));
+    assert_int_equal(n, octet_len - 2U);
+    assert_memory_equal(recovered, octets + 1, n);
+}
+
+/**
+ * @brief Test NRZI-encoded stream round-trips to the octet frame
+ */
+static void test_ax25_nrzi(void **state) {
+    (void)state;
+
+    uint8_t octets[64];
+    uint8_t stream[AX25_BITSTREAM_MAX_LEN(64U)];
+    uint8_t recovered[64];
+    size_t octet_len = 0;
+    size_t stream_len = 0;
+
+    assert_int_equal(encode_test_frame(octets, sizeof(octets), 0, &octet_len),
+                     SMART_QSO_OK);
+    assert_int_equal(encode_test_frame(stream, sizeof(stream), AX25_OPT_NRZI,
+                                       &stream_len), SMART_QSO_OK);
+
+    size_t n = receive_bitstream(stream, stream_len * 8U, true,
+                                 recovered, sizeof(recovered));
+    assert_int_equal(n, octet_len - 2U);
+    assert_memory_equal(recovered, octets + 1, n);
+}
+
+/**
+ * @brief Test overflow is reported and in-place reserve is octet-only
+ */
+static void test_ax25_limits(void **state) {
+    (void)state;
+
+    uint8_t out[AX25_BITSTREAM_MAX_LEN(64U)];
+    size_t len = 99;
+    size_t available = 99;
+    Ax25Encoder_t enc;
+
+    assert_int_equal(encode_test_frame(out, 20, 0, &len), SMART_QSO_ERROR_NO_MEM);
+    assert_int_equal(len, 0);
+    assert_int_equal(encode_test_frame(out, 20, AX25_OPT_NRZI, &len),
+                     SMART_QSO_ERROR_NO_MEM);
+
+    assert_int_equal(ax25_encoder_begin(&enc, out, sizeof(out), AX25_OPT_BIT_STUFF),
+                     SMART_QSO_OK);
+    assert_null(ax25_encoder_reserve(&enc, &available));
+    assert_int_equal(available, 0);
+
+    assert_int_equal(ax25_encoder_begin(&enc, out, sizeof(out), 0), SMART_QSO_OK);
+    assert_non_null(ax25_encoder_reserve(&enc, &available));
+    assert_int_equal(available, sizeof(out) - 1U - AX25_TRAILER_LEN);
+
+    assert_int_equal(ax25_encoder_begin(NULL, out, sizeof(out), 0),
+                     SMART_QSO_ERROR_NULL_PTR);
+}
+
+/**
+ * @brief Test single-pass beacon encode matches build + serialize
+ */
+static void test_beacon_encode_matches_serialize(void **state) {
+    (void)state;
+
+    BeaconContent_t content;
+    Ax25Frame_t frame;
+    uint8_t legacy[AX25_MAX_FRAME_LEN];
+    uint8_t direct[AX25_MAX_FRAME_LEN];
+    size_t direct_len = 0;
+
+    (void)fault_mgmt_init();
+    (void)mission_data_init();
+    (void)eps_init();
+    assert_int_equal(beacon_init(), SMART_QSO_OK);
+    assert_int_equal(beacon_generate_content(&content, "Hello from orbit", 16),
+                     SMART_QSO_OK);
+
+    assert_int_equal(beacon_build_ax25_frame(&content, &frame), SMART_QSO_OK);
+    size_t legacy_len = beacon_serialize_ax25(&frame, legacy, sizeof(legacy));
+    assert_true(legacy_len > 0U);
+
+    assert_int_equal(beacon_encode_ax25(&content, direct, sizeof(direct), 0,
+                                        &direct_len), SMART_QSO_OK);
+    assert_int_equal(direct_len, legacy_len);
+    assert_memory_equal(direct, legacy, legacy_len);
+
+    /* Too small for the info field */
+    assert_int_equal(beacon_encode_ax25(&content, direct, 40, 0, &direct_len),
+                     SMART_QSO_ERROR_NO_MEM);
+}
+
+/*===========================================================================*/
+/* Test Suite                                                                 */
+/*===========================================================================*/
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_ax25_octet_frame),
+        cmocka_unit_test(test_ax25_bit_stuffing),
+        cmocka_unit_test(test_ax25_nrzi),
+        cmocka_unit_test(test_ax25_limits),
+        cmocka_unit_test(test_beacon_encode_matches_serialize),
+    };
+
+    return cmocka_run_group_tests_name("AX.25 Encoder Tests", tests, NULL, NULL);
+}
@@ -0,0 +1,582 @@
+/**
+ * @file test_beacon_payload.c
+ * @brief Unit tests for beacon payload rendering
+ *
+ * Checks the cached, integer-only payload renderer against the original
+ * snprintf() format across text changes, field value changes and field
+ * width changes.
+ *
+ * Also covers the binary beacon layout, shared with the ground decoder
+ * test (software/ground/tests/test_beacon_decoder.py), the log-digest
+ * beacon, the text:binary:digest interleave and the airtime planner.
+ *
+ * @requirement SRS-F021 Include telemetry in beacon
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Include the module under test */
+#include "beacon.h"
+#include "crc16.h"
+#include "fault_mgmt.h"
+
+/*===========================================================================*/
+/* Test Helpers                                                               */
+/*===========================================================================*/
+
+/**
+ * @brief Original snprintf-based payload format
+ */
+static size_t reference_format(const BeaconContent_t *content,
+                               char *buffer, size_t buffer_len)
+{
+    int written = snprintf(buffer, buffer_len,
+        "de %s: %s | T=%u M=%s SOC=%u BV=%.1f SUN=%u RF=%u QSO=%u",
+        BEACON_CALLSIGN,
+        content->text,
+        content->telemetry.timestamp,
+        content->telemetry.power_mode == 0 ? "SAFE" :
+            (content->telemetry.power_mode == 1 ? "IDLE" : "ACTIVE"),
+        content->telemetry.soc,
+        content->telemetry.battery_mv / 1000.0,
+        content->telemetry.sunlit,
+        content->telemetry.rf_power,
+        content->telemetry.qso_count);
+
+    if (written < 0 || (size_t)written >= buffer_len) {
+        return 0;
+    }
+    return (size_t)written;
+}
+
+static void set_text(BeaconContent_t *content, const char *text)
+{
+    size_t len = strlen(text);
+    memcpy(content->text, text, len + 1U);
+    content->text_len = len;
+}
+
+static void assert_matches_reference(const BeaconContent_t *content)
+{
+    char expected[BEACON_MAX_PAYLOAD_LEN];
+    char actual[BEACON_MAX_PAYLOAD_LEN];
+
+    size_t expected_len = reference_format(content, expected, sizeof(expected));
+    size_t actual_len = beacon_format_payload(content, actual, sizeof(actual));
+
+    assert_int_equal(actual_len, expected_len);
+    if (expected_len > 0U) {
+        assert_string_equal(actual, expected);
+    }
+}
+
+/**
+ * @brief Generate beacons and count them by format
+ */
+static void count_formats(size_t beacons, uint32_t counts[BEACON_FORMAT_COUNT])
+{
+    BeaconContent_t content;
+
+    memset(counts, 0, BEACON_FORMAT_COUNT * sizeof(counts[0]));
+    for (size_t i = 0; i < beacons; i++) {
+        assert_int_equal(beacon_generate_content(&content, NULL, 0), SMART_QSO_OK);
+        assert_true((uint32_t)content.format < BEACON_FORMAT_COUNT);
+        counts[content.format]++;
+    }
+}
+
+static int setup(void **state)
+{
+    (void)state;
+    if (fault_mgmt_init() != SMART_QSO_OK || fault_log_clear() != SMART_QSO_OK) {
+        return -1;
+    }
+    return (beacon_init() == SMART_QSO_OK) ? 0 : -1;
+}
+
+/*===========================================================================*/
+/* Test Cases                                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief Test first render and repeated renders match snprintf
+ */
+static void test_payload_matches_reference(void **state) {
+    (void)state;
+
+    BeaconContent_t content;
+    memset(&content, 0, sizeof(content));
+    set_text(&content, "Hello from orbit");
+    content.telemetry.timestamp = 1700000000U;
+    content.telemetry.power_mode = 2;
+    content.telemetry.soc = 75;
+    content.telemetry.battery_mv = 7400;
+    content.telemetry.sunlit = 1;
+    content.telemetry.rf_power = 1;
+    content.telemetry.qso_count = 42;
+
+    assert_matches_reference(&content);
+    assert_matches_reference(&content);
+
+    /* Same width: digits patched in place */
+    content.telemetry.timestamp++;
+    content.telemetry.battery_mv = 7312;
+    assert_matches_reference(&content);
+}
+
+/**
+ * @brief Test field width changes re-render the tail
+ */
+static void test_payload_width_changes(void **state) {
+    (void)state;
+
+    BeaconContent_t content;
+    memset(&content, 0, sizeof(content));
+    set_text(&content, "width test");
+
+    static const uint8_t socs[] = { 9, 10, 100, 99, 0, 255 };
+    static const uint8_t modes[] = { 0, 1, 2, 0, 3, 1 };
+    static const uint16_t qsos[] = { 0, 9, 10, 65535, 5, 1000 };
+
+    for (size_t i = 0; i < sizeof(socs); i++) {
+        content.telemetry.soc = socs[i];
+        content.telemetry.power_mode = modes[i];
+        content.telemetry.qso_count = qsos[i];
+        content.telemetry.timestamp = (uint32_t)(i * 999999U);
+        content.telemetry.battery_mv = (uint16_t)(900U + i * 10000U);
+        assert_matches_reference(&content);
+    }
+}
+
+/**
+ * @brief Test text changes rebuild the payload
+ */
+static void test_payload_text_changes(void **state) {
+    (void)state;
+
+    BeaconContent_t content;
+    memset(&content, 0, sizeof(content));
+    content.telemetry.timestamp = 12345;
+
+    set_text(&content, "first");
+    assert_matches_reference(&content);
+    set_text(&content, "second, longer message");
+    assert_matches_reference(&content);
+    set_text(&content, "third!");
+    assert_matches_reference(&content);
+    set_text(&content, "");
+    assert_matches_reference(&content);
+}
+
+/**
+ * @brief Test battery voltage formatting without floating point
+ *
+ * Exact ties (x.x50 V) round half up; snprintf rounds the binary double,
+ * so those values are excluded from the comparison.
+ */
+static void test_payload_battery_voltage(void **state) {
+    (void)state;
+
+    BeaconContent_t content;
+    memset(&content, 0, sizeof(content));
+    set_text(&content, "bv");
+
+    for (uint32_t mv = 0; mv <= 65535U; mv += 7U) {
+        if ((mv % 100U) == 50U) {
+            continue;
+        }
+        content.telemetry.battery_mv = (uint16_t)mv;
+        assert_matches_reference(&content);
+    }
+
+    char out[BEACON_MAX_PAYLOAD_LEN];
+    content.telemetry.battery_mv = 7250;
+    assert_true(beacon_format_payload(&content, out, sizeof(out)) > 0U);
+    assert_non_null(strstr(out, "BV=7.3 "));
+}
+
+/**
+ * @brief Test oversize payloads and small buffers are rejected
+ */
+static void test_payload_limits(void **state) {
+    (void)state;
+
+    BeaconContent_t content;
+    char out[BEACON_MAX_PAYLOAD_LEN];
+    memset(&content, 0, sizeof(content));
+
+    /* Longest text plus maximal fields exceeds the payload limit */
+    memset(content.text, 'A', BEACON_MAX_TEXT_LEN - 1U);
+    content.text[BEACON_MAX_TEXT_LEN - 1U] = '\0';
+    content.telemetry.timestamp = 4294967295U;
+    content.telemetry.power_mode = 2;
+    content.telemetry.soc = 255;
+    content.telemetry.battery_mv = 65535;
+    content.telemetry.qso_count = 65535;
+    assert_matches_reference(&content);
+    assert_int_equal(beacon_format_payload(&content, out, sizeof(out)), 0);
+
+    /* Short text recovers */
+    set_text(&content, "ok");
+    assert_matches_reference(&content);
+
+    /* Buffer smaller than the payload */
+    assert_int_equal(beacon_format_payload(&content, out, 10), 0);
+    assert_int_equal(beacon_format_payload(NULL, out, sizeof(out)), 0);
+}
+
+/**
+ * @brief Test binary beacon layout against the shared golden vector
+ */
+static void test_binary_golden(void **state) {
+    (void)state;
+
+    /* Must match BINARY_GOLDEN in software/ground/tests/test_beacon_decoder.py */
+    static const uint8_t golden[BEACON_BIN_LEN] = {
+        0xB1, 0x00, 0x00, 0x00, 0x2A, 0x65, 0x53, 0xF1, 0x00, 0x02,
+        0x57, 0x1C, 0xF4, 0xFB, 0x17, 0x01, 0x02, 0x04, 0xD2, 0x02,
+        0x37, 0x01, 0x01, 0x83, 0xF2
+    };
+
+    BeaconContent_t content;
+    uint8_t out[BEACON_BIN_LEN];
+    memset(&content, 0, sizeof(content));
+    content.sequence = 42;
+    content.source = BEACON_SOURCE_AI;
+    content.format = BEACON_FORMAT_BINARY;
+    content.telemetry.timestamp = 1700000000U;
+    content.telemetry.power_mode = 2;
+    content.telemetry.soc = 87;
+    content.telemetry.battery_mv = 7412;
+    content.telemetry.temp_obc = -5;
+    content.telemetry.temp_payload = 23;
+    content.telemetry.sunlit = 1;
+    content.telemetry.rf_power = 2;
+    content.telemetry.qso_count = 1234;
+    content.telemetry.orbit_number = 567;
+    content.telemetry.fault_flags = 0x01;
+
+    assert_int_equal(beacon_format_info(&content, out, sizeof(out)), BEACON_BIN_LEN);
+    assert_memory_equal(out, golden, BEACON_BIN_LEN);
+    assert_int_equal(beacon_format_binary(&content, out, BEACON_BIN_LEN - 1U), 0);
+}
+
+/**
+ * @brief Test text:binary:digest interleave ratio
+ */
+static void test_interleave(void **state) {
+    (void)state;
+
+    BeaconContent_t content;
+    BeaconState_t bs;
+
+    /* Default is two text, one binary, one digest */
+    static const BeaconFormat_t defaults[] = {
+        BEACON_FORMAT_TEXT, BEACON_FORMAT_TEXT,
+        BEACON_FORMAT_BINARY, BEACON_FORMAT_DIGEST, BEACON_FORMAT_TEXT
+    };
+    for (size_t i = 0; i < sizeof(defaults) / sizeof(defaults[0]); i++) {
+        assert_int_equal(beacon_generate_content(&content, NULL, 0), SMART_QSO_OK);
+        assert_int_equal(content.format, defaults[i]);
+    }
+
+    /* 3:1 */
+    assert_int_equal(beacon_set_interleave(3, 1, 0), SMART_QSO_OK);
+    static const BeaconFormat_t expected[] = {
+        BEACON_FORMAT_TEXT, BEACON_FORMAT_TEXT, BEACON_FORMAT_TEXT,
+        BEACON_FORMAT_BINARY, BEACON_FORMAT_TEXT
+    };
+    for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+        assert_int_equal(beacon_generate_content(&content, NULL, 0), SMART_QSO_OK);
+        assert_int_equal(content.format, expected[i]);
+    }
+
+    /* Text only */
+    assert_int_equal(beacon_set_interleave(1, 0, 0), SMART_QSO_OK);
+    for (int i = 0; i < 4; i++) {
+        assert_int_equal(beacon_generate_content(&content, NULL, 0), SMART_QSO_OK);
+        assert_int_equal(content.format, BEACON_FORMAT_TEXT);
+    }
+
+    assert_int_equal(beacon_set_interleave(0, 0, 0), SMART_QSO_ERROR_INVALID);
+    assert_int_equal(beacon_get_state(&bs), SMART_QSO_OK);
+    assert_int_equal(bs.text_ratio, 1);
+    assert_int_equal(bs.binary_ratio, 0);
+    assert_int_equal(bs.digest_ratio, 0);
+}
+
+/**
+ * @brief Test a cycle longer than 255 beacons keeps the configured counts
+ */
+static void test_interleave_long_cycle(void **state) {
+    (void)state;
+
+    uint32_t counts[BEACON_FORMAT_COUNT];
+
+    assert_int_equal(beacon_set_interleave(200, 100, 0), SMART_QSO_OK);
+    count_formats(300U, counts);
+    assert_int_equal(counts[BEACON_FORMAT_TEXT], 200);
+    assert_int_equal(counts[BEACON_FORMAT_BINARY], 100);
+    assert_int_equal(counts[BEACON_FORMAT_DIGEST], 0);
+
+    /* The next cycle starts over with text */
+    count_formats(1U, counts);
+    assert_int_equal(counts[BEACON_FORMAT_TEXT], 1);
+
+    /* Longest cycle: the digest share survives positions past 510 */
+    assert_int_equal(beacon_set_interleave(255, 255, 255), SMART_QSO_OK);
+    count_formats(765U, counts);
+    assert_int_equal(counts[BEACON_FORMAT_TEXT], 255);
+    assert_int_equal(counts[BEACON_FORMAT_BINARY], 255);
+    assert_int_equal(counts[BEACON_FORMAT_DIGEST], 255);
+}
+
+/**
+ * @brief Test the log-digest beacon carries the newest faults first
+ */
+static void test_digest(void **state) {
+    (void)state;
+
+    BeaconContent_t content;
+    uint8_t out[BEACON_DIGEST_LEN];
+
+    memset(&content, 0, sizeof(content));
+    content.sequence = 7;
+    content.telemetry.timestamp = 1000;
+
+    /* Empty log: header only, entries zeroed */
+    assert_int_equal(beacon_format_digest(&content, out, sizeof(out)), BEACON_DIGEST_LEN);
+    assert_int_equal(out[0], BEACON_DIGEST_TYPE);
+    assert_int_equal(out[11], 0);
+    for (size_t i = 12; i < BEACON_DIGEST_LEN - 2U; i++) {
+        assert_int_equal(out[i], 0);
+    }
+
+    static const FaultType_t types[] = {
+        FAULT_TYPE_POWER, FAULT_TYPE_THERMAL, FAULT_TYPE_WATCHDOG,
+        FAULT_TYPE_UART, FAULT_TYPE_MODE_CHANGE
+    };
+    for (size_t i = 0; i < sizeof(types) / sizeof(types[0]); i++) {
+        assert_int_equal(fault_log_add(types[i], FAULT_SEVERITY_WARNING, "test", 50.0),
+                         SMART_QSO_OK);
+    }
+    assert_int_equal(fault_log_mark_recovered(4), SMART_QSO_OK);
+
+    content.format = BEACON_FORMAT_DIGEST;
+    assert_int_equal(beacon_format_info(&content, out, sizeof(out)), BEACON_DIGEST_LEN);
+    assert_int_equal(((uint16_t)out[9] << 8) | out[10], 5);
+    assert_int_equal(out[11], BEACON_DIGEST_ENTRIES);
+
+    /* Newest first: MODE_CHANGE (recovered), UART, WATCHDOG, THERMAL */
+    assert_int_equal(out[12], FAULT_TYPE_MODE_CHANGE);
+    assert_int_equal(out[13], FAULT_SEVERITY_WARNING);
+    assert_int_equal(out[14], 1);
+    assert_int_equal(out[19], FAULT_TYPE_UART);
+    assert_int_equal(out[21], 0);
+    assert_int_equal(out[26], FAULT_TYPE_WATCHDOG);
+    assert_int_equal(out[33], FAULT_TYPE_THERMAL);
+
+    assert_int_equal(crc16_x25(out, BEACON_DIGEST_LEN - 2U),
+                     ((uint16_t)out[40] << 8) | out[41]);
+    assert_int_equal(beacon_format_digest(&content, out, BEACON_DIGEST_LEN - 1U), 0);
+}
+
+/**
+ * @brief Test airtime estimate from frame length
+ */
+static void test_airtime(void **state) {
+    (void)state;
+
+    /* 150 bytes = 1200 bits = 1000 ms at 1200 bd */
+    assert_int_equal(beacon_airtime_ms(150),
+                     BEACON_TX_PREAMBLE_MS + 1000U + BEACON_TX_TAIL_MS);
+    /* Partial milliseconds round up */
+    assert_int_equal(beacon_airtime_ms(1),
+                     BEACON_TX_PREAMBLE_MS + 7U + BEACON_TX_TAIL_MS);
+    assert_int_equal(beacon_airtime_ms(0), BEACON_TX_PREAMBLE_MS + BEACON_TX_TAIL_MS);
+}
+
+/**
+ * @brief Test the planner stretches, compresses and defers beacons
+ */
+static void test_airtime_budget(void **state) {
+    (void)state;
+
+    BeaconContent_t content;
+    BeaconState_t bs;
+
+    assert_int_equal(beacon_set_airtime_budget(0, 0), SMART_QSO_ERROR_INVALID);
+    assert_int_equal(beacon_set_airtime_budget(1000, 1001), SMART_QSO_ERROR_INVALID);
+    assert_int_equal(beacon_set_interleave(0, 1, 0), SMART_QSO_OK);
+
+    /* Default 5% budget paces binary beacons at ~18 s */
+    beacon_update_interval(POWER_MODE_ACTIVE);
+    assert_int_equal(beacon_get_state(&bs), SMART_QSO_OK);
+    assert_int_equal(bs.interval_ms, (BEACON_ORBIT_PERIOD_MS / BEACON_DEFAULT_AIRTIME_BUDGET_MS) *
+                     beacon_airtime_ms(1U + 16U + BEACON_BIN_LEN + AX25_TRAILER_LEN));
+
+    /* Plenty of budget: ACTIVE compresses to half the mode interval */
+    assert_int_equal(beacon_set_airtime_budget(BEACON_ORBIT_PERIOD_MS,
+                                               BEACON_ORBIT_PERIOD_MS / 2U), SMART_QSO_OK);
+    assert_int_equal(beacon_get_state(&bs), SMART_QSO_OK);
+    assert_int_equal(bs.interval_ms, BEACON_INTERVAL_ACTIVE_MS / 2U);
+
+    /* ...but SAFE never beacons faster than its mode interval */
+    beacon_update_interval(POWER_MODE_SAFE);
+    assert_int_equal(beacon_get_state(&bs), SMART_QSO_OK);
+    assert_int_equal(bs.interval_ms, BEACON_INTERVAL_SAFE_MS);
+    beacon_update_interval(POWER_MODE_ACTIVE);
+
+    /* Send one binary beacon and check the accounting */
+    assert_int_equal(beacon_generate_content(&content, NULL, 0), SMART_QSO_OK);
+    assert_int_equal(content.format, BEACON_FORMAT_BINARY);
+    assert_int_equal(beacon_transmit(&content), SMART_QSO_OK);
+    beacon_mark_transmitted(1000);
+
+    uint32_t bin_airtime = beacon_airtime_ms(1U + 16U + BEACON_BIN_LEN + AX25_TRAILER_LEN);
+    assert_int_equal(beacon_get_state(&bs), SMART_QSO_OK);
+    assert_int_equal(bs.last_airtime_ms, bin_airtime);
+    assert_int_equal(bs.orbit_airtime_ms, bin_airtime);
+    assert_int_equal(bs.total_airtime_ms, bin_airtime);
+    assert_int_equal(bs.format_airtime_ms[BEACON_FORMAT_BINARY], bin_airtime);
+    assert_int_equal(bs.useful_bytes_tx, BEACON_BIN_LEN);
+
+    /* Tight budget: two more beacons in the 100 s window stretches the interval */
+    assert_int_equal(beacon_set_airtime_budget(100000U, 3U * bin_airtime), SMART_QSO_OK);
+    assert_int_equal(beacon_get_state(&bs), SMART_QSO_OK);
+    assert_int_equal(bs.interval_ms, 99000U / 2U);
+    assert_true(bs.interval_ms > BEACON_INTERVAL_ACTIVE_MS);
+
+    /* Exhausted budget: wait for the next window */
+    assert_int_equal(beacon_set_airtime_budget(100000U, bin_airtime), SMART_QSO_OK);
+    beacon_mark_transmitted(2000);
+    assert_int_equal(beacon_get_state(&bs), SMART_QSO_OK);
+    assert_int_equal(bs.interval_ms, 98000U);
+    assert_int_equal(bs.budget_deferrals, 1);
+
+    /* Text beacons are downgraded while budget is short */
+    assert_int_equal(beacon_set_interleave(1, 0, 0), SMART_QSO_OK);
+    assert_int_equal(beacon_set_airtime_budget(100000U, 2U * bin_airtime), SMART_QSO_OK);
+    assert_int_equal(beacon_generate_content(&content, NULL, 0), SMART_QSO_OK);
+    assert_int_equal(content.format, BEACON_FORMAT_BINARY);
+    assert_int_equal(beacon_get_state(&bs), SMART_QSO_OK);
+    assert_int_equal(bs.budget_deferrals, 2);
+
+    /* New window restores the budget */
+    assert_int_equal(beacon_transmit(&content), SMART_QSO_OK);
+    beacon_mark_transmitted(101000);
+    assert_int_equal(beacon_get_state(&bs), SMART_QSO_OK);
+    assert_int_equal(bs.orbit_start_ms, 101000U);
+    assert_int_equal(bs.orbit_airtime_ms, bin_airtime);
+    assert_int_equal(bs.total_airtime_ms, 2U * bin_airtime);
+}
+
+/**
+ * @brief Test a binary beacon goes out as a compact AX.25 frame
+ */
+static void test_binary_frame(void **state) {
+    (void)state;
+
+    BeaconContent_t content;
+    uint8_t text_frame[AX25_MAX_FRAME_LEN];
+    uint8_t bin_frame[AX25_MAX_FRAME_LEN];
+    size_t text_len = 0;
+    size_t bin_len = 0;
+
+    assert_int_equal(beacon_generate_content(&content, NULL, 0), SMART_QSO_OK);
+    content.format = BEACON_FORMAT_TEXT;
+    assert_int_equal(beacon_encode_ax25(&content, text_frame, sizeof(text_frame),
+                                        0, &text_len), SMART_QSO_OK);
+    content.format = BEACON_FORMAT_BINARY;
+    assert_int_equal(beacon_encode_ax25(&content, bin_frame, sizeof(bin_frame),
+                                        0, &bin_len), SMART_QSO_OK);
+
+    assert_int_equal(bin_len, 1U + 16U + BEACON_BIN_LEN + AX25_TRAILER_LEN);
+    assert_true(bin_len < text_len);
+    assert_int_equal(bin_frame[17], BEACON_BIN_TYPE);
+
+    /* Embedded CRC covers the packed fields */
+    assert_int_equal(crc16_x25(bin_frame + 17, BEACON_BIN_LEN - 2U),
+                     ((uint16_t)bin_frame[17 + 23] << 8) | bin_frame[17 + 24]);
+
+    assert_int_equal(beacon_transmit(&content), SMART_QSO_OK);
+}
+
+/**
+ * @brief Test FX.25 beacons wrap the bit-stuffed AX.25 frame
+ */
+static void test_fx25_beacon(void **state) {
+    (void)state;
+
+    BeaconContent_t content;
+    BeaconState_t bs;
+    uint8_t stream[AX25_BITSTREAM_MAX_LEN(AX25_MAX_FRAME_LEN)];
+    uint8_t tx[FX25_MAX_LEN];
+    size_t stream_len = 0;
+    size_t tx_len = 0;
+
+    assert_int_equal(beacon_generate_content(&content, NULL, 0), SMART_QSO_OK);
+    content.format = BEACON_FORMAT_BINARY;
+
+    assert_int_equal(beacon_encode_ax25(&content, stream, sizeof(stream),
+                                        AX25_OPT_BIT_STUFF, &stream_len), SMART_QSO_OK);
+    assert_int_equal(beacon_encode_fx25(&content, tx, sizeof(tx), &tx_len), SMART_QSO_OK);
+    assert_int_equal(tx_len, FX25_TAG_LEN + 96U);
+
+    /* Flip a byte: the decoded block still starts with the plain frame */
+    tx[FX25_TAG_LEN + 10U] ^= 0xFFU;
+    uint8_t data[FEC_RS_K];
+    size_t data_len = sizeof(data);
+    size_t corrected = 0;
+    assert_int_equal(fx25_decode(tx, tx_len, data, &data_len, &corrected), SMART_QSO_OK);
+    assert_int_equal(corrected, 1);
+    assert_memory_equal(data, stream, stream_len - 1U);
+
+    /* Transmit counts FX.25 beacons; long text falls back to plain AX.25 */
+    beacon_set_fec(true);
+    assert_int_equal(beacon_transmit(&content), SMART_QSO_OK);
+
+    content.format = BEACON_FORMAT_TEXT;
+    memset(content.text, 'A', 150U);
+    content.text[150] = '\0';
+    content.text_len = 150U;
+    assert_int_equal(beacon_encode_fx25(&content, tx, sizeof(tx), &tx_len),
+                     SMART_QSO_ERROR_INVALID);
+    assert_int_equal(beacon_transmit(&content), SMART_QSO_OK);
+
+    assert_int_equal(beacon_get_state(&bs), SMART_QSO_OK);
+    assert_true(bs.fec_enabled);
+    assert_int_equal(bs.fec_beacon_count, 1);
+    assert_int_equal(bs.useful_bytes_tx,
+                     BEACON_BIN_LEN + beacon_format_payload(&content, (char *)data, sizeof(data)));
+}
+
+/*===========================================================================*/
+/* Test Suite                                                                 */
+/*===========================================================================*/
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup(test_payload_matches_reference, setup),
+        cmocka_unit_test_setup(test_payload_width_changes, setup),
+        cmocka_unit_test_setup(test_payload_text_changes, setup),
+        cmocka_unit_test_setup(test_payload_battery_voltage, setup),
+        cmocka_unit_test_setup(test_payload_limits, setup),
+        cmocka_unit_test_setup(test_binary_golden, setup),
+        cmocka_unit_test_setup(test_interleave, setup),
+        cmocka_unit_test_setup(test_interleave_long_cycle, setup),
+        cmocka_unit_test_setup(test_binary_frame, setup),
+        cmocka_unit_test_setup(test_digest, setup),
+        cmocka_unit_test_setup(test_airtime, setup),
+        cmocka_unit_test_setup(test_airtime_budget, setup),
+        cmocka_unit_test_setup(test_fx25_beacon, setup),
+    };
+
+    return cmocka_run_group_tests_name("Beacon Payload Tests", tests, NULL, NULL);
+}
@@ -0,0 +1,172 @@
+/**
+ * @file test_crc16.c
+ * @brief Unit tests for CRC-16/X.25 module
+ *
+ * Tests the AX.25 FCS against the catalogue check value and against
+ * vectors shared with the ground tools (software/ground/tests/test_crc16.py).
+ *
+ * @requirement SRS-DATA-002 System shall protect data integrity with CRC
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <string.h>
+
+/* Include the module under test */
+#include "crc16.h"
+
+/*===========================================================================*/
+/* Shared Conformance Vectors                                                 */
+/*===========================================================================*/
+
+/** Length of the shared pseudo-random vector */
+#define VECTOR_LEN 1024U
+
+/**
+ * @brief Expected FCS over prefixes of the shared vector
+ *
+ * Must match SHARED_VECTORS in software/ground/tests/test_crc16.py.
+ */
+static const struct {
+    size_t len;
+    uint16_t fcs;
+} s_shared_vectors[] = {
+    { 1U,    0x5342U },
+    { 7U,    0xC289U },
+    { 64U,   0xB78BU },
+    { 255U,  0x2C24U },
+    { 1024U, 0x2DFBU },
+};
+
+/**
+ * @brief Generate the shared vector (ANSI C LCG, seed 1, bits 16..23)
+ */
+static void make_shared_vector(uint8_t *out, size_t len)
+{
+    uint32_t x = 1U;
+    for (size_t i = 0; i < len; i++) {
+        x = (x * 1103515245U + 12345U) & 0x7FFFFFFFU;
+        out[i] = (uint8_t)(x >> 16);
+    }
+}
+
+/**
+ * @brief Bitwise reference (the former beacon_crc16 loop)
+ */
+static uint16_t crc16_bitwise(const uint8_t *data, size_t len)
+{
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int j = 0; j < 8; j++) {
+            crc = (crc & 1U) ? (uint16_t)((crc >> 1) ^ 0x8408U) : (uint16_t)(crc >> 1);
+        }
+    }
+    return (uint16_t)(crc ^ 0xFFFFU);
+}
+
+/*===========================================================================*/
+/* Test Cases                                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief Test CRC-16/X.25 with catalogue check value
+ */
+static void test_crc16_known_vector(void **state) {
+    (void)state;
+
+    assert_int_equal(crc16_x25("123456789", 9), CRC16_X25_CHECK);
+}
+
+/**
+ * @brief Test empty and NULL input
+ */
+static void test_crc16_empty(void **state) {
+    (void)state;
+
+    assert_int_equal(crc16_x25("", 0), 0x0000);
+    assert_int_equal(crc16_x25_update(0x1234, NULL, 10), 0x1234);
+}
+
+/**
+ * @brief Test shared cross-language vectors
+ */
+static void test_crc16_shared_vectors(void **state) {
+    (void)state;
+
+    uint8_t data[VECTOR_LEN];
+    make_shared_vector(data, sizeof(data));
+
+    for (size_t i = 0; i < sizeof(s_shared_vectors) / sizeof(s_shared_vectors[0]); i++) {
+        assert_int_equal(crc16_x25(data, s_shared_vectors[i].len),
+                         s_shared_vectors[i].fcs);
+    }
+}
+
+/**
+ * @brief Test table implementation against the bitwise reference
+ */
+static void test_crc16_matches_bitwise(void **state) {
+    (void)state;
+
+    uint8_t data[VECTOR_LEN];
+    make_shared_vector(data, sizeof(data));
+
+    for (size_t len = 0; len <= sizeof(data); len += 13) {
+        assert_int_equal(crc16_x25(data, len), crc16_bitwise(data, len));
+    }
+}
+
+/**
+ * @brief Test incremental calculation matches one-shot
+ */
+static void test_crc16_incremental(void **state) {
+    (void)state;
+
+    const char *test_data = "123456789";
+    Crc16Ctx_t ctx;
+
+    crc16_ctx_init(&ctx);
+    crc16_update(&ctx, test_data, 3);
+    crc16_update_byte(&ctx, (uint8_t)test_data[3]);
+    crc16_update(&ctx, test_data + 4, 0);
+    crc16_update(&ctx, test_data + 4, 5);
+
+    assert_int_equal(crc16_final(&ctx), CRC16_X25_CHECK);
+}
+
+/**
+ * @brief Test receiver-side check: data plus FCS (LSB first) gives residue
+ */
+static void test_crc16_residue(void **state) {
+    (void)state;
+
+    uint8_t frame[11];
+    memcpy(frame, "123456789", 9);
+    uint16_t fcs = crc16_x25(frame, 9);
+    frame[9] = (uint8_t)(fcs & 0xFFU);
+    frame[10] = (uint8_t)(fcs >> 8);
+
+    assert_int_equal(crc16_x25_update(CRC16_X25_INIT, frame, sizeof(frame)),
+                     CRC16_X25_RESIDUE);
+}
+
+/*===========================================================================*/
+/* Test Suite                                                                 */
+/*===========================================================================*/
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_crc16_known_vector),
+        cmocka_unit_test(test_crc16_empty),
+        cmocka_unit_test(test_crc16_shared_vectors),
+        cmocka_unit_test(test_crc16_matches_bitwise),
+        cmocka_unit_test(test_crc16_incremental),
+        cmocka_unit_test(test_crc16_residue),
+    };
+
+    return cmocka_run_group_tests_name("CRC16 Tests", tests, NULL, NULL);
+}
@@ -16,6 +16,7 @@
 
 /* Include the module under test */
 #include "smart_qso.h"
+#include "crc32.h"
 
 /*===========================================================================*/
 /* Test Cases                                                                 */
@@ -164,6 +165,78 @@ static void test_crc32_structure(void **state) {
     assert_true(result);
 }
 
+/**
+ * @brief Test incremental CRC32 matches one-shot calculation
+ */
+static void test_crc32_incremental(void **state) {
+    (void)state;
+
+    const char *test_data = "123456789";
+    uint32_t crc = SMART_QSO_CRC32_INIT;
+
+    crc = smart_qso_crc32_update(crc, test_data, 4);
+    crc = smart_qso_crc32_update(crc, test_data + 4, 0);
+    crc = smart_qso_crc32_update(crc, test_data + 4, 5);
+
+    assert_int_equal(crc ^ 0xFFFFFFFF, 0xCBF43926);
+}
+
+/**
+ * @brief Test every supported engine against the bytewise reference
+ *
+ * Covers odd lengths, unaligned starts and split incremental updates so
+ * the slicing and folding paths hit their tail handling.
+ */
+static void test_crc32_engines_match_reference(void **state) {
+    (void)state;
+
+    static uint8_t data[1100];
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)((i * 131U) ^ (i >> 3));
+    }
+
+    for (int impl = 0; impl < (int)CRC32_IMPL_COUNT; impl++) {
+        if (!crc32_impl_supported((Crc32Impl_t)impl)) {
+            assert_int_equal(crc32_select((Crc32Impl_t)impl),
+                             SMART_QSO_ERROR_INVALID);
+            continue;
+        }
+
+        for (size_t offset = 0; offset < 8; offset++) {
+            for (size_t len = 1; len + offset <= sizeof(data); len += 37) {
+                assert_int_equal(crc32_select(CRC32_IMPL_BYTEWISE), SMART_QSO_OK);
+                uint32_t expected = smart_qso_crc32(data + offset, len);
+
+                assert_int_equal(crc32_select((Crc32Impl_t)impl), SMART_QSO_OK);
+                Crc32Ctx_t ctx;
+                crc32_ctx_init(&ctx);
+                crc32_update(&ctx, data + offset, len / 3);
+                crc32_update(&ctx, data + offset + len / 3, len - len / 3);
+
+                assert_int_equal(crc32_final(&ctx), expected);
+                assert_int_equal(smart_qso_crc32(data + offset, len), expected);
+            }
+        }
+    }
+
+    (void)crc32_init();
+}
+
+/**
+ * @brief Test engine selection
+ */
+static void test_crc32_select(void **state) {
+    (void)state;
+
+    Crc32Impl_t impl = crc32_init();
+    assert_true(crc32_impl_supported(impl));
+    assert_int_equal(crc32_get_impl(), impl);
+    assert_true(crc32_impl_supported(CRC32_IMPL_SLICE8));
+    assert_int_equal(crc32_select(CRC32_IMPL_COUNT), SMART_QSO_ERROR_INVALID);
+    assert_string_equal(crc32_impl_name(CRC32_IMPL_SLICE8), "slice8");
+    assert_string_equal(crc32_impl_name(CRC32_IMPL_COUNT), "unknown");
+}
+
 /*===========================================================================*/
 /* Test Suite                                                                 */
 /*===========================================================================*/
@@ -178,6 +251,9 @@ int main(void) {
         cmocka_unit_test(test_crc32_verify_failure),
         cmocka_unit_test(test_crc32_large_data),
         cmocka_unit_test(test_crc32_structure),
+        cmocka_unit_test(test_crc32_incremental),
+        cmocka_unit_test(test_crc32_engines_match_reference),
+        cmocka_unit_test(test_crc32_select),
     };
 
     return cmocka_run_group_tests_name("CRC32 Tests", tests, NULL, NULL);
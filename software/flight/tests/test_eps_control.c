@@ -27,6 +27,8 @@
 /* Include the module under test */
 #include "smart_qso.h"
 #include "eps_control.h"
+#include "kv_store.h"
+#include "hal/hal_flash.h"
 #include <math.h>
 
 /*===========================================================================*/
@@ -45,8 +47,9 @@
 
 static int setup(void **state) {
     (void)state;
-    /* Remove any existing config file */
-    unlink(EPS_CONFIG_FILE);
+    /* Start from empty persistent storage */
+    (void)hal_flash_init();
+    (void)kv_store_format();
     /* Initialize EPS module */
     SmartQsoResult_t result = eps_init();
     assert_int_equal(result, SMART_QSO_OK);
@@ -56,7 +59,7 @@ static int setup(void **state) {
 static int teardown(void **state) {
     (void)state;
     /* Clean up config file */
-    unlink(EPS_CONFIG_FILE);
+    (void)kv_store_format();
     return 0;
 }
 
@@ -25,6 +25,8 @@
 /* Include the modules under test */
 #include "smart_qso.h"
 #include "fault_mgmt.h"
+#include "kv_store.h"
+#include "hal/hal_flash.h"
 
 /*===========================================================================*/
 /* Test Fixtures                                                              */
@@ -32,9 +34,10 @@
 
 static int setup(void **state) {
     (void)state;
-    /* Clean up any existing fault log file first */
-    unlink(FAULT_LOG_FILE);
-    /* Initialize fault management - this will try to load but file is gone */
+    /* Start from empty persistent storage */
+    (void)hal_flash_init();
+    (void)kv_store_format();
+    /* Initialize fault management - nothing to load */
     SmartQsoResult_t result = fault_mgmt_init();
     assert_int_equal(result, SMART_QSO_OK);
     /* Clear any loaded state to ensure clean slate for each test */
@@ -44,7 +47,7 @@ static int setup(void **state) {
 
 static int teardown(void **state) {
     (void)state;
-    unlink(FAULT_LOG_FILE);
+    (void)kv_store_format();
     return 0;
 }
 
@@ -319,7 +322,7 @@ static void test_fault_log_get_entry(void **state) {
 /**
  * @brief Test fault log persistence
  *
- * Note: fault_log_clear() removes the persistence file, so we test
+ * Note: fault_log_clear() deletes the persisted entries, so we test
  * save and load without clearing in between.
  *
  * @requirement SRS-F041 Maintain fault log in NVM
@@ -347,6 +350,56 @@ static void test_fault_persistence(void **state) {
     assert_int_equal(count_after, count_before);
 }
 
+/**
+ * @brief Test a flush writes only queued entries and the ring survives a reset
+ *
+ * @requirement SRS-F041 Maintain fault log in NVM
+ */
+static void test_fault_persist_incremental(void **state) {
+    (void)state;
+    KvStats_t before;
+    KvStats_t after;
+    char desc[SMART_QSO_FAULT_DESC_LEN];
+
+    /* Wrap the ring */
+    for (size_t i = 0; i < SMART_QSO_MAX_FAULT_ENTRIES + 5U; i++) {
+        (void)snprintf(desc, sizeof(desc), "Fault %zu", i);
+        fault_log_add(FAULT_TYPE_UART, FAULT_SEVERITY_INFO, desc, 0.5);
+    }
+
+    assert_int_equal(fault_log_flush(), SMART_QSO_OK);
+
+    /* Adding a fault only queues it; the flush writes that entry and the index */
+    kv_store_get_stats(&before);
+    fault_log_add(FAULT_TYPE_POWER, FAULT_SEVERITY_ERROR, "Newest", 0.4);
+    kv_store_get_stats(&after);
+    assert_int_equal(after.puts, before.puts);
+    assert_int_equal(fault_log_flush(), SMART_QSO_OK);
+    kv_store_get_stats(&after);
+    assert_int_equal(after.puts - before.puts, 2);
+    if (after.compactions == before.compactions) {
+        assert_true((after.bytes_written - before.bytes_written) <
+                    2U * KV_RECORD_SIZE(sizeof(FaultLogEntry_t)));
+    }
+
+    /* Reboot: oldest-first order is preserved across the wrap */
+    assert_int_equal(fault_mgmt_init(), SMART_QSO_OK);
+    assert_int_equal(fault_log_get_count(), SMART_QSO_MAX_FAULT_ENTRIES);
+
+    FaultLogEntry_t entry;
+    assert_int_equal(fault_log_get_entry(0, &entry), SMART_QSO_OK);
+    assert_string_equal(entry.description, "Fault 6");
+    assert_int_equal(fault_log_get_last(&entry), SMART_QSO_OK);
+    assert_string_equal(entry.description, "Newest");
+
+    /* Recovery marks persist */
+    assert_int_equal(fault_log_mark_recovered(0), SMART_QSO_OK);
+    assert_int_equal(fault_log_flush(), SMART_QSO_OK);
+    assert_int_equal(fault_mgmt_init(), SMART_QSO_OK);
+    assert_int_equal(fault_log_get_entry(0, &entry), SMART_QSO_OK);
+    assert_true(entry.recovered);
+}
+
 /*===========================================================================*/
 /* Test Cases: Fault Types                                                    */
 /*===========================================================================*/
@@ -439,6 +492,7 @@ int main(void) {
 
         /* Persistence tests */
         cmocka_unit_test_setup_teardown(test_fault_persistence, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_fault_persist_incremental, setup, teardown),
 
         /* Fault type tests */
         cmocka_unit_test_setup_teardown(test_fault_all_types, setup, teardown),
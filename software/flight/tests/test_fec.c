@@ -0,0 +1,323 @@
+/**
+ * @file test_fec.c
+ * @brief Unit tests for Reed-Solomon FEC, FX.25 and telemetry coding
+ *
+ * Check bytes are compared against vectors shared with the ground
+ * decoder (software/ground/tests/test_fec.py); correction is exercised
+ * with pseudo-random error patterns up to and beyond the code's limit.
+ *
+ * @requirement SRS-DATA-002 System shall protect data integrity with CRC
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <string.h>
+
+/* Include the module under test */
+#include "fec.h"
+#include "ax25.h"
+
+/*===========================================================================*/
+/* Shared Conformance Vectors                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief Check bytes of the shared vector (full and 32-byte shortened)
+ *
+ * Must match SHARED_PARITY in software/ground/tests/test_fec.py.
+ */
+static const uint8_t s_parity_223[FEC_RS_PARITY] = {
+    0x21, 0xBB, 0xEA, 0x23, 0xBE, 0x45, 0x55, 0xAA,
+    0x60, 0x41, 0x45, 0xA2, 0xD8, 0x45, 0x7D, 0x56,
+    0x1F, 0x6E, 0x10, 0x6A, 0x2E, 0x4D, 0xCE, 0xA3,
+    0x4C, 0xE5, 0x17, 0x3B, 0x06, 0x56, 0x76, 0x61
+};
+
+static const uint8_t s_parity_32[FEC_RS_PARITY] = {
+    0xAD, 0x26, 0x6C, 0xC9, 0x15, 0xFE, 0x88, 0xA7,
+    0x23, 0xC2, 0x50, 0xA5, 0xD1, 0xD6, 0x34, 0x9F,
+    0x57, 0x13, 0xA9, 0xCF, 0x84, 0x9A, 0x1D, 0x8B,
+    0x57, 0x45, 0xEF, 0xD2, 0x63, 0xA2, 0x97, 0x11
+};
+
+/**
+ * @brief Generate the shared vector (ANSI C LCG, seed 1, bits 16..23)
+ */
+static void make_shared_vector(uint8_t *out, size_t len)
+{
+    uint32_t x = 1U;
+    for (size_t i = 0; i < len; i++) {
+        x = (x * 1103515245U + 12345U) & 0x7FFFFFFFU;
+        out[i] = (uint8_t)(x >> 16);
+    }
+}
+
+/** Error pattern generator state */
+static uint32_t s_rng = 12345U;
+
+static uint32_t next_rand(void)
+{
+    s_rng = (s_rng * 1103515245U + 12345U) & 0x7FFFFFFFU;
+    return s_rng >> 8;
+}
+
+/**
+ * @brief Corrupt count distinct bytes of a block with non-zero errors
+ */
+static void corrupt(uint8_t *block, size_t len, size_t count)
+{
+    bool hit[FEC_RS_N];
+    memset(hit, 0, sizeof(hit));
+
+    for (size_t i = 0; i < count; i++) {
+        size_t pos;
+        do {
+            pos = next_rand() % len;
+        } while (hit[pos]);
+        hit[pos] = true;
+        block[pos] ^= (uint8_t)(1U + (next_rand() % 255U));
+    }
+}
+
+/*===========================================================================*/
+/* Test Cases                                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief Test check bytes against the shared vectors
+ */
+static void test_rs_shared_vectors(void **state) {
+    (void)state;
+
+    uint8_t data[FEC_RS_K];
+    uint8_t parity[FEC_RS_PARITY];
+    make_shared_vector(data, sizeof(data));
+
+    assert_int_equal(fec_rs_encode(data, FEC_RS_K, parity), SMART_QSO_OK);
+    assert_memory_equal(parity, s_parity_223, FEC_RS_PARITY);
+
+    assert_int_equal(fec_rs_encode(data, 32U, parity), SMART_QSO_OK);
+    assert_memory_equal(parity, s_parity_32, FEC_RS_PARITY);
+}
+
+/**
+ * @brief Test argument checking
+ */
+static void test_rs_invalid(void **state) {
+    (void)state;
+
+    uint8_t block[FEC_RS_N] = {0};
+
+    assert_int_equal(fec_rs_encode(NULL, 1U, block), SMART_QSO_ERROR_NULL_PTR);
+    assert_int_equal(fec_rs_encode(block, 0U, block), SMART_QSO_ERROR_INVALID);
+    assert_int_equal(fec_rs_encode(block, FEC_RS_K + 1U, block), SMART_QSO_ERROR_INVALID);
+    assert_int_equal(fec_rs_decode(NULL, FEC_RS_N, NULL), SMART_QSO_ERROR_NULL_PTR);
+    assert_int_equal(fec_rs_decode(block, FEC_RS_PARITY, NULL), SMART_QSO_ERROR_INVALID);
+    assert_int_equal(fec_rs_decode(block, FEC_RS_N + 1U, NULL), SMART_QSO_ERROR_INVALID);
+}
+
+/**
+ * @brief Test correction of up to 16 errors in full and shortened codewords
+ */
+static void test_rs_corrects(void **state) {
+    (void)state;
+
+    static const size_t lengths[] = { 1U, 32U, 100U, FEC_RS_K };
+    uint8_t data[FEC_RS_K];
+    uint8_t block[FEC_RS_N];
+    make_shared_vector(data, sizeof(data));
+
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+        size_t k = lengths[l];
+        size_t n = k + FEC_RS_PARITY;
+
+        for (size_t errors = 0; errors <= FEC_RS_MAX_CORRECT; errors++) {
+            memcpy(block, data, k);
+            assert_int_equal(fec_rs_encode(block, k, block + k), SMART_QSO_OK);
+            corrupt(block, n, errors);
+
+            size_t corrected = 99U;
+            assert_int_equal(fec_rs_decode(block, n, &corrected), SMART_QSO_OK);
+            assert_int_equal(corrected, errors);
+            assert_memory_equal(block, data, k);
+        }
+    }
+}
+
+/**
+ * @brief Test more than 16 errors is reported, not miscorrected
+ */
+static void test_rs_uncorrectable(void **state) {
+    (void)state;
+
+    uint8_t data[FEC_RS_K];
+    uint8_t block[FEC_RS_N];
+    make_shared_vector(data, sizeof(data));
+
+    for (int trial = 0; trial < 20; trial++) {
+        memcpy(block, data, FEC_RS_K);
+        assert_int_equal(fec_rs_encode(block, FEC_RS_K, block + FEC_RS_K), SMART_QSO_OK);
+        corrupt(block, FEC_RS_N, FEC_RS_MAX_CORRECT + 1U);
+
+        assert_int_equal(fec_rs_decode(block, FEC_RS_N, NULL), SMART_QSO_ERROR);
+    }
+}
+
+/**
+ * @brief Test FX.25 picks the shortest codeword and survives errors
+ */
+static void test_fx25_roundtrip(void **state) {
+    (void)state;
+
+    static const struct {
+        size_t info_len;
+        size_t codeword;
+    } cases[] = {
+        { 1U, 64U }, { 30U, 96U }, { 80U, 160U }, { 180U, 255U }
+    };
+    uint8_t info[200];
+    make_shared_vector(info, sizeof(info));
+
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        uint8_t stream[AX25_BITSTREAM_MAX_LEN(AX25_MAX_FRAME_LEN)];
+        Ax25Encoder_t enc;
+        size_t stream_len = 0;
+
+        assert_int_equal(ax25_encoder_begin(&enc, stream, sizeof(stream),
+                                            AX25_OPT_BIT_STUFF), SMART_QSO_OK);
+        ax25_encoder_put_address(&enc, "CQ", 0, false);
+        ax25_encoder_put_address(&enc, "SQSO", 1, true);
+        ax25_encoder_put_u8(&enc, AX25_CTRL_UI);
+        ax25_encoder_put_u8(&enc, AX25_PID_NO_L3);
+        ax25_encoder_put_bytes(&enc, info, cases[c].info_len);
+        assert_int_equal(ax25_encoder_finish(&enc, &stream_len), SMART_QSO_OK);
+
+        uint8_t tx[FX25_MAX_LEN];
+        size_t tx_len = 0;
+        assert_int_equal(fx25_encode(stream, enc.frame_bits, tx, sizeof(tx), &tx_len),
+                         SMART_QSO_OK);
+        assert_int_equal(tx_len, FX25_TAG_LEN + cases[c].codeword);
+
+        /* Unaware receivers still find the frame verbatim after the tag */
+        assert_memory_equal(tx + FX25_TAG_LEN, stream, enc.frame_bits / 8U);
+
+        /* Damage the tag a little and the codeword as much as allowed */
+        tx[0] ^= 0x81U;
+        corrupt(tx + FX25_TAG_LEN, cases[c].codeword, FEC_RS_MAX_CORRECT);
+
+        uint8_t data[FEC_RS_K];
+        size_t data_len = sizeof(data);
+        size_t corrected = 0;
+        assert_int_equal(fx25_decode(tx, tx_len, data, &data_len, &corrected),
+                         SMART_QSO_OK);
+        assert_int_equal(data_len, cases[c].codeword - FEC_RS_PARITY);
+        assert_int_equal(corrected, FEC_RS_MAX_CORRECT);
+        assert_memory_equal(data, stream, enc.frame_bits / 8U);
+    }
+}
+
+/**
+ * @brief Test FX.25 padding continues the idle flag pattern
+ */
+static void test_fx25_padding(void **state) {
+    (void)state;
+
+    /* 12 bits: opening flag and half an octet */
+    const uint8_t stream[2] = { AX25_FLAG, 0x05U };
+    uint8_t tx[FX25_MAX_LEN];
+    size_t tx_len = 0;
+
+    assert_int_equal(fx25_encode(stream, 12U, tx, sizeof(tx), &tx_len), SMART_QSO_OK);
+
+    /* Bits 12..15 are flag bits 0..3 (0,1,1,1); then flag bits 4..7, 0..3 */
+    assert_int_equal(tx[FX25_TAG_LEN], AX25_FLAG);
+    assert_int_equal(tx[FX25_TAG_LEN + 1U], 0xE5U);
+    assert_int_equal(tx[FX25_TAG_LEN + 2U], 0xE7U);
+
+    assert_int_equal(fx25_encode(stream, 0U, tx, sizeof(tx), &tx_len),
+                     SMART_QSO_ERROR_INVALID);
+    assert_int_equal(fx25_encode(stream, 12U, tx, 70U, &tx_len), SMART_QSO_ERROR_NO_MEM);
+}
+
+/**
+ * @brief Test unknown tags are rejected
+ */
+static void test_fx25_bad_tag(void **state) {
+    (void)state;
+
+    uint8_t rx[FX25_MAX_LEN];
+    uint8_t data[FEC_RS_K];
+    size_t data_len = sizeof(data);
+    memset(rx, 0x55, sizeof(rx));
+
+    assert_int_equal(fx25_decode(rx, sizeof(rx), data, &data_len, NULL),
+                     SMART_QSO_ERROR_INVALID);
+    assert_int_equal(fx25_decode(rx, 4U, data, &data_len, NULL),
+                     SMART_QSO_ERROR_INVALID);
+}
+
+/**
+ * @brief Test telemetry frames split into codewords and decode back
+ */
+static void test_tlm_roundtrip(void **state) {
+    (void)state;
+
+    static const size_t lengths[] = { 5U, 18U, 227U, 228U, 256U };
+    uint8_t frame[256];
+    make_shared_vector(frame, sizeof(frame));
+
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+        size_t len = lengths[l];
+        uint8_t coded[FEC_TLM_CODED_LEN(256U)];
+        size_t coded_len = 0;
+
+        assert_int_equal(fec_tlm_encode(frame, len, coded, sizeof(coded), &coded_len),
+                         SMART_QSO_OK);
+        assert_int_equal(coded_len, FEC_TLM_CODED_LEN(len));
+        assert_memory_equal(coded, frame, FEC_TLM_SYNC_LEN);
+
+        /* A burst inside the first codeword */
+        size_t burst = (len < 20U) ? 1U : 8U;
+        for (size_t i = 0; i < burst; i++) {
+            coded[FEC_TLM_SYNC_LEN + i] ^= 0xFFU;
+        }
+
+        uint8_t out[256];
+        size_t out_len = sizeof(out);
+        size_t corrected = 0;
+        assert_int_equal(fec_tlm_decode(coded, coded_len, out, &out_len, &corrected),
+                         SMART_QSO_OK);
+        assert_int_equal(out_len, len);
+        assert_int_equal(corrected, burst);
+        assert_memory_equal(out, frame, len);
+    }
+
+    uint8_t coded[FEC_TLM_CODED_LEN(256U)];
+    size_t coded_len = 0;
+    assert_int_equal(fec_tlm_encode(frame, FEC_TLM_SYNC_LEN, coded, sizeof(coded), &coded_len),
+                     SMART_QSO_ERROR_INVALID);
+    assert_int_equal(fec_tlm_encode(frame, 256U, coded, 300U, &coded_len),
+                     SMART_QSO_ERROR_NO_MEM);
+}
+
+/*===========================================================================*/
+/* Test Suite                                                                 */
+/*===========================================================================*/
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_rs_shared_vectors),
+        cmocka_unit_test(test_rs_invalid),
+        cmocka_unit_test(test_rs_corrects),
+        cmocka_unit_test(test_rs_uncorrectable),
+        cmocka_unit_test(test_fx25_roundtrip),
+        cmocka_unit_test(test_fx25_padding),
+        cmocka_unit_test(test_fx25_bad_tag),
+        cmocka_unit_test(test_tlm_roundtrip),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
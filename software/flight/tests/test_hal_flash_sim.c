@@ -0,0 +1,422 @@
+/**
+ * @file test_hal_flash_sim.c
+ * @brief Unit tests for the simulated flash device and power-loss torture
+ *
+ * @requirement SRS-Q022 Software shall support simulation and flight builds
+ * @requirement SRS-F060 Persist mission data to non-volatile memory
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Include the module under test */
+#include "hal/hal.h"
+#include "kv_store.h"
+
+/** Backing file for the mmap tests */
+#define TEST_IMAGE_FILE     "/tmp/smart_qso_flash_sim_test.img"
+
+/** Power cuts in the torture test */
+#define TORTURE_CUTS        150U
+
+/** Power cuts in the key-value store torture test */
+#define KV_TORTURE_CUTS     150U
+
+/** Keys the key-value store torture test overwrites */
+#define KV_TORTURE_KEYS     8U
+
+/*===========================================================================*/
+/* Test Fixtures                                                              */
+/*===========================================================================*/
+
+/**
+ * @brief Setup function - default device, detached and unworn
+ */
+static int setup(void **state)
+{
+    (void)state;
+    (void)hal_deinit();
+    hal_flash_sim_set_endurance(0U);
+    if (hal_flash_sim_configure(NULL) != SMART_QSO_OK) {
+        return -1;
+    }
+    return (hal_flash_phys_init() == SMART_QSO_OK) ? 0 : -1;
+}
+
+static HalFlashSimStats_t get_sim_stats(void)
+{
+    HalFlashSimStats_t stats;
+    assert_int_equal(hal_flash_sim_get_stats(&stats), SMART_QSO_OK);
+    return stats;
+}
+
+/** Deterministic pseudo-random numbers for the torture test */
+static uint32_t s_rng = 12345U;
+
+static uint32_t next_random(void)
+{
+    s_rng = (s_rng * 1664525U) + 1013904223U;
+    return s_rng >> 8;
+}
+
+/*===========================================================================*/
+/* Device Model Tests                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief Test programming only clears bits unless the rules are relaxed
+ */
+static void test_sim_program_rules(void **state)
+{
+    (void)state;
+    const uint8_t first[4] = { 0xF0U, 0x0FU, 0xAAU, 0xFFU };
+    const uint8_t second[4] = { 0x30U, 0xFFU, 0x0AU, 0x00U };
+    uint8_t cells[4];
+
+    assert_int_equal(hal_flash_phys_program(3U, 0U, first, sizeof(first)), SMART_QSO_OK);
+
+    /* Clearing more bits is fine */
+    assert_int_equal(hal_flash_phys_program(3U, 2U, &second[2], 2U), SMART_QSO_OK);
+    assert_int_equal(get_sim_stats().program_violations, 0);
+
+    /* Setting one is not; the cells keep old AND new */
+    assert_int_equal(hal_flash_phys_program(3U, 0U, second, 2U), SMART_QSO_ERROR_INVALID);
+    assert_int_equal(hal_flash_phys_read(3U, 0U, cells, sizeof(cells)), SMART_QSO_OK);
+    assert_int_equal(cells[0], 0x30U);
+    assert_int_equal(cells[1], 0x0FU);
+    assert_int_equal(cells[2], 0x0AU);
+    assert_int_equal(cells[3], 0x00U);
+    assert_int_equal(get_sim_stats().program_violations, 1);
+
+    /* Only an erase sets bits */
+    assert_int_equal(hal_flash_phys_erase(3U), SMART_QSO_OK);
+    assert_int_equal(hal_flash_phys_program(3U, 0U, second, sizeof(second)), SMART_QSO_OK);
+
+    /* Relaxed rules overwrite, but still count the violation */
+    HalFlashSimConfig_t config;
+    hal_flash_sim_default_config(&config);
+    config.enforce_program_rules = false;
+    assert_int_equal(hal_flash_sim_configure(&config), SMART_QSO_OK);
+    assert_int_equal(hal_flash_phys_init(), SMART_QSO_OK);
+    assert_int_equal(hal_flash_phys_program(3U, 0U, first, sizeof(first)), SMART_QSO_OK);
+    assert_int_equal(hal_flash_phys_program(3U, 0U, second, sizeof(second)), SMART_QSO_OK);
+    assert_int_equal(hal_flash_phys_read(3U, 0U, cells, sizeof(cells)), SMART_QSO_OK);
+    assert_memory_equal(cells, second, sizeof(second));
+    assert_int_equal(get_sim_stats().program_violations, 1);
+}
+
+/**
+ * @brief Test page geometry, operation timing and the busy state
+ */
+static void test_sim_timing(void **state)
+{
+    (void)state;
+    HalFlashSimConfig_t config;
+    uint8_t data[100];
+
+    hal_flash_sim_default_config(&config);
+    config.page_size = 100U;
+    assert_int_equal(hal_flash_sim_configure(&config), SMART_QSO_ERROR_PARAM);
+    config.page_size = 0U;
+    assert_int_equal(hal_flash_sim_configure(&config), SMART_QSO_ERROR_PARAM);
+
+    config.page_size = 64U;
+    config.erase_time_us = 1000U;
+    config.page_program_time_us = 100U;
+    assert_int_equal(hal_flash_sim_configure(&config), SMART_QSO_OK);
+    assert_int_equal(hal_flash_phys_init(), SMART_QSO_OK);
+
+    /* Bytes 60..159 touch pages 0, 1 and 2 */
+    memset(data, 0x5AU, sizeof(data));
+    assert_int_equal(hal_flash_phys_program(0U, 60U, data, sizeof(data)), SMART_QSO_OK);
+    assert_int_equal(hal_flash_phys_erase(1U), SMART_QSO_OK);
+
+    HalFlashSimStats_t stats = get_sim_stats();
+    assert_int_equal(stats.page_programs, 3);
+    assert_int_equal(stats.erases, 1);
+    assert_int_equal(stats.busy_time_us, 1300U);
+
+    /* Only charged, not waited for, unless real-time */
+    assert_false(hal_flash_busy());
+
+    config.realtime = true;
+    config.erase_time_us = 5000U;
+    assert_int_equal(hal_flash_sim_configure(&config), SMART_QSO_OK);
+    assert_int_equal(hal_flash_phys_init(), SMART_QSO_OK);
+
+    assert_int_equal(hal_timer_init(), SMART_QSO_OK);
+    uint64_t start = hal_timer_get_us();
+    assert_int_equal(hal_flash_phys_erase(2U), SMART_QSO_OK);
+    assert_true(hal_flash_busy());
+
+    /* The next operation waits for the erase to finish */
+    assert_int_equal(hal_flash_phys_read(2U, 0U, data, 1U), SMART_QSO_OK);
+    assert_true((hal_timer_get_us() - start) >= 5000U);
+    assert_false(hal_flash_busy());
+}
+
+/**
+ * @brief Test a power cut tears the operation and takes the device down
+ */
+static void test_sim_power_loss(void **state)
+{
+    (void)state;
+    uint8_t data[HAL_FLASH_SECTOR_SIZE];
+    uint8_t cells[HAL_FLASH_SECTOR_SIZE];
+
+    memset(data, 0x00U, sizeof(data));
+    hal_flash_sim_power_loss_after(1U);
+    assert_int_equal(hal_flash_phys_program(5U, 0U, data, 8U), SMART_QSO_OK);
+    assert_int_equal(hal_flash_phys_program(6U, 0U, data, sizeof(data)), SMART_QSO_ERROR);
+    assert_false(hal_flash_sim_powered());
+    assert_int_equal(get_sim_stats().power_losses, 1);
+
+    /* Nothing works until power-up */
+    assert_int_equal(hal_flash_phys_read(6U, 0U, cells, sizeof(cells)), SMART_QSO_ERROR);
+    assert_int_equal(hal_flash_phys_erase(6U), SMART_QSO_ERROR);
+    assert_int_equal(hal_flash_phys_init(), SMART_QSO_OK);
+    assert_true(hal_flash_sim_powered());
+
+    /* The torn program reached a prefix of the sector */
+    assert_int_equal(hal_flash_phys_read(6U, 0U, cells, sizeof(cells)), SMART_QSO_OK);
+    size_t reached = 0;
+    while ((reached < sizeof(cells)) && (cells[reached] == 0x00U)) {
+        reached++;
+    }
+    assert_true(reached < sizeof(cells));
+    for (size_t i = reached; i < sizeof(cells); i++) {
+        assert_int_equal(cells[i], 0xFFU);
+    }
+
+    /* A cancelled cut never fires */
+    hal_flash_sim_power_loss_after(2U);
+    hal_flash_sim_power_loss_after(0U);
+    for (uint32_t b = 10U; b < 14U; b++) {
+        assert_int_equal(hal_flash_phys_erase(b), SMART_QSO_OK);
+    }
+    assert_true(hal_flash_sim_powered());
+}
+
+/**
+ * @brief Test a file-backed device keeps its contents and wear
+ */
+static void test_sim_backing_file(void **state)
+{
+    (void)state;
+    HalFlashSimConfig_t config;
+    uint8_t out[40];
+    uint8_t in[40];
+
+    (void)remove(TEST_IMAGE_FILE);
+    hal_flash_sim_default_config(&config);
+    config.backing_file = TEST_IMAGE_FILE;
+    assert_int_equal(hal_flash_sim_configure(&config), SMART_QSO_OK);
+    assert_int_equal(hal_flash_init(), SMART_QSO_OK);
+
+    memset(out, 0x3CU, sizeof(out));
+    assert_int_equal(hal_flash_erase(FLASH_REGION_BACKUP), SMART_QSO_OK);
+    assert_int_equal(hal_flash_write(FLASH_REGION_BACKUP, 250U, out, sizeof(out)), SMART_QSO_OK);
+    HalFlashWearStats_t before;
+    assert_int_equal(hal_flash_get_wear_stats(&before), SMART_QSO_OK);
+
+    /* Process restart: detach and map the file again */
+    (void)hal_deinit();
+    assert_int_equal(hal_flash_sim_configure(&config), SMART_QSO_OK);
+    assert_int_equal(hal_flash_init(), SMART_QSO_OK);
+    assert_int_equal(hal_flash_read(FLASH_REGION_BACKUP, 250U, in, sizeof(in)), SMART_QSO_OK);
+    assert_memory_equal(in, out, sizeof(out));
+
+    HalFlashWearStats_t after;
+    assert_int_equal(hal_flash_get_wear_stats(&after), SMART_QSO_OK);
+    assert_int_equal(after.total_erases, before.total_erases);
+
+    (void)hal_deinit();
+    (void)remove(TEST_IMAGE_FILE);
+}
+
+/*===========================================================================*/
+/* Torture Tests                                                              */
+/*===========================================================================*/
+
+/**
+ * @brief Test the wear-leveling layer survives power cuts at random points
+ *
+ * Repeatedly erases and refills the fault log region while power is cut
+ * after a random number of device operations, then powers up and checks
+ * nothing outside the interrupted region changed and no block was lost.
+ */
+static void test_sim_torture_wear_leveling(void **state)
+{
+    (void)state;
+    uint8_t cold[HAL_FLASH_SECTOR_SIZE * 2U];
+    uint8_t check[HAL_FLASH_SECTOR_SIZE * 2U];
+    uint8_t sector[HAL_FLASH_SECTOR_SIZE];
+    const size_t hot_size = hal_flash_region_size(FLASH_REGION_FAULT_LOG);
+
+    assert_int_equal(hal_flash_init(), SMART_QSO_OK);
+    for (size_t i = 0; i < sizeof(cold); i++) {
+        cold[i] = (uint8_t)(i ^ 0xA5U);
+    }
+    assert_int_equal(hal_flash_write(FLASH_REGION_MISSION_DATA, 0U, cold, sizeof(cold)),
+                     SMART_QSO_OK);
+
+    for (uint32_t cut = 0; cut < TORTURE_CUTS; cut++) {
+        hal_flash_sim_power_loss_after(1U + (next_random() % 120U));
+
+        /* Erase and refill the hot region until the power goes */
+        for (uint32_t cycle = 0; hal_flash_sim_powered(); cycle++) {
+            if (hal_flash_erase(FLASH_REGION_FAULT_LOG) != SMART_QSO_OK) {
+                break;
+            }
+            memset(sector, (int)(cycle & 0x7FU), sizeof(sector));
+            for (size_t offset = 0; offset < hot_size; offset += sizeof(sector)) {
+                if (hal_flash_write(FLASH_REGION_FAULT_LOG, (uint32_t)offset, sector,
+                                    sizeof(sector)) != SMART_QSO_OK) {
+                    break;
+                }
+            }
+        }
+
+        /* Power-up */
+        assert_int_equal(hal_flash_init(), SMART_QSO_OK);
+
+        HalFlashWearStats_t wear;
+        assert_int_equal(hal_flash_get_wear_stats(&wear), SMART_QSO_OK);
+        assert_int_equal(wear.lost_blocks, 0);
+        assert_int_equal(wear.retired_blocks, 0);
+        assert_int_equal(wear.free_blocks, HAL_FLASH_SPARE_BLOCKS);
+
+        assert_int_equal(hal_flash_read(FLASH_REGION_MISSION_DATA, 0U, check, sizeof(check)),
+                         SMART_QSO_OK);
+        assert_memory_equal(check, cold, sizeof(cold));
+        for (size_t offset = 0; offset < hot_size; offset += sizeof(sector)) {
+            assert_int_equal(hal_flash_read(FLASH_REGION_FAULT_LOG, (uint32_t)offset, sector,
+                                            sizeof(sector)), SMART_QSO_OK);
+        }
+    }
+
+    /* The layer never programs cells that are not erased */
+    HalFlashSimStats_t stats = get_sim_stats();
+    assert_int_equal(stats.power_losses, TORTURE_CUTS);
+    assert_int_equal(stats.program_violations, 0);
+}
+
+/**
+ * @brief Fill a torture value: its sequence number, then a pattern
+ *
+ * @return Value length, 4..KV_MAX_VALUE_LEN bytes depending on seq
+ */
+static size_t kv_torture_value(uint32_t seq, uint8_t *value)
+{
+    size_t len = sizeof(seq) + (size_t)((seq * 37U) % (KV_MAX_VALUE_LEN - sizeof(seq) + 1U));
+
+    memcpy(value, &seq, sizeof(seq));
+    for (size_t i = sizeof(seq); i < len; i++) {
+        value[i] = (uint8_t)(seq + i);
+    }
+    return len;
+}
+
+/**
+ * @brief Check a key holds exactly the value written with seq
+ */
+static bool kv_torture_holds(uint16_t key, uint32_t seq)
+{
+    uint8_t expected[KV_MAX_VALUE_LEN];
+    uint8_t value[KV_MAX_VALUE_LEN];
+    size_t len = 0;
+
+    size_t expected_len = kv_torture_value(seq, expected);
+    return (kv_get(key, 1U, value, sizeof(value), &len) == SMART_QSO_OK) &&
+           (len == expected_len) && (memcmp(value, expected, len) == 0);
+}
+
+/**
+ * @brief Test the key-value store survives power cuts at random points
+ *
+ * Overwrites a few keys with values of varying length, so the active bank
+ * fills and compacts often, while power is cut after a random number of
+ * device operations. After each power-up every key must read back either
+ * its last acknowledged value or the one being written when power went.
+ */
+static void test_sim_torture_kv_store(void **state)
+{
+    (void)state;
+    uint32_t committed[KV_TORTURE_KEYS] = {0};
+    uint8_t value[KV_MAX_VALUE_LEN];
+    uint32_t seq = 0;
+    KvStats_t stats;
+
+    assert_int_equal(hal_flash_init(), SMART_QSO_OK);
+    assert_int_equal(kv_store_format(), SMART_QSO_OK);
+
+    for (uint32_t cut = 0; cut < KV_TORTURE_CUTS; cut++) {
+        uint32_t key_index = 0;
+
+        hal_flash_sim_power_loss_after(1U + (next_random() % 400U));
+
+        /* Overwrite random keys until a put fails with the power */
+        while (hal_flash_sim_powered()) {
+            key_index = next_random() % KV_TORTURE_KEYS;
+            seq++;
+            size_t len = kv_torture_value(seq, value);
+            if (kv_put(KV_KEY(KV_NS_MISSION, key_index), 1U, value, len) != SMART_QSO_OK) {
+                break;
+            }
+            committed[key_index] = seq;
+        }
+        assert_false(hal_flash_sim_powered());
+
+        /* Power-up */
+        assert_int_equal(hal_flash_init(), SMART_QSO_OK);
+        assert_int_equal(kv_store_mount(), SMART_QSO_OK);
+
+        /* The interrupted put either landed whole or not at all */
+        uint16_t interrupted = KV_KEY(KV_NS_MISSION, key_index);
+        if (kv_torture_holds(interrupted, seq)) {
+            committed[key_index] = seq;
+        }
+        for (uint32_t k = 0; k < KV_TORTURE_KEYS; k++) {
+            uint16_t key = KV_KEY(KV_NS_MISSION, k);
+            if (committed[k] == 0U) {
+                assert_int_equal(kv_get(key, 1U, value, sizeof(value), NULL), SMART_QSO_ERROR);
+            } else {
+                assert_true(kv_torture_holds(key, committed[k]));
+            }
+        }
+    }
+
+    /* Power went during compactions too, and never left the store unusable */
+    assert_int_equal(kv_store_get_stats(&stats), SMART_QSO_OK);
+    assert_true(stats.generation > 10U);
+
+    HalFlashSimStats_t sim = get_sim_stats();
+    assert_int_equal(sim.power_losses, KV_TORTURE_CUTS);
+    assert_int_equal(sim.program_violations, 0);
+}
+
+/*===========================================================================*/
+/* Test Suite                                                                 */
+/*===========================================================================*/
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        /* Device model tests */
+        cmocka_unit_test_setup(test_sim_program_rules, setup),
+        cmocka_unit_test_setup(test_sim_timing, setup),
+        cmocka_unit_test_setup(test_sim_power_loss, setup),
+        cmocka_unit_test_setup(test_sim_backing_file, setup),
+
+        /* Torture tests */
+        cmocka_unit_test_setup(test_sim_torture_wear_leveling, setup),
+        cmocka_unit_test_setup(test_sim_torture_kv_store, setup),
+    };
+
+    return cmocka_run_group_tests_name("HAL Flash Simulation Tests", tests, NULL, NULL);
+}
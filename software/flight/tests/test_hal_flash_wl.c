@@ -0,0 +1,305 @@
+/**
+ * @file test_hal_flash_wl.c
+ * @brief Unit tests for the flash wear-leveling layer (on the simulated device)
+ *
+ * @requirement SRS-F060 Persist mission data to non-volatile memory
+ * @requirement SRS-F041 Maintain fault log in non-volatile memory
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <string.h>
+
+/* Include the module under test */
+#include "hal/hal.h"
+
+/** Simulated endurance for the wear-out test */
+#define TEST_ENDURANCE  40U
+
+/*===========================================================================*/
+/* Test Fixtures                                                              */
+/*===========================================================================*/
+
+/**
+ * @brief Setup function - a new, unworn device
+ */
+static int setup(void **state)
+{
+    (void)state;
+    (void)hal_deinit();
+    hal_flash_sim_set_endurance(0U);
+    return (hal_flash_init() == SMART_QSO_OK) ? 0 : -1;
+}
+
+static void fill_pattern(uint8_t *buf, size_t len, uint8_t seed)
+{
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = (uint8_t)(seed + (i * 7U));
+    }
+}
+
+static HalFlashWearStats_t get_stats(void)
+{
+    HalFlashWearStats_t stats;
+    assert_int_equal(hal_flash_get_wear_stats(&stats), SMART_QSO_OK);
+    return stats;
+}
+
+/*===========================================================================*/
+/* Region API Tests                                                           */
+/*===========================================================================*/
+
+/**
+ * @brief Test reads, writes across blocks, and parameter checks
+ */
+static void test_wl_read_write(void **state)
+{
+    (void)state;
+    uint8_t out[600];
+    uint8_t in[600];
+
+    assert_int_equal(hal_flash_region_size(FLASH_REGION_STATE), 32768U);
+    assert_int_equal(hal_flash_region_size(FLASH_REGION_EPS_CONFIG), 256U);
+    assert_int_equal(hal_flash_region_size(FLASH_REGION_COUNT), 0U);
+
+    /* A new device reads erased */
+    assert_int_equal(hal_flash_read(FLASH_REGION_FAULT_LOG, 0U, in, sizeof(in)), SMART_QSO_OK);
+    for (size_t i = 0; i < sizeof(in); i++) {
+        assert_int_equal(in[i], 0xFF);
+    }
+
+    /* Unaligned write spanning three blocks */
+    fill_pattern(out, sizeof(out), 0x11U);
+    assert_int_equal(hal_flash_write(FLASH_REGION_FAULT_LOG, 100U, out, sizeof(out)),
+                     SMART_QSO_OK);
+    assert_int_equal(hal_flash_read(FLASH_REGION_FAULT_LOG, 100U, in, sizeof(in)), SMART_QSO_OK);
+    assert_memory_equal(in, out, sizeof(out));
+
+    assert_int_equal(hal_flash_write(FLASH_REGION_EPS_CONFIG, 200U, out, 57U),
+                     SMART_QSO_ERROR_INVALID);
+    assert_int_equal(hal_flash_read(FLASH_REGION_COUNT, 0U, in, 1U), SMART_QSO_ERROR_INVALID);
+    assert_int_equal(hal_flash_read(FLASH_REGION_STATE, 0U, NULL, 1U), SMART_QSO_ERROR_NULL_PTR);
+    assert_int_equal(hal_flash_erase(FLASH_REGION_COUNT), SMART_QSO_ERROR_INVALID);
+    assert_int_equal(hal_flash_get_wear_stats(NULL), SMART_QSO_ERROR_NULL_PTR);
+
+    HalFlashWearStats_t stats = get_stats();
+    assert_int_equal(stats.physical_blocks, HAL_FLASH_PHYS_BLOCKS);
+    assert_int_equal(stats.free_blocks, HAL_FLASH_SPARE_BLOCKS);
+    assert_int_equal(stats.retired_blocks, 0);
+    assert_int_equal(stats.max_erase_count, 1);
+}
+
+/**
+ * @brief Test data and erase counts survive a reset
+ */
+static void test_wl_remount(void **state)
+{
+    (void)state;
+    uint8_t out[64];
+    uint8_t in[64];
+
+    for (int i = 0; i < 3; i++) {
+        assert_int_equal(hal_flash_erase(FLASH_REGION_MISSION_DATA), SMART_QSO_OK);
+    }
+    fill_pattern(out, sizeof(out), 0x42U);
+    assert_int_equal(hal_flash_write(FLASH_REGION_MISSION_DATA, 224U, out, sizeof(out)),
+                     SMART_QSO_OK);
+    HalFlashWearStats_t before = get_stats();
+    assert_true(before.remaps > 0U);
+
+    assert_int_equal(hal_flash_init(), SMART_QSO_OK);
+    assert_int_equal(hal_flash_read(FLASH_REGION_MISSION_DATA, 224U, in, sizeof(in)),
+                     SMART_QSO_OK);
+    assert_memory_equal(in, out, sizeof(out));
+
+    HalFlashWearStats_t after = get_stats();
+    assert_int_equal(after.total_erases, before.total_erases);
+    assert_int_equal(after.free_blocks, before.free_blocks);
+}
+
+/*===========================================================================*/
+/* Wear Leveling Tests                                                        */
+/*===========================================================================*/
+
+/**
+ * @brief Test a hot region's erases are spread over the spare pool
+ */
+static void test_wl_spreads_wear(void **state)
+{
+    (void)state;
+    const uint32_t erases = 200U;
+
+    for (uint32_t i = 0; i < erases; i++) {
+        assert_int_equal(hal_flash_erase(FLASH_REGION_STATE), SMART_QSO_OK);
+    }
+
+    /* In place every STATE block would have erases + 1 */
+    HalFlashWearStats_t stats = get_stats();
+    assert_true(stats.max_erase_count < erases);
+    assert_true(stats.remaps > erases);
+    assert_true((stats.remaining_cycles) <
+                ((uint64_t)HAL_FLASH_PHYS_BLOCKS * HAL_FLASH_ENDURANCE_CYCLES));
+
+    assert_int_equal(hal_flash_wear_level(FLASH_REGION_STATE),
+                     (stats.max_erase_count * 100U) / HAL_FLASH_ENDURANCE_CYCLES);
+    assert_int_equal(hal_flash_wear_level(FLASH_REGION_EPS_CONFIG), 0);
+    assert_int_equal(hal_flash_wear_level(FLASH_REGION_COUNT), 0);
+}
+
+/*===========================================================================*/
+/* Bad Block Tests                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief Test a failed program moves the block's data to a replacement
+ */
+static void test_wl_program_failure(void **state)
+{
+    (void)state;
+    uint8_t first[32];
+    uint8_t second[32];
+    uint8_t in[32];
+
+    fill_pattern(first, sizeof(first), 0x01U);
+    fill_pattern(second, sizeof(second), 0x80U);
+    assert_int_equal(hal_flash_write(FLASH_REGION_EPS_CONFIG, 0U, first, sizeof(first)),
+                     SMART_QSO_OK);
+
+    hal_flash_sim_fail_next_program();
+    assert_int_equal(hal_flash_write(FLASH_REGION_EPS_CONFIG, 64U, second, sizeof(second)),
+                     SMART_QSO_OK);
+
+    HalFlashWearStats_t stats = get_stats();
+    assert_int_equal(stats.relocations, 1);
+    assert_int_equal(stats.retired_blocks, 1);
+    assert_int_equal(stats.free_blocks, HAL_FLASH_SPARE_BLOCKS - 1U);
+
+    /* Both writes present, before and after a reset */
+    for (int pass = 0; pass < 2; pass++) {
+        assert_int_equal(hal_flash_read(FLASH_REGION_EPS_CONFIG, 0U, in, sizeof(in)),
+                         SMART_QSO_OK);
+        assert_memory_equal(in, first, sizeof(first));
+        assert_int_equal(hal_flash_read(FLASH_REGION_EPS_CONFIG, 64U, in, sizeof(in)),
+                         SMART_QSO_OK);
+        assert_memory_equal(in, second, sizeof(second));
+        assert_int_equal(hal_flash_init(), SMART_QSO_OK);
+    }
+    assert_int_equal(get_stats().retired_blocks, 1);
+}
+
+/**
+ * @brief Test power lost while relocating leaves the old block in service
+ */
+static void test_wl_relocation_power_loss(void **state)
+{
+    (void)state;
+    uint8_t first[32];
+    uint8_t second[32];
+    uint8_t in[32];
+
+    fill_pattern(first, sizeof(first), 0x01U);
+    fill_pattern(second, sizeof(second), 0x80U);
+    assert_int_equal(hal_flash_write(FLASH_REGION_EPS_CONFIG, 0U, first, sizeof(first)),
+                     SMART_QSO_OK);
+
+    /* The program fails, then power goes while copying to the replacement */
+    hal_flash_sim_fail_next_program();
+    hal_flash_sim_power_loss_after(1U);
+    assert_int_equal(hal_flash_write(FLASH_REGION_EPS_CONFIG, 64U, second, sizeof(second)),
+                     SMART_QSO_ERROR);
+
+    HalFlashWearStats_t stats = get_stats();
+    assert_int_equal(stats.relocations, 0);
+    assert_int_equal(stats.retired_blocks, 0);
+
+    assert_int_equal(hal_flash_init(), SMART_QSO_OK);
+    stats = get_stats();
+    assert_int_equal(stats.retired_blocks, 0);
+    assert_int_equal(stats.lost_blocks, 0);
+    assert_int_equal(hal_flash_read(FLASH_REGION_EPS_CONFIG, 0U, in, sizeof(in)), SMART_QSO_OK);
+    assert_memory_equal(in, first, sizeof(first));
+}
+
+/**
+ * @brief Test worn-out blocks are retired until the spare pool runs out
+ */
+static void test_wl_wear_out(void **state)
+{
+    (void)state;
+    uint8_t out[HAL_FLASH_SECTOR_SIZE];
+    uint8_t in[HAL_FLASH_SECTOR_SIZE];
+    uint32_t cycles = 0;
+    uint32_t retired_before_loss = 0;
+
+    (void)hal_deinit();
+    hal_flash_sim_set_endurance(TEST_ENDURANCE);
+    assert_int_equal(hal_flash_init(), SMART_QSO_OK);
+
+    while (hal_flash_erase(FLASH_REGION_STATE_B) == SMART_QSO_OK) {
+        retired_before_loss = get_stats().retired_blocks;
+        cycles++;
+
+        /* Every block of the region still holds data */
+        fill_pattern(out, sizeof(out), (uint8_t)cycles);
+        for (uint32_t offset = 0; offset < 32768U; offset += HAL_FLASH_SECTOR_SIZE) {
+            assert_int_equal(hal_flash_write(FLASH_REGION_STATE_B, offset, out, sizeof(out)),
+                             SMART_QSO_OK);
+        }
+        assert_int_equal(hal_flash_read(FLASH_REGION_STATE_B, 32512U, in, sizeof(in)),
+                         SMART_QSO_OK);
+        assert_memory_equal(in, out, sizeof(out));
+        assert_true(cycles < (TEST_ENDURANCE * 4U));
+    }
+
+    /* Outlived the weakest block by retiring blocks along the way */
+    assert_true(cycles > TEST_ENDURANCE);
+    assert_true(retired_before_loss > 0U);
+
+    HalFlashWearStats_t stats = get_stats();
+    assert_int_equal(stats.free_blocks, 0);
+    assert_true(stats.retired_blocks > HAL_FLASH_SPARE_BLOCKS);
+    assert_true(stats.lost_blocks > 0U);
+
+    /* After a reset retired blocks stay retired and lost blocks stay lost */
+    assert_int_equal(hal_flash_init(), SMART_QSO_OK);
+    HalFlashWearStats_t after = get_stats();
+    assert_int_equal(after.retired_blocks, stats.retired_blocks);
+    assert_int_equal(after.lost_blocks, stats.lost_blocks);
+
+    /* Only the lost blocks fail; other regions are untouched */
+    uint32_t unreadable = 0;
+    for (uint32_t offset = 0; offset < 32768U; offset += HAL_FLASH_SECTOR_SIZE) {
+        if (hal_flash_read(FLASH_REGION_STATE_B, offset, in, 1U) != SMART_QSO_OK) {
+            unreadable++;
+        }
+    }
+    assert_int_equal(unreadable, after.lost_blocks);
+    assert_int_equal(hal_flash_read(FLASH_REGION_MISSION_DATA, 0U, in, sizeof(in)),
+                     SMART_QSO_OK);
+}
+
+/*===========================================================================*/
+/* Test Suite                                                                 */
+/*===========================================================================*/
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        /* Region API tests */
+        cmocka_unit_test_setup(test_wl_read_write, setup),
+        cmocka_unit_test_setup(test_wl_remount, setup),
+
+        /* Wear leveling tests */
+        cmocka_unit_test_setup(test_wl_spreads_wear, setup),
+
+        /* Bad block tests */
+        cmocka_unit_test_setup(test_wl_program_failure, setup),
+        cmocka_unit_test_setup(test_wl_relocation_power_loss, setup),
+        cmocka_unit_test_setup(test_wl_wear_out, setup),
+    };
+
+    return cmocka_run_group_tests_name("HAL Flash Wear Leveling Tests", tests, NULL, NULL);
+}
@@ -0,0 +1,293 @@
+/**
+ * @file test_kv_store.c
+ * @brief Unit tests for the log-structured key-value store
+ *
+ * @requirement SRS-DATA-001 System shall persist mission data across resets
+ * @requirement SRS-DATA-002 System shall protect data integrity with CRC
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <string.h>
+
+/* Include the module under test */
+#include "kv_store.h"
+#include "hal/hal.h"
+
+/** Key used by the single-key tests */
+#define TEST_KEY        KV_KEY(KV_NS_MISSION, 0x42U)
+
+/*===========================================================================*/
+/* Test Fixtures                                                              */
+/*===========================================================================*/
+
+/**
+ * @brief Setup function - start from an empty store on a fresh device
+ */
+static int setup(void **state)
+{
+    (void)state;
+    if ((hal_flash_sim_configure(NULL) != SMART_QSO_OK) || (hal_flash_init() != SMART_QSO_OK)) {
+        return -1;
+    }
+    return (kv_store_format() == SMART_QSO_OK) ? 0 : -1;
+}
+
+/**
+ * @brief Group teardown - leave no keys behind for other suites
+ */
+static int teardown_group(void **state)
+{
+    (void)state;
+    return (kv_store_format() == SMART_QSO_OK) ? 0 : -1;
+}
+
+/**
+ * @brief Program one byte of a bank to zero (programming only clears bits)
+ */
+static void clear_bank_byte(uint8_t bank, uint32_t offset)
+{
+    static const HalFlashRegion_t regions[KV_BANK_COUNT] = {
+        FLASH_REGION_STATE,
+        FLASH_REGION_STATE_B
+    };
+    uint8_t value = 0;
+
+    assert_int_equal(hal_flash_read(regions[bank], offset, &value, 1U), SMART_QSO_OK);
+    assert_int_not_equal(value, 0);
+    value = 0;
+    assert_int_equal(hal_flash_write(regions[bank], offset, &value, 1U), SMART_QSO_OK);
+}
+
+/**
+ * @brief Fetch TEST_KEY as a uint32_t
+ */
+static uint32_t get_u32(void)
+{
+    uint32_t value = 0;
+    size_t len = 0;
+
+    assert_int_equal(kv_get(TEST_KEY, 1U, &value, sizeof(value), &len), SMART_QSO_OK);
+    assert_int_equal(len, sizeof(value));
+    return value;
+}
+
+/*===========================================================================*/
+/* Basic Tests                                                                */
+/*===========================================================================*/
+
+/**
+ * @brief Test put/get roundtrip, overwrite and remount
+ */
+static void test_kv_put_get(void **state)
+{
+    (void)state;
+    uint32_t value = 0x12345678U;
+
+    assert_int_equal(kv_put(TEST_KEY, 1U, &value, sizeof(value)), SMART_QSO_OK);
+    assert_int_equal(get_u32(), 0x12345678U);
+
+    value = 0xCAFEF00DU;
+    assert_int_equal(kv_put(TEST_KEY, 1U, &value, sizeof(value)), SMART_QSO_OK);
+    assert_int_equal(get_u32(), 0xCAFEF00DU);
+
+    /* Survives a reset */
+    assert_int_equal(kv_store_mount(), SMART_QSO_OK);
+    assert_int_equal(get_u32(), 0xCAFEF00DU);
+
+    KvStats_t stats;
+    assert_int_equal(kv_store_get_stats(&stats), SMART_QSO_OK);
+    assert_int_equal(stats.live_keys, 1);
+    assert_int_equal(stats.sequence, 2);
+}
+
+/**
+ * @brief Test parameter validation and lookup errors
+ */
+static void test_kv_errors(void **state)
+{
+    (void)state;
+    uint8_t big[KV_MAX_VALUE_LEN + 1U];
+    uint32_t value = 7U;
+    uint8_t small = 0;
+
+    memset(big, 0, sizeof(big));
+    assert_int_equal(kv_put(TEST_KEY, 1U, NULL, 4U), SMART_QSO_ERROR_NULL_PTR);
+    assert_int_equal(kv_put(TEST_KEY, 1U, &value, 0U), SMART_QSO_ERROR_INVALID);
+    assert_int_equal(kv_put(TEST_KEY, 1U, big, sizeof(big)), SMART_QSO_ERROR_INVALID);
+
+    /* Absent key */
+    assert_int_equal(kv_get(TEST_KEY, 1U, &value, sizeof(value), NULL), SMART_QSO_ERROR);
+
+    assert_int_equal(kv_put(TEST_KEY, 1U, &value, sizeof(value)), SMART_QSO_OK);
+    assert_int_equal(kv_get(TEST_KEY, 1U, NULL, sizeof(value), NULL), SMART_QSO_ERROR_NULL_PTR);
+
+    /* Schema version mismatch */
+    assert_int_equal(kv_get(TEST_KEY, 2U, &value, sizeof(value), NULL), SMART_QSO_ERROR_INVALID);
+
+    /* Buffer too small */
+    assert_int_equal(kv_get(TEST_KEY, 1U, &small, sizeof(small), NULL), SMART_QSO_ERROR_NO_MEM);
+
+    assert_int_equal(kv_store_get_stats(NULL), SMART_QSO_ERROR_NULL_PTR);
+}
+
+/**
+ * @brief Test a deleted key stays deleted across a reset
+ */
+static void test_kv_delete(void **state)
+{
+    (void)state;
+    uint32_t value = 1U;
+
+    assert_int_equal(kv_put(TEST_KEY, 1U, &value, sizeof(value)), SMART_QSO_OK);
+    assert_int_equal(kv_delete(TEST_KEY), SMART_QSO_OK);
+    assert_int_equal(kv_get(TEST_KEY, 1U, &value, sizeof(value), NULL), SMART_QSO_ERROR);
+
+    /* Deleting an absent key writes nothing */
+    KvStats_t before;
+    KvStats_t after;
+    kv_store_get_stats(&before);
+    assert_int_equal(kv_delete(TEST_KEY), SMART_QSO_OK);
+    kv_store_get_stats(&after);
+    assert_int_equal(after.bytes_written, before.bytes_written);
+
+    assert_int_equal(kv_store_mount(), SMART_QSO_OK);
+    assert_int_equal(kv_get(TEST_KEY, 1U, &value, sizeof(value), NULL), SMART_QSO_ERROR);
+    kv_store_get_stats(&after);
+    assert_int_equal(after.live_keys, 0);
+}
+
+/*===========================================================================*/
+/* Power Loss Tests                                                           */
+/*===========================================================================*/
+
+/**
+ * @brief Test a torn record falls back to the key's previous value
+ */
+static void test_kv_torn_record(void **state)
+{
+    (void)state;
+    KvStats_t stats;
+    uint32_t value = 100U;
+
+    assert_int_equal(kv_put(TEST_KEY, 1U, &value, sizeof(value)), SMART_QSO_OK);
+
+    /* Each put is one program: power fails part way through the second */
+    hal_flash_sim_power_loss_after(1U);
+    value = 200U;
+    assert_int_equal(kv_put(TEST_KEY, 1U, &value, sizeof(value)), SMART_QSO_OK);
+    value = 300U;
+    assert_int_not_equal(kv_put(TEST_KEY, 1U, &value, sizeof(value)), SMART_QSO_OK);
+    assert_false(hal_flash_sim_powered());
+
+    assert_int_equal(hal_flash_init(), SMART_QSO_OK);
+    assert_int_equal(kv_store_mount(), SMART_QSO_OK);
+    assert_int_equal(get_u32(), 200U);
+    kv_store_get_stats(&stats);
+    assert_int_equal(stats.torn_records, 1);
+
+    /* Writing continues after the damaged record */
+    value = 400U;
+    assert_int_equal(kv_put(TEST_KEY, 1U, &value, sizeof(value)), SMART_QSO_OK);
+    assert_int_equal(kv_store_mount(), SMART_QSO_OK);
+    assert_int_equal(get_u32(), 400U);
+}
+
+/**
+ * @brief Test compaction keeps live keys and erases rarely
+ */
+static void test_kv_compaction(void **state)
+{
+    (void)state;
+    KvStats_t start;
+    KvStats_t stats;
+    uint32_t value = 0;
+    uint32_t before_switch = 0;
+    uint8_t other[64];
+
+    memset(other, 0xA5, sizeof(other));
+    assert_int_equal(kv_put(KV_KEY(KV_NS_EPS, 9U), 3U, other, sizeof(other)), SMART_QSO_OK);
+    assert_int_equal(kv_put(TEST_KEY, 1U, &value, sizeof(value)), SMART_QSO_OK);
+    kv_store_get_stats(&start);
+
+    /* Overwrite one key until the active bank fills up */
+    do {
+        before_switch = value;
+        value++;
+        assert_int_equal(kv_put(TEST_KEY, 1U, &value, sizeof(value)), SMART_QSO_OK);
+        kv_store_get_stats(&stats);
+    } while (stats.compactions == start.compactions);
+
+    assert_int_not_equal(stats.active_bank, start.active_bank);
+    assert_int_equal(stats.generation, start.generation + 1U);
+    assert_int_equal(stats.live_keys, 2);
+
+    /* One erase per bank's worth of puts */
+    assert_int_equal(stats.erase_count - start.erase_count, 1);
+    assert_true((stats.puts - start.puts) > (KV_BANK_SIZE / KV_RECORD_SIZE(sizeof(value))) - 8U);
+
+    uint8_t check[64];
+    assert_int_equal(kv_store_mount(), SMART_QSO_OK);
+    assert_int_equal(get_u32(), value);
+    assert_int_equal(kv_get(KV_KEY(KV_NS_EPS, 9U), 3U, check, sizeof(check), NULL), SMART_QSO_OK);
+    assert_memory_equal(check, other, sizeof(other));
+
+    /* A damaged header on the new bank: the old bank still rules */
+    clear_bank_byte(stats.active_bank, 0);
+    assert_int_equal(kv_store_mount(), SMART_QSO_OK);
+    assert_int_equal(get_u32(), before_switch);
+    kv_store_get_stats(&stats);
+    assert_int_equal(stats.active_bank, start.active_bank);
+}
+
+/*===========================================================================*/
+/* Capacity Tests                                                             */
+/*===========================================================================*/
+
+/**
+ * @brief Test the key index limit
+ */
+static void test_kv_index_full(void **state)
+{
+    (void)state;
+    uint32_t value = 1U;
+
+    for (uint32_t i = 0; i < KV_MAX_KEYS; i++) {
+        assert_int_equal(kv_put((uint16_t)(0x1000U + i), 1U, &value, sizeof(value)),
+                         SMART_QSO_OK);
+    }
+    assert_int_equal(kv_put((uint16_t)(0x1000U + KV_MAX_KEYS), 1U, &value, sizeof(value)),
+                     SMART_QSO_ERROR_NO_MEM);
+
+    /* Existing keys can still be updated, and deleting frees a slot */
+    assert_int_equal(kv_put(0x1000U, 1U, &value, sizeof(value)), SMART_QSO_OK);
+    assert_int_equal(kv_delete(0x1001U), SMART_QSO_OK);
+    assert_int_equal(kv_put((uint16_t)(0x1000U + KV_MAX_KEYS), 1U, &value, sizeof(value)),
+                     SMART_QSO_OK);
+}
+
+/*===========================================================================*/
+/* Test Suite                                                                 */
+/*===========================================================================*/
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        /* Basic tests */
+        cmocka_unit_test_setup(test_kv_put_get, setup),
+        cmocka_unit_test_setup(test_kv_errors, setup),
+        cmocka_unit_test_setup(test_kv_delete, setup),
+
+        /* Power loss tests */
+        cmocka_unit_test_setup(test_kv_torn_record, setup),
+        cmocka_unit_test_setup(test_kv_compaction, setup),
+
+        /* Capacity tests */
+        cmocka_unit_test_setup(test_kv_index_full, setup),
+    };
+
+    return cmocka_run_group_tests_name("KV Store Tests", tests, NULL, teardown_group);
+}
@@ -24,6 +24,9 @@
 /* Include the module under test */
 #include "smart_qso.h"
 #include "mission_data.h"
+#include "kv_store.h"
+#include "persistence.h"
+#include "hal/hal_flash.h"
 
 /*===========================================================================*/
 /* Test Helpers                                                               */
@@ -38,8 +41,9 @@
 
 static int setup(void **state) {
     (void)state;
-    /* Remove any existing data file */
-    unlink(MISSION_DATA_FILE);
+    /* Start from empty persistent storage */
+    (void)hal_flash_init();
+    (void)kv_store_format();
     /* Initialize mission data module */
     SmartQsoResult_t result = mission_data_init();
     assert_int_equal(result, SMART_QSO_OK);
@@ -48,7 +52,7 @@ static int setup(void **state) {
 
 static int teardown(void **state) {
     (void)state;
-    unlink(MISSION_DATA_FILE);
+    (void)kv_store_format();
     return 0;
 }
 
@@ -202,10 +206,12 @@ static void test_mission_data_save(void **state) {
     SmartQsoResult_t result = mission_data_save();
     assert_int_equal(result, SMART_QSO_OK);
 
-    /* Verify file exists */
-    FILE *f = fopen(MISSION_DATA_FILE, "rb");
-    assert_non_null(f);
-    fclose(f);
+    /* Verify the record exists */
+    MissionData_t stored;
+    size_t len = 0;
+    assert_int_equal(kv_get(KV_KEY_MISSION_DATA, MISSION_DATA_SCHEMA_VERSION,
+                            &stored, sizeof(stored), &len), SMART_QSO_OK);
+    assert_int_equal(len, sizeof(MissionData_t));
 }
 
 /**
@@ -280,16 +286,11 @@ static void test_mission_data_crc_protection(void **state) {
 
     mission_data_save();
 
-    /* Read raw file and verify CRC is present */
-    FILE *f = fopen(MISSION_DATA_FILE, "rb");
-    assert_non_null(f);
-
-    fseek(f, 0, SEEK_END);
-    long size = ftell(f);
-    fclose(f);
-
-    /* File should include CRC32 (4 bytes) */
-    assert_true(size >= (long)sizeof(uint32_t));
+    /* Read the raw record and verify its CRC */
+    MissionData_t stored;
+    assert_int_equal(kv_get(KV_KEY_MISSION_DATA, MISSION_DATA_SCHEMA_VERSION,
+                            &stored, sizeof(stored), NULL), SMART_QSO_OK);
+    assert_int_equal(stored.crc32, smart_qso_crc32(&stored, offsetof(MissionData_t, crc32)));
 }
 
 /**
@@ -303,21 +304,21 @@ static void test_mission_data_corruption_detection(void **state) {
     /* Save valid data */
     mission_data_save();
 
-    /* Corrupt the file */
-    FILE *f = fopen(MISSION_DATA_FILE, "r+b");
-    assert_non_null(f);
-
-    /* Write garbage to the middle */
-    fseek(f, 10, SEEK_SET);
-    uint8_t garbage = 0xFF;
-    fwrite(&garbage, 1, 1, f);
-    fclose(f);
-
-    /* Attempt to load - should fail or use defaults */
-    (void)mission_data_load();
-
-    /* Either returns error or reinitializes with defaults */
-    /* Implementation dependent - check that we don't crash */
+    /* Store a copy with garbage in the middle */
+    MissionData_t stored;
+    assert_int_equal(kv_get(KV_KEY_MISSION_DATA, MISSION_DATA_SCHEMA_VERSION,
+                            &stored, sizeof(stored), NULL), SMART_QSO_OK);
+    ((uint8_t *)&stored)[10] ^= 0xFF;
+    assert_int_equal(kv_put(KV_KEY_MISSION_DATA, MISSION_DATA_SCHEMA_VERSION,
+                            &stored, sizeof(stored)), SMART_QSO_OK);
+
+    /* Attempt to load - the struct CRC rejects it */
+    assert_int_equal(mission_data_load(), SMART_QSO_ERROR);
+
+    /* A record from another schema version is not used either */
+    assert_int_equal(kv_put(KV_KEY_MISSION_DATA, MISSION_DATA_SCHEMA_VERSION + 1U,
+                            &stored, sizeof(stored)), SMART_QSO_OK);
+    assert_int_equal(mission_data_load(), SMART_QSO_ERROR_INVALID);
 }
 
 /*===========================================================================*/
@@ -370,6 +371,26 @@ static void test_mission_data_get_energy(void **state) {
     assert_true(FLOAT_EQUAL(energy, data.total_energy_wh));
 }
 
+/**
+ * @brief Test running totals wait for a checkpoint; other changes save at once
+ */
+static void test_mission_data_checkpoint(void **state) {
+    (void)state;
+
+    assert_int_equal(persist_init(), SMART_QSO_OK);
+    mission_data_update_uptime(1000);
+    mission_data_add_energy(0.5);
+    assert_false(persist_is_dirty(PERSIST_MODULE_MISSION));
+
+    /* The CRC still covers the new totals */
+    MissionData_t data;
+    mission_data_get(&data);
+    assert_int_equal(data.crc32, smart_qso_crc32(&data, offsetof(MissionData_t, crc32)));
+
+    mission_data_record_fault("Checkpoint test");
+    assert_true(persist_is_dirty(PERSIST_MODULE_MISSION));
+}
+
 /**
  * @brief Test set_start function
  */
@@ -457,6 +478,7 @@ int main(void) {
         cmocka_unit_test_setup_teardown(test_mission_data_get_reset_count, setup, teardown),
         cmocka_unit_test_setup_teardown(test_mission_data_get_uptime, setup, teardown),
         cmocka_unit_test_setup_teardown(test_mission_data_get_energy, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_mission_data_checkpoint, setup, teardown),
         cmocka_unit_test_setup_teardown(test_mission_data_set_start, setup, teardown),
 
         /* Boundary tests */
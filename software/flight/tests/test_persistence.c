@@ -0,0 +1,223 @@
+/**
+ * @file test_persistence.c
+ * @brief Unit tests for the write-coalescing persistence service
+ *
+ * @requirement SRS-DATA-001 System shall persist mission data across resets
+ * @requirement SRS-F051 Save state before watchdog reset
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+/* Include the module under test */
+#include "persistence.h"
+
+/*===========================================================================*/
+/* Test Doubles                                                               */
+/*===========================================================================*/
+
+/** Calls to each fake save function */
+static uint32_t s_mission_saves;
+static uint32_t s_eps_saves;
+
+/** Result the EPS fake returns */
+static SmartQsoResult_t s_eps_result;
+
+static SmartQsoResult_t fake_mission_save(void)
+{
+    s_mission_saves++;
+    return SMART_QSO_OK;
+}
+
+static SmartQsoResult_t fake_eps_save(void)
+{
+    s_eps_saves++;
+    return s_eps_result;
+}
+
+/*===========================================================================*/
+/* Test Fixtures                                                              */
+/*===========================================================================*/
+
+/**
+ * @brief Setup function - two registered modules, 1 s window
+ */
+static int setup(void **state)
+{
+    (void)state;
+    s_mission_saves = 0;
+    s_eps_saves = 0;
+    s_eps_result = SMART_QSO_OK;
+
+    (void)persist_init();
+    if ((persist_register(PERSIST_MODULE_MISSION, fake_mission_save) != SMART_QSO_OK) ||
+        (persist_register(PERSIST_MODULE_EPS, fake_eps_save) != SMART_QSO_OK) ||
+        (persist_set_window_ms(1000U) != SMART_QSO_OK)) {
+        return -1;
+    }
+    return 0;
+}
+
+/*===========================================================================*/
+/* Configuration Tests                                                        */
+/*===========================================================================*/
+
+/**
+ * @brief Test registration and window validation
+ */
+static void test_persist_config(void **state)
+{
+    (void)state;
+
+    assert_int_equal(persist_register(PERSIST_MODULE_FAULT_LOG, NULL), SMART_QSO_ERROR_NULL_PTR);
+    assert_int_equal(persist_register(PERSIST_MODULE_COUNT, fake_mission_save),
+                     SMART_QSO_ERROR_PARAM);
+
+    assert_int_equal(persist_get_window_ms(), 1000U);
+    assert_int_equal(persist_set_window_ms(PERSIST_MAX_WINDOW_MS + 1U), SMART_QSO_ERROR_PARAM);
+    assert_int_equal(persist_get_window_ms(), 1000U);
+
+    assert_int_equal(persist_init(), SMART_QSO_OK);
+    assert_int_equal(persist_get_window_ms(), PERSIST_DEFAULT_WINDOW_MS);
+    assert_int_equal(persist_get_stats(NULL), SMART_QSO_ERROR_NULL_PTR);
+}
+
+/*===========================================================================*/
+/* Coalescing Tests                                                           */
+/*===========================================================================*/
+
+/**
+ * @brief Test changes within a window cost one save, after the window
+ */
+static void test_persist_coalesce(void **state)
+{
+    (void)state;
+    uint64_t now = smart_qso_now_ms();
+
+    /* Nothing dirty: nothing saved */
+    assert_int_equal(persist_service(now + 5000U), 0);
+
+    for (int i = 0; i < 50; i++) {
+        persist_mark_dirty(PERSIST_MODULE_MISSION);
+    }
+    assert_true(persist_is_dirty(PERSIST_MODULE_MISSION));
+    assert_false(persist_is_dirty(PERSIST_MODULE_EPS));
+
+    /* Window not yet elapsed */
+    assert_int_equal(persist_service(now), 0);
+    assert_int_equal(s_mission_saves, 0);
+
+    assert_int_equal(persist_service(now + 1000U), 1);
+    assert_int_equal(s_mission_saves, 1);
+    assert_false(persist_is_dirty(PERSIST_MODULE_MISSION));
+
+    /* Clean afterwards */
+    assert_int_equal(persist_service(now + 5000U), 0);
+    assert_int_equal(s_mission_saves, 1);
+
+    PersistStats_t stats;
+    assert_int_equal(persist_get_stats(&stats), SMART_QSO_OK);
+    assert_int_equal(stats.marks, 50);
+    assert_int_equal(stats.saves, 1);
+}
+
+/**
+ * @brief Test a failed save stays dirty and is retried a window later
+ */
+static void test_persist_retry(void **state)
+{
+    (void)state;
+    uint64_t now = smart_qso_now_ms();
+
+    s_eps_result = SMART_QSO_ERROR_IO;
+    persist_mark_dirty(PERSIST_MODULE_EPS);
+    assert_int_equal(persist_service(now + 1000U), 0);
+    assert_int_equal(s_eps_saves, 1);
+    assert_true(persist_is_dirty(PERSIST_MODULE_EPS));
+
+    /* Backs off for a window from the failure */
+    assert_int_equal(persist_service(now + 1500U), 0);
+    assert_int_equal(s_eps_saves, 1);
+
+    s_eps_result = SMART_QSO_OK;
+    assert_int_equal(persist_service(now + 2000U), 1);
+    assert_false(persist_is_dirty(PERSIST_MODULE_EPS));
+
+    PersistStats_t stats;
+    persist_get_stats(&stats);
+    assert_int_equal(stats.save_errors, 1);
+}
+
+/**
+ * @brief Test a module without a save function keeps its changes
+ */
+static void test_persist_unregistered(void **state)
+{
+    (void)state;
+
+    persist_mark_dirty(PERSIST_MODULE_FAULT_LOG);
+    assert_int_equal(persist_service(smart_qso_now_ms() + 5000U), 0);
+    assert_true(persist_is_dirty(PERSIST_MODULE_FAULT_LOG));
+
+    /* Out-of-range modules are ignored */
+    persist_mark_dirty(PERSIST_MODULE_COUNT);
+    assert_false(persist_is_dirty(PERSIST_MODULE_COUNT));
+}
+
+/*===========================================================================*/
+/* Forced Flush Tests                                                         */
+/*===========================================================================*/
+
+/**
+ * @brief Test forced flushes save dirty modules without waiting
+ */
+static void test_persist_flush_all(void **state)
+{
+    (void)state;
+
+    persist_mark_dirty(PERSIST_MODULE_EPS);
+    assert_int_equal(persist_flush_all(), SMART_QSO_OK);
+    assert_int_equal(s_eps_saves, 1);
+    assert_int_equal(s_mission_saves, 0);
+    assert_false(persist_is_dirty(PERSIST_MODULE_EPS));
+
+    /* Pre-reset callback is a forced flush */
+    persist_mark_dirty(PERSIST_MODULE_MISSION);
+    persist_prereset_handler();
+    assert_int_equal(s_mission_saves, 1);
+
+    /* Failures are reported */
+    s_eps_result = SMART_QSO_ERROR_IO;
+    persist_mark_dirty(PERSIST_MODULE_EPS);
+    assert_int_equal(persist_flush_all(), SMART_QSO_ERROR_IO);
+    assert_true(persist_is_dirty(PERSIST_MODULE_EPS));
+
+    PersistStats_t stats;
+    persist_get_stats(&stats);
+    assert_int_equal(stats.forced_flushes, 3);
+}
+
+/*===========================================================================*/
+/* Test Suite                                                                 */
+/*===========================================================================*/
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        /* Configuration tests */
+        cmocka_unit_test_setup(test_persist_config, setup),
+
+        /* Coalescing tests */
+        cmocka_unit_test_setup(test_persist_coalesce, setup),
+        cmocka_unit_test_setup(test_persist_retry, setup),
+        cmocka_unit_test_setup(test_persist_unregistered, setup),
+
+        /* Forced flush tests */
+        cmocka_unit_test_setup(test_persist_flush_all, setup),
+    };
+
+    return cmocka_run_group_tests_name("Persistence Tests", tests, NULL, NULL);
+}
@@ -0,0 +1,249 @@
+/**
+ * @file test_sensor_filter.c
+ * @brief Unit tests for the sensor filter pipeline
+ *
+ * Tests filtering, decimation and window summaries per SRS-F071.
+ *
+ * @requirement SRS-F071 Sample sensors at configurable rates
+ * @requirement SRS-SENS-003 System shall validate sensor readings
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <string.h>
+#include <math.h>
+
+/* Include the module under test */
+#include "smart_qso.h"
+#include "sensor_filter.h"
+
+/*===========================================================================*/
+/* Test Fixtures                                                              */
+/*===========================================================================*/
+
+static int setup(void **state) {
+    (void)state;
+    sensor_filter_reset();
+    return 0;
+}
+
+/**
+ * @brief Configure one slot
+ */
+static SmartQsoResult_t configure(size_t slot, SensorFilterKind_t kind, uint8_t length,
+                                  uint16_t decimation, double alpha) {
+    SensorFilterConfig_t config = { kind, length, decimation, alpha };
+    return sensor_filter_configure(slot, &config);
+}
+
+/**
+ * @brief Run one sample through one slot
+ */
+static double update_one(uint16_t slot, double raw, bool *published) {
+    double value = 0.0;
+    sensor_filter_update(&slot, &raw, 1U, &value, published);
+    return value;
+}
+
+/*===========================================================================*/
+/* Test Cases: Configuration                                                  */
+/*===========================================================================*/
+
+/**
+ * @brief Test filter names from the sensor configuration
+ */
+static void test_filter_parse_kind(void **state) {
+    (void)state;
+    SensorFilterKind_t kind = SENSOR_FILTER_NONE;
+
+    assert_int_equal(sensor_filter_parse_kind("moving_average", &kind), SMART_QSO_OK);
+    assert_int_equal(kind, SENSOR_FILTER_MOVING_AVERAGE);
+    assert_int_equal(sensor_filter_parse_kind("iir", &kind), SMART_QSO_OK);
+    assert_int_equal(kind, SENSOR_FILTER_IIR);
+    assert_int_equal(sensor_filter_parse_kind("median", &kind), SMART_QSO_OK);
+    assert_int_equal(kind, SENSOR_FILTER_MEDIAN);
+    assert_int_equal(sensor_filter_parse_kind("none", &kind), SMART_QSO_OK);
+    assert_int_equal(kind, SENSOR_FILTER_NONE);
+    assert_int_equal(sensor_filter_parse_kind("kalman", &kind), SMART_QSO_ERROR_PARAM);
+}
+
+/**
+ * @brief Test out-of-range configurations are rejected
+ */
+static void test_filter_configure_limits(void **state) {
+    (void)state;
+    SensorFilterConfig_t config;
+
+    assert_int_equal(configure(0, SENSOR_FILTER_MEDIAN, SENSOR_FILTER_MAX_LENGTH + 1U, 1U, 0.0),
+                     SMART_QSO_ERROR_PARAM);
+    assert_int_equal(configure(0, SENSOR_FILTER_NONE, 1U, SENSOR_FILTER_MAX_DECIMATION + 1U, 0.0),
+                     SMART_QSO_ERROR_PARAM);
+    assert_int_equal(configure(0, SENSOR_FILTER_IIR, 1U, 1U, 0.0), SMART_QSO_ERROR_PARAM);
+    assert_int_equal(configure(0, SENSOR_FILTER_IIR, 1U, 1U, 1.5), SMART_QSO_ERROR_PARAM);
+    assert_int_equal(configure(SMART_QSO_MAX_SENSORS, SENSOR_FILTER_NONE, 1U, 1U, 0.0),
+                     SMART_QSO_ERROR_PARAM);
+
+    /* Zeroed lengths and decimations mean 1 */
+    assert_int_equal(configure(0, SENSOR_FILTER_MOVING_AVERAGE, 0U, 0U, 0.0), SMART_QSO_OK);
+    assert_int_equal(sensor_filter_get_config(0, &config), SMART_QSO_OK);
+    assert_int_equal(config.length, 1);
+    assert_int_equal(config.decimation, 1);
+}
+
+/*===========================================================================*/
+/* Test Cases: Filters                                                        */
+/*===========================================================================*/
+
+/**
+ * @brief Test unconfigured slots publish every sample unchanged
+ */
+static void test_filter_passthrough(void **state) {
+    (void)state;
+    bool published = false;
+
+    assert_true(fabs(update_one(0, 3.25, &published) - 3.25) < 1e-12);
+    assert_true(published);
+    assert_true(fabs(update_one(0, -1.5, &published) + 1.5) < 1e-12);
+    assert_true(published);
+}
+
+/**
+ * @brief Test the moving average fills, then slides
+ */
+static void test_filter_moving_average(void **state) {
+    (void)state;
+    static const double raw[] = { 1.0, 2.0, 3.0, 4.0, 5.0 };
+    static const double expect[] = { 1.0, 1.5, 2.0, 2.5, 3.5 };
+    bool published = false;
+
+    assert_int_equal(configure(2, SENSOR_FILTER_MOVING_AVERAGE, 4U, 1U, 0.0), SMART_QSO_OK);
+    for (size_t n = 0; n < 5; n++) {
+        assert_true(fabs(update_one(2, raw[n], &published) - expect[n]) < 1e-12);
+    }
+}
+
+/**
+ * @brief Test the median rejects a single outlier
+ */
+static void test_filter_median(void **state) {
+    (void)state;
+    static const double raw[] = { 1.0, 100.0, 2.0, 3.0, 4.0 };
+    static const double expect[] = { 1.0, 50.5, 2.0, 3.0, 3.0 };
+    bool published = false;
+
+    assert_int_equal(configure(1, SENSOR_FILTER_MEDIAN, 3U, 1U, 0.0), SMART_QSO_OK);
+    for (size_t n = 0; n < 5; n++) {
+        assert_true(fabs(update_one(1, raw[n], &published) - expect[n]) < 1e-12);
+    }
+}
+
+/**
+ * @brief Test the IIR starts from its first sample
+ */
+static void test_filter_iir(void **state) {
+    (void)state;
+    bool published = false;
+
+    assert_int_equal(configure(0, SENSOR_FILTER_IIR, 0U, 1U, 0.5), SMART_QSO_OK);
+    assert_true(fabs(update_one(0, 8.0, &published) - 8.0) < 1e-12);
+    assert_true(fabs(update_one(0, 0.0, &published) - 4.0) < 1e-12);
+    assert_true(fabs(update_one(0, 0.0, &published) - 2.0) < 1e-12);
+}
+
+/*===========================================================================*/
+/* Test Cases: Decimation                                                     */
+/*===========================================================================*/
+
+/**
+ * @brief Test one value per window is published with the window summary
+ */
+static void test_filter_decimation_summary(void **state) {
+    (void)state;
+    static const double raw[] = { 2.0, -1.0, 5.0, 7.0 };
+    SensorSummary_t summary;
+    bool published = false;
+
+    assert_int_equal(configure(3, SENSOR_FILTER_NONE, 1U, 3U, 0.0), SMART_QSO_OK);
+    assert_int_equal(sensor_filter_get_summary(3, &summary), SMART_QSO_OK);
+    assert_int_equal(summary.samples, 0);
+
+    (void)update_one(3, raw[0], &published);
+    assert_false(published);
+    (void)update_one(3, raw[1], &published);
+    assert_false(published);
+    assert_true(fabs(update_one(3, raw[2], &published) - 5.0) < 1e-12);
+    assert_true(published);
+
+    assert_int_equal(sensor_filter_get_summary(3, &summary), SMART_QSO_OK);
+    assert_int_equal(summary.samples, 3);
+    assert_true(fabs(summary.min + 1.0) < 1e-12);
+    assert_true(fabs(summary.max - 5.0) < 1e-12);
+    assert_true(fabs(summary.mean - 2.0) < 1e-12);
+
+    /* The next window starts fresh; the summary holds until it completes */
+    (void)update_one(3, raw[3], &published);
+    assert_false(published);
+    assert_int_equal(sensor_filter_get_summary(3, &summary), SMART_QSO_OK);
+    assert_true(fabs(summary.max - 5.0) < 1e-12);
+}
+
+/**
+ * @brief Test a batch across slots matches updating each slot on its own
+ */
+static void test_filter_batch(void **state) {
+    (void)state;
+    const uint16_t slots[] = { 4, 5, 6 };
+    double raw[3];
+    double value[3];
+    bool published[3];
+    double single[3][6];
+    bool single_published = false;
+
+    for (int pass = 0; pass < 2; pass++) {
+        sensor_filter_reset();
+        assert_int_equal(configure(4, SENSOR_FILTER_IIR, 0U, 2U, 0.25), SMART_QSO_OK);
+        assert_int_equal(configure(5, SENSOR_FILTER_MEDIAN, 5U, 1U, 0.0), SMART_QSO_OK);
+        assert_int_equal(configure(6, SENSOR_FILTER_MOVING_AVERAGE, 3U, 3U, 0.0), SMART_QSO_OK);
+
+        for (size_t t = 0; t < 6; t++) {
+            for (size_t n = 0; n < 3; n++) {
+                raw[n] = (double)((t * 7U + n * 3U) % 11U);
+            }
+            if (pass == 0) {
+                for (size_t n = 0; n < 3; n++) {
+                    single[n][t] = update_one(slots[n], raw[n], &single_published);
+                }
+            } else {
+                sensor_filter_update(slots, raw, 3U, value, published);
+                for (size_t n = 0; n < 3; n++) {
+                    assert_memory_equal(&value[n], &single[n][t], sizeof(double));
+                }
+                assert_true(published[0] == ((t % 2U) == 1U));
+                assert_true(published[1]);
+                assert_true(published[2] == ((t % 3U) == 2U));
+            }
+        }
+    }
+}
+
+/*===========================================================================*/
+/* Test Runner                                                                */
+/*===========================================================================*/
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup(test_filter_parse_kind, setup),
+        cmocka_unit_test_setup(test_filter_configure_limits, setup),
+        cmocka_unit_test_setup(test_filter_passthrough, setup),
+        cmocka_unit_test_setup(test_filter_moving_average, setup),
+        cmocka_unit_test_setup(test_filter_median, setup),
+        cmocka_unit_test_setup(test_filter_iir, setup),
+        cmocka_unit_test_setup(test_filter_decimation_summary, setup),
+        cmocka_unit_test_setup(test_filter_batch, setup),
+    };
+
+    return cmocka_run_group_tests_name("Sensor Filter Tests", tests, NULL, NULL);
+}
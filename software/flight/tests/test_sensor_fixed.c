@@ -0,0 +1,107 @@
+/**
+ * @file test_sensor_fixed.c
+ * @brief Unit tests for fixed-point sensor values
+ *
+ * @requirement SRS-SENS-001 System shall support configurable sensor framework
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+/* Include the module under test */
+#include "smart_qso.h"
+#include "sensor_fixed.h"
+
+/*===========================================================================*/
+/* Test Cases                                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief Test conversion rounds half away from zero and saturates
+ */
+static void test_fixed_from_double(void **state) {
+    (void)state;
+
+    assert_int_equal(sensor_fixed_from_double(12.345, 3U), 12345);
+    assert_int_equal(sensor_fixed_from_double(-12.345, 3U), -12345);
+    assert_int_equal(sensor_fixed_from_double(0.0005, 3U), 1);
+    assert_int_equal(sensor_fixed_from_double(-0.0005, 3U), -1);
+    assert_int_equal(sensor_fixed_from_double(0.00049, 3U), 0);
+    assert_int_equal(sensor_fixed_from_double(0.49999999999999994, 0U), 0);
+    assert_int_equal(sensor_fixed_from_double(7.6, 0U), 8);
+    assert_int_equal(sensor_fixed_from_double(1.5, 6U), 1500000);
+
+    assert_int_equal(sensor_fixed_from_double(3.0e6, 3U), INT32_MAX);
+    assert_int_equal(sensor_fixed_from_double(-3.0e6, 3U), INT32_MIN);
+    assert_int_equal(sensor_fixed_from_double(NAN, 3U), 0);
+}
+
+/**
+ * @brief Test rescaling between decimal places
+ */
+static void test_fixed_rescale(void **state) {
+    (void)state;
+
+    assert_int_equal(sensor_fixed_rescale(12345, 3U, 3U), 12345);
+    assert_int_equal(sensor_fixed_rescale(12345, 3U, 5U), 1234500);
+    assert_int_equal(sensor_fixed_rescale(12345, 3U, 1U), 123);
+    assert_int_equal(sensor_fixed_rescale(12350, 3U, 1U), 124);
+    assert_int_equal(sensor_fixed_rescale(-12350, 3U, 1U), -124);
+    assert_int_equal(sensor_fixed_rescale(-12349, 3U, 1U), -123);
+    assert_int_equal(sensor_fixed_rescale(499999, 6U, 0U), 0);
+    assert_int_equal(sensor_fixed_rescale(500000, 6U, 0U), 1);
+
+    assert_int_equal(sensor_fixed_rescale(INT32_MAX, 0U, 6U), INT32_MAX);
+    assert_int_equal(sensor_fixed_rescale(INT32_MIN, 0U, 1U), INT32_MIN);
+
+    assert_int_equal(sensor_fixed_to_i16(32767), 32767);
+    assert_int_equal(sensor_fixed_to_i16(40000), INT16_MAX);
+    assert_int_equal(sensor_fixed_to_i16(-40000), INT16_MIN);
+}
+
+/**
+ * @brief Test formatting matches "%.<decimals>f" of the scaled value
+ */
+static void test_fixed_format(void **state) {
+    (void)state;
+    char text[SENSOR_FIXED_TEXT_MAX];
+    char ref[32];
+
+    static const int32_t values[] = {
+        0, 1, -1, 9, 10, 999, 1000, -1000, 12345, -12345, 1000000, INT32_MAX, INT32_MIN
+    };
+
+    for (uint8_t decimals = 0; decimals <= SENSOR_FIXED_MAX_DECIMALS; decimals++) {
+        double scale = pow(10.0, (double)decimals);
+        for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+            size_t len = sensor_fixed_format(values[i], decimals, text);
+            (void)snprintf(ref, sizeof(ref), "%.*f", (int)decimals, (double)values[i] / scale);
+            assert_string_equal(text, ref);
+            assert_int_equal(len, strlen(ref));
+            assert_true(len < SENSOR_FIXED_TEXT_MAX);
+        }
+    }
+
+    assert_int_equal(sensor_fixed_format(-5, 3U, text), 6);
+    assert_string_equal(text, "-0.005");
+}
+
+/*===========================================================================*/
+/* Test Runner                                                                */
+/*===========================================================================*/
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_fixed_from_double),
+        cmocka_unit_test(test_fixed_rescale),
+        cmocka_unit_test(test_fixed_format),
+    };
+
+    return cmocka_run_group_tests_name("Sensor Fixed Tests", tests, NULL, NULL);
+}
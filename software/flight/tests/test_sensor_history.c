@@ -0,0 +1,148 @@
+/**
+ * @file test_sensor_history.c
+ * @brief Unit tests for the per-sensor sample history
+ *
+ * @requirement SRS-F071 Sample sensors at configurable rates
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <string.h>
+#include <math.h>
+
+/* Include the module under test */
+#include "smart_qso.h"
+#include "sensor_history.h"
+
+/*===========================================================================*/
+/* Test Fixtures                                                              */
+/*===========================================================================*/
+
+static int setup(void **state) {
+    (void)state;
+    sensor_history_reset();
+    return 0;
+}
+
+/**
+ * @brief Push samples t = 100 * k, value = k for k in [first, last]
+ */
+static void push_range(size_t slot, unsigned first, unsigned last) {
+    for (unsigned k = first; k <= last; k++) {
+        sensor_history_push(slot, 100U * (uint64_t)k, (double)k);
+    }
+}
+
+/**
+ * @brief Check samples are consecutive pushes starting at k = first
+ */
+static void assert_run(const SensorSample_t *samples, size_t count, unsigned first) {
+    for (size_t i = 0; i < count; i++) {
+        assert_int_equal(samples[i].timestamp_ms, 100U * (first + i));
+        assert_true(fabs(samples[i].value - (double)(first + i)) < 1e-12);
+    }
+}
+
+/*===========================================================================*/
+/* Test Cases                                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief Test depth limits, pool exhaustion and single configuration
+ */
+static void test_history_configure(void **state) {
+    (void)state;
+
+    assert_int_equal(sensor_history_configure(0, SENSOR_HISTORY_MAX_DEPTH + 1U),
+                     SMART_QSO_ERROR_PARAM);
+    assert_int_equal(sensor_history_configure(SMART_QSO_MAX_SENSORS, 1U), SMART_QSO_ERROR_PARAM);
+    assert_int_equal(sensor_history_configure(0, 4U), SMART_QSO_OK);
+    assert_int_equal(sensor_history_configure(0, 4U), SMART_QSO_ERROR_INVALID);
+    assert_int_equal(sensor_history_depth(0), 4);
+    assert_int_equal(sensor_history_free(), SENSOR_HISTORY_POOL_SIZE - 4U);
+
+    /* Fill the pool, then nothing more fits */
+    size_t slot = 1;
+    while (sensor_history_free() >= SENSOR_HISTORY_MAX_DEPTH) {
+        assert_int_equal(sensor_history_configure(slot++, SENSOR_HISTORY_MAX_DEPTH), SMART_QSO_OK);
+    }
+    uint16_t rest = (uint16_t)sensor_history_free();
+    assert_int_equal(sensor_history_configure(slot, (uint16_t)(rest + 1U)), SMART_QSO_ERROR_NO_MEM);
+    assert_int_equal(sensor_history_configure(slot, rest), SMART_QSO_OK);
+
+    sensor_history_reset();
+    assert_int_equal(sensor_history_free(), SENSOR_HISTORY_POOL_SIZE);
+    assert_int_equal(sensor_history_depth(0), 0);
+}
+
+/**
+ * @brief Test the last N samples come back oldest first across the wrap
+ */
+static void test_history_last(void **state) {
+    (void)state;
+    SensorSample_t samples[8];
+
+    assert_int_equal(sensor_history_configure(0, 2U), SMART_QSO_OK);
+    assert_int_equal(sensor_history_configure(1, 5U), SMART_QSO_OK);
+    assert_int_equal(sensor_history_last(1, 8U, samples), 0);
+
+    push_range(1, 1U, 3U);
+    assert_int_equal(sensor_history_last(1, 8U, samples), 3);
+    assert_run(samples, 3U, 1U);
+
+    push_range(1, 4U, 12U);
+    assert_int_equal(sensor_history_last(1, 8U, samples), 5);
+    assert_run(samples, 5U, 8U);
+    assert_int_equal(sensor_history_last(1, 2U, samples), 2);
+    assert_run(samples, 2U, 11U);
+
+    /* The neighbouring ring is untouched */
+    assert_int_equal(sensor_history_last(0, 8U, samples), 0);
+
+    /* A slot without a ring keeps nothing */
+    push_range(2, 1U, 3U);
+    assert_int_equal(sensor_history_last(2, 8U, samples), 0);
+}
+
+/**
+ * @brief Test samples after a time, paging through more than fit
+ */
+static void test_history_since(void **state) {
+    (void)state;
+    SensorSample_t samples[8];
+
+    assert_int_equal(sensor_history_configure(0, 6U), SMART_QSO_OK);
+    push_range(0, 1U, 10U);
+
+    /* Ring holds k = 5..10 */
+    assert_int_equal(sensor_history_since(0, 700U, 8U, samples), 3);
+    assert_run(samples, 3U, 8U);
+    assert_int_equal(sensor_history_since(0, 750U, 8U, samples), 3);
+    assert_run(samples, 3U, 8U);
+    assert_int_equal(sensor_history_since(0, 1000U, 8U, samples), 0);
+    assert_int_equal(sensor_history_since(0, 0U, 8U, samples), 6);
+    assert_run(samples, 6U, 5U);
+
+    /* Oldest first when more match than fit; continue from the last seen */
+    assert_int_equal(sensor_history_since(0, 0U, 4U, samples), 4);
+    assert_run(samples, 4U, 5U);
+    assert_int_equal(sensor_history_since(0, samples[3].timestamp_ms, 4U, samples), 2);
+    assert_run(samples, 2U, 9U);
+}
+
+/*===========================================================================*/
+/* Test Runner                                                                */
+/*===========================================================================*/
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup(test_history_configure, setup),
+        cmocka_unit_test_setup(test_history_last, setup),
+        cmocka_unit_test_setup(test_history_since, setup),
+    };
+
+    return cmocka_run_group_tests_name("Sensor History Tests", tests, NULL, NULL);
+}
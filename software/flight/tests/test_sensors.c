@@ -24,6 +24,8 @@
 /* Include the module under test */
 #include "smart_qso.h"
 #include "sensors.h"
+#include "adcs_control.h"
+#include "hal/hal.h"
 
 /*===========================================================================*/
 /* Test Fixtures                                                              */
@@ -70,6 +72,214 @@ static void test_sensors_load_yaml_missing(void **state) {
     assert_int_equal(result, SMART_QSO_ERROR_IO);
 }
 
+/**
+ * @brief Test a YAML table loads with every field, including the IDs on
+ *        the list item lines
+ */
+static void test_sensors_load_yaml_fields(void **state) {
+    (void)state;
+    const char *path = "/tmp/smart_qso_test_sensors.yaml";
+
+    FILE *f = fopen(path, "w");
+    assert_non_null(f);
+    fprintf(f, "# test table\nsensors:\n"
+               "  - id: BV\n    name: Battery Voltage\n    type: eps_voltage\n"
+               "    channel: battery\n    units: V\n    period_ms: 1000\n"
+               "  -\n    id: ST\n    name: \"Status Hex\"\n    type: status_hex2\n"
+               "    units: hex\n    period_ms: 2000\n");
+    fclose(f);
+
+    assert_int_equal(sensors_load_yaml(path), SMART_QSO_OK);
+    assert_int_equal(sensors_get_count(), 2);
+
+    Sensor_t sensor;
+    assert_int_equal(sensors_get_by_id("BV", &sensor), SMART_QSO_OK);
+    assert_string_equal(sensor.name, "Battery Voltage");
+    assert_string_equal(sensor.channel, "battery");
+    assert_string_equal(sensor.units, "V");
+    assert_int_equal(sensor.period_ms, 1000);
+    assert_int_equal(sensor.value_type, SENSOR_VALUE_NUMERIC);
+
+    assert_int_equal(sensors_get_by_id("ST", &sensor), SMART_QSO_OK);
+    assert_string_equal(sensor.name, "Status Hex");
+    assert_int_equal(sensor.value_type, SENSOR_VALUE_HEX2);
+
+    /* The view's read function samples the same channel */
+    double value = 0.0;
+    char text[8] = {0};
+    assert_int_equal(sensors_get(0, &sensor), SMART_QSO_OK);
+    assert_non_null(sensor.read);
+    assert_true(sensor.read(&sensor, &value, text));
+    assert_true(value > 7.0 && value < 9.0);
+
+    unlink(path);
+}
+
+/**
+ * @brief Test filter and decimation settings load, and a sensor with an
+ *        unknown filter is skipped
+ *
+ * @requirement SRS-F071 Sample sensors at configurable rates
+ */
+static void test_sensors_load_yaml_filter(void **state) {
+    (void)state;
+    const char *path = "/tmp/smart_qso_test_sensors.yaml";
+
+    FILE *f = fopen(path, "w");
+    assert_non_null(f);
+    fprintf(f, "sensors:\n"
+               "  - id: BV\n    type: eps_voltage\n    channel: battery\n    units: V\n"
+               "    period_ms: 1000\n    filter: median\n    filter_length: 5\n"
+               "    decimation: 3\n"
+               "  - id: BUSV\n    type: eps_voltage\n    channel: bus\n    units: V\n"
+               "    period_ms: 1000\n    filter: iir\n    filter_alpha: 0.25\n"
+               "  - id: BT\n    type: eps_temperature\n    units: C\n    filter: kalman\n");
+    fclose(f);
+
+    assert_int_equal(sensors_load_yaml(path), SMART_QSO_OK);
+    assert_int_equal(sensors_get_count(), 2);
+
+    Sensor_t sensor;
+    assert_int_equal(sensors_get_by_id("BV", &sensor), SMART_QSO_OK);
+    assert_int_equal(sensor.filter.kind, SENSOR_FILTER_MEDIAN);
+    assert_int_equal(sensor.filter.length, 5);
+    assert_int_equal(sensor.filter.decimation, 3);
+    assert_int_equal(sensors_get_by_id("BUSV", &sensor), SMART_QSO_OK);
+    assert_int_equal(sensor.filter.kind, SENSOR_FILTER_IIR);
+    assert_true(fabs(sensor.filter.alpha - 0.25) < 1e-12);
+
+    /* BV publishes once every third poll, with its window summary */
+    SensorSummary_t summary;
+    char buffer[256];
+    for (uint64_t t = 1000U; t <= 2000U; t += 1000U) {
+        assert_int_equal(sensors_poll(t), 2);
+        assert_int_equal(sensors_get_by_id("BV", &sensor), SMART_QSO_OK);
+        assert_true(fabs(sensor.last_value) < 1e-12);
+    }
+    assert_int_equal(sensors_get_summary(0, &summary), SMART_QSO_OK);
+    assert_int_equal(summary.samples, 0);
+    sensors_format_telemetry(buffer, sizeof(buffer));
+    assert_null(strstr(buffer, "BV_MIN="));
+
+    assert_int_equal(sensors_poll(3000U), 2);
+    assert_int_equal(sensors_get_by_id("BV", &sensor), SMART_QSO_OK);
+    assert_true(sensor.last_value > 7.0 && sensor.last_value < 9.0);
+    assert_int_equal(sensors_get_summary(0, &summary), SMART_QSO_OK);
+    assert_int_equal(summary.samples, 3);
+    assert_true(summary.min <= summary.mean && summary.mean <= summary.max);
+
+    sensors_format_telemetry(buffer, sizeof(buffer));
+    assert_non_null(strstr(buffer, "BV_MIN="));
+    assert_non_null(strstr(buffer, "BV_AVG="));
+    assert_null(strstr(buffer, "BUSV_MIN="));
+
+    unlink(path);
+}
+
+/**
+ * Image compiled from a two-sensor table (BV with an IIR filter and
+ * decimation 2, ST). Must match SHARED_IMAGE in
+ * software/ground/tests/test_sensor_image_compiler.py.
+ */
+static const uint8_t s_shared_image[] = {
+    0x43, 0x53, 0x51, 0x53, 0x02, 0x00, 0x02, 0x00, 0x27, 0x00, 0x00, 0x00,
+    0x69, 0x9D, 0x53, 0x42, 0x02, 0x01, 0x02, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x03, 0x00, 0x13, 0x00, 0xE8, 0x03, 0x00, 0x00, 0x90, 0xD0, 0x03, 0x00,
+    0x00, 0x00, 0x03, 0x00, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x15, 0x00,
+    0x18, 0x00, 0x23, 0x00, 0xD0, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x03, 0x00, 0x42, 0x56, 0x00, 0x42, 0x61, 0x74, 0x74, 0x65,
+    0x72, 0x79, 0x20, 0x56, 0x6F, 0x6C, 0x74, 0x61, 0x67, 0x65, 0x00, 0x56,
+    0x00, 0x53, 0x54, 0x00, 0x53, 0x74, 0x61, 0x74, 0x75, 0x73, 0x20, 0x48,
+    0x65, 0x78, 0x00, 0x68, 0x65, 0x78, 0x00,
+};
+
+/**
+ * @brief Test a compiled configuration image loads with types, channels
+ *        and filters resolved
+ *
+ * @requirement SRS-SENS-001 System shall support configurable sensor framework
+ */
+static void test_sensors_load_image(void **state) {
+    (void)state;
+    Sensor_t sensor;
+
+    assert_int_equal(sensors_load_image(s_shared_image, sizeof(s_shared_image)), SMART_QSO_OK);
+    assert_int_equal(sensors_get_count(), 2);
+
+    assert_int_equal(sensors_get(0, &sensor), SMART_QSO_OK);
+    assert_string_equal(sensor.id, "BV");
+    assert_string_equal(sensor.name, "Battery Voltage");
+    assert_string_equal(sensor.type, "eps_voltage");
+    assert_string_equal(sensor.channel, "battery");
+    assert_string_equal(sensor.units, "V");
+    assert_int_equal(sensor.period_ms, 1000);
+    assert_int_equal(sensor.value_type, SENSOR_VALUE_NUMERIC);
+    assert_int_equal(sensor.filter.kind, SENSOR_FILTER_IIR);
+    assert_int_equal(sensor.filter.decimation, 2);
+    assert_true(fabs(sensor.filter.alpha - 0.25) < 1e-12);
+
+    assert_int_equal(sensors_get(1, &sensor), SMART_QSO_OK);
+    assert_string_equal(sensor.id, "ST");
+    assert_string_equal(sensor.channel, "");
+    assert_int_equal(sensor.period_ms, 2000);
+    assert_int_equal(sensor.value_type, SENSOR_VALUE_HEX2);
+
+    /* The bound sensors read their channels */
+    assert_int_equal(sensors_poll(1000U), 2);
+    assert_int_equal(sensors_poll(2000U), 1);
+    assert_int_equal(sensors_get(0, &sensor), SMART_QSO_OK);
+    assert_true(sensor.last_value > 7.0 && sensor.last_value < 9.0);
+}
+
+/**
+ * @brief Test corrupt or incomplete images are rejected without adding
+ *        any sensor
+ */
+static void test_sensors_load_image_corrupt(void **state) {
+    (void)state;
+    uint8_t image[sizeof(s_shared_image)];
+
+    assert_int_equal(sensors_load_image(s_shared_image, sizeof(s_shared_image) - 1U),
+                     SMART_QSO_ERROR_TRUNCATED);
+    assert_int_equal(sensors_load_image(s_shared_image, 8U), SMART_QSO_ERROR_INVALID);
+
+    /* Any flipped bit fails the CRC */
+    for (size_t i = 0; i < sizeof(image); i++) {
+        if ((i >= 6U) && (i < 10U)) {
+            continue;   /* Count and pool size change the length checked */
+        }
+        memcpy(image, s_shared_image, sizeof(image));
+        image[i] ^= 0x10U;
+        assert_int_not_equal(sensors_load_image(image, sizeof(image)), SMART_QSO_OK);
+    }
+    assert_int_equal(sensors_get_count(), 0);
+}
+
+/**
+ * @brief Test an image stored in FLASH_REGION_SENSOR_CONFIG loads at boot
+ */
+static void test_sensors_load_flash(void **state) {
+    (void)state;
+    uint8_t image[sizeof(s_shared_image)];
+
+    assert_int_equal(hal_flash_init(), SMART_QSO_OK);
+    assert_int_equal(hal_flash_erase(FLASH_REGION_SENSOR_CONFIG), SMART_QSO_OK);
+    assert_int_equal(sensors_load_flash(), SMART_QSO_ERROR);
+
+    /* A corrupt upload is not stored */
+    memcpy(image, s_shared_image, sizeof(image));
+    image[sizeof(image) - 2U] ^= 0x01U;
+    assert_int_equal(sensors_store_image(image, sizeof(image)), SMART_QSO_ERROR_INVALID);
+
+    assert_int_equal(sensors_store_image(s_shared_image, sizeof(s_shared_image)), SMART_QSO_OK);
+    assert_int_equal(sensors_load_flash(), SMART_QSO_OK);
+    assert_int_equal(sensors_get_count(), 2);
+
+    Sensor_t sensor;
+    assert_int_equal(sensors_get_by_id("ST", &sensor), SMART_QSO_OK);
+    assert_string_equal(sensor.type, "status_hex2");
+}
+
 /*===========================================================================*/
 /* Test Cases: Sensor Polling                                                 */
 /*===========================================================================*/
@@ -115,6 +325,128 @@ static void test_sensors_poll_timing(void **state) {
     assert_true(second_poll <= first_poll);
 }
 
+/**
+ * @brief Test only due sensors are polled and the next deadline is reported
+ *
+ * @requirement SRS-F071 Sample sensors at configurable rates
+ */
+static void test_sensors_poll_queue(void **state) {
+    (void)state;
+
+    /* No sensors: nothing ever due */
+    assert_int_equal(sensors_next_poll_ms(), UINT64_MAX);
+
+    sensors_load_defaults();
+    size_t count = sensors_get_count();
+
+    /* Everything due on the first poll; BT has a 2 s period, the rest 1 s */
+    assert_int_equal(sensors_poll(1000U), count);
+    assert_int_equal(sensors_next_poll_ms(), 2000U);
+    assert_int_equal(sensors_poll(1999U), 0);
+    assert_int_equal(sensors_poll(2000U), count - 1U);
+    assert_int_equal(sensors_next_poll_ms(), 3000U);
+
+    /* A late poll catches up once and reschedules from the poll time */
+    assert_int_equal(sensors_poll(4500U), count);
+    assert_int_equal(sensors_next_poll_ms(), 5500U);
+
+    Sensor_t sensor;
+    assert_int_equal(sensors_get_by_id("BT", &sensor), SMART_QSO_OK);
+    assert_int_equal(sensor.next_poll_ms, 6500U);
+}
+
+/**
+ * @brief Test due ADC sensors are sampled in one multi-channel scan
+ *
+ * @requirement SRS-F070 Collect telemetry from all sensors
+ */
+static void test_sensors_poll_adc_batch(void **state) {
+    (void)state;
+    HalAdcSimStats_t stats;
+
+    sensors_load_defaults();
+    sensors_set_environment(true, 0.75);
+
+    /* BV, BUSV, BDI, SPV and SPC share one scan; JPC is not on the ADC */
+    assert_int_equal(sensors_poll(1000U), sensors_get_count());
+    assert_int_equal(hal_adc_sim_get_stats(&stats), SMART_QSO_OK);
+    assert_int_equal(stats.transactions, 1);
+    assert_int_equal(stats.conversions, 5);
+
+    Sensor_t sensor;
+    assert_int_equal(sensors_get_by_id("BV", &sensor), SMART_QSO_OK);
+    assert_true(fabs(sensor.last_value - 8.1375) < 0.02);
+    assert_int_equal(sensors_get_by_id("BDI", &sensor), SMART_QSO_OK);
+    assert_true(fabs(sensor.last_value - 0.05) < 0.005);
+    assert_int_equal(sensors_get_by_id("BUSV", &sensor), SMART_QSO_OK);
+    assert_true(fabs(sensor.last_value - 5.0) < 0.02);
+
+    /* Still one scan when only some sensors are due */
+    assert_int_equal(sensors_poll(2000U), sensors_get_count() - 1U);
+    hal_adc_sim_get_stats(&stats);
+    assert_int_equal(stats.transactions, 2);
+    assert_int_equal(stats.conversions, 10);
+
+    /* A single-sensor read samples only its own channel */
+    assert_int_equal(sensors_poll_one(1U), SMART_QSO_OK);
+    hal_adc_sim_get_stats(&stats);
+    assert_int_equal(stats.transactions, 3);
+    assert_int_equal(stats.conversions, 11);
+}
+
+/**
+ * @brief Test ADCS sensors bind through the driver registry and are read
+ *        one measurement per driver; unknown types are skipped
+ *
+ * @requirement SRS-F070 Collect telemetry from all sensors
+ */
+static void test_sensors_poll_adcs_drivers(void **state) {
+    (void)state;
+    const char *path = "/tmp/smart_qso_test_sensors.yaml";
+    const Vec3_t mag = {12.5, -3.0, 41.0};
+    const Vec3_t sun = {0.0, 2.0, 0.0};
+
+    FILE *f = fopen(path, "w");
+    assert_non_null(f);
+    fprintf(f, "sensors:\n"
+               "  - id: MAGX\n    type: magnetometer\n    channel: x\n    units: uT\n"
+               "  - id: IMU\n    type: imu\n    channel: x\n"
+               "  - id: MAGZ\n    type: magnetometer\n    channel: z\n    units: uT\n"
+               "  - id: SUNY\n    type: sun_sensor\n    channel: y\n"
+               "  - id: MAGB\n    type: magnetometer\n    channel: battery\n");
+    fclose(f);
+    adcs_set_sim_sensors(&mag, &sun, NULL);
+
+    assert_int_equal(sensors_load_yaml(path), SMART_QSO_OK);
+    assert_int_equal(sensors_get_count(), 4);
+
+    Sensor_t sensor;
+    assert_int_equal(sensors_get_by_id("IMU", &sensor), SMART_QSO_ERROR);
+    assert_int_equal(sensors_get_by_id("MAGZ", &sensor), SMART_QSO_OK);
+    assert_string_equal(sensor.type, "magnetometer");
+    assert_int_equal(sensor.value_type, SENSOR_VALUE_NUMERIC);
+
+    /* MAGB has no such axis: it stays configured but never reads */
+    assert_int_equal(sensors_poll(1000U), 3);
+    assert_int_equal(sensors_get_by_id("MAGX", &sensor), SMART_QSO_OK);
+    assert_true(fabs(sensor.last_value - 12.5) < 1e-9);
+    assert_int_equal(sensors_get_by_id("MAGZ", &sensor), SMART_QSO_OK);
+    assert_true(fabs(sensor.last_value - 41.0) < 1e-9);
+    assert_int_equal(sensors_get_by_id("SUNY", &sensor), SMART_QSO_OK);
+    assert_true(fabs(sensor.last_value - 1.0) < 1e-9);
+
+    /* The view reads through the same driver */
+    double value = 0.0;
+    char text[8] = {0};
+    assert_int_equal(sensors_get_by_id("MAGX", &sensor), SMART_QSO_OK);
+    assert_true(sensor.read(&sensor, &value, text));
+    assert_true(fabs(value - 12.5) < 1e-9);
+    assert_int_equal(sensors_get_by_id("MAGB", &sensor), SMART_QSO_OK);
+    assert_false(sensor.read(&sensor, &value, text));
+
+    unlink(path);
+}
+
 /*===========================================================================*/
 /* Test Cases: Sensor Access                                                  */
 /*===========================================================================*/
@@ -134,6 +466,205 @@ static void test_sensors_get_by_id_unknown(void **state) {
     assert_int_not_equal(result, SMART_QSO_OK);
 }
 
+/**
+ * @brief Test published values are timestamped and kept in the sensor's
+ *        history, read back by count and by time
+ *
+ * @requirement SRS-F071 Sample sensors at configurable rates
+ */
+static void test_sensors_history(void **state) {
+    (void)state;
+    const char *path = "/tmp/smart_qso_test_sensors.yaml";
+    SensorHandle_t handle = SENSOR_HANDLE_INVALID;
+    SensorSample_t samples[4];
+    size_t count = 0;
+    Sensor_t sensor;
+
+    FILE *f = fopen(path, "w");
+    assert_non_null(f);
+    fprintf(f, "sensors:\n"
+               "  - id: BV\n    type: eps_voltage\n    channel: battery\n"
+               "    period_ms: 1000\n    decimation: 2\n    history: 3\n"
+               "  - id: ST\n    type: status_hex2\n    period_ms: 1000\n    history: 4\n"
+               "  - id: BUSV\n    type: eps_voltage\n    channel: bus\n    history: 65\n");
+    fclose(f);
+
+    /* A depth above the limit rejects the sensor; text sensors keep none */
+    assert_int_equal(sensors_load_yaml(path), SMART_QSO_OK);
+    assert_int_equal(sensors_get_count(), 2);
+    assert_int_equal(sensors_get_by_id("ST", &sensor), SMART_QSO_OK);
+    assert_int_equal(sensor.history, 0);
+    assert_int_equal(sensor.last_update_ms, 0);
+
+    assert_int_equal(sensors_find("BV", &handle), SMART_QSO_OK);
+    assert_int_equal(sensors_get_samples(handle, 4U, samples, &count), SMART_QSO_OK);
+    assert_int_equal(count, 0);
+
+    /* Every other sample is published: at 2000, 4000, 6000 and 8000 */
+    for (uint64_t t = 1000U; t <= 8000U; t += 1000U) {
+        (void)sensors_poll(t);
+    }
+    assert_int_equal(sensors_get_by_handle(handle, &sensor), SMART_QSO_OK);
+    assert_int_equal(sensor.history, 3);
+    assert_int_equal(sensor.last_update_ms, 8000);
+    assert_int_equal(sensors_get_by_id("ST", &sensor), SMART_QSO_OK);
+    assert_int_equal(sensor.last_update_ms, 8000);
+
+    assert_int_equal(sensors_get_samples(handle, 4U, samples, &count), SMART_QSO_OK);
+    assert_int_equal(count, 3);
+    assert_int_equal(samples[0].timestamp_ms, 4000);
+    assert_int_equal(samples[2].timestamp_ms, 8000);
+    assert_true(samples[2].value > 7.0 && samples[2].value < 9.0);
+    assert_int_equal(sensors_get_samples(handle, 1U, samples, &count), SMART_QSO_OK);
+    assert_int_equal(count, 1);
+    assert_int_equal(samples[0].timestamp_ms, 8000);
+
+    assert_int_equal(sensors_get_samples_since(handle, 4000U, 4U, samples, &count),
+                     SMART_QSO_OK);
+    assert_int_equal(count, 2);
+    assert_int_equal(samples[0].timestamp_ms, 6000);
+    assert_int_equal(sensors_get_samples_since(handle, 8000U, 4U, samples, &count),
+                     SMART_QSO_OK);
+    assert_int_equal(count, 0);
+    assert_int_equal(sensors_get_samples(SENSOR_HANDLE_INVALID, 4U, samples, &count),
+                     SMART_QSO_ERROR_INVALID);
+
+    unlink(path);
+}
+
+/**
+ * @brief Test handles read a sensor without its ID and go stale on reload
+ */
+static void test_sensors_find_handle(void **state) {
+    (void)state;
+    SensorHandle_t handle = SENSOR_HANDLE_INVALID;
+    Sensor_t sensor;
+    double value = 0.0;
+
+    assert_int_equal(sensors_load_defaults(), SMART_QSO_OK);
+    assert_int_equal(sensors_find("BV", &handle), SMART_QSO_OK);
+    assert_int_not_equal(handle, SENSOR_HANDLE_INVALID);
+    assert_int_equal(sensors_find("XX", &handle), SMART_QSO_ERROR);
+
+    assert_int_equal(sensors_find("BV", &handle), SMART_QSO_OK);
+    assert_int_equal(sensors_poll(1000U), sensors_get_count());
+    assert_int_equal(sensors_get_by_handle(handle, &sensor), SMART_QSO_OK);
+    assert_string_equal(sensor.id, "BV");
+    assert_int_equal(sensors_get_value(handle, &value), SMART_QSO_OK);
+    assert_memory_equal(&value, &sensor.last_value, sizeof(value));
+    assert_true(value > 7.0 && value < 9.0);
+
+    assert_int_equal(sensors_get_value(SENSOR_HANDLE_INVALID, &value), SMART_QSO_ERROR_INVALID);
+
+    /* Reloading the table invalidates old handles */
+    assert_int_equal(sensors_init(), SMART_QSO_OK);
+    assert_int_equal(sensors_load_defaults(), SMART_QSO_OK);
+    assert_int_equal(sensors_get_value(handle, &value), SMART_QSO_ERROR_INVALID);
+    assert_int_equal(sensors_get_by_handle(handle, &sensor), SMART_QSO_ERROR_INVALID);
+}
+
+/**
+ * @brief Test values are published in fixed point with each sensor's
+ *        decimals, formatted and packed from it
+ *
+ * @requirement SRS-F073 Include telemetry in beacon transmissions
+ */
+static void test_sensors_fixed_point(void **state) {
+    (void)state;
+    const char *path = "/tmp/smart_qso_test_sensors.yaml";
+    SensorHandle_t handles[3] = {SENSOR_HANDLE_INVALID, SENSOR_HANDLE_INVALID,
+                                 SENSOR_HANDLE_INVALID};
+    Sensor_t sensor;
+    double value = 0.0;
+    int32_t fixed = 0;
+    uint8_t decimals = 0;
+    uint16_t fields[3];
+    char buffer[128];
+    char expected[32];
+
+    FILE *f = fopen(path, "w");
+    assert_non_null(f);
+    fprintf(f, "sensors:\n"
+               "  - id: BV\n    type: eps_voltage\n    channel: battery\n    units: V\n"
+               "    period_ms: 1000\n    decimals: 2\n"
+               "  - id: BUSV\n    type: eps_voltage\n    channel: bus\n    units: V\n"
+               "    period_ms: 1000\n"
+               "  - id: BAD\n    type: eps_voltage\n    channel: bus\n    decimals: 7\n");
+    fclose(f);
+
+    assert_int_equal(sensors_load_yaml(path), SMART_QSO_OK);
+    assert_int_equal(sensors_get_count(), 2);
+    assert_int_equal(sensors_get(0, &sensor), SMART_QSO_OK);
+    assert_int_equal(sensor.decimals, 2);
+    assert_int_equal(sensors_get(1, &sensor), SMART_QSO_OK);
+    assert_int_equal(sensor.decimals, SENSOR_FIXED_DEFAULT_DECIMALS);
+
+    assert_int_equal(sensors_find("BV", &handles[0]), SMART_QSO_OK);
+    assert_int_equal(sensors_find("BUSV", &handles[1]), SMART_QSO_OK);
+    assert_int_equal(sensors_poll(1000U), 2);
+
+    assert_int_equal(sensors_get_value(handles[0], &value), SMART_QSO_OK);
+    assert_int_equal(sensors_get_fixed(handles[0], &fixed, &decimals), SMART_QSO_OK);
+    assert_int_equal(decimals, 2);
+    assert_int_equal(fixed, sensor_fixed_from_double(value, 2U));
+    assert_int_equal(sensors_get_fixed(SENSOR_HANDLE_INVALID, &fixed, &decimals),
+                     SMART_QSO_ERROR_INVALID);
+
+    /* Telemetry prints each value with its sensor's decimals */
+    assert_true(sensors_format_telemetry(buffer, sizeof(buffer)) > 0U);
+    (void)snprintf(expected, sizeof(expected), "BV=%.2fV,BUSV=", value);
+    assert_memory_equal(buffer, expected, strlen(expected));
+
+    /* Fields are rescaled to their own decimals; a stale handle packs 0 */
+    fields[2] = 0xFFFFU;
+    assert_int_equal(sensors_pack_i16(handles, 3U, 1U, fields), SMART_QSO_ERROR_INVALID);
+    assert_int_equal((int16_t)fields[0], sensor_fixed_rescale(fixed, 2U, 1U));
+    assert_int_equal(fields[2], 0);
+    assert_int_equal(sensors_pack_i16(handles, 2U, 1U, fields), SMART_QSO_OK);
+    assert_int_equal(sensors_pack_i16(handles, 2U, SENSOR_FIXED_MAX_DECIMALS + 1U, fields),
+                     SMART_QSO_ERROR_PARAM);
+
+    unlink(path);
+}
+
+/**
+ * @brief Test every ID of a full table is found, and a repeated ID finds
+ *        the first sensor registered with it
+ */
+static void test_sensors_find_full_table(void **state) {
+    (void)state;
+    const char *path = "/tmp/smart_qso_test_sensors.yaml";
+    char id[SMART_QSO_SENSOR_ID_LEN];
+    SensorHandle_t handle;
+    Sensor_t sensor;
+
+    FILE *f = fopen(path, "w");
+    assert_non_null(f);
+    fprintf(f, "sensors:\n");
+    for (unsigned i = 0; i < SMART_QSO_MAX_SENSORS; i++) {
+        fprintf(f, "  - id: S%02u\n    name: Sensor %u\n    type: software_timer\n",
+                i % (SMART_QSO_MAX_SENSORS - 1U), i);
+    }
+    fclose(f);
+
+    assert_int_equal(sensors_load_yaml(path), SMART_QSO_OK);
+    assert_int_equal(sensors_get_count(), SMART_QSO_MAX_SENSORS);
+
+    for (size_t i = 0; i < SMART_QSO_MAX_SENSORS - 1U; i++) {
+        (void)snprintf(id, sizeof(id), "S%02u", (unsigned)i);
+        assert_int_equal(sensors_find(id, &handle), SMART_QSO_OK);
+        assert_int_equal(sensors_get_by_handle(handle, &sensor), SMART_QSO_OK);
+        assert_string_equal(sensor.id, id);
+        assert_int_equal(sensors_get_by_id(id, &sensor), SMART_QSO_OK);
+        assert_string_equal(sensor.id, id);
+    }
+    assert_int_equal(sensors_get_by_id("S00", &sensor), SMART_QSO_OK);
+    assert_string_equal(sensor.name, "Sensor 0");
+    assert_int_equal(sensors_find("S0", &handle), SMART_QSO_ERROR);
+
+    unlink(path);
+}
+
 /**
  * @brief Test getting sensor by index with defaults
  */
@@ -238,13 +769,25 @@ int main(void) {
         /* Initialization tests */
         cmocka_unit_test_setup_teardown(test_sensors_init, setup, teardown),
         cmocka_unit_test_setup_teardown(test_sensors_load_yaml_missing, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_sensors_load_yaml_fields, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_sensors_load_yaml_filter, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_sensors_load_image, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_sensors_load_image_corrupt, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_sensors_load_flash, setup, teardown),
 
         /* Polling tests */
         cmocka_unit_test_setup_teardown(test_sensors_poll, setup, teardown),
         cmocka_unit_test_setup_teardown(test_sensors_poll_timing, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_sensors_poll_queue, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_sensors_poll_adc_batch, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_sensors_poll_adcs_drivers, setup, teardown),
 
         /* Sensor access tests */
         cmocka_unit_test_setup_teardown(test_sensors_get_by_id_unknown, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_sensors_find_handle, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_sensors_fixed_point, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_sensors_find_full_table, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_sensors_history, setup, teardown),
         cmocka_unit_test_setup_teardown(test_sensors_get, setup, teardown),
 
         /* Telemetry formatting tests */
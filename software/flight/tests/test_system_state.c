@@ -18,6 +18,8 @@
 
 /* Include the module under test */
 #include "system_state.h"
+#include "kv_store.h"
+#include "hal/hal_flash.h"
 
 /*===========================================================================*/
 /* Test Fixtures                                                              */
@@ -33,6 +35,18 @@ static int setup(void **state)
     return 0;
 }
 
+/**
+ * @brief Setup function - start from empty persistent storage
+ */
+static int setup_persist(void **state)
+{
+    (void)state;
+    if ((hal_flash_init() != SMART_QSO_OK) || (kv_store_format() != SMART_QSO_OK)) {
+        return -1;
+    }
+    return (sys_state_load() == SMART_QSO_OK) ? 0 : -1;
+}
+
 /*===========================================================================*/
 /* Initialization Tests                                                       */
 /*===========================================================================*/
@@ -182,8 +196,8 @@ static void test_sys_set_temperature(void **state)
     ThermalState_t thermal;
     ret = sys_get_thermal_state(&thermal);
     assert_int_equal(ret, SMART_QSO_OK);
-    assert_true(fabs(thermal.obc_temp_c - 35.0f) < 0.1f);
-    assert_true(fabs(thermal.eps_temp_c - 28.0f) < 0.1f);
+    assert_true(fabsf(thermal.obc_temp_c - 35.0f) < 0.1f);
+    assert_true(fabsf(thermal.eps_temp_c - 28.0f) < 0.1f);
 }
 
 /**
@@ -225,9 +239,9 @@ static void test_sys_set_magnetometer(void **state)
     AdcsState_t adcs;
     ret = sys_get_adcs_state(&adcs);
     assert_int_equal(ret, SMART_QSO_OK);
-    assert_true(fabs(adcs.mag_x_ut - 10.5f) < 0.1f);
-    assert_true(fabs(adcs.mag_y_ut - (-20.3f)) < 0.1f);
-    assert_true(fabs(adcs.mag_z_ut - 5.1f) < 0.1f);
+    assert_true(fabsf(adcs.mag_x_ut - 10.5f) < 0.1f);
+    assert_true(fabsf(adcs.mag_y_ut - (-20.3f)) < 0.1f);
+    assert_true(fabsf(adcs.mag_z_ut - 5.1f) < 0.1f);
 }
 
 /**
@@ -243,9 +257,9 @@ static void test_sys_set_gyroscope(void **state)
     AdcsState_t adcs;
     ret = sys_get_adcs_state(&adcs);
     assert_int_equal(ret, SMART_QSO_OK);
-    assert_true(fabs(adcs.gyro_x_dps - 1.0f) < 0.1f);
-    assert_true(fabs(adcs.gyro_y_dps - 2.0f) < 0.1f);
-    assert_true(fabs(adcs.gyro_z_dps - 3.0f) < 0.1f);
+    assert_true(fabsf(adcs.gyro_x_dps - 1.0f) < 0.1f);
+    assert_true(fabsf(adcs.gyro_y_dps - 2.0f) < 0.1f);
+    assert_true(fabsf(adcs.gyro_z_dps - 3.0f) < 0.1f);
 }
 
 /**
@@ -513,6 +527,112 @@ static void test_sys_get_full_state_null(void **state)
     assert_int_equal(ret, SMART_QSO_ERROR_NULL_PTR);
 }
 
+/*===========================================================================*/
+/* Persistence Tests                                                          */
+/*===========================================================================*/
+
+/**
+ * @brief Test every section survives save and load
+ */
+static void test_sys_state_persist_roundtrip(void **state)
+{
+    (void)state;
+
+    sys_set_battery_voltage(4.05);
+    sys_set_power_mode(POWER_MODE_ACTIVE);
+    sys_set_temperature(2, -5.5f);
+    sys_set_magnetometer(1.0f, 2.0f, 3.0f);
+    sys_set_beacon_interval(30);
+    sys_increment_boot_count();
+    sys_increment_boot_count();
+    sm_process_event(sys_get_sm_context(), EVENT_BOOT_COMPLETE, NULL);
+    assert_int_equal(sys_state_save(), SMART_QSO_OK);
+    assert_false(sys_state_is_dirty());
+
+    /* Clobber RAM, then reload */
+    sys_state_init();
+    assert_int_equal(sys_state_load(), SMART_QSO_OK);
+
+    PowerState_t power;
+    ThermalState_t thermal;
+    AdcsState_t adcs;
+    CommState_t comm;
+    sys_get_power_state(&power);
+    sys_get_thermal_state(&thermal);
+    sys_get_adcs_state(&adcs);
+    sys_get_comm_state(&comm);
+
+    assert_true(fabs(power.battery_voltage - 4.05) < 0.001);
+    assert_int_equal(power.power_mode, POWER_MODE_ACTIVE);
+    assert_true(fabsf(thermal.battery_temp_c + 5.5f) < 0.001f);
+    assert_true(fabsf(adcs.mag_z_ut - 3.0f) < 0.001f);
+    assert_int_equal(comm.beacon_interval_s, 30);
+    assert_int_equal(sys_get_boot_count(), 2);
+    assert_int_equal(sys_get_operational_state(), STATE_DETUMBLE);
+    assert_false(sys_state_is_dirty());
+}
+
+/**
+ * @brief Test a save puts only the dirty sections
+ */
+static void test_sys_state_dirty_section_save(void **state)
+{
+    (void)state;
+    KvStats_t before;
+    KvStats_t after;
+
+    /* First save puts every section */
+    assert_int_equal(sys_state_save(), SMART_QSO_OK);
+    kv_store_get_stats(&before);
+    assert_int_equal(before.live_keys, SYS_SECTION_COUNT);
+
+    sys_set_battery_voltage(3.9);
+    assert_int_equal(sys_state_dirty_sections(), 1U << SYS_SECTION_POWER);
+    assert_int_equal(sys_state_save(), SMART_QSO_OK);
+    assert_int_equal(sys_state_dirty_sections(), 0U);
+    kv_store_get_stats(&after);
+
+    assert_int_equal(after.puts - before.puts, 1);
+    assert_true((after.bytes_written - before.bytes_written) < sizeof(SystemState_t) / 2U);
+    assert_int_equal(after.erase_count, before.erase_count);
+
+    /* A save with nothing changed writes nothing */
+    assert_int_equal(sys_state_save(), SMART_QSO_OK);
+    kv_store_get_stats(&before);
+    assert_int_equal(before.bytes_written, after.bytes_written);
+
+    /* Setting an unchanged value is flagged but not rewritten */
+    sys_set_battery_voltage(3.9);
+    assert_true(sys_state_is_dirty());
+    assert_int_equal(sys_state_save(), SMART_QSO_OK);
+    kv_store_get_stats(&after);
+    assert_int_equal(after.bytes_written, before.bytes_written);
+}
+
+/**
+ * @brief Test state saved before a reset is restored after remount
+ */
+static void test_sys_state_persist_remount(void **state)
+{
+    (void)state;
+    PowerState_t power;
+    MissionState_t mission;
+
+    sys_set_battery_voltage(4.0);
+    sys_increment_qso_count();
+    assert_int_equal(sys_state_save(), SMART_QSO_OK);
+
+    /* Unsaved changes are lost across the reset */
+    sys_set_battery_voltage(3.5);
+
+    assert_int_equal(kv_store_mount(), SMART_QSO_OK);
+    assert_int_equal(sys_state_load(), SMART_QSO_OK);
+    sys_get_power_state(&power);
+    sys_get_mission_state(&mission);
+    assert_true(fabs(power.battery_voltage - 4.0) < 0.001);
+    assert_int_equal(mission.qso_count, 1);
+}
+
 /*===========================================================================*/
 /* Test Suite                                                                 */
 /*===========================================================================*/
@@ -560,6 +680,11 @@ int main(void)
         cmocka_unit_test_setup(test_sys_state_dirty_flag, setup),
         cmocka_unit_test_setup(test_sys_get_full_state, setup),
         cmocka_unit_test_setup(test_sys_get_full_state_null, setup),
+
+        /* Persistence tests */
+        cmocka_unit_test_setup(test_sys_state_persist_roundtrip, setup_persist),
+        cmocka_unit_test_setup(test_sys_state_dirty_section_save, setup_persist),
+        cmocka_unit_test_setup(test_sys_state_persist_remount, setup_persist),
     };
 
     return cmocka_run_group_tests_name("System State Tests", tests, NULL, NULL);
@@ -0,0 +1,411 @@
+/**
+ * @file test_telemetry_builder.c
+ * @brief Unit tests for the zero-copy telemetry frame builder
+ *
+ * Verifies that frames built directly into a transmit buffer carry a valid
+ * header and CRC, match the legacy generate + serialize path, and are
+ * encoded big-endian independent of host byte order.
+ *
+ * @requirement SRS-TLM-003 Telemetry shall be CRC protected
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <string.h>
+
+/* Include the module under test */
+#include "telemetry.h"
+#include "system_state.h"
+#include "wire_codec.h"
+
+#if defined(WIRE_CODEC_PORTABLE) && (defined(WIRE_TO_BE16) || defined(WIRE_TO_LE16))
+#error "WIRE_CODEC_PORTABLE must select the shift-based codec"
+#endif
+
+/*===========================================================================*/
+/* Helpers                                                                    */
+/*===========================================================================*/
+
+/**
+ * @brief Read the big-endian CRC trailer of a serialized frame
+ */
+static uint32_t read_crc_trailer(const uint8_t *frame, size_t len)
+{
+    return wire_get_be32(&frame[len - TLM_CRC_LEN]);
+}
+
+/*===========================================================================*/
+/* Test Fixtures                                                              */
+/*===========================================================================*/
+
+static int setup(void **state)
+{
+    (void)state;
+    (void)sys_state_init();
+    (void)tlm_init();
+    return 0;
+}
+
+/*===========================================================================*/
+/* Builder Tests                                                              */
+/*===========================================================================*/
+
+/**
+ * @brief A built frame has a correct length and a verifiable CRC
+ */
+static void test_builder_frame_crc(void **state)
+{
+    (void)state;
+
+    uint8_t buf[TLM_MAX_FRAME_SIZE];
+    TlmBuilder_t builder;
+    size_t len = 0;
+
+    assert_int_equal(tlm_builder_begin(&builder, buf, sizeof(buf),
+                                       TLM_TYPE_EVENT, 7), SMART_QSO_OK);
+    tlm_builder_put_u8(&builder, 0xA5);
+    tlm_builder_put_u16(&builder, 0x1234);
+    tlm_builder_put_u32(&builder, 0xDEADBEEF);
+    assert_int_equal(tlm_builder_finish(&builder, &len), SMART_QSO_OK);
+
+    assert_int_equal(len, TLM_HEADER_LEN + 7U + TLM_CRC_LEN);
+    assert_int_equal(read_crc_trailer(buf, len), smart_qso_crc32(buf, len - TLM_CRC_LEN));
+}
+
+/**
+ * @brief Header fields are emitted at the start of the buffer
+ */
+static void test_builder_header_fields(void **state)
+{
+    (void)state;
+
+    uint8_t buf[TLM_MAX_FRAME_SIZE];
+    TlmBuilder_t builder;
+    size_t len = 0;
+
+    assert_int_equal(tlm_builder_begin(&builder, buf, sizeof(buf),
+                                       TLM_TYPE_EVENT, 1), SMART_QSO_OK);
+    tlm_builder_put_u8(&builder, 0x42);
+    assert_int_equal(tlm_builder_finish(&builder, &len), SMART_QSO_OK);
+
+    TlmHeader_t header;
+    assert_int_equal(tlm_decode_header(buf, len, &header), SMART_QSO_OK);
+    assert_int_equal(header.sync_word, TLM_SYNC_WORD);
+    assert_int_equal(header.type, TLM_TYPE_EVENT);
+    assert_int_equal(header.data_len, 1);
+    assert_int_equal(buf[TLM_HEADER_LEN], 0x42);
+}
+
+/**
+ * @brief Too-small buffer is rejected without consuming a sequence number
+ */
+static void test_builder_buffer_too_small(void **state)
+{
+    (void)state;
+
+    uint8_t buf[TLM_HEADER_LEN + TLM_CRC_LEN];
+    TlmBuilder_t builder;
+    TlmStats_t stats;
+
+    assert_int_equal(tlm_builder_begin(&builder, buf, sizeof(buf),
+                                       TLM_TYPE_EVENT, 1), SMART_QSO_ERROR_NO_MEM);
+    assert_int_equal(tlm_get_stats(&stats), SMART_QSO_OK);
+    assert_int_equal(stats.sequence_number, 0);
+}
+
+/**
+ * @brief Writing past the declared payload length fails the frame
+ */
+static void test_builder_overflow(void **state)
+{
+    (void)state;
+
+    uint8_t buf[TLM_MAX_FRAME_SIZE];
+    TlmBuilder_t builder;
+    size_t len = 0;
+
+    assert_int_equal(tlm_builder_begin(&builder, buf, sizeof(buf),
+                                       TLM_TYPE_EVENT, 2), SMART_QSO_OK);
+    tlm_builder_put_u32(&builder, 0x01020304);
+    assert_int_equal(tlm_builder_finish(&builder, &len), SMART_QSO_ERROR_INVALID);
+}
+
+/**
+ * @brief Finishing before the payload is complete fails the frame
+ */
+static void test_builder_underfill(void **state)
+{
+    (void)state;
+
+    uint8_t buf[TLM_MAX_FRAME_SIZE];
+    TlmBuilder_t builder;
+    size_t len = 0;
+
+    assert_int_equal(tlm_builder_begin(&builder, buf, sizeof(buf),
+                                       TLM_TYPE_EVENT, 4), SMART_QSO_OK);
+    tlm_builder_put_u16(&builder, 0x0102);
+    assert_int_equal(tlm_builder_finish(&builder, &len), SMART_QSO_ERROR_INVALID);
+}
+
+/*===========================================================================*/
+/* Frame Generation Tests                                                     */
+/*===========================================================================*/
+
+/**
+ * @brief Zero-copy housekeeping matches generate + serialize
+ */
+static void test_build_matches_serialize(void **state)
+{
+    (void)state;
+
+    TlmFrame_t frame;
+    uint8_t legacy[TLM_MAX_FRAME_SIZE];
+    uint8_t direct[TLM_MAX_FRAME_SIZE];
+    size_t frame_len = 0;
+    size_t legacy_len = 0;
+    size_t direct_len = 0;
+
+    assert_int_equal(tlm_generate_housekeeping(&frame, &frame_len), SMART_QSO_OK);
+    assert_int_equal(tlm_serialize(&frame, TLM_HK_PAYLOAD_LEN, legacy,
+                                   sizeof(legacy), &legacy_len), SMART_QSO_OK);
+
+    (void)tlm_init();
+    assert_int_equal(tlm_build_housekeeping(direct, sizeof(direct), &direct_len),
+                     SMART_QSO_OK);
+
+    assert_int_equal(direct_len, legacy_len);
+    assert_int_equal(direct_len, frame_len);
+    assert_memory_equal(direct, legacy, direct_len);
+}
+
+/**
+ * @brief RS-coded frame decodes back to the plain frame after errors
+ */
+static void test_serialize_fec(void **state)
+{
+    (void)state;
+
+    TlmFrame_t frame;
+    uint8_t plain[TLM_MAX_FRAME_SIZE];
+    uint8_t coded[TLM_FEC_MAX_FRAME_SIZE];
+    uint8_t decoded[TLM_MAX_FRAME_SIZE];
+    size_t frame_len = 0;
+    size_t plain_len = 0;
+    size_t coded_len = 0;
+    size_t decoded_len = sizeof(decoded);
+
+    assert_int_equal(tlm_generate_housekeeping(&frame, &frame_len), SMART_QSO_OK);
+    assert_int_equal(tlm_serialize(&frame, TLM_HK_PAYLOAD_LEN, plain,
+                                   sizeof(plain), &plain_len), SMART_QSO_OK);
+    assert_int_equal(tlm_serialize_fec(&frame, TLM_HK_PAYLOAD_LEN, coded,
+                                       sizeof(coded), &coded_len), SMART_QSO_OK);
+    assert_int_equal(coded_len, plain_len + FEC_RS_PARITY);
+
+    /* Smash the header and CRC */
+    coded[5] ^= 0xFFU;
+    coded[6] ^= 0x01U;
+    coded[plain_len - 1U] ^= 0x80U;
+
+    size_t corrected = 0;
+    assert_int_equal(fec_tlm_decode(coded, coded_len, decoded, &decoded_len, &corrected),
+                     SMART_QSO_OK);
+    assert_int_equal(corrected, 3);
+    assert_int_equal(decoded_len, plain_len);
+    assert_memory_equal(decoded, plain, plain_len);
+
+    assert_int_equal(tlm_serialize_fec(&frame, TLM_HK_PAYLOAD_LEN, coded,
+                                       plain_len, &coded_len), SMART_QSO_ERROR_NO_MEM);
+}
+
+/**
+ * @brief Built frames consume sequence numbers and count as generated
+ */
+static void test_build_updates_stats(void **state)
+{
+    (void)state;
+
+    uint8_t buf[TLM_MAX_FRAME_SIZE];
+    size_t len = 0;
+    TlmStats_t stats;
+
+    assert_int_equal(tlm_build_eps(buf, sizeof(buf), &len), SMART_QSO_OK);
+    assert_int_equal(tlm_build_adcs(buf, sizeof(buf), &len), SMART_QSO_OK);
+    assert_int_equal(tlm_get_stats(&stats), SMART_QSO_OK);
+    assert_int_equal(stats.frames_generated, 2);
+    assert_int_equal(stats.sequence_number, 2);
+}
+
+/**
+ * @brief Beacon build increments the beacon counter
+ */
+static void test_build_beacon_counts(void **state)
+{
+    (void)state;
+
+    uint8_t buf[TLM_MAX_FRAME_SIZE];
+    size_t len = 0;
+    CommState_t comm;
+
+    assert_int_equal(tlm_build_beacon(buf, sizeof(buf), &len), SMART_QSO_OK);
+    assert_int_equal(len, TLM_HEADER_LEN + TLM_BEACON_PAYLOAD_LEN + TLM_CRC_LEN);
+    assert_int_equal(sys_get_comm_state(&comm), SMART_QSO_OK);
+    assert_int_equal(comm.beacon_count, 1);
+}
+
+/**
+ * @brief NULL arguments are rejected
+ */
+static void test_build_null_args(void **state)
+{
+    (void)state;
+
+    uint8_t buf[TLM_MAX_FRAME_SIZE];
+    size_t len = 0;
+
+    assert_int_equal(tlm_build_housekeeping(NULL, sizeof(buf), &len),
+                     SMART_QSO_ERROR_NULL_PTR);
+    assert_int_equal(tlm_build_housekeeping(buf, sizeof(buf), NULL),
+                     SMART_QSO_ERROR_NULL_PTR);
+}
+
+/*===========================================================================*/
+/* Wire Encoding Tests                                                        */
+/*===========================================================================*/
+
+/**
+ * @brief Codec primitives emit fixed byte order on any host
+ */
+static void test_wire_codec_byte_order(void **state)
+{
+    (void)state;
+
+    uint8_t buf[8] = {0};
+    const uint8_t expected_be[6] = {0x12, 0x34, 0xDE, 0xAD, 0xBE, 0xEF};
+
+    wire_put_be16(&buf[1], 0x1234);
+    wire_put_be32(&buf[3], 0xDEADBEEF);
+    assert_memory_equal(&buf[1], expected_be, sizeof(expected_be));
+    assert_int_equal(wire_get_be16(&buf[1]), 0x1234);
+    assert_int_equal(wire_get_be32(&buf[3]), 0xDEADBEEF);
+
+    wire_put_le16(&buf[1], 0x1234);
+    assert_int_equal(buf[1], 0x34);
+    assert_int_equal(buf[2], 0x12);
+    assert_int_equal(wire_get_le16(&buf[1]), 0x1234);
+}
+
+/**
+ * @brief Codec primitives match byte-at-a-time encoding for many values
+ */
+static void test_wire_codec_matches_reference(void **state)
+{
+    (void)state;
+
+    uint8_t buf[16];
+    uint16_t values[4] = {0};
+    uint32_t x = 0x9E3779B9U;
+
+    for (uint32_t n = 0; n < 1000U; n++) {
+        x = (x * 1664525U) + 1013904223U;
+        size_t at = n % 5U;
+
+        wire_put_be32(&buf[at], x);
+        assert_int_equal(buf[at], (uint8_t)(x >> 24));
+        assert_int_equal(buf[at + 3U], (uint8_t)x);
+        assert_int_equal(wire_get_be32(&buf[at]), x);
+        assert_int_equal(wire_get_le32(&buf[at]),
+                         ((x >> 24) & 0xFFU) | ((x >> 8) & 0xFF00U) |
+                         ((x << 8) & 0xFF0000U) | ((x << 24) & 0xFF000000U));
+
+        uint16_t h = (uint16_t)(x >> 7);
+        wire_put_be16(&buf[at], h);
+        assert_int_equal(buf[at], (uint8_t)(h >> 8));
+        assert_int_equal(wire_get_be16(&buf[at]), h);
+        wire_put_le16(&buf[at], h);
+        assert_int_equal(buf[at], (uint8_t)h);
+        assert_int_equal(wire_get_le16(&buf[at]), h);
+
+        values[n % 4U] = h;
+        wire_put_be16_array(&buf[at], values, 4U);
+        for (size_t i = 0; i < 4U; i++) {
+            assert_int_equal(wire_get_be16(&buf[at + (i * 2U)]), values[i]);
+        }
+    }
+}
+
+/**
+ * @brief Housekeeping frame from default state matches a golden vector
+ *
+ * The vector was generated independently of the flight code; a match
+ * shows the frame is big-endian and padding-free on this host.
+ */
+static void test_housekeeping_golden_vector(void **state)
+{
+    (void)state;
+
+    static const uint8_t expected[] = {
+        /* Header: sync, version, type, sequence, timestamp, length */
+        0x1A, 0xCF, 0xFC, 0x1D, 0x01, 0x01, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x1A,
+        /* Power: 3700 mV, 0 mA, 50 %, SAFE */
+        0x0E, 0x74, 0x00, 0x00, 0x32, 0x00,
+        /* Thermal: 25 C x4 */
+        0x19, 0x19, 0x19, 0x19,
+        /* Status, comms, ADCS */
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        /* CRC32 */
+        0x4D, 0x07, 0xBF, 0x3F
+    };
+    uint8_t buf[TLM_MAX_FRAME_SIZE];
+    size_t len = 0;
+
+    assert_int_equal(tlm_build_housekeeping(buf, sizeof(buf), &len), SMART_QSO_OK);
+    assert_int_equal(len, sizeof(expected));
+    assert_memory_equal(buf, expected, sizeof(expected));
+}
+
+/**
+ * @brief Header decode rejects short buffers and bad sync words
+ */
+static void test_decode_header_invalid(void **state)
+{
+    (void)state;
+
+    uint8_t buf[TLM_HEADER_LEN] = {0};
+    TlmHeader_t header;
+
+    assert_int_equal(tlm_decode_header(buf, sizeof(buf) - 1U, &header),
+                     SMART_QSO_ERROR_INVALID);
+    assert_int_equal(tlm_decode_header(buf, sizeof(buf), &header),
+                     SMART_QSO_ERROR_INVALID);
+}
+
+/*===========================================================================*/
+/* Test Suite                                                                 */
+/*===========================================================================*/
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup(test_builder_frame_crc, setup),
+        cmocka_unit_test_setup(test_builder_header_fields, setup),
+        cmocka_unit_test_setup(test_builder_buffer_too_small, setup),
+        cmocka_unit_test_setup(test_builder_overflow, setup),
+        cmocka_unit_test_setup(test_builder_underfill, setup),
+        cmocka_unit_test_setup(test_build_matches_serialize, setup),
+        cmocka_unit_test_setup(test_serialize_fec, setup),
+        cmocka_unit_test_setup(test_build_updates_stats, setup),
+        cmocka_unit_test_setup(test_build_beacon_counts, setup),
+        cmocka_unit_test_setup(test_build_null_args, setup),
+        cmocka_unit_test_setup(test_wire_codec_byte_order, setup),
+        cmocka_unit_test_setup(test_wire_codec_matches_reference, setup),
+        cmocka_unit_test_setup(test_housekeeping_golden_vector, setup),
+        cmocka_unit_test_setup(test_decode_header_invalid, setup),
+    };
+
+    return cmocka_run_group_tests_name("Telemetry Builder Tests", tests, NULL, NULL);
+}
@@ -0,0 +1,267 @@
+/**
+ * @file test_yaml_parser.c
+ * @brief Unit tests for the YAML parser and streaming tokenizer
+ *
+ * @requirement SRS-SENS-001 System shall support configurable sensor framework
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <string.h>
+#include <stdio.h>
+
+/* Include the module under test */
+#include "yaml_parser.h"
+
+/*===========================================================================*/
+/* Test Data                                                                  */
+/*===========================================================================*/
+
+static const char s_doc[] =
+    "# mission config\n"
+    "mission:\n"
+    "  name: \"SMART-QSO\"\n"
+    "  beacon:\n"
+    "    period_s: 60\r\n"
+    "\n"
+    "    text: 'hello: world'\n"
+    "sensors:\n"
+    "  - id: BV\n"
+    "    period_ms: 1000\n"
+    "  -\n"
+    "    id: ST\n"
+    "  - plain\n"
+    "end: 1";
+
+/** Tokens of s_doc rendered by render_token() */
+static const char *const s_expect[] = {
+    "M mission",
+    "S mission.name=SMART-QSO",
+    "M mission.beacon",
+    "S mission.beacon.period_s=60",
+    "S mission.beacon.text=hello: world",
+    "M sensors",
+    "S -sensors.id=BV",
+    "S sensors.period_ms=1000",
+    "S -sensors.=",
+    "S sensors.id=ST",
+    "S -sensors.=plain",
+    "S end=1",
+};
+
+#define EXPECT_COUNT (sizeof(s_expect) / sizeof(s_expect[0]))
+
+/** Rendered tokens */
+static char s_got[32][96];
+static size_t s_got_count;
+
+/*===========================================================================*/
+/* Helpers                                                                    */
+/*===========================================================================*/
+
+/**
+ * @brief Render a token as "<kind> [-]path.key[=value]"
+ */
+static void render_token(const yaml_token_t *token, char *out, size_t size) {
+    size_t n = (size_t)snprintf(out, size, "%c %s", (token->kind == YAML_TOKEN_MAPPING) ? 'M' : 'S',
+                                token->item ? "-" : "");
+    for (uint8_t d = 0; d < token->depth; d++) {
+        n += yaml_span_copy(token->path[d], &out[n], size - n);
+        out[n++] = '.';
+    }
+    n += yaml_span_copy(token->key, &out[n], size - n);
+    if (token->kind == YAML_TOKEN_SCALAR) {
+        out[n++] = '=';
+        (void)yaml_span_copy(token->value, &out[n], size - n);
+    } else {
+        out[n] = '\0';
+    }
+}
+
+/**
+ * @brief Tokenize s_doc fed in chunks of `step` bytes
+ */
+static yaml_error_t tokenize_chunked(size_t step) {
+    yaml_tokenizer_t tok;
+    yaml_token_t token;
+    size_t length = strlen(s_doc);
+    yaml_error_t err = YAML_NEED_INPUT;
+
+    yaml_tokenizer_init(&tok);
+    s_got_count = 0;
+    for (size_t pos = 0; (err == YAML_NEED_INPUT) && (pos < length); pos += step) {
+        size_t n = ((length - pos) < step) ? (length - pos) : step;
+        assert_int_equal(yaml_tokenizer_feed(&tok, &s_doc[pos], n, (pos + n) == length), YAML_OK);
+        while ((err = yaml_tokenizer_next(&tok, &token)) == YAML_OK) {
+            render_token(&token, s_got[s_got_count], sizeof(s_got[0]));
+            s_got_count++;
+        }
+    }
+    return err;
+}
+
+/**
+ * @brief Tokenize a whole document and return the first non-OK result
+ */
+static yaml_error_t tokenize_all(const char *doc, yaml_tokenizer_t *tok) {
+    yaml_token_t token;
+    yaml_error_t err;
+
+    yaml_tokenizer_init(tok);
+    (void)yaml_tokenizer_feed(tok, doc, strlen(doc), true);
+    while ((err = yaml_tokenizer_next(tok, &token)) == YAML_OK) {
+    }
+    return err;
+}
+
+/** Pairs received by the callback interface */
+static char s_pairs[8][160];
+static size_t s_pair_count;
+
+static void collect_pair(const char *path, const char *value, void *user_data) {
+    (void)user_data;
+    if (s_pair_count < 8U) {
+        (void)snprintf(s_pairs[s_pair_count], sizeof(s_pairs[0]), "%s=%s", path, value);
+        s_pair_count++;
+    }
+}
+
+/*===========================================================================*/
+/* Test Cases: Tokenizer                                                      */
+/*===========================================================================*/
+
+/**
+ * @brief Test paths, items, quotes, comments and CRLF line endings
+ */
+static void test_tokenizer_document(void **state) {
+    (void)state;
+
+    assert_int_equal(tokenize_chunked(sizeof(s_doc)), YAML_NEED_INPUT);
+    assert_int_equal(s_got_count, EXPECT_COUNT);
+    for (size_t i = 0; i < EXPECT_COUNT; i++) {
+        assert_string_equal(s_got[i], s_expect[i]);
+    }
+}
+
+/**
+ * @brief Test every chunk size gives the tokens of the whole buffer
+ */
+static void test_tokenizer_chunk_boundaries(void **state) {
+    (void)state;
+
+    for (size_t step = 1; step < sizeof(s_doc); step++) {
+        assert_int_equal(tokenize_chunked(step), YAML_NEED_INPUT);
+        assert_int_equal(s_got_count, EXPECT_COUNT);
+        for (size_t i = 0; i < EXPECT_COUNT; i++) {
+            assert_string_equal(s_got[i], s_expect[i]);
+        }
+    }
+}
+
+/**
+ * @brief Test keys and values are views into the fed buffer
+ */
+static void test_tokenizer_zero_copy(void **state) {
+    (void)state;
+    static const char doc[] = "radio:\n  callsign: W6YX\n";
+    yaml_tokenizer_t tok;
+    yaml_token_t token;
+
+    yaml_tokenizer_init(&tok);
+    assert_int_equal(yaml_tokenizer_feed(&tok, doc, strlen(doc), true), YAML_OK);
+    assert_int_equal(yaml_tokenizer_next(&tok, &token), YAML_OK);
+    assert_int_equal(yaml_tokenizer_next(&tok, &token), YAML_OK);
+    assert_true(token.key.ptr == &doc[9]);
+    assert_true(token.value.ptr == &doc[19]);
+    assert_int_equal(token.value.len, 4);
+    assert_int_equal(token.line, 2);
+    assert_true(yaml_token_path_is(&token, "radio.callsign"));
+    assert_false(yaml_token_path_is(&token, "radio"));
+    assert_false(yaml_token_path_is(&token, "radio.callsign.x"));
+    assert_false(yaml_token_path_is(&token, "radio.call"));
+    assert_true(yaml_span_equals(token.value, "W6YX"));
+    assert_int_equal(yaml_tokenizer_next(&tok, &token), YAML_NEED_INPUT);
+    assert_int_equal(yaml_tokenizer_next(&tok, &token), YAML_NEED_INPUT);
+}
+
+/**
+ * @brief Test malformed input is reported with its line, and stays reported
+ */
+static void test_tokenizer_errors(void **state) {
+    (void)state;
+    yaml_tokenizer_t tok;
+    yaml_token_t token;
+    char doc[2 * YAML_MAX_LINE_LENGTH];
+
+    assert_int_equal(tokenize_all("a: 1\nno separator\nb: 2\n", &tok), YAML_ERROR_SYNTAX);
+    assert_int_equal(tok.line, 2);
+    assert_int_equal(yaml_tokenizer_next(&tok, &token), YAML_ERROR_SYNTAX);
+
+    assert_int_equal(tokenize_all(": value\n", &tok), YAML_ERROR_SYNTAX);
+    assert_int_equal(tokenize_all("a:\n b:\n  c:\n   d:\n    e:\n     f:\n      g:\n       h:\n"
+                                  "        i:\n", &tok), YAML_ERROR_DEPTH);
+
+    memset(doc, 'x', sizeof(doc));
+    doc[0] = 'k';
+    doc[1] = ':';
+    doc[sizeof(doc) - 1U] = '\0';
+    assert_int_equal(tokenize_all(doc, &tok), YAML_ERROR_MEMORY);
+
+    /* A chunk must be consumed before the next is fed */
+    yaml_tokenizer_init(&tok);
+    assert_int_equal(yaml_tokenizer_feed(&tok, "a: 1\n", 5U, false), YAML_OK);
+    assert_int_equal(yaml_tokenizer_feed(&tok, "b: 2\n", 5U, true), YAML_ERROR_INVALID_PARAM);
+    assert_int_equal(yaml_tokenizer_next(&tok, &token), YAML_OK);
+    assert_int_equal(yaml_tokenizer_next(&tok, &token), YAML_NEED_INPUT);
+    assert_int_equal(yaml_tokenizer_feed(&tok, "b: 2\n", 5U, true), YAML_OK);
+    assert_int_equal(yaml_tokenizer_feed(&tok, NULL, 0U, true), YAML_ERROR_INVALID_PARAM);
+}
+
+/*===========================================================================*/
+/* Test Cases: Callback Interface                                             */
+/*===========================================================================*/
+
+/**
+ * @brief Test the callback receives dotted paths and NUL-terminated values
+ */
+static void test_parse_string_callback(void **state) {
+    (void)state;
+
+    assert_int_equal(yaml_parser_init(), YAML_OK);
+    assert_int_equal(yaml_register_callback(NULL, NULL), YAML_ERROR_INVALID_PARAM);
+    assert_int_equal(yaml_register_callback(collect_pair, NULL), YAML_OK);
+    s_pair_count = 0;
+
+    assert_int_equal(yaml_parse_string(s_doc, strlen(s_doc)), YAML_OK);
+    assert_int_equal(s_pair_count, 7);
+    assert_string_equal(s_pairs[0], "mission.name=SMART-QSO");
+    assert_string_equal(s_pairs[1], "mission.beacon.period_s=60");
+    assert_string_equal(s_pairs[2], "mission.beacon.text=hello: world");
+    assert_string_equal(s_pairs[3], "sensors.id=BV");
+    assert_string_equal(s_pairs[6], "end=1");
+
+    const char *bad = "a: 1\n  b\n";
+    assert_int_equal(yaml_parse_string(bad, strlen(bad)), YAML_ERROR_SYNTAX);
+    assert_int_equal(yaml_get_last_error(), YAML_ERROR_SYNTAX);
+    assert_int_equal(yaml_get_error_line(), 2);
+    assert_string_equal(yaml_error_to_string(YAML_ERROR_SYNTAX), "Syntax error");
+}
+
+/*===========================================================================*/
+/* Test Runner                                                                */
+/*===========================================================================*/
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_tokenizer_document),
+        cmocka_unit_test(test_tokenizer_chunk_boundaries),
+        cmocka_unit_test(test_tokenizer_zero_copy),
+        cmocka_unit_test(test_tokenizer_errors),
+        cmocka_unit_test(test_parse_string_callback),
+    };
+
+    return cmocka_run_group_tests_name("YAML Parser Tests", tests, NULL, NULL);
+}
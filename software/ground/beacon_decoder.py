@@ -17,6 +17,9 @@ from typing import Optional, Dict, Any, List, Tuple
 from dataclasses import dataclass, field
 from enum import IntEnum
 
+from crc16 import crc16_x25
+from fec import fx25_decode, hdlc_unstuff
+
 # Configure logging
 logging.basicConfig(level=logging.INFO)
 logger = logging.getLogger(__name__)
@@ -29,6 +32,8 @@ class BeaconType(IntEnum):
     GREETING = 2
     EMERGENCY = 3
     TEST = 4
+    BINARY = 5
+    LOG_DIGEST = 6
     UNKNOWN = 255
 
 
@@ -82,6 +87,20 @@ class BeaconDecoder:
     FLAG = 0x7E
     MIN_FRAME_SIZE = 17  # dest(7) + src(7) + ctrl(1) + pid(1) + fcs(2)
 
+    # Binary beacon info field (see beacon_format_binary() in flight beacon.c)
+    BINARY_TYPE = 0xB1
+    BINARY_FORMAT = ">BIIBBHbbBBHHBBH"
+    BINARY_LEN = struct.calcsize(BINARY_FORMAT)  # 25
+    POWER_MODES = {0: "SAFE", 1: "IDLE"}
+
+    # Log-digest beacon info field (see beacon_format_digest() in flight beacon.c)
+    DIGEST_TYPE = 0xB2
+    DIGEST_HEADER_FORMAT = ">BIIHB"
+    DIGEST_ENTRY_FORMAT = ">BBBI"
+    DIGEST_ENTRIES = 4
+    DIGEST_LEN = (struct.calcsize(DIGEST_HEADER_FORMAT) +
+                  DIGEST_ENTRIES * struct.calcsize(DIGEST_ENTRY_FORMAT) + 2)  # 42
+
     # Telemetry field patterns
     TELEMETRY_PATTERNS = {
         "battery_voltage": r"V:(\d+\.?\d*)V?",
@@ -134,6 +153,14 @@ class BeaconDecoder:
                 errors=errors
             )
 
+        if self.is_binary_info(ax25_frame.info):
+            return self._decode_packed(raw_frame, ax25_frame, start_time,
+                                       self.decode_binary_info, BeaconType.BINARY)
+
+        if self.is_digest_info(ax25_frame.info):
+            return self._decode_packed(raw_frame, ax25_frame, start_time,
+                                       self.decode_digest_info, BeaconType.LOG_DIGEST)
+
         # Extract info text
         try:
             info_text = ax25_frame.info.decode('ascii', errors='replace')
@@ -166,6 +193,45 @@ class BeaconDecoder:
             errors=errors
         )
 
+    def decode_fx25(self, received: bytes) -> DecodedBeacon:
+        """
+        Decode an FX.25 transmission (tag + RS codeword, NRZI removed).
+
+        Corrects the codeword, unstuffs the embedded AX.25 frame and
+        decodes it. The number of corrected bytes is reported in
+        telemetry["fec_corrected"].
+
+        Args:
+            received: Received bytes starting at the correlation tag
+
+        Returns:
+            DecodedBeacon with parsed data
+        """
+        start_time = time.time()
+        block, corrected = fx25_decode(received)
+        frame = hdlc_unstuff(block) if block is not None else None
+        if frame is None:
+            self._error_count += 1
+            return DecodedBeacon(
+                raw_frame=received,
+                ax25_frame=None,
+                beacon_type=BeaconType.UNKNOWN,
+                callsign="",
+                sequence=None,
+                timestamp=None,
+                ai_generated=False,
+                info_text="",
+                telemetry={},
+                decode_time=time.time() - start_time,
+                valid=False,
+                errors=["FX.25 codeword uncorrectable"]
+            )
+
+        beacon = self.decode(frame)
+        beacon.raw_frame = received
+        beacon.telemetry["fec_corrected"] = corrected
+        return beacon
+
     def decode_kiss(self, kiss_data: bytes) -> List[DecodedBeacon]:
         """
         Decode KISS-framed data.
@@ -185,6 +251,103 @@ class BeaconDecoder:
 
         return beacons
 
+    @classmethod
+    def is_binary_info(cls, info: bytes) -> bool:
+        """Check whether an info field is a binary beacon (type byte)."""
+        return len(info) > 0 and info[0] == cls.BINARY_TYPE
+
+    def decode_binary_info(self, info: bytes) -> Tuple[Dict[str, Any], List[str]]:
+        """
+        Decode a binary beacon info field.
+
+        Args:
+            info: Info field bytes starting with the type byte
+
+        Returns:
+            Tuple of (fields, errors)
+        """
+        errors: List[str] = []
+
+        if len(info) != self.BINARY_LEN:
+            return {}, [f"Binary beacon length {len(info)} != {self.BINARY_LEN}"]
+
+        (_type, sequence, timestamp, power_mode, soc, battery_mv,
+         temp_obc, temp_payload, sunlit, rf_power, qso_count,
+         orbit_number, fault_flags, source, crc) = struct.unpack(self.BINARY_FORMAT, info)
+
+        if crc16_x25(info[:-2]) != crc:
+            errors.append("Binary beacon CRC mismatch")
+
+        fields = {
+            "sequence": sequence,
+            "timestamp": timestamp,
+            "power_mode": self.POWER_MODES.get(power_mode, "ACTIVE"),
+            "battery_soc": soc,
+            "battery_voltage": battery_mv / 1000.0,
+            "battery_mv": battery_mv,
+            "temperature": temp_obc,
+            "temperature_payload": temp_payload,
+            "sunlit": bool(sunlit),
+            "rf_power": rf_power,
+            "qso_count": qso_count,
+            "orbit_number": orbit_number,
+            "fault_flags": fault_flags,
+            "ai_generated": source == 1,
+        }
+        return fields, errors
+
+    @classmethod
+    def is_digest_info(cls, info: bytes) -> bool:
+        """Check whether an info field is a log-digest beacon (type byte)."""
+        return len(info) > 0 and info[0] == cls.DIGEST_TYPE
+
+    def decode_digest_info(self, info: bytes) -> Tuple[Dict[str, Any], List[str]]:
+        """
+        Decode a log-digest beacon info field.
+
+        Args:
+            info: Info field bytes starting with the type byte
+
+        Returns:
+            Tuple of (fields, errors); fields["faults"] lists the fault log
+            entries, most recent first
+        """
+        errors: List[str] = []
+
+        if len(info) != self.DIGEST_LEN:
+            return {}, [f"Digest beacon length {len(info)} != {self.DIGEST_LEN}"]
+
+        (_type, sequence, timestamp, fault_count,
+         entries) = struct.unpack_from(self.DIGEST_HEADER_FORMAT, info)
+        (crc,) = struct.unpack_from(">H", info, self.DIGEST_LEN - 2)
+
+        if crc16_x25(info[:-2]) != crc:
+            errors.append("Digest beacon CRC mismatch")
+        if entries > self.DIGEST_ENTRIES:
+            errors.append(f"Digest entry count {entries} > {self.DIGEST_ENTRIES}")
+            entries = self.DIGEST_ENTRIES
+
+        offset = struct.calcsize(self.DIGEST_HEADER_FORMAT)
+        entry_len = struct.calcsize(self.DIGEST_ENTRY_FORMAT)
+        faults = []
+        for i in range(entries):
+            fault_type, severity, recovered, time_s = struct.unpack_from(
+                self.DIGEST_ENTRY_FORMAT, info, offset + i * entry_len)
+            faults.append({
+                "fault_type": fault_type,
+                "severity": severity,
+                "recovered": bool(recovered),
+                "time_s": time_s,
+            })
+
+        fields = {
+            "sequence": sequence,
+            "timestamp": timestamp,
+            "fault_count": fault_count,
+            "faults": faults,
+        }
+        return fields, errors
+
     def get_statistics(self) -> Dict[str, int]:
         """Get decoder statistics."""
         return {
@@ -197,6 +360,35 @@ class BeaconDecoder:
         self._decode_count = 0
         self._error_count = 0
 
+    def _decode_packed(self, raw_frame: bytes, ax25_frame: AX25Frame,
+                       start_time: float, decode_info, beacon_type: BeaconType) -> DecodedBeacon:
+        """Build a DecodedBeacon from a binary or log-digest beacon frame."""
+        fields, errors = decode_info(ax25_frame.info)
+        if errors:
+            self._error_count += 1
+        else:
+            self._decode_count += 1
+
+        telemetry = {
+            key: value for key, value in fields.items()
+            if key not in ("sequence", "timestamp", "ai_generated")
+        }
+
+        return DecodedBeacon(
+            raw_frame=raw_frame,
+            ax25_frame=ax25_frame,
+            beacon_type=beacon_type,
+            callsign=ax25_frame.source.callsign,
+            sequence=fields.get("sequence"),
+            timestamp=fields.get("timestamp"),
+            ai_generated=bool(fields.get("ai_generated", False)),
+            info_text="",
+            telemetry=telemetry,
+            decode_time=time.time() - start_time,
+            valid=len(errors) == 0 and ax25_frame.fcs_valid,
+            errors=errors
+        )
+
     def _parse_ax25(self, data: bytes) -> Optional[AX25Frame]:
         """Parse raw AX.25 frame."""
         # Remove flags if present
@@ -282,18 +474,8 @@ class BeaconDecoder:
             return None
 
     def _calculate_fcs(self, data: bytes) -> int:
-        """Calculate AX.25 FCS (CRC-16-CCITT)."""
-        fcs = 0xFFFF
-
-        for byte in data:
-            fcs ^= byte
-            for _ in range(8):
-                if fcs & 0x0001:
-                    fcs = (fcs >> 1) ^ 0x8408
-                else:
-                    fcs >>= 1
-
-        return fcs ^ 0xFFFF
+        """Calculate AX.25 FCS (CRC-16/X.25)."""
+        return crc16_x25(data)
 
     def _extract_kiss_frames(self, data: bytes) -> List[bytes]:
         """Extract AX.25 frames from KISS data."""
@@ -0,0 +1,146 @@
+"""
+CRC-16 Module for SMART-QSO Ground Station
+
+Table-driven CRC-16 variants shared by the ground tools:
+
+- CRC-16/X.25: AX.25 / HDLC frame check sequence. Matches crc16_x25() in
+  the flight software (software/flight/src/crc16.c).
+- CRC-16/CCITT-FALSE: FL-UPDATE payload checksum used by
+  tools/fl_update_builder.py.
+
+Run as a script to compare table and bitwise throughput:
+
+    python crc16.py [size_bytes] [iterations]
+
+Author: SMART-QSO Team
+Date: 2026-01-02
+Version: 1.0
+"""
+
+import sys
+import time
+from typing import Callable, List
+
+# CRC-16/X.25 parameters (reflected)
+X25_POLY_REFLECTED = 0x8408
+X25_INIT = 0xFFFF
+X25_XOROUT = 0xFFFF
+X25_CHECK = 0x906E
+X25_RESIDUE = 0xF0B8
+
+# CRC-16/CCITT-FALSE parameters (MSB first)
+CCITT_POLY = 0x1021
+CCITT_INIT = 0xFFFF
+CCITT_CHECK = 0x29B1
+
+
+def _build_reflected_table(poly: int) -> List[int]:
+    """Build a 256-entry table for an LSB-first CRC-16."""
+    table = []
+    for i in range(256):
+        crc = i
+        for _ in range(8):
+            crc = (crc >> 1) ^ poly if crc & 1 else crc >> 1
+        table.append(crc)
+    return table
+
+
+def _build_normal_table(poly: int) -> List[int]:
+    """Build a 256-entry table for an MSB-first CRC-16."""
+    table = []
+    for i in range(256):
+        crc = i << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ poly) if crc & 0x8000 else (crc << 1)
+        table.append(crc & 0xFFFF)
+    return table
+
+
+_X25_TABLE = _build_reflected_table(X25_POLY_REFLECTED)
+_CCITT_TABLE = _build_normal_table(CCITT_POLY)
+
+
+def crc16_x25_update(crc: int, data: bytes) -> int:
+    """
+    Advance a raw CRC-16/X.25 register.
+
+    Args:
+        crc: Register value (X25_INIT to start)
+        data: Input bytes
+
+    Returns:
+        Updated register; XOR with X25_XOROUT to finalize
+    """
+    table = _X25_TABLE
+    for byte in data:
+        crc = (crc >> 8) ^ table[(crc ^ byte) & 0xFF]
+    return crc
+
+
+def crc16_x25(data: bytes) -> int:
+    """
+    Calculate the AX.25 FCS (CRC-16/X.25).
+
+    Args:
+        data: Frame bytes from destination address through info field
+
+    Returns:
+        16-bit FCS, transmitted least significant byte first
+    """
+    return crc16_x25_update(X25_INIT, data) ^ X25_XOROUT
+
+
+def crc16_ccitt_false(data: bytes) -> int:
+    """
+    Calculate CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF, no final XOR).
+
+    Args:
+        data: Input bytes
+
+    Returns:
+        16-bit CRC value
+    """
+    table = _CCITT_TABLE
+    crc = CCITT_INIT
+    for byte in data:
+        crc = ((crc << 8) & 0xFFFF) ^ table[(crc >> 8) ^ byte]
+    return crc
+
+
+def crc16_x25_bitwise(data: bytes) -> int:
+    """Bitwise CRC-16/X.25 reference, kept for conformance tests."""
+    crc = X25_INIT
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = (crc >> 1) ^ X25_POLY_REFLECTED if crc & 1 else crc >> 1
+    return crc ^ X25_XOROUT
+
+
+def _throughput(func: Callable[[bytes], int], data: bytes, iterations: int) -> float:
+    """Return throughput of func over data in MB/s."""
+    start = time.perf_counter()
+    for _ in range(iterations):
+        func(data)
+    elapsed = time.perf_counter() - start
+    return (len(data) * iterations) / elapsed / 1e6 if elapsed > 0 else 0.0
+
+
+def main() -> int:
+    """Report table vs bitwise throughput."""
+    size = int(sys.argv[1]) if len(sys.argv) > 1 else 330
+    iterations = int(sys.argv[2]) if len(sys.argv) > 2 else 2000
+    data = bytes((i * 37) & 0xFF for i in range(size))
+
+    if crc16_x25(data) != crc16_x25_bitwise(data):
+        print("CRC-16/X.25 table/bitwise mismatch")
+        return 1
+
+    print(f"CRC-16/X.25 throughput ({size} bytes x {iterations})")
+    print(f"  bitwise {_throughput(crc16_x25_bitwise, data, iterations):8.2f} MB/s")
+    print(f"  table   {_throughput(crc16_x25, data, iterations):8.2f} MB/s")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,349 @@
+"""
+Forward Error Correction Module for SMART-QSO Ground Station
+
+Decoders for the flight software's RS(255,223) downlink coding
+(software/flight/src/fec.c):
+
+- Reed-Solomon RS(255,223) over GF(2^8), field polynomial 0x11D, first
+  consecutive root alpha^1. Shortened blocks (1..223 data bytes) are
+  supported. Corrects up to 16 byte errors per codeword.
+- FX.25: 64-bit correlation tag, then a codeword holding the bit-stuffed
+  AX.25 frame padded with flags. hdlc_unstuff() recovers the AX.25 frame
+  for BeaconDecoder.
+- Telemetry: uncoded 4-byte sync word, then the frame body split evenly
+  into shortened RS(255,223) codewords.
+
+Author: SMART-QSO Team
+Date: 2026-01-02
+Version: 1.0
+"""
+
+from typing import List, Optional, Tuple
+
+# Reed-Solomon parameters
+RS_N = 255
+RS_K = 223
+RS_PARITY = RS_N - RS_K
+RS_MAX_CORRECT = RS_PARITY // 2
+GF_POLY = 0x11D
+
+# FX.25 (RS(255,223) family): (tag, n, k), ascending size
+FX25_TAG_LEN = 8
+FX25_TAG_MAX_ERRORS = 8
+FX25_MODES = [
+    (0xDBF869BD2DBB1776, 64, 32),    # Tag_08
+    (0x1EB7B9CDBC09C00E, 96, 64),    # Tag_07
+    (0xFF94DC634F1CFF4E, 160, 128),  # Tag_06
+    (0x6E260B1AC5835FAE, 255, 223),  # Tag_05
+]
+
+# Telemetry framing
+TLM_SYNC_LEN = 4
+
+HDLC_FLAG = 0x7E
+
+
+def _build_gf_tables() -> Tuple[List[int], List[int]]:
+    """Build GF(2^8) exp (doubled, to skip the modulo) and log tables."""
+    exp = [0] * 510
+    log = [0] * 256
+    x = 1
+    for i in range(255):
+        exp[i] = x
+        log[x] = i
+        x <<= 1
+        if x & 0x100:
+            x ^= GF_POLY
+    for i in range(255, 510):
+        exp[i] = exp[i - 255]
+    return exp, log
+
+
+_GF_EXP, _GF_LOG = _build_gf_tables()
+
+
+def _gf_mul(a: int, b: int) -> int:
+    if a == 0 or b == 0:
+        return 0
+    return _GF_EXP[_GF_LOG[a] + _GF_LOG[b]]
+
+
+def _gf_inv(a: int) -> int:
+    return _GF_EXP[255 - _GF_LOG[a]]
+
+
+def _build_generator() -> List[int]:
+    """Generator polynomial, highest degree first (leading 1)."""
+    gen = [1]
+    for i in range(1, RS_PARITY + 1):
+        root = _GF_EXP[i]
+        nxt = gen + [0]
+        for j, coef in enumerate(gen):
+            nxt[j + 1] ^= _gf_mul(coef, root)
+        gen = nxt
+    return gen
+
+
+_GENERATOR = _build_generator()
+
+
+def rs_encode(data: bytes) -> bytes:
+    """
+    Compute RS(255,223) check bytes.
+
+    Args:
+        data: 1..223 data bytes
+
+    Returns:
+        32 check bytes, sent after the data
+    """
+    if not 0 < len(data) <= RS_K:
+        raise ValueError(f"RS data length {len(data)} not in 1..{RS_K}")
+
+    # Polynomial long division of data(x) * x^32 by the generator
+    work = bytearray(data) + bytearray(RS_PARITY)
+    for i in range(len(data)):
+        coef = work[i]
+        if coef:
+            for j in range(1, RS_PARITY + 1):
+                work[i + j] ^= _gf_mul(_GENERATOR[j], coef)
+    return bytes(work[len(data):])
+
+
+def _poly_eval_low_first(poly: List[int], x: int) -> int:
+    result = 0
+    for coef in reversed(poly):
+        result = _gf_mul(result, x) ^ coef
+    return result
+
+
+def rs_decode(block: bytes) -> Tuple[Optional[bytes], int]:
+    """
+    Correct a received codeword.
+
+    Args:
+        block: Data bytes followed by 32 check bytes (33..255 bytes)
+
+    Returns:
+        (corrected block, bytes corrected), or (None, 0) if uncorrectable
+    """
+    n = len(block)
+    if not RS_PARITY < n <= RS_N:
+        raise ValueError(f"RS block length {n} not in {RS_PARITY + 1}..{RS_N}")
+
+    synd = []
+    for i in range(1, RS_PARITY + 1):
+        root = _GF_EXP[i]
+        value = 0
+        for byte in block:
+            value = _gf_mul(value, root) ^ byte
+        synd.append(value)
+    if not any(synd):
+        return bytes(block), 0
+
+    # Berlekamp-Massey, polynomials low order first
+    locator = [1]
+    previous = [1]
+    for step in range(RS_PARITY):
+        previous = [0] + previous
+        delta = synd[step]
+        for i in range(1, len(locator)):
+            delta ^= _gf_mul(locator[i], synd[step - i])
+        if delta:
+            if len(previous) > len(locator):
+                updated = [_gf_mul(c, delta) for c in previous]
+                previous = [_gf_mul(c, _gf_inv(delta)) for c in locator]
+                locator = updated
+            size = max(len(locator), len(previous))
+            locator = locator + [0] * (size - len(locator))
+            scaled = previous + [0] * (size - len(previous))
+            locator = [a ^ _gf_mul(delta, b) for a, b in zip(locator, scaled)]
+    while len(locator) > 1 and locator[-1] == 0:
+        locator.pop()
+
+    errors = len(locator) - 1
+    if errors > RS_MAX_CORRECT:
+        return None, 0
+
+    omega = [0] * RS_PARITY
+    for i in range(RS_PARITY):
+        for j in range(min(i, errors) + 1):
+            omega[i] ^= _gf_mul(synd[i - j], locator[j])
+    derivative = [locator[i] if i % 2 == 1 else 0 for i in range(1, len(locator))]
+
+    fixed = bytearray(block)
+    found = 0
+    for k in range(n):
+        x_inv = _GF_EXP[(255 - (n - 1 - k)) % 255]
+        if _poly_eval_low_first(locator, x_inv) != 0:
+            continue
+        denom = _poly_eval_low_first(derivative, x_inv)
+        if denom == 0:
+            return None, 0
+        fixed[k] ^= _gf_mul(_poly_eval_low_first(omega, x_inv), _gf_inv(denom))
+        found += 1
+
+    if found != errors:
+        return None, 0
+    return bytes(fixed), found
+
+
+def hdlc_stuff(frame: bytes) -> Tuple[bytes, int]:
+    """
+    Bit-stuff a frame between flags, bits packed LSB first.
+
+    Args:
+        frame: AX.25 frame octets (address through FCS)
+
+    Returns:
+        (bit stream padded with idle flag bits, bits up to the closing flag)
+    """
+    bits: List[int] = []
+    bits.extend((HDLC_FLAG >> i) & 1 for i in range(8))
+    ones = 0
+    for byte in frame:
+        for i in range(8):
+            bit = (byte >> i) & 1
+            bits.append(bit)
+            ones = ones + 1 if bit else 0
+            if ones == 5:
+                bits.append(0)
+                ones = 0
+    bits.extend((HDLC_FLAG >> i) & 1 for i in range(8))
+    frame_bits = len(bits)
+    pad = 0
+    while len(bits) % 8:
+        bits.append((HDLC_FLAG >> pad) & 1)
+        pad += 1
+    out = bytearray(len(bits) // 8)
+    for i, bit in enumerate(bits):
+        out[i >> 3] |= bit << (i & 7)
+    return bytes(out), frame_bits
+
+
+def hdlc_unstuff(stream: bytes) -> Optional[bytes]:
+    """
+    Extract the first frame from an HDLC bit stream (LSB first, no NRZI).
+
+    Returns:
+        Frame octets between the first pair of flags, or None
+    """
+    bits = [(byte >> i) & 1 for byte in stream for i in range(8)]
+    flag = [(HDLC_FLAG >> i) & 1 for i in range(8)]
+
+    pos = 0
+    while pos + 8 <= len(bits) and bits[pos:pos + 8] != flag:
+        pos += 1
+    pos += 8
+    # Skip repeated opening flags
+    while bits[pos:pos + 8] == flag:
+        pos += 8
+
+    out = bytearray()
+    acc = 0
+    count = 0
+    ones = 0
+    while pos < len(bits):
+        if bits[pos:pos + 8] == flag:
+            return bytes(out) if count == 0 and out else None
+        bit = bits[pos]
+        pos += 1
+        if ones == 5:
+            if bit:
+                return None  # abort or misaligned flag
+            ones = 0
+            continue
+        ones = ones + 1 if bit else 0
+        acc |= bit << count
+        count += 1
+        if count == 8:
+            out.append(acc)
+            acc = 0
+            count = 0
+    return None
+
+
+def fx25_encode(stream: bytes, stream_bits: int) -> bytes:
+    """Wrap an HDLC bit stream in the shortest fitting FX.25 codeword."""
+    stream_len = (stream_bits + 7) // 8
+    if stream_bits == 0 or stream_len > RS_K:
+        raise ValueError(f"FX.25 stream of {stream_len} bytes does not fit")
+
+    tag, _n, k = next(mode for mode in FX25_MODES if mode[2] >= stream_len)
+    data = bytearray(stream[:stream_len]) + bytearray(k - stream_len)
+    for bit in range(stream_bits, k * 8):
+        mask = 1 << (bit & 7)
+        if (HDLC_FLAG >> ((bit - stream_bits) & 7)) & 1:
+            data[bit >> 3] |= mask
+        else:
+            data[bit >> 3] &= ~mask & 0xFF
+    return tag.to_bytes(FX25_TAG_LEN, "little") + bytes(data) + rs_encode(bytes(data))
+
+
+def fx25_decode(received: bytes) -> Tuple[Optional[bytes], int]:
+    """
+    Match the correlation tag and correct the codeword.
+
+    Returns:
+        (corrected data block, bytes corrected), or (None, 0) if no tag
+        matches, the input is short or the codeword is uncorrectable
+    """
+    if len(received) < FX25_TAG_LEN:
+        return None, 0
+    tag = int.from_bytes(received[:FX25_TAG_LEN], "little")
+    distance, n, k = min((bin(tag ^ t).count("1"), n, k) for t, n, k in FX25_MODES)
+    if distance > FX25_TAG_MAX_ERRORS or len(received) < FX25_TAG_LEN + n:
+        return None, 0
+
+    block, corrected = rs_decode(received[FX25_TAG_LEN:FX25_TAG_LEN + n])
+    if block is None:
+        return None, 0
+    return block[:k], corrected
+
+
+def _tlm_block_lengths(body: int, blocks: int) -> List[int]:
+    return [body // blocks + (1 if i < body % blocks else 0) for i in range(blocks)]
+
+
+def tlm_fec_encode(frame: bytes) -> bytes:
+    """RS-encode a serialized telemetry frame (sync word left uncoded)."""
+    body = len(frame) - TLM_SYNC_LEN
+    if body <= 0:
+        raise ValueError("Telemetry frame too short")
+    blocks = (body + RS_K - 1) // RS_K
+    out = bytearray(frame[:TLM_SYNC_LEN])
+    pos = TLM_SYNC_LEN
+    for length in _tlm_block_lengths(body, blocks):
+        data = frame[pos:pos + length]
+        out += data + rs_encode(data)
+        pos += length
+    return bytes(out)
+
+
+def tlm_fec_decode(coded: bytes) -> Tuple[Optional[bytes], int]:
+    """
+    Correct an RS-coded telemetry frame and strip the check bytes.
+
+    Returns:
+        (frame, bytes corrected), or (None, 0) if any codeword is
+        uncorrectable or the length is not a valid coded length
+    """
+    coded_body = len(coded) - TLM_SYNC_LEN
+    if coded_body <= RS_PARITY:
+        return None, 0
+    blocks = (coded_body + RS_N - 1) // RS_N
+    body = coded_body - blocks * RS_PARITY
+    if body <= 0:
+        return None, 0
+
+    frame = bytearray(coded[:TLM_SYNC_LEN])
+    pos = TLM_SYNC_LEN
+    total = 0
+    for length in _tlm_block_lengths(body, blocks):
+        block, corrected = rs_decode(coded[pos:pos + length + RS_PARITY])
+        if block is None:
+            return None, 0
+        frame += block[:length]
+        total += corrected
+        pos += length + RS_PARITY
+    return bytes(frame), total
@@ -20,6 +20,8 @@ from beacon_decoder import (
     BeaconDecoder, BeaconType, AX25Address, AX25Frame,
     DecodedBeacon, decode_beacon
 )
+from crc16 import crc16_x25
+from fec import FX25_TAG_LEN, hdlc_stuff, fx25_encode
 
 
 class TestBeaconType(unittest.TestCase):
@@ -438,6 +440,190 @@ class TestBeaconDecoderType(unittest.TestCase):
         self.decoder._decode_count = 0
 
 
+# Binary beacon info field produced by beacon_format_binary().
+# Must match the golden vector in software/flight/tests/test_beacon_payload.c.
+BINARY_GOLDEN = bytes.fromhex("b10000002a6553f10002571cf4fb17010204d20237010183f2")
+
+
+def build_ax25_frame(info: bytes) -> bytes:
+    """Build a flagged AX.25 UI frame from CQ to SQSO-1 around an info field."""
+    def address(callsign: str, ssid: int, last: bool) -> bytes:
+        padded = callsign.ljust(6)[:6]
+        return bytes(ord(c) << 1 for c in padded) + bytes(
+            [0x60 | (ssid << 1) | (0x01 if last else 0x00)])
+
+    body = address("CQ", 0, False) + address("SQSO-1", 1, True) + b"\x03\xf0" + info
+    fcs = crc16_x25(body)
+    return b"\x7e" + body + struct.pack("<H", fcs) + b"\x7e"
+
+
+class TestBeaconDecoderBinary(unittest.TestCase):
+    """Test binary beacon auto-detection and decoding."""
+
+    def setUp(self):
+        """Set up test fixtures."""
+        self.decoder = BeaconDecoder()
+
+    def test_detect_binary_type_byte(self):
+        """Test type byte identifies binary info fields."""
+        self.assertTrue(BeaconDecoder.is_binary_info(BINARY_GOLDEN))
+        self.assertFalse(BeaconDecoder.is_binary_info(b"de SQSO-1: hi"))
+        self.assertFalse(BeaconDecoder.is_binary_info(b""))
+
+    def test_decode_binary_golden(self):
+        """Test decoding the shared golden vector."""
+        fields, errors = self.decoder.decode_binary_info(BINARY_GOLDEN)
+
+        self.assertEqual(errors, [])
+        self.assertEqual(fields["sequence"], 42)
+        self.assertEqual(fields["timestamp"], 1700000000)
+        self.assertEqual(fields["power_mode"], "ACTIVE")
+        self.assertEqual(fields["battery_soc"], 87)
+        self.assertEqual(fields["battery_mv"], 7412)
+        self.assertAlmostEqual(fields["battery_voltage"], 7.412)
+        self.assertEqual(fields["temperature"], -5)
+        self.assertEqual(fields["temperature_payload"], 23)
+        self.assertTrue(fields["sunlit"])
+        self.assertEqual(fields["rf_power"], 2)
+        self.assertEqual(fields["qso_count"], 1234)
+        self.assertEqual(fields["orbit_number"], 567)
+        self.assertEqual(fields["fault_flags"], 1)
+        self.assertTrue(fields["ai_generated"])
+
+    def test_decode_binary_crc_mismatch(self):
+        """Test corrupted binary beacon is flagged."""
+        corrupted = bytearray(BINARY_GOLDEN)
+        corrupted[10] ^= 0x01
+        _, errors = self.decoder.decode_binary_info(bytes(corrupted))
+
+        self.assertIn("Binary beacon CRC mismatch", errors)
+
+    def test_decode_binary_wrong_length(self):
+        """Test truncated binary beacon is rejected."""
+        fields, errors = self.decoder.decode_binary_info(BINARY_GOLDEN[:-1])
+
+        self.assertEqual(fields, {})
+        self.assertEqual(len(errors), 1)
+
+    def test_decode_binary_frame(self):
+        """Test full frame decode auto-detects binary beacons."""
+        beacon = self.decoder.decode(build_ax25_frame(BINARY_GOLDEN))
+
+        self.assertTrue(beacon.valid)
+        self.assertEqual(beacon.beacon_type, BeaconType.BINARY)
+        self.assertEqual(beacon.callsign, "SQSO-1")
+        self.assertEqual(beacon.sequence, 42)
+        self.assertEqual(beacon.timestamp, 1700000000)
+        self.assertTrue(beacon.ai_generated)
+        self.assertEqual(beacon.telemetry["battery_soc"], 87)
+
+    def test_decode_text_frame_unchanged(self):
+        """Test text beacons still go through the text path."""
+        beacon = self.decoder.decode(build_ax25_frame(b"de SQSO-1: hello B:80%"))
+
+        self.assertTrue(beacon.valid)
+        self.assertNotEqual(beacon.beacon_type, BeaconType.BINARY)
+        self.assertEqual(beacon.telemetry["battery_soc"], 80)
+
+
+def build_digest(sequence: int, timestamp: int, fault_count: int, faults) -> bytes:
+    """Pack a log-digest info field as beacon_format_digest() does."""
+    body = struct.pack(">BIIHB", 0xB2, sequence, timestamp, fault_count, len(faults))
+    for fault_type, severity, recovered, time_s in faults:
+        body += struct.pack(">BBBI", fault_type, severity, recovered, time_s)
+    body += bytes(7 * (4 - len(faults)))
+    return body + struct.pack(">H", crc16_x25(body))
+
+
+class TestDigestBeacon(unittest.TestCase):
+    """Test log-digest beacon decoding."""
+
+    def setUp(self):
+        """Set up test fixtures."""
+        self.decoder = BeaconDecoder()
+        self.digest = build_digest(9, 1200, 5, [(2, 2, 1, 1100), (6, 3, 0, 900),
+                                                (5, 4, 0, 600), (3, 2, 0, 30)])
+
+    def test_digest_length(self):
+        """Test digest layout length matches the flight constant."""
+        self.assertEqual(BeaconDecoder.DIGEST_LEN, 42)
+        self.assertEqual(len(self.digest), 42)
+
+    def test_is_digest_info(self):
+        """Test type byte detection."""
+        self.assertTrue(BeaconDecoder.is_digest_info(self.digest))
+        self.assertFalse(BeaconDecoder.is_digest_info(BINARY_GOLDEN))
+        self.assertFalse(BeaconDecoder.is_binary_info(self.digest))
+
+    def test_decode_digest_fields(self):
+        """Test header and entries decode, most recent first."""
+        fields, errors = self.decoder.decode_digest_info(self.digest)
+
+        self.assertEqual(errors, [])
+        self.assertEqual(fields["sequence"], 9)
+        self.assertEqual(fields["timestamp"], 1200)
+        self.assertEqual(fields["fault_count"], 5)
+        self.assertEqual(len(fields["faults"]), 4)
+        self.assertEqual(fields["faults"][0],
+                         {"fault_type": 2, "severity": 2, "recovered": True, "time_s": 1100})
+        self.assertEqual(fields["faults"][3]["fault_type"], 3)
+
+    def test_decode_partial_digest(self):
+        """Test unused entries are not reported."""
+        fields, errors = self.decoder.decode_digest_info(build_digest(1, 2, 1, [(1, 1, 0, 5)]))
+
+        self.assertEqual(errors, [])
+        self.assertEqual(len(fields["faults"]), 1)
+
+    def test_decode_digest_crc_mismatch(self):
+        """Test corrupted digest is flagged."""
+        corrupted = bytearray(self.digest)
+        corrupted[13] ^= 0x01
+        _, errors = self.decoder.decode_digest_info(bytes(corrupted))
+
+        self.assertEqual(len(errors), 1)
+
+    def test_decode_digest_frame(self):
+        """Test full frame decode auto-detects log-digest beacons."""
+        beacon = self.decoder.decode(build_ax25_frame(self.digest))
+
+        self.assertTrue(beacon.valid)
+        self.assertEqual(beacon.beacon_type, BeaconType.LOG_DIGEST)
+        self.assertEqual(beacon.sequence, 9)
+        self.assertEqual(beacon.telemetry["fault_count"], 5)
+
+
+class TestFx25Beacon(unittest.TestCase):
+    """Test FX.25-coded beacon decoding."""
+
+    def setUp(self):
+        """Set up test fixtures."""
+        stream, bits = hdlc_stuff(build_ax25_frame(BINARY_GOLDEN)[1:-1])
+        self.received = bytearray(fx25_encode(stream, bits))
+
+    def test_decoder_fx25_beacon(self):
+        """Test BeaconDecoder recovers a damaged binary beacon."""
+        received = self.received
+        for pos in range(FX25_TAG_LEN, FX25_TAG_LEN + 40, 4):
+            received[pos] ^= 0xFF
+
+        beacon = BeaconDecoder().decode_fx25(bytes(received))
+        self.assertTrue(beacon.valid)
+        self.assertEqual(beacon.beacon_type, BeaconType.BINARY)
+        self.assertEqual(beacon.sequence, 42)
+        self.assertEqual(beacon.telemetry["fec_corrected"], 10)
+
+    def test_decoder_fx25_uncorrectable(self):
+        """Test BeaconDecoder reports an uncorrectable codeword."""
+        received = self.received
+        for pos in range(FX25_TAG_LEN, len(received), 2):
+            received[pos] ^= 0xFF
+
+        beacon = BeaconDecoder().decode_fx25(bytes(received))
+        self.assertFalse(beacon.valid)
+        self.assertEqual(len(beacon.errors), 1)
+
+
 class TestDecodeBeaconConvenience(unittest.TestCase):
     """Test decode_beacon convenience function."""
 
@@ -0,0 +1,141 @@
+"""
+Unit tests for CRC-16 Module
+
+Checks the table-driven ground CRC-16 implementations against catalogue
+check values, the former bitwise loops, and vectors shared with the
+flight software unit test (software/flight/tests/test_crc16.c).
+
+Author: SMART-QSO Team
+Date: 2026-01-02
+Version: 1.0
+"""
+
+import unittest
+import time
+
+import sys
+import os
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.dirname(os.path.abspath(__file__))), "tools"))
+
+from crc16 import (
+    crc16_x25, crc16_x25_update, crc16_x25_bitwise, crc16_ccitt_false,
+    X25_INIT, X25_CHECK, X25_RESIDUE, CCITT_CHECK
+)
+from beacon_decoder import BeaconDecoder
+from fl_update_builder import calculate_crc16
+
+# Expected FCS over prefixes of the shared vector.
+# Must match s_shared_vectors in software/flight/tests/test_crc16.c.
+SHARED_VECTORS = [
+    (1, 0x5342),
+    (7, 0xC289),
+    (64, 0xB78B),
+    (255, 0x2C24),
+    (1024, 0x2DFB),
+]
+
+
+def make_shared_vector(length: int) -> bytes:
+    """Generate the shared vector (ANSI C LCG, seed 1, bits 16..23)."""
+    x = 1
+    out = bytearray()
+    for _ in range(length):
+        x = (x * 1103515245 + 12345) & 0x7FFFFFFF
+        out.append((x >> 16) & 0xFF)
+    return bytes(out)
+
+
+def ccitt_false_bitwise(data: bytes) -> int:
+    """The former fl_update_builder bit loop."""
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= (byte << 8)
+        for _ in range(8):
+            if crc & 0x8000:
+                crc = ((crc << 1) ^ 0x1021) & 0xFFFF
+            else:
+                crc = (crc << 1) & 0xFFFF
+    return crc
+
+
+class TestCrc16X25(unittest.TestCase):
+    """Test CRC-16/X.25 (AX.25 FCS)."""
+
+    def test_check_value(self):
+        """Test catalogue check value."""
+        self.assertEqual(crc16_x25(b"123456789"), X25_CHECK)
+
+    def test_empty(self):
+        """Test FCS of empty data."""
+        self.assertEqual(crc16_x25(b""), 0x0000)
+
+    def test_shared_vectors(self):
+        """Test vectors shared with the flight unit test."""
+        data = make_shared_vector(1024)
+        for length, expected in SHARED_VECTORS:
+            self.assertEqual(crc16_x25(data[:length]), expected, f"len={length}")
+
+    def test_matches_bitwise(self):
+        """Test table version against the bitwise reference."""
+        data = make_shared_vector(1024)
+        for length in range(0, 1025, 13):
+            self.assertEqual(crc16_x25(data[:length]), crc16_x25_bitwise(data[:length]))
+
+    def test_incremental(self):
+        """Test incremental update matches one-shot."""
+        crc = crc16_x25_update(X25_INIT, b"1234")
+        crc = crc16_x25_update(crc, b"56789")
+        self.assertEqual(crc ^ 0xFFFF, X25_CHECK)
+
+    def test_residue(self):
+        """Test data plus FCS (LSB first) gives the good-frame residue."""
+        fcs = crc16_x25(b"123456789")
+        frame = b"123456789" + bytes([fcs & 0xFF, fcs >> 8])
+        self.assertEqual(crc16_x25_update(X25_INIT, frame), X25_RESIDUE)
+
+    def test_decoder_uses_shared_fcs(self):
+        """Test beacon decoder FCS matches the shared implementation."""
+        decoder = BeaconDecoder()
+        data = make_shared_vector(200)
+        self.assertEqual(decoder._calculate_fcs(data), crc16_x25(data))
+
+    def test_table_faster_than_bitwise(self):
+        """Test table version outperforms the bit loop on a max-size frame."""
+        data = make_shared_vector(330)
+
+        start = time.perf_counter()
+        for _ in range(50):
+            crc16_x25_bitwise(data)
+        bitwise = time.perf_counter() - start
+
+        start = time.perf_counter()
+        for _ in range(50):
+            crc16_x25(data)
+        table = time.perf_counter() - start
+
+        self.assertLess(table, bitwise)
+
+
+class TestCrc16CcittFalse(unittest.TestCase):
+    """Test CRC-16/CCITT-FALSE (FL-UPDATE checksum)."""
+
+    def test_check_value(self):
+        """Test catalogue check value."""
+        self.assertEqual(crc16_ccitt_false(b"123456789"), CCITT_CHECK)
+
+    def test_matches_bitwise(self):
+        """Test table version against the former bit loop."""
+        data = make_shared_vector(1024)
+        for length in range(0, 1025, 31):
+            self.assertEqual(crc16_ccitt_false(data[:length]),
+                             ccitt_false_bitwise(data[:length]))
+
+    def test_fl_update_builder_unchanged(self):
+        """Test FL-UPDATE checksum is unchanged by the table version."""
+        data = make_shared_vector(256)
+        self.assertEqual(calculate_crc16(data), ccitt_false_bitwise(data))
+
+
+if __name__ == "__main__":
+    unittest.main()
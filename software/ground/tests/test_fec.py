@@ -0,0 +1,167 @@
+"""
+Unit tests for the FEC Module
+
+Checks RS(255,223) check bytes against vectors shared with the flight
+software unit test (software/flight/tests/test_fec.c), error correction
+limits, FX.25 wrapping and the telemetry block framing.
+
+Author: SMART-QSO Team
+Date: 2026-01-02
+Version: 1.0
+"""
+
+import random
+import unittest
+
+import sys
+import os
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+
+from fec import (
+    RS_K, RS_PARITY, RS_MAX_CORRECT, FX25_TAG_LEN,
+    rs_encode, rs_decode, hdlc_stuff, hdlc_unstuff,
+    fx25_encode, fx25_decode, tlm_fec_encode, tlm_fec_decode
+)
+
+# Check bytes of the shared vector (full 223 bytes and its 32-byte prefix).
+# Must match s_parity_223 / s_parity_32 in software/flight/tests/test_fec.c.
+SHARED_PARITY = {
+    223: bytes.fromhex("21bbea23be4555aa604145a2d8457d561f6e106a2e4dcea34ce5173b06567661"),
+    32: bytes.fromhex("ad266cc915fe88a723c250a5d1d6349f5713a9cf849a1d8b5745efd263a29711"),
+}
+
+
+def make_shared_vector(length: int) -> bytes:
+    """Generate the shared vector (ANSI C LCG, seed 1, bits 16..23)."""
+    x = 1
+    out = bytearray()
+    for _ in range(length):
+        x = (x * 1103515245 + 12345) & 0x7FFFFFFF
+        out.append((x >> 16) & 0xFF)
+    return bytes(out)
+
+
+def corrupt(block: bytes, count: int, rng: random.Random) -> bytes:
+    """Corrupt count distinct bytes with non-zero error values."""
+    damaged = bytearray(block)
+    for pos in rng.sample(range(len(block)), count):
+        damaged[pos] ^= rng.randint(1, 255)
+    return bytes(damaged)
+
+
+class TestReedSolomon(unittest.TestCase):
+    """Test RS(255,223) encode and decode."""
+
+    def test_shared_vectors(self):
+        """Test check bytes match the flight encoder."""
+        for length, parity in SHARED_PARITY.items():
+            self.assertEqual(rs_encode(make_shared_vector(RS_K)[:length]), parity)
+
+    def test_clean_codeword(self):
+        """Test a clean codeword decodes unchanged."""
+        data = make_shared_vector(100)
+        block, corrected = rs_decode(data + rs_encode(data))
+        self.assertEqual(block[:100], data)
+        self.assertEqual(corrected, 0)
+
+    def test_corrects_up_to_limit(self):
+        """Test up to 16 byte errors are corrected in any block length."""
+        rng = random.Random(7)
+        for length in (1, 32, 150, RS_K):
+            data = make_shared_vector(length)
+            codeword = data + rs_encode(data)
+            for errors in (1, 8, RS_MAX_CORRECT):
+                block, corrected = rs_decode(corrupt(codeword, errors, rng))
+                self.assertEqual(block, codeword)
+                self.assertEqual(corrected, errors)
+
+    def test_uncorrectable(self):
+        """Test more than 16 errors are reported."""
+        rng = random.Random(11)
+        data = make_shared_vector(RS_K)
+        codeword = data + rs_encode(data)
+        for _ in range(10):
+            block, _ = rs_decode(corrupt(codeword, RS_MAX_CORRECT + 1, rng))
+            self.assertIsNone(block)
+
+    def test_invalid_lengths(self):
+        """Test out-of-range lengths raise."""
+        with self.assertRaises(ValueError):
+            rs_encode(b"")
+        with self.assertRaises(ValueError):
+            rs_encode(bytes(RS_K + 1))
+        with self.assertRaises(ValueError):
+            rs_decode(bytes(RS_PARITY))
+
+
+class TestHdlc(unittest.TestCase):
+    """Test HDLC bit stuffing helpers."""
+
+    def test_roundtrip(self):
+        """Test frames with flag-like and all-ones bytes survive stuffing."""
+        frame = b"\x7e\xff\xff\x00\x1f\xf8hello"
+        stream, _ = hdlc_stuff(frame)
+        self.assertEqual(hdlc_unstuff(stream), frame)
+
+    def test_no_frame(self):
+        """Test a stream without a closing flag yields None."""
+        self.assertIsNone(hdlc_unstuff(b"\x7e\x01\x02"))
+
+
+class TestFx25(unittest.TestCase):
+    """Test FX.25 wrapping and decoding."""
+
+    def test_mode_selection(self):
+        """Test the shortest fitting codeword is used."""
+        for info_len, codeword in ((1, 64), (30, 96), (80, 160), (180, 255)):
+            stream, bits = hdlc_stuff(bytes(16 + info_len + 2))
+            self.assertEqual(len(fx25_encode(stream, bits)), FX25_TAG_LEN + codeword)
+
+    def test_roundtrip_with_errors(self):
+        """Test tag and codeword errors are tolerated."""
+        rng = random.Random(3)
+        frame = make_shared_vector(120)
+        stream, bits = hdlc_stuff(frame)
+        received = bytearray(fx25_encode(stream, bits))
+        received[0] ^= 0x11
+        received = received[:FX25_TAG_LEN] + corrupt(bytes(received[FX25_TAG_LEN:]),
+                                                      RS_MAX_CORRECT, rng)
+
+        block, corrected = fx25_decode(bytes(received))
+        self.assertEqual(corrected, RS_MAX_CORRECT)
+        self.assertEqual(hdlc_unstuff(block), frame)
+
+    def test_unknown_tag(self):
+        """Test an unrelated tag is rejected."""
+        block, _ = fx25_decode(bytes([0x55]) * 104)
+        self.assertIsNone(block)
+
+
+class TestTelemetryFec(unittest.TestCase):
+    """Test RS-coded telemetry frames."""
+
+    def test_roundtrip(self):
+        """Test frames split into codewords decode back after a burst."""
+        for length in (5, 18, 227, 228, 256):
+            frame = make_shared_vector(length)
+            coded = bytearray(tlm_fec_encode(frame))
+            self.assertEqual(coded[:4], frame[:4])
+            for pos in range(4, 4 + min(8, length - 4)):
+                coded[pos] ^= 0xFF
+
+            decoded, corrected = tlm_fec_decode(bytes(coded))
+            self.assertEqual(decoded, frame)
+            self.assertEqual(corrected, min(8, length - 4))
+
+    def test_coded_length(self):
+        """Test coded length adds 32 bytes per codeword."""
+        self.assertEqual(len(tlm_fec_encode(bytes(44))), 44 + 32)
+        self.assertEqual(len(tlm_fec_encode(bytes(256))), 256 + 64)
+
+    def test_too_short(self):
+        """Test short input is rejected."""
+        self.assertEqual(tlm_fec_decode(bytes(10)), (None, 0))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,169 @@
+"""
+Unit tests for the Sensor Configuration Image Compiler
+
+Checks the compiled image against a vector shared with the flight software
+unit test (software/flight/tests/test_sensors.c), decoding, and rejection
+of configurations the flight loader would not accept.
+
+Author: SMART-QSO Team
+Date: 2026-01-02
+Version: 1.0
+"""
+
+import unittest
+
+import sys
+import os
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.dirname(os.path.abspath(__file__))), "tools"))
+
+from sensor_image_compiler import (
+    HEADER_SIZE, MAX_IMAGE_SIZE, compile_yaml, decode_image
+)
+
+FLIGHT_YAML = os.path.join(
+    os.path.dirname(os.path.dirname(os.path.dirname(os.path.abspath(__file__)))),
+    "flight", "sensors.yaml")
+
+SHARED_YAML = """\
+sensors:
+  - id: BV
+    name: Battery Voltage
+    type: eps_voltage
+    channel: battery
+    units: V
+    period_ms: 1000
+    filter: iir
+    filter_alpha: 0.25
+    decimation: 2
+  - id: ST
+    name: Status Hex
+    type: status_hex2
+    units: hex
+    period_ms: 2000
+"""
+
+# Image compiled from SHARED_YAML.
+# Must match s_shared_image in software/flight/tests/test_sensors.c.
+SHARED_IMAGE = bytes.fromhex(
+    "435351530200020027000000"
+    "699d53420201020002000000"
+    "03001300e803000090d00300"
+    "000003000500000000001500"
+    "18002300d007000000000000"
+    "000003004256004261747465"
+    "727920566f6c746167650056"
+    "005354005374617475732048"
+    "65780068657800"
+)
+
+
+def sensor_yaml(**fields: str) -> str:
+    """Build a one-sensor configuration."""
+    base = {"id": "X", "type": "eps_voltage", "channel": "battery", "period_ms": "1000"}
+    base.update(fields)
+    lines = ["sensors:"]
+    for n, (key, value) in enumerate(base.items()):
+        lines.append(f"  {'- ' if n == 0 else '  '}{key}: {value}")
+    return "\n".join(lines) + "\n"
+
+
+class TestCompile(unittest.TestCase):
+    """Test image compilation."""
+
+    def test_shared_vector(self):
+        """Test the image matches the flight loader's vector."""
+        self.assertEqual(compile_yaml(SHARED_YAML), SHARED_IMAGE)
+
+    def test_round_trip(self):
+        """Test decoding returns the resolved fields."""
+        sensors = decode_image(compile_yaml(SHARED_YAML))
+        self.assertEqual(len(sensors), 2)
+        self.assertEqual(sensors[0].id, "BV")
+        self.assertEqual(sensors[0].channel, "battery")
+        self.assertEqual(sensors[0].filter, "iir")
+        self.assertEqual(sensors[0].alpha_ppm, 250000)
+        self.assertEqual(sensors[0].decimation, 2)
+        self.assertEqual(sensors[1].type, "status_hex2")
+        self.assertEqual(sensors[1].channel, "")
+        self.assertEqual(sensors[1].period_ms, 2000)
+
+    def test_adcs_types(self):
+        """Test the ADCS driver types and axis channels resolve."""
+        image = compile_yaml("sensors:\n  - id: MAGX\n    type: magnetometer\n"
+                             "    channel: x\n  - id: SUNZ\n    type: sun_sensor\n"
+                             "    channel: z\n")
+        sensors = decode_image(image)
+        self.assertEqual([(s.type, s.channel) for s in sensors],
+                         [("magnetometer", "x"), ("sun_sensor", "z")])
+
+    def test_flight_config(self):
+        """Test the flight sensors.yaml compiles and fits the flash region."""
+        with open(FLIGHT_YAML, encoding="utf-8") as f:
+            image = compile_yaml(f.read())
+        self.assertLessEqual(len(image), MAX_IMAGE_SIZE)
+        self.assertGreater(len(decode_image(image)), 0)
+
+    def test_rejects_unknown_names(self):
+        """Test names the flight loader cannot bind are compile errors."""
+        for fields in ({"type": "thermocouple"}, {"channel": "payload"},
+                       {"filter": "kalman"}):
+            with self.subTest(fields=fields):
+                with self.assertRaises(ValueError):
+                    compile_yaml(sensor_yaml(**fields))
+
+    def test_rejects_out_of_range(self):
+        """Test out-of-range filter settings are compile errors."""
+        for fields in ({"filter": "iir", "filter_alpha": "0"},
+                       {"filter": "iir", "filter_alpha": "1.5"},
+                       {"filter": "median", "filter_length": "17"},
+                       {"decimation": "3601"},
+                       {"history": "65"},
+                       {"decimals": "7"},
+                       {"id": "TOOLONGID"}):
+            with self.subTest(fields=fields):
+                with self.assertRaises(ValueError):
+                    compile_yaml(sensor_yaml(**fields))
+
+    def test_history(self):
+        """Test history depths are carried and limited to the flight pool."""
+        sensors = decode_image(compile_yaml(sensor_yaml(history="64")))
+        self.assertEqual(sensors[0].history, 64)
+        many = "sensors:\n" + "".join(
+            f"  - id: S{i}\n    type: eps_voltage\n    history: 64\n" for i in range(9))
+        with self.assertRaises(ValueError):
+            compile_yaml(many)
+
+    def test_decimals(self):
+        """Test fixed-point decimal places are carried, defaulting to 3."""
+        self.assertEqual(decode_image(compile_yaml(sensor_yaml()))[0].decimals, 3)
+        self.assertEqual(decode_image(compile_yaml(sensor_yaml(decimals="0")))[0].decimals, 0)
+        self.assertEqual(decode_image(compile_yaml(sensor_yaml(decimals="6")))[0].decimals, 6)
+
+    def test_rejects_too_many_sensors(self):
+        """Test a table larger than the flight table is rejected."""
+        with self.assertRaises(ValueError):
+            compile_yaml(SHARED_YAML, max_sensors=1)
+
+
+class TestDecode(unittest.TestCase):
+    """Test image checks."""
+
+    def test_corruption_detected(self):
+        """Test a flipped bit anywhere after the header fails the CRC."""
+        for i in range(HEADER_SIZE, len(SHARED_IMAGE)):
+            image = bytearray(SHARED_IMAGE)
+            image[i] ^= 0x01
+            with self.subTest(offset=i):
+                with self.assertRaises(ValueError):
+                    decode_image(bytes(image))
+
+    def test_truncated(self):
+        """Test a short image is rejected."""
+        with self.assertRaises(ValueError):
+            decode_image(SHARED_IMAGE[:-1])
+        with self.assertRaises(ValueError):
+            decode_image(SHARED_IMAGE[:HEADER_SIZE - 1])
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -34,6 +34,10 @@ from pathlib import Path
 from typing import List, Optional, BinaryIO
 import math
 
+# Shared CRC implementations live in software/ground
+sys.path.insert(0, str(Path(__file__).resolve().parent.parent))
+from crc16 import crc16_ccitt_false  # noqa: E402
+
 
 # Frame constants
 FL_MAGIC = 0x464C  # "FL"
@@ -87,7 +91,7 @@ class FLUpdateManifest:
 
 def calculate_crc16(data: bytes) -> int:
     """
-    Calculate CRC-16-CCITT.
+    Calculate CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF).
 
     Args:
         data: Input bytes
@@ -95,18 +99,7 @@ def calculate_crc16(data: bytes) -> int:
     Returns:
         16-bit CRC value
     """
-    crc = 0xFFFF
-    polynomial = 0x1021
-
-    for byte in data:
-        crc ^= (byte << 8)
-        for _ in range(8):
-            if crc & 0x8000:
-                crc = ((crc << 1) ^ polynomial) & 0xFFFF
-            else:
-                crc = (crc << 1) & 0xFFFF
-
-    return crc
+    return crc16_ccitt_false(data)
 
 
 def split_data(data: bytes, chunk_size: int) -> List[bytes]:
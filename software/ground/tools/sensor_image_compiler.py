@@ -0,0 +1,423 @@
+#!/usr/bin/env python3
+"""
+SMART-QSO Sensor Configuration Image Compiler
+
+Compiles sensors.yaml into the binary image the flight software loads with
+sensors_load_image() or from FLASH_REGION_SENSOR_CONFIG. Type and channel
+names are resolved to IDs here, so the flight software parses no text at
+boot, and the image can be uploaded as a single blob.
+
+Document ID: SMART-QSO-GND-004
+Version: 1.0
+
+Image Format (little-endian, see software/flight/include/sensor_image.h):
++--------+--------+--------+--------+--------+--------+
+| Magic  | Ver    | Count  | Pool   | Rsvd   | CRC32  |  Header, 16 bytes
+| 4 byte | 2 byte | 2 byte | 2 byte | 2 byte | 4 byte |
++--------+--------+--------+--------+--------+--------+
+| Count x 24-byte records | Pool bytes of NUL-terminated strings |
+
+- Magic: 0x53515343 ("SQSC")
+- CRC32: IEEE CRC32 over header bytes 0-11 and everything after the header
+- Record: type, channel, filter, filter_length (u8 each), decimation (u16),
+  id/name/units string offsets (u16 each), period_ms (u32),
+  alpha_ppm (u32), history (u16), decimals (u8), reserved (u8)
+"""
+
+import argparse
+import struct
+import sys
+import zlib
+from dataclasses import dataclass
+from pathlib import Path
+from typing import Dict, List
+
+# Format constants. Must match software/flight/include/sensor_image.h.
+IMAGE_MAGIC = 0x53515343  # "SQSC"
+IMAGE_VERSION = 2
+HEADER_SIZE = 16
+RECORD_SIZE = 24
+MAX_IMAGE_SIZE = 2048
+ALPHA_SCALE = 1000000
+
+HEADER_FORMAT = "<IHHHHI"
+RECORD_FORMAT = "<BBBBHHHHIIHBB"
+
+TYPE_IDS: Dict[str, int] = {
+    "software_timer": 1,
+    "eps_voltage": 2,
+    "eps_current": 3,
+    "eps_temperature": 4,
+    "status_hex2": 5,
+    "magnetometer": 6,
+    "sun_sensor": 7,
+}
+
+CHANNEL_IDS: Dict[str, int] = {
+    "": 0,
+    "battery": 1,
+    "bus": 2,
+    "solar": 3,
+    "battery_discharge": 4,
+    "jetson": 5,
+    "x": 6,
+    "y": 7,
+    "z": 8,
+}
+
+FILTER_IDS: Dict[str, int] = {
+    "none": 0,
+    "moving_average": 1,
+    "iir": 2,
+    "median": 3,
+}
+
+# Field limits (buffer sizes include the terminator), from smart_qso.h and
+# sensor_filter.h.
+ID_LEN = 8
+NAME_LEN = 64
+UNITS_LEN = 16
+MAX_SENSORS = 32
+FILTER_MAX_LENGTH = 16
+FILTER_MAX_DECIMATION = 3600
+HISTORY_MAX_DEPTH = 64
+HISTORY_POOL_SIZE = 512
+
+# Fixed-point decimal places, from sensor_fixed.h
+MAX_DECIMALS = 6
+DEFAULT_DECIMALS = 3
+
+# Types with text values, which keep no history
+TEXT_TYPES = {"status_hex2"}
+
+
+@dataclass
+class SensorEntry:
+    """One resolved sensor."""
+    id: str
+    name: str
+    type: str
+    channel: str
+    units: str
+    period_ms: int
+    filter: str = "none"
+    filter_length: int = 0
+    decimation: int = 0
+    alpha_ppm: int = 0
+    history: int = 0
+    decimals: int = DEFAULT_DECIMALS
+
+
+def parse_sensors_yaml(text: str) -> List[Dict[str, str]]:
+    """
+    Parse the sensors.yaml subset the flight loader accepts.
+
+    Lines are trimmed; '#' lines are comments; items start with '-' under
+    'sensors:' and hold 'key: value' fields, quotes stripped.
+
+    Args:
+        text: File contents
+
+    Returns:
+        List of field dictionaries, one per sensor
+    """
+    items: List[Dict[str, str]] = []
+    in_list = False
+
+    for raw in text.splitlines():
+        line = raw.strip()
+        if not line or line.startswith("#"):
+            continue
+        if not in_list:
+            in_list = (line == "sensors:")
+            continue
+
+        field = line
+        if line == "-" or line.startswith("- "):
+            items.append({})
+            field = line[1:].strip()
+            if not field:
+                continue
+        if ":" not in field or not items:
+            continue
+
+        key, _, value = field.partition(":")
+        value = value.strip()
+        if len(value) >= 2 and value[0] in "\"'" and value[-1] in "\"'":
+            value = value[1:-1]
+        items[-1][key.strip()] = value
+
+    return items
+
+
+def _int_field(fields: Dict[str, str], key: str, limit: int, sensor: str,
+               default: int = 0) -> int:
+    text = fields.get(key, "") or str(default)
+    try:
+        value = int(text, 10)
+    except ValueError:
+        raise ValueError(f"{sensor}: {key} '{text}' is not an integer")
+    if not 0 <= value <= limit:
+        raise ValueError(f"{sensor}: {key} {value} out of range 0..{limit}")
+    return value
+
+
+def resolve_sensor(fields: Dict[str, str]) -> SensorEntry:
+    """
+    Check one sensor's fields and resolve its names.
+
+    Args:
+        fields: Parsed fields
+
+    Returns:
+        Resolved sensor
+
+    Raises:
+        ValueError: If a field is unknown or out of range
+    """
+    sensor_id = fields.get("id", "")
+    label = sensor_id or "<no id>"
+    if not sensor_id:
+        raise ValueError(f"{label}: missing id")
+
+    for key, size in (("id", ID_LEN), ("name", NAME_LEN), ("units", UNITS_LEN)):
+        if len(fields.get(key, "").encode("ascii")) >= size:
+            raise ValueError(f"{label}: {key} longer than {size - 1} characters")
+
+    sensor_type = fields.get("type", "")
+    if sensor_type not in TYPE_IDS:
+        raise ValueError(f"{label}: unknown type '{sensor_type}'")
+    channel = fields.get("channel", "")
+    if channel not in CHANNEL_IDS:
+        raise ValueError(f"{label}: unknown channel '{channel}'")
+    filter_name = fields.get("filter", "none")
+    if filter_name not in FILTER_IDS:
+        raise ValueError(f"{label}: unknown filter '{filter_name}'")
+
+    alpha_ppm = 0
+    if filter_name == "iir":
+        try:
+            alpha = float(fields.get("filter_alpha", "0"))
+        except ValueError:
+            raise ValueError(f"{label}: filter_alpha is not a number")
+        alpha_ppm = round(alpha * ALPHA_SCALE)
+        if not 0 < alpha_ppm <= ALPHA_SCALE:
+            raise ValueError(f"{label}: filter_alpha must be in (0, 1]")
+
+    return SensorEntry(
+        id=sensor_id,
+        name=fields.get("name", ""),
+        type=sensor_type,
+        channel=channel,
+        units=fields.get("units", ""),
+        period_ms=_int_field(fields, "period_ms", 0xFFFFFFFF, label),
+        filter=filter_name,
+        filter_length=_int_field(fields, "filter_length", FILTER_MAX_LENGTH, label),
+        decimation=_int_field(fields, "decimation", FILTER_MAX_DECIMATION, label),
+        alpha_ppm=alpha_ppm,
+        history=_int_field(fields, "history", HISTORY_MAX_DEPTH, label),
+        decimals=_int_field(fields, "decimals", MAX_DECIMALS, label, DEFAULT_DECIMALS),
+    )
+
+
+def build_image(sensors: List[SensorEntry], max_sensors: int = MAX_SENSORS) -> bytes:
+    """
+    Build the binary image.
+
+    Args:
+        sensors: Resolved sensors
+        max_sensors: Flight table size (SMART_QSO_MAX_SENSORS)
+
+    Returns:
+        Image bytes
+
+    Raises:
+        ValueError: If the sensors do not fit
+    """
+    if len(sensors) > max_sensors:
+        raise ValueError(f"{len(sensors)} sensors, the flight table holds {max_sensors}")
+    history = sum(s.history for s in sensors if s.type not in TEXT_TYPES)
+    if history > HISTORY_POOL_SIZE:
+        raise ValueError(f"{history} history samples, the flight pool holds {HISTORY_POOL_SIZE}")
+
+    pool = bytearray()
+    offsets: Dict[str, int] = {}
+
+    def intern(text: str) -> int:
+        if text not in offsets:
+            offsets[text] = len(pool)
+            pool.extend(text.encode("ascii") + b"\0")
+        return offsets[text]
+
+    records = bytearray()
+    for s in sensors:
+        records += struct.pack(
+            RECORD_FORMAT,
+            TYPE_IDS[s.type],
+            CHANNEL_IDS[s.channel],
+            FILTER_IDS[s.filter],
+            s.filter_length,
+            s.decimation,
+            intern(s.id),
+            intern(s.name),
+            intern(s.units),
+            s.period_ms,
+            s.alpha_ppm,
+            s.history,
+            s.decimals,
+            0,
+        )
+
+    size = HEADER_SIZE + len(records) + len(pool)
+    if size > MAX_IMAGE_SIZE:
+        raise ValueError(f"image is {size} bytes, the flash region holds {MAX_IMAGE_SIZE}")
+
+    head = struct.pack("<IHHHH", IMAGE_MAGIC, IMAGE_VERSION, len(sensors), len(pool), 0)
+    body = bytes(records) + bytes(pool)
+    crc = zlib.crc32(body, zlib.crc32(head)) & 0xFFFFFFFF
+    return head + struct.pack("<I", crc) + body
+
+
+def compile_yaml(text: str, max_sensors: int = MAX_SENSORS) -> bytes:
+    """
+    Compile sensors.yaml text to an image.
+
+    Args:
+        text: sensors.yaml contents
+        max_sensors: Flight table size
+
+    Returns:
+        Image bytes
+    """
+    items = parse_sensors_yaml(text)
+    if not items:
+        raise ValueError("no sensors defined")
+    return build_image([resolve_sensor(fields) for fields in items], max_sensors)
+
+
+def decode_image(data: bytes) -> List[SensorEntry]:
+    """
+    Decode and check an image.
+
+    Args:
+        data: Image bytes
+
+    Returns:
+        Sensors in the image
+
+    Raises:
+        ValueError: If the image is corrupt
+    """
+    if len(data) < HEADER_SIZE:
+        raise ValueError(f"image too short: {len(data)} < {HEADER_SIZE}")
+    magic, version, count, pool_size, _, crc = struct.unpack(HEADER_FORMAT, data[:HEADER_SIZE])
+    if magic != IMAGE_MAGIC:
+        raise ValueError(f"invalid magic: 0x{magic:08X}")
+    if version != IMAGE_VERSION:
+        raise ValueError(f"unsupported version {version}")
+
+    size = HEADER_SIZE + count * RECORD_SIZE + pool_size
+    if len(data) < size:
+        raise ValueError(f"image truncated: {len(data)} < {size}")
+    calculated = zlib.crc32(data[HEADER_SIZE:size], zlib.crc32(data[:12])) & 0xFFFFFFFF
+    if crc != calculated:
+        raise ValueError(f"CRC mismatch: 0x{crc:08X} != 0x{calculated:08X}")
+
+    pool = data[HEADER_SIZE + count * RECORD_SIZE:size]
+
+    def string(offset: int) -> str:
+        end = pool.find(b"\0", offset)
+        if offset >= len(pool) or end < 0:
+            raise ValueError(f"string offset {offset} out of range")
+        return pool[offset:end].decode("ascii")
+
+    types = {v: k for k, v in TYPE_IDS.items()}
+    channels = {v: k for k, v in CHANNEL_IDS.items()}
+    filters = {v: k for k, v in FILTER_IDS.items()}
+    sensors: List[SensorEntry] = []
+    for i in range(count):
+        start = HEADER_SIZE + i * RECORD_SIZE
+        (type_id, channel_id, filter_id, length, decimation, id_off, name_off, units_off,
+         period_ms, alpha_ppm, history, decimals, _) = struct.unpack(RECORD_FORMAT, data[start:start + RECORD_SIZE])
+        if type_id not in types or channel_id not in channels or filter_id not in filters:
+            raise ValueError(f"record {i}: unknown type, channel or filter ID")
+        sensors.append(SensorEntry(
+            id=string(id_off),
+            name=string(name_off),
+            type=types[type_id],
+            channel=channels[channel_id],
+            units=string(units_off),
+            period_ms=period_ms,
+            filter=filters[filter_id],
+            filter_length=length,
+            decimation=decimation,
+            alpha_ppm=alpha_ppm,
+            history=history,
+            decimals=decimals,
+        ))
+    return sensors
+
+
+def main() -> int:
+    """Main entry point."""
+    parser = argparse.ArgumentParser(
+        description="SMART-QSO Sensor Configuration Image Compiler",
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+        epilog="""
+Examples:
+  %(prog)s software/flight/sensors.yaml -o sensors.bin
+  %(prog)s sensors.yaml -o sensors.bin --max-sensors 64
+  %(prog)s --dump sensors.bin
+        """
+    )
+
+    parser.add_argument("input", nargs="?", help="sensors.yaml to compile")
+    parser.add_argument("-o", "--output", help="Output image file")
+    parser.add_argument("--max-sensors", type=int, default=MAX_SENSORS,
+                        help=f"Flight sensor table size (default {MAX_SENSORS})")
+    parser.add_argument("--dump", help="Check and print an image file")
+
+    args = parser.parse_args()
+
+    if args.dump:
+        try:
+            sensors = decode_image(Path(args.dump).read_bytes())
+        except (IOError, ValueError) as e:
+            print(f"Invalid image: {e}", file=sys.stderr)
+            return 1
+        for s in sensors:
+            extra = ""
+            if s.filter == "iir":
+                extra += f" filter=iir alpha={s.alpha_ppm / ALPHA_SCALE:g}"
+            elif s.filter != "none":
+                extra += f" filter={s.filter} length={s.filter_length}"
+            if s.decimation > 1:
+                extra += f" decimation={s.decimation}"
+            if s.history:
+                extra += f" history={s.history}"
+            if s.decimals != DEFAULT_DECIMALS:
+                extra += f" decimals={s.decimals}"
+            print(f"{s.id:<8} {s.type:<16} {s.channel or '-':<18} {s.period_ms:>6} ms "
+                  f"{s.units:<4} \"{s.name}\"{extra}")
+        return 0
+
+    if not args.input or not args.output:
+        parser.print_help()
+        return 1
+
+    try:
+        image = compile_yaml(Path(args.input).read_text(), args.max_sensors)
+    except IOError as e:
+        print(f"Error reading input: {e}", file=sys.stderr)
+        return 1
+    except ValueError as e:
+        print(f"Error: {e}", file=sys.stderr)
+        return 1
+
+    Path(args.output).write_bytes(image)
+    print(f"Wrote {args.output}: {len(image)} bytes")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())